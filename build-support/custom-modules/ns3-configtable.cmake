@@ -167,6 +167,12 @@ macro(write_configtable)
   string(APPEND out "Netmap emulation FdNetDevice  : ")
   check_on_or_off("${ENABLE_EMU}" "${ENABLE_NETMAP_EMU}")
 
+  string(APPEND out "Packet metadata               : ")
+  check_on_or_off("${NS3_PACKET_METADATA}" "${NS3_PACKET_METADATA}")
+
+  string(APPEND out "Profiling counters            : ")
+  check_on_or_off("${NS3_PROFILING}" "${NS3_PROFILING}")
+
   string(APPEND out "PyViz visualizer              : ")
   check_on_or_off("${NS3_VISUALIZER}" "${ENABLE_VISUALIZER}")
 
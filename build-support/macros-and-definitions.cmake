@@ -592,6 +592,14 @@ macro(process_options)
     add_definitions(-DENABLE_DES_METRICS)
   endif()
 
+  if(${NS3_PROFILING})
+    add_definitions(-DENABLE_PROFILING)
+  endif()
+
+  if(NOT ${NS3_PACKET_METADATA})
+    add_definitions(-DDISABLE_PACKET_METADATA)
+  endif()
+
   if(${NS3_SANITIZE} AND ${NS3_SANITIZE_MEMORY})
     message(
       FATAL_ERROR
@@ -20,11 +20,27 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "boolean.h"
 #include "log.h"
+#include "profiler.h"
 #include "scheduler.h"
 #include "simulator.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define NS3_HAVE_DLADDR
+#endif
 
 /**
  * \file
@@ -45,10 +61,23 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("EventTelemetry",
+                          "Keep the count and dispatch time of the events by callee, "
+                          "and the event queue depth and horizon distribution.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&DefaultSimulatorImpl::m_eventTelemetry),
+                          MakeBooleanChecker())
+            .AddAttribute("EventTelemetryDumpInterval",
+                          "Simulated time between dumps of the event telemetry to std::clog. "
+                          "Zero disables the periodic dump.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&DefaultSimulatorImpl::m_telemetryDumpInterval),
+                          MakeTimeChecker());
     return tid;
 }
 
@@ -64,6 +93,9 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_eventCount = 0;
     m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
+    m_eventTelemetry = false;
+    m_nextTelemetryDumpTs = 0;
+    ResetEventTelemetry();
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl()
@@ -83,6 +115,7 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+    m_scheduledEventTypes.clear();
     SimulatorImpl::DoDispose();
 }
 
@@ -90,6 +123,11 @@ void
 DefaultSimulatorImpl::Destroy()
 {
     NS_LOG_FUNCTION(this);
+    if (m_eventTelemetry && m_telemetryDumpInterval.IsStrictlyPositive())
+    {
+        std::clog << "Event telemetry at " << TimeStep(m_currentTs).As(Time::S) << std::endl;
+        PrintEventTelemetry(std::clog);
+    }
     while (!m_destroyEvents.empty())
     {
         Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
@@ -129,6 +167,7 @@ DefaultSimulatorImpl::GetSystemId() const
 void
 DefaultSimulatorImpl::ProcessOneEvent()
 {
+    NS_PROFILE_SCOPE("core", "DefaultSimulatorImpl::ProcessOneEvent");
     Scheduler::Event next = m_events->RemoveNext();
 
     PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
@@ -141,12 +180,237 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_eventTelemetry)
+    {
+        InvokeWithTelemetry(next.impl, next.key.m_uid);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
 }
 
+void
+DefaultSimulatorImpl::RecordEventType(EventImpl* event, uint32_t uid)
+{
+    EventCallee callee = event->GetCallee();
+    m_scheduledEventTypes[uid] =
+        EventTypeKey(callee.type ? callee.type : &typeid(*event),
+                     callee.objectType,
+                     callee.function,
+                     callee.object ? callee.object->GetInstanceTypeId().GetUid() : 0);
+}
+
+void
+DefaultSimulatorImpl::InvokeWithTelemetry(EventImpl* event, uint32_t uid)
+{
+    // the object of a cancelled event may be gone, so its type was recorded
+    // when the event was scheduled
+    EventTypeKey key(&typeid(*event), nullptr, nullptr, 0);
+    auto it = m_scheduledEventTypes.find(uid);
+    if (it != m_scheduledEventTypes.end())
+    {
+        key = it->second;
+        m_scheduledEventTypes.erase(it);
+    }
+    EventTypeCounters& counters = m_eventTypes[key];
+
+    if (event->IsCancelled())
+    {
+        counters.cancelled++;
+    }
+    else
+    {
+        auto start = std::chrono::steady_clock::now();
+        event->Invoke();
+        counters.dispatchNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+        counters.count++;
+    }
+
+    uint64_t depth = m_unscheduledEvents;
+    m_queueStats.samples++;
+    m_queueStats.depthSum += depth;
+    m_queueStats.maxDepth = std::max(m_queueStats.maxDepth, depth);
+
+    if (m_telemetryDumpInterval.IsStrictlyPositive())
+    {
+        if (m_nextTelemetryDumpTs == 0)
+        {
+            m_nextTelemetryDumpTs = m_telemetryDumpInterval.GetTimeStep();
+        }
+        if (m_currentTs >= m_nextTelemetryDumpTs)
+        {
+            std::clog << "Event telemetry at " << TimeStep(m_currentTs).As(Time::S) << std::endl;
+            PrintEventTelemetry(std::clog);
+            while (m_nextTelemetryDumpTs <= m_currentTs)
+            {
+                m_nextTelemetryDumpTs += m_telemetryDumpInterval.GetTimeStep();
+            }
+        }
+    }
+}
+
+void
+DefaultSimulatorImpl::RecordHorizon(const Time& delay)
+{
+    uint32_t bucket = 0;
+    if (delay.IsStrictlyPositive())
+    {
+        // one bucket per decade, from 1 us to 10 s
+        double limit = 1e-6;
+        bucket = 1;
+        while (bucket < HORIZON_BUCKETS - 1 && delay.GetSeconds() >= limit)
+        {
+            limit *= 10;
+            bucket++;
+        }
+    }
+    m_queueStats.horizons[bucket]++;
+}
+
+/**
+ * \ingroup simulator
+ * Demangle a symbol or type name, when supported.
+ *
+ * \param [in] name The mangled name.
+ * \returns The demangled name, or the name itself.
+ */
+static std::string
+Demangle(std::string name)
+{
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        name = demangled;
+    }
+    std::free(demangled);
+#endif
+    return name;
+}
+
+/**
+ * \ingroup simulator
+ * Get a readable name for the callee of an event.
+ *
+ * The symbol of the function is used when it can be resolved, otherwise
+ * the demangled type of the callee: the signature of the function or class
+ * method, or the type of the functor or of the event class. The dynamic
+ * type of the object, if known, is appended for class methods.
+ *
+ * \param [in] type The type of the callee.
+ * \param [in] objectType The dynamic type of the object, if known.
+ * \param [in] function The address of the function, if known.
+ * \returns The name of the callee.
+ */
+static std::string
+GetCalleeName(const std::type_info* type, const std::type_info* objectType, const void* function)
+{
+    std::string name = Demangle(type->name());
+#ifdef NS3_HAVE_DLADDR
+    Dl_info info;
+    if (function != nullptr && dladdr(function, &info) != 0 && info.dli_sname != nullptr &&
+        info.dli_saddr == function)
+    {
+        name = Demangle(info.dli_sname);
+    }
+#endif
+    if (objectType != nullptr)
+    {
+        name += " on " + Demangle(objectType->name());
+    }
+    return name;
+}
+
+std::vector<DefaultSimulatorImpl::EventTypeStats>
+DefaultSimulatorImpl::GetEventTypeStats() const
+{
+    std::vector<EventTypeStats> stats;
+    for (const auto& eventType : m_eventTypes)
+    {
+        EventTypeStats s;
+        uint16_t uid = std::get<3>(eventType.first);
+        // the TypeId already names the dynamic type of an ns-3 object
+        s.callee = GetCalleeName(std::get<0>(eventType.first),
+                                 uid == 0 ? std::get<1>(eventType.first) : nullptr,
+                                 std::get<2>(eventType.first));
+        if (uid != 0)
+        {
+            TypeId tid;
+            tid.SetUid(uid);
+            s.objectType = tid.GetName();
+        }
+        s.count = eventType.second.count;
+        s.cancelled = eventType.second.cancelled;
+        s.dispatchNs = eventType.second.dispatchNs;
+        stats.push_back(s);
+    }
+    std::sort(stats.begin(), stats.end(), [](const EventTypeStats& a, const EventTypeStats& b) {
+        return a.dispatchNs > b.dispatchNs;
+    });
+    return stats;
+}
+
+DefaultSimulatorImpl::QueueStats
+DefaultSimulatorImpl::GetQueueStats() const
+{
+    return m_queueStats;
+}
+
+void
+DefaultSimulatorImpl::PrintEventTelemetry(std::ostream& os) const
+{
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << std::setw(12) << "events" << std::setw(12) << "cancelled" << std::setw(14) << "time [ms]"
+       << std::setw(12) << "avg [us]"
+       << "  callee [object]" << std::endl;
+    for (const auto& s : GetEventTypeStats())
+    {
+        os << std::setw(12) << s.count << std::setw(12) << s.cancelled << std::setw(14)
+           << s.dispatchNs / 1e6 << std::setw(12)
+           << (s.count > 0 ? s.dispatchNs / 1e3 / s.count : 0.0) << "  " << s.callee;
+        if (!s.objectType.empty())
+        {
+            os << " [" << s.objectType << "]";
+        }
+        os << std::endl;
+    }
+
+    os << "queue depth: mean "
+       << (m_queueStats.samples > 0 ? double(m_queueStats.depthSum) / m_queueStats.samples : 0.0)
+       << " max " << m_queueStats.maxDepth << std::endl;
+    static const char* horizonLabels[HORIZON_BUCKETS] =
+        {"0", "<1us", "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", "<10s", ">=10s"};
+    os << "event horizons:";
+    for (uint32_t bucket = 0; bucket < HORIZON_BUCKETS; ++bucket)
+    {
+        os << " " << horizonLabels[bucket] << ": " << m_queueStats.horizons[bucket];
+    }
+    os << std::endl;
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void
+DefaultSimulatorImpl::ResetEventTelemetry()
+{
+    m_eventTypes.clear();
+    m_queueStats.samples = 0;
+    m_queueStats.depthSum = 0;
+    m_queueStats.maxDepth = 0;
+    m_queueStats.horizons.fill(0);
+}
+
 bool
 DefaultSimulatorImpl::IsFinished() const
 {
@@ -177,6 +441,10 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         ev.key.m_ts = m_currentTs + event.timestamp;
         ev.key.m_context = event.context;
         ev.key.m_uid = m_uid;
+        if (m_eventTelemetry)
+        {
+            RecordEventType(ev.impl, m_uid);
+        }
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
@@ -228,6 +496,11 @@ DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
 
     NS_ASSERT_MSG(delay.IsPositive(), "DefaultSimulatorImpl::Schedule(): Negative delay");
     Time tAbsolute = delay + TimeStep(m_currentTs);
+    if (m_eventTelemetry)
+    {
+        RecordHorizon(delay);
+        RecordEventType(event, m_uid);
+    }
 
     Scheduler::Event ev;
     ev.impl = event;
@@ -248,6 +521,11 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
     if (m_mainThreadId == std::this_thread::get_id())
     {
         Time tAbsolute = delay + TimeStep(m_currentTs);
+        if (m_eventTelemetry)
+        {
+            RecordHorizon(delay);
+            RecordEventType(event, m_uid);
+        }
         Scheduler::Event ev;
         ev.impl = event;
         ev.key.m_ts = (uint64_t)tAbsolute.GetTimeStep();
@@ -342,6 +620,10 @@ DefaultSimulatorImpl::Remove(const EventId& id)
     event.impl->Cancel();
     // whenever we remove an event from the event list, we have to unref it.
     event.impl->Unref();
+    if (m_eventTelemetry)
+    {
+        m_scheduledEventTypes.erase(event.key.m_uid);
+    }
 
     m_unscheduledEvents--;
 }
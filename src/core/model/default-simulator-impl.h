@@ -20,11 +20,20 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "nstime.h"
 #include "simulator-impl.h"
 
+#include <array>
 #include <list>
+#include <map>
 #include <mutex>
+#include <ostream>
+#include <string>
 #include <thread>
+#include <tuple>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
 
 /**
  * \file
@@ -42,6 +51,16 @@ class Scheduler;
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the EventTelemetry attribute is set, the simulator keeps, for each
+ * event type (the function or class method invoked by the event and the
+ * TypeId of its object), the number of dispatched and cancelled events and
+ * the wall-clock time spent in them. It also samples the depth of the event
+ * queue at every dispatch and keeps a histogram of the horizons of the
+ * scheduled events. The data is available through GetEventTypeStats,
+ * GetQueueStats and PrintEventTelemetry, and can be periodically dumped to
+ * std::clog with the EventTelemetryDumpInterval attribute. To use it, get the
+ * implementation with Simulator::GetImplementation and cast it.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -78,6 +97,56 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /** Number of buckets of the event horizon histogram. */
+    static constexpr uint32_t HORIZON_BUCKETS = 10;
+
+    /** Event telemetry of the events invoking the same callee. */
+    struct EventTypeStats
+    {
+        /** Function or class method invoked by the events. */
+        std::string callee;
+        /** TypeId name of the object the method is invoked on, if any. */
+        std::string objectType;
+        /** Number of dispatched events. */
+        uint64_t count;
+        /** Number of cancelled events removed from the queue. */
+        uint64_t cancelled;
+        /** Wall-clock time spent in the events, in nanoseconds. */
+        uint64_t dispatchNs;
+    };
+
+    /** Event queue telemetry. */
+    struct QueueStats
+    {
+        /** Number of queue depth samples, one per dispatched event. */
+        uint64_t samples;
+        /** Sum of the sampled queue depths. */
+        uint64_t depthSum;
+        /** Maximum sampled queue depth. */
+        uint64_t maxDepth;
+        /**
+         * Number of scheduled events by horizon (delay from the current
+         * time): zero, then below 1 us, 10 us, ..., 10 s, and above.
+         */
+        std::array<uint64_t, HORIZON_BUCKETS> horizons;
+    };
+
+    /**
+     * \returns The event telemetry, by decreasing dispatch time.
+     */
+    std::vector<EventTypeStats> GetEventTypeStats() const;
+    /**
+     * \returns The event queue telemetry.
+     */
+    QueueStats GetQueueStats() const;
+    /**
+     * Print the event and queue telemetry.
+     * \param [in,out] os The output stream.
+     */
+    void PrintEventTelemetry(std::ostream& os) const;
+    /** Clear the event and queue telemetry. */
+    void ResetEventTelemetry();
+
   private:
     void DoDispose() override;
 
@@ -85,6 +154,24 @@ class DefaultSimulatorImpl : public SimulatorImpl
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
+    /**
+     * Invoke an event and update the event telemetry.
+     * \param [in] event The event.
+     * \param [in] uid The uid of the event.
+     */
+    void InvokeWithTelemetry(EventImpl* event, uint32_t uid);
+    /**
+     * Record the type of a scheduled event, while the object it is bound
+     * to is known to be alive.
+     * \param [in] event The event.
+     * \param [in] uid The uid of the event.
+     */
+    void RecordEventType(EventImpl* event, uint32_t uid);
+    /**
+     * Update the event horizon histogram.
+     * \param [in] delay The delay of a scheduled event.
+     */
+    void RecordHorizon(const Time& delay);
 
     /** Wrap an event with its execution context. */
     struct EventWithContext
@@ -135,6 +222,33 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /**
+     * Event type: type of the callee, or event class when it is unknown,
+     * dynamic type of the object, function address and object TypeId uid.
+     */
+    typedef std::tuple<const std::type_info*, const std::type_info*, const void*, uint16_t>
+        EventTypeKey;
+    /** Telemetry counters of an event type. */
+    struct EventTypeCounters
+    {
+        uint64_t count{0};      //!< Dispatched events.
+        uint64_t cancelled{0};  //!< Cancelled events.
+        uint64_t dispatchNs{0}; //!< Wall-clock time spent in the events.
+    };
+
+    /** Whether the event telemetry is collected. */
+    bool m_eventTelemetry;
+    /** Simulated time between dumps of the telemetry, zero to disable. */
+    Time m_telemetryDumpInterval;
+    /** Timestamp of the next dump of the telemetry. */
+    uint64_t m_nextTelemetryDumpTs;
+    /** The event telemetry. */
+    std::map<EventTypeKey, EventTypeCounters> m_eventTypes;
+    /** Type of the events in the queue, by event uid. */
+    std::unordered_map<uint32_t, EventTypeKey> m_scheduledEventTypes;
+    /** The event queue telemetry. */
+    QueueStats m_queueStats;
 };
 
 } // namespace ns3
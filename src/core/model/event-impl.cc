@@ -67,4 +67,10 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+EventCallee
+EventImpl::GetCallee() const
+{
+    return EventCallee();
+}
+
 } // namespace ns3
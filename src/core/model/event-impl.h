@@ -22,6 +22,7 @@
 #include "simple-ref-count.h"
 
 #include <stdint.h>
+#include <typeinfo>
 
 /**
  * \file
@@ -32,6 +33,25 @@
 namespace ns3
 {
 
+class ObjectBase;
+
+/**
+ * \ingroup events
+ * Identification of the function invoked by an event, used by the
+ * event telemetry of DefaultSimulatorImpl.
+ */
+struct EventCallee
+{
+    /** Type of the functor, function pointer or class method pointer, if known. */
+    const std::type_info* type = nullptr;
+    /** Dynamic type of the object a class method is invoked on, if polymorphic. */
+    const std::type_info* objectType = nullptr;
+    /** Address of the function, for the events which invoke a function. */
+    const void* function = nullptr;
+    /** Object the class method is invoked on, if it is an ObjectBase. */
+    const ObjectBase* object = nullptr;
+};
+
 /**
  * \ingroup events
  * \brief A simulation event.
@@ -66,6 +86,14 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * Get the function invoked by this event.
+     *
+     * The object the event is bound to, if any, must be alive.
+     *
+     * \returns The callee, with null fields when it is unknown.
+     */
+    virtual EventCallee GetCallee() const;
 
   protected:
     /**
@@ -58,6 +58,11 @@ MakeEvent(void (*f)())
             (*m_function)();
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function);
+        }
+
       private:
         F m_function;
     }* ev = new EventFunctionImpl0(f);
@@ -353,6 +353,9 @@ EventImpl* MakeEvent(T function);
 #include "event-impl.h"
 #include "type-traits.h"
 
+#include <type_traits>
+#include <typeinfo>
+
 namespace ns3
 {
 
@@ -392,6 +395,55 @@ struct EventMemberImplObjTraits<T*>
     }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Build the EventCallee of an event which invokes a class method.
+ *
+ * The method is identified by the type of the class method pointer and by
+ * the dynamic type of the object, which tells apart the overrides of a
+ * virtual method. The object must be alive.
+ *
+ * \tparam MEM \deduced The class method function signature.
+ * \tparam T \deduced The class type.
+ * \param [in] function The class method.
+ * \param [in] obj The object the method is invoked on.
+ * \return The callee.
+ */
+template <typename MEM, typename T>
+EventCallee
+MakeEventCallee(const MEM& function, const T& obj)
+{
+    EventCallee callee;
+    callee.type = &typeid(MEM);
+    if constexpr (std::is_polymorphic<T>::value)
+    {
+        callee.objectType = &typeid(obj);
+    }
+    if constexpr (std::is_base_of<ObjectBase, T>::value)
+    {
+        callee.object = &obj;
+    }
+    return callee;
+}
+
+/**
+ * \ingroup makeeventfnptr
+ * Build the EventCallee of an event which invokes a function.
+ *
+ * \tparam F \deduced The function pointer type.
+ * \param [in] function The function.
+ * \return The callee.
+ */
+template <typename F>
+EventCallee
+MakeEventCallee(F function)
+{
+    EventCallee callee;
+    callee.type = &typeid(F);
+    callee.function = reinterpret_cast<const void*>(function);
+    return callee;
+}
+
 template <typename MEM, typename OBJ>
 EventImpl*
 MakeEvent(MEM mem_ptr, OBJ obj)
@@ -416,6 +468,12 @@ MakeEvent(MEM mem_ptr, OBJ obj)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)();
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function,
+                                   EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
         OBJ m_obj;
         MEM m_function;
     }* ev = new EventMemberImpl0(obj, mem_ptr);
@@ -449,6 +507,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function,
+                                   EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -484,6 +548,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1, m_a2);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function,
+                                   EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -521,6 +591,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1, m_a2, m_a3);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function,
+                                   EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -561,6 +637,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
              m_function)(m_a1, m_a2, m_a3, m_a4);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function,
+                                   EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -609,6 +691,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
              m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function,
+                                   EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -660,6 +748,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
              m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function,
+                                   EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -700,6 +794,11 @@ MakeEvent(void (*f)(U1), T1 a1)
             (*m_function)(m_a1);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
     }* ev = new EventFunctionImpl1(f, a1);
@@ -735,6 +834,11 @@ MakeEvent(void (*f)(U1, U2), T1 a1, T2 a2)
             (*m_function)(m_a1, m_a2);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -772,6 +876,11 @@ MakeEvent(void (*f)(U1, U2, U3), T1 a1, T2 a2, T3 a3)
             (*m_function)(m_a1, m_a2, m_a3);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -818,6 +927,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4), T1 a1, T2 a2, T3 a3, T4 a4)
             (*m_function)(m_a1, m_a2, m_a3, m_a4);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -868,6 +982,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4, U5), T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
             (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -922,6 +1041,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4, U5, U6), T1 a1, T2 a2, T3 a3, T4 a4, T5 a5,
             (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
         }
 
+        EventCallee GetCallee() const override
+        {
+            return MakeEventCallee(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -956,6 +1080,13 @@ MakeEvent(T function)
             m_function();
         }
 
+        EventCallee GetCallee() const override
+        {
+            EventCallee callee;
+            callee.type = &typeid(T);
+            return callee;
+        }
+
         T m_function;
     }* ev = new EventImplFunctional(function);
 
@@ -0,0 +1,261 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup debugging
+ * ns3::Profiler implementation.
+ */
+
+#ifdef ENABLE_PROFILING
+
+namespace
+{
+/** Number of heap allocations made by the process. */
+std::atomic<uint64_t> g_allocations{0};
+} // namespace
+
+void*
+operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif /* ENABLE_PROFILING */
+
+namespace ns3
+{
+
+namespace
+{
+/** Innermost profiled scope of the calling thread. */
+thread_local ProfileScope* g_currentScope = nullptr;
+
+/**
+ * \return the registry of the profiling counters
+ */
+std::vector<ProfileCounter*>&
+GetCounters()
+{
+    static std::vector<ProfileCounter*> counters;
+    return counters;
+}
+
+/**
+ * \return the mutex protecting the registry
+ */
+std::mutex&
+GetCountersMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+} // namespace
+
+ProfileCounter::ProfileCounter(const char* module, const char* name)
+    : m_module(module),
+      m_name(name)
+{
+    Reset();
+    Profiler::Register(this);
+}
+
+void
+ProfileCounter::Reset()
+{
+    m_calls = 0;
+    m_totalNs = 0;
+    m_selfNs = 0;
+    m_allocs = 0;
+    m_selfAllocs = 0;
+}
+
+ProfileScope::ProfileScope(ProfileCounter& counter)
+    : m_counter(counter),
+      m_parent(g_currentScope),
+      m_start(std::chrono::steady_clock::now()),
+      m_startAllocs(Profiler::GetAllocations()),
+      m_childNs(0),
+      m_childAllocs(0)
+{
+    g_currentScope = this;
+}
+
+ProfileScope::~ProfileScope()
+{
+    uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - m_start)
+                           .count();
+    uint64_t allocs = Profiler::GetAllocations() - m_startAllocs;
+
+    m_counter.m_calls++;
+    m_counter.m_totalNs += elapsed;
+    m_counter.m_selfNs += elapsed - std::min(elapsed, m_childNs);
+    m_counter.m_allocs += allocs;
+    m_counter.m_selfAllocs += allocs - std::min(allocs, m_childAllocs);
+
+    if (m_parent != nullptr)
+    {
+        m_parent->m_childNs += elapsed;
+        m_parent->m_childAllocs += allocs;
+    }
+    g_currentScope = m_parent;
+}
+
+void
+Profiler::Register(ProfileCounter* counter)
+{
+    std::lock_guard<std::mutex> lock(GetCountersMutex());
+    GetCounters().push_back(counter);
+}
+
+void
+Profiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(GetCountersMutex());
+    for (auto counter : GetCounters())
+    {
+        counter->Reset();
+    }
+}
+
+bool
+Profiler::HasData()
+{
+    std::lock_guard<std::mutex> lock(GetCountersMutex());
+    for (auto counter : GetCounters())
+    {
+        if (counter->m_calls > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t
+Profiler::GetAllocations()
+{
+#ifdef ENABLE_PROFILING
+    return g_allocations.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+void
+Profiler::Report(std::ostream& os)
+{
+    std::lock_guard<std::mutex> lock(GetCountersMutex());
+
+    // group by module, most expensive regions first
+    std::map<std::string, std::vector<const ProfileCounter*>> modules;
+    for (auto counter : GetCounters())
+    {
+        if (counter->m_calls > 0)
+        {
+            modules[counter->m_module].push_back(counter);
+        }
+    }
+
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << "Profiler report (self excludes nested profiled regions)" << std::endl;
+    os << std::left << std::setw(48) << "region" << std::right << std::setw(12) << "calls"
+       << std::setw(14) << "total [ms]" << std::setw(14) << "self [ms]" << std::setw(12)
+       << "avg [us]" << std::setw(12) << "allocs" << std::setw(12) << "self allocs"
+       << std::endl;
+    os << std::fixed << std::setprecision(3);
+    for (auto& module : modules)
+    {
+        auto& counters = module.second;
+        std::sort(counters.begin(),
+                  counters.end(),
+                  [](const ProfileCounter* a, const ProfileCounter* b) {
+                      return a->m_selfNs > b->m_selfNs;
+                  });
+        uint64_t calls = 0;
+        uint64_t selfNs = 0;
+        uint64_t selfAllocs = 0;
+        for (auto counter : counters)
+        {
+            calls += counter->m_calls;
+            selfNs += counter->m_selfNs;
+            selfAllocs += counter->m_selfAllocs;
+        }
+        os << std::left << std::setw(48) << module.first << std::right << std::setw(12) << calls
+           << std::setw(14) << "" << std::setw(14) << selfNs / 1e6 << std::setw(12) << ""
+           << std::setw(12) << "" << std::setw(12) << selfAllocs << std::endl;
+        for (auto counter : counters)
+        {
+            os << "  " << std::left << std::setw(46) << counter->m_name << std::right
+               << std::setw(12) << counter->m_calls << std::setw(14) << counter->m_totalNs / 1e6
+               << std::setw(14) << counter->m_selfNs / 1e6 << std::setw(12)
+               << counter->m_totalNs / 1e3 / counter->m_calls << std::setw(12)
+               << counter->m_allocs << std::setw(12) << counter->m_selfAllocs << std::endl;
+        }
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace ns3
@@ -0,0 +1,164 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_PROFILER_H
+#define NS3_PROFILER_H
+
+/**
+ * \file
+ * \ingroup debugging
+ * ns3::Profiler declaration and the NS_PROFILE_SCOPE macro.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup debugging
+ *
+ * Accumulated statistics of a profiled code region.
+ *
+ * Counters are normally created by the NS_PROFILE_SCOPE macro as
+ * function-local statics and register themselves with the Profiler.
+ */
+class ProfileCounter
+{
+  public:
+    /**
+     * Create and register a counter.
+     * \param module the name of the module the region belongs to
+     * \param name the name of the region
+     */
+    ProfileCounter(const char* module, const char* name);
+
+    /** Clear the accumulated statistics. */
+    void Reset();
+
+    const char* m_module;  //!< module the region belongs to
+    const char* m_name;    //!< name of the region
+    uint64_t m_calls;      //!< number of times the region was entered
+    uint64_t m_totalNs;    //!< wall-clock time spent in the region
+    uint64_t m_selfNs;     //!< time not spent in nested profiled regions
+    uint64_t m_allocs;     //!< heap allocations made in the region
+    uint64_t m_selfAllocs; //!< allocations not made in nested profiled regions
+};
+
+/**
+ * \ingroup debugging
+ *
+ * RAII timer that charges the enclosing scope to a ProfileCounter.
+ *
+ * Scopes nest: the time and allocations of a nested profiled scope are
+ * excluded from the self time and self allocations of its parent, so that
+ * the per-module self figures of the report add up to the profiled time.
+ */
+class ProfileScope
+{
+  public:
+    /**
+     * Start timing.
+     * \param counter the counter to charge
+     */
+    ProfileScope(ProfileCounter& counter);
+    /** Stop timing and update the counter. */
+    ~ProfileScope();
+
+  private:
+    ProfileCounter& m_counter;                        //!< charged counter
+    ProfileScope* m_parent;                           //!< enclosing profiled scope
+    std::chrono::steady_clock::time_point m_start;    //!< entry time
+    uint64_t m_startAllocs;                           //!< allocation count at entry
+    uint64_t m_childNs;                               //!< time spent in nested scopes
+    uint64_t m_childAllocs;                           //!< allocations made in nested scopes
+};
+
+/**
+ * \ingroup debugging
+ *
+ * Registry of the profiling counters and report generator.
+ *
+ * The profiling counters are compiled in only when ns-3 is configured with
+ * \c --enable-profiling (CMake option \c NS3_PROFILING), which defines
+ * \c ENABLE_PROFILING. In that case the report is printed to std::clog at
+ * Simulator::Destroy, and can be printed at any other time with Report.
+ * Heap allocations are counted by replacing the global operator new.
+ */
+class Profiler
+{
+  public:
+    /**
+     * Add a counter to the registry.
+     * \param counter the counter
+     */
+    static void Register(ProfileCounter* counter);
+
+    /**
+     * Print the calls, time and allocations of each profiled region, grouped
+     * by module, to an output stream.
+     * \param os the output stream
+     */
+    static void Report(std::ostream& os);
+
+    /** Clear the statistics of all the counters. */
+    static void Reset();
+
+    /**
+     * \return whether any profiled region has been entered since the last Reset
+     */
+    static bool HasData();
+
+    /**
+     * \return the number of heap allocations made so far by the process,
+     *         or zero if allocations are not counted
+     */
+    static uint64_t GetAllocations();
+};
+
+} // namespace ns3
+
+/**
+ * \ingroup debugging
+ * Helper to build unique identifiers in NS_PROFILE_SCOPE.
+ */
+#define NS_PROFILE_CONCAT_IMPL(a, b) a##b
+/**
+ * \ingroup debugging
+ * Helper to build unique identifiers in NS_PROFILE_SCOPE.
+ */
+#define NS_PROFILE_CONCAT(a, b) NS_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILING
+/**
+ * \ingroup debugging
+ * Charge the rest of the enclosing scope to the profiling counter
+ * identified by module and name. Compiles to nothing unless ns-3 is
+ * configured with profiling enabled.
+ * \param module the name of the module, as a string literal
+ * \param name the name of the profiled region, as a string literal
+ */
+#define NS_PROFILE_SCOPE(module, name)                                                             \
+    static ns3::ProfileCounter NS_PROFILE_CONCAT(nsProfileCounter, __LINE__)(module, name);       \
+    ns3::ProfileScope NS_PROFILE_CONCAT(nsProfileScope,                                            \
+                                        __LINE__)(NS_PROFILE_CONCAT(nsProfileCounter, __LINE__))
+#else
+#define NS_PROFILE_SCOPE(module, name)
+#endif
+
+#endif /* NS3_PROFILER_H */
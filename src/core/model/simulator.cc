@@ -25,6 +25,7 @@
 #include "log.h"
 #include "map-scheduler.h"
 #include "object-factory.h"
+#include "profiler.h"
 #include "ptr.h"
 #include "scheduler.h"
 #include "simulator-impl.h"
@@ -156,6 +157,14 @@ Simulator::Destroy()
     (*pimpl)->Destroy();
     (*pimpl)->Unref();
     *pimpl = nullptr;
+
+#ifdef ENABLE_PROFILING
+    if (Profiler::HasData())
+    {
+        Profiler::Report(std::clog);
+        Profiler::Reset();
+    }
+#endif
 }
 
 void
@@ -0,0 +1,113 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/profiler.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup debugging
+ * Profiler test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup core-tests
+ * Check the accounting of nested profiled scopes and the report.
+ */
+class ProfilerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ProfilerTestCase();
+    void DoRun() override;
+};
+
+ProfilerTestCase::ProfilerTestCase()
+    : TestCase("Check the accounting of nested profiled scopes")
+{
+}
+
+void
+ProfilerTestCase::DoRun()
+{
+    // counters must outlive the test, as they stay in the registry
+    static ProfileCounter outer("profiler-test-outer", "Outer");
+    static ProfileCounter inner("profiler-test-inner", "Inner");
+    Profiler::Reset();
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        ProfileScope outerScope(outer);
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            ProfileScope innerScope(inner);
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(outer.m_calls, 10, "Wrong number of outer calls");
+    NS_TEST_ASSERT_MSG_EQ(inner.m_calls, 30, "Wrong number of inner calls");
+    NS_TEST_ASSERT_MSG_EQ(inner.m_selfNs, inner.m_totalNs, "Leaf scope self time != total time");
+    NS_TEST_ASSERT_MSG_EQ(outer.m_selfNs + inner.m_totalNs,
+                          outer.m_totalNs,
+                          "Nested time not excluded from the self time of the parent");
+    NS_TEST_ASSERT_MSG_EQ(Profiler::HasData(), true, "Profiler has no data");
+
+    std::ostringstream report;
+    Profiler::Report(report);
+    NS_TEST_ASSERT_MSG_NE(report.str().find("profiler-test-outer"),
+                          std::string::npos,
+                          "Module missing from the report");
+    NS_TEST_ASSERT_MSG_NE(report.str().find("Inner"),
+                          std::string::npos,
+                          "Region missing from the report");
+
+    Profiler::Reset();
+    NS_TEST_ASSERT_MSG_EQ(outer.m_calls, 0, "Counter not reset");
+    NS_TEST_ASSERT_MSG_EQ(outer.m_totalNs, 0, "Counter not reset");
+}
+
+/**
+ * \ingroup core-tests
+ * Profiler test suite
+ */
+class ProfilerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    ProfilerTestSuite()
+        : TestSuite("profiler")
+    {
+        AddTestCase(new ProfilerTestCase());
+    }
+};
+
+/**
+ * \ingroup core-tests
+ * ProfilerTestSuite instance variable.
+ */
+static ProfilerTestSuite g_profilerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -16,7 +16,10 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/boolean.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/default-simulator-impl.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
@@ -24,6 +27,9 @@
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <string>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -717,6 +723,230 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the event telemetry of DefaultSimulatorImpl.
+ */
+class SimulatorEventTelemetryTestCase : public TestCase
+{
+  public:
+    SimulatorEventTelemetryTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Test Events.
+     * @{
+     */
+    void EventA(){};
+    void EventB(int){};
+    /** @} */
+};
+
+SimulatorEventTelemetryTestCase::SimulatorEventTelemetryTestCase()
+    : TestCase("Check the event telemetry of DefaultSimulatorImpl")
+{
+}
+
+void
+SimulatorEventTelemetryTestCase::DoRun()
+{
+    Simulator::Destroy();
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventTelemetry", BooleanValue(true));
+
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(i), &SimulatorEventTelemetryTestCase::EventA, this);
+    }
+    Simulator::Schedule(Seconds(20), &SimulatorEventTelemetryTestCase::EventB, this, 1);
+    EventId cancelled =
+        Simulator::Schedule(Seconds(20), &SimulatorEventTelemetryTestCase::EventB, this, 2);
+    cancelled.Cancel();
+    Simulator::ScheduleNow(&SimulatorEventTelemetryTestCase::EventB, this, 3);
+    Simulator::Run();
+
+    Ptr<DefaultSimulatorImpl> impl =
+        DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Not using DefaultSimulatorImpl");
+
+    std::vector<DefaultSimulatorImpl::EventTypeStats> stats = impl->GetEventTypeStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), 2, "Events not grouped by callee");
+    uint64_t eventsA = 0;
+    uint64_t eventsB = 0;
+    uint64_t cancelledB = 0;
+    for (const auto& s : stats)
+    {
+        if (s.count == 5)
+        {
+            eventsA = s.count;
+        }
+        else
+        {
+            eventsB = s.count;
+            cancelledB = s.cancelled;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(eventsA, 5, "Wrong number of EventA dispatches");
+    NS_TEST_ASSERT_MSG_EQ(eventsB, 2, "Wrong number of EventB dispatches");
+    NS_TEST_ASSERT_MSG_EQ(cancelledB, 1, "Wrong number of cancelled EventB");
+
+    DefaultSimulatorImpl::QueueStats queue = impl->GetQueueStats();
+    NS_TEST_ASSERT_MSG_EQ(queue.samples, 8, "Wrong number of queue depth samples");
+    NS_TEST_ASSERT_MSG_EQ(queue.maxDepth, 7, "Wrong maximum queue depth");
+    NS_TEST_ASSERT_MSG_EQ(queue.horizons[0], 2, "Wrong number of zero-delay events");
+    NS_TEST_ASSERT_MSG_EQ(queue.horizons[5], 4, "Wrong number of events below 10 ms");
+    NS_TEST_ASSERT_MSG_EQ(queue.horizons[DefaultSimulatorImpl::HORIZON_BUCKETS - 1],
+                          2,
+                          "Wrong number of events above 10 s");
+
+    Simulator::Destroy();
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventTelemetry", BooleanValue(false));
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Base class of the handlers of the virtual method events.
+ */
+class TelemetryTestHandler
+{
+  public:
+    virtual ~TelemetryTestHandler() = default;
+
+    /** Handle an event. */
+    virtual void Handle() = 0;
+};
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief First override of the virtual method events.
+ */
+class TelemetryTestHandlerA : public TelemetryTestHandler
+{
+  public:
+    void Handle() override
+    {
+    }
+};
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Second override of the virtual method events.
+ */
+class TelemetryTestHandlerB : public TelemetryTestHandler
+{
+  public:
+    void Handle() override
+    {
+    }
+};
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Object whose events are cancelled after it is released.
+ */
+class TelemetryTestObject : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::TelemetryTestObject").SetParent<Object>();
+        return tid;
+    }
+
+    /** Handle an event. */
+    void Handle()
+    {
+    }
+};
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the event telemetry of virtual methods and of the cancelled
+ * events of released objects.
+ */
+class SimulatorEventTelemetryCalleeTestCase : public TestCase
+{
+  public:
+    SimulatorEventTelemetryCalleeTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SimulatorEventTelemetryCalleeTestCase::SimulatorEventTelemetryCalleeTestCase()
+    : TestCase("Check the event telemetry of virtual methods and released objects")
+{
+}
+
+void
+SimulatorEventTelemetryCalleeTestCase::DoRun()
+{
+    Simulator::Destroy();
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventTelemetry", BooleanValue(true));
+
+    // the two overrides of the same method are different callees
+    TelemetryTestHandlerA handlerA;
+    TelemetryTestHandlerB handlerB;
+    TelemetryTestHandler* handler = &handlerA;
+    Simulator::Schedule(MilliSeconds(1), &TelemetryTestHandler::Handle, handler);
+    handler = &handlerB;
+    Simulator::Schedule(MilliSeconds(2), &TelemetryTestHandler::Handle, handler);
+    Simulator::Schedule(MilliSeconds(3), &TelemetryTestHandler::Handle, handler);
+
+    // the object of a cancelled event is not accessed when it is dispatched
+    Ptr<TelemetryTestObject> object = CreateObject<TelemetryTestObject>();
+    Simulator::Schedule(MilliSeconds(4), &TelemetryTestObject::Handle, object);
+    EventId cancelled =
+        Simulator::Schedule(MilliSeconds(5), &TelemetryTestObject::Handle, PeekPointer(object));
+    cancelled.Cancel();
+    object = nullptr;
+    Simulator::Run();
+
+    Ptr<DefaultSimulatorImpl> impl =
+        DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Not using DefaultSimulatorImpl");
+
+    std::vector<DefaultSimulatorImpl::EventTypeStats> stats = impl->GetEventTypeStats();
+    // the events bound to a Ptr and to a raw pointer invoke the same callee
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), 3, "Overrides not told apart");
+    uint64_t objectEvents = 0;
+    uint64_t cancelledObjectEvents = 0;
+    for (const auto& s : stats)
+    {
+        if (s.objectType.empty())
+        {
+            // the callee is named after the override
+            bool isA = s.callee.find("TelemetryTestHandlerA") != std::string::npos;
+            bool isB = s.callee.find("TelemetryTestHandlerB") != std::string::npos;
+            NS_TEST_ASSERT_MSG_NE(isA, isB, "Override not in the callee name " << s.callee);
+            NS_TEST_ASSERT_MSG_EQ(s.count, (isA ? 1 : 2), "Wrong number of events of " << s.callee);
+            NS_TEST_ASSERT_MSG_EQ(s.cancelled, 0, "Wrong number of cancelled handler events");
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(s.objectType, "ns3::TelemetryTestObject", "Wrong object type");
+            objectEvents += s.count;
+            cancelledObjectEvents += s.cancelled;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(objectEvents, 1, "Wrong number of object events");
+    NS_TEST_ASSERT_MSG_EQ(cancelledObjectEvents, 1, "Wrong number of cancelled object events");
+
+    Simulator::Destroy();
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventTelemetry", BooleanValue(false));
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -740,6 +970,8 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        AddTestCase(new SimulatorEventTelemetryTestCase(), TestCase::QUICK);
+        AddTestCase(new SimulatorEventTelemetryCalleeTestCase(), TestCase::QUICK);
     }
 };
 
@@ -66,7 +66,7 @@ EpcSgwPgwApplication::UeInfo::RemoveBearer(uint8_t bearerId)
 }
 
 uint32_t
-EpcSgwPgwApplication::UeInfo::Classify(Ptr<Packet> p, uint16_t protocolNumber)
+EpcSgwPgwApplication::UeInfo::Classify(Ptr<const Packet> p, uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION(this << p);
     // we hardcode DOWNLINK direction since the PGW is espected to
@@ -167,14 +167,17 @@ EpcSgwPgwApplication::RecvFromTunDevice(Ptr<Packet> packet,
                                         uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION(this << source << dest << protocolNumber << packet << packet->GetSize());
-    m_rxTunPktTrace(packet->Copy());
-    Ptr<Packet> pCopy = packet->Copy();
+    // the sinks get their own copy, which is only made if there are any
+    if (!m_rxTunPktTrace.IsEmpty())
+    {
+        m_rxTunPktTrace(packet->Copy());
+    }
 
-    // get IP address of UE
+    // get IP address of UE, reading the header in place
     if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
     {
         Ipv4Header ipv4Header;
-        pCopy->RemoveHeader(ipv4Header);
+        packet->PeekHeader(ipv4Header);
         Ipv4Address ueAddr = ipv4Header.GetDestination();
         NS_LOG_LOGIC("packet addressed to UE " << ueAddr);
         // find corresponding UeInfo address
@@ -200,7 +203,7 @@ EpcSgwPgwApplication::RecvFromTunDevice(Ptr<Packet> packet,
     else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
         Ipv6Header ipv6Header;
-        pCopy->RemoveHeader(ipv6Header);
+        packet->PeekHeader(ipv6Header);
         Ipv6Address ueAddr = ipv6Header.GetDestination();
         NS_LOG_LOGIC("packet addressed to UE " << ueAddr);
         // find corresponding UeInfo address
@@ -252,7 +255,10 @@ EpcSgwPgwApplication::RecvFromS1uSocket(Ptr<Socket> socket)
 
     SendToTunDevice(packet, teid);
 
-    m_rxS1uPktTrace(packet->Copy());
+    if (!m_rxS1uPktTrace.IsEmpty())
+    {
+        m_rxS1uPktTrace(packet->Copy());
+    }
 }
 
 void
@@ -227,7 +227,7 @@ class EpcSgwPgwApplication : public Application
          * among all the bearers of this UE;  returns 0 if no bearers
          * matches with the previously declared TFTs
          */
-        uint32_t Classify(Ptr<Packet> p, uint16_t protocolNumber);
+        uint32_t Classify(Ptr<const Packet> p, uint16_t protocolNumber);
 
         /**
          * \return the address of the eNB to which the UE is connected
@@ -35,9 +35,7 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
-#include "ns3/tcp-header.h"
 #include "ns3/tcp-l4-protocol.h"
-#include "ns3/udp-header.h"
 #include "ns3/udp-l4-protocol.h"
 
 namespace ns3
@@ -45,6 +43,8 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EpcTftClassifier");
 
+const uint32_t EpcTftClassifier::MAX_CACHED_FLOWS;
+
 EpcTftClassifier::EpcTftClassifier()
 {
     NS_LOG_FUNCTION(this);
@@ -55,6 +55,7 @@ EpcTftClassifier::Add(Ptr<EpcTft> tft, uint32_t id)
 {
     NS_LOG_FUNCTION(this << tft << id);
     m_tftMap[id] = tft;
+    m_flowCache.clear();
 
     // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
     NS_ASSERT(m_tftMap.size() <= 16);
@@ -65,15 +66,40 @@ EpcTftClassifier::Delete(uint32_t id)
 {
     NS_LOG_FUNCTION(this << id);
     m_tftMap.erase(id);
+    m_flowCache.clear();
+}
+
+/**
+ * Read the source and destination ports of the UDP or TCP header that follows
+ * the IP header, without copying the packet. Both headers start with the ports.
+ *
+ * \param p the IP packet
+ * \param offset the size of the IP header
+ * \param [out] sourcePort the source port
+ * \param [out] destinationPort the destination port
+ * \return false if the packet is too short to hold the ports
+ */
+static bool
+PeekPorts(Ptr<const Packet> p, uint32_t offset, uint16_t& sourcePort, uint16_t& destinationPort)
+{
+    uint8_t buffer[64]; // largest IPv4 header and the two ports
+    NS_ASSERT(offset + 4 <= sizeof(buffer));
+    if (p->CopyData(buffer, offset + 4) < offset + 4)
+    {
+        return false;
+    }
+    sourcePort = (buffer[offset] << 8) | buffer[offset + 1];
+    destinationPort = (buffer[offset + 2] << 8) | buffer[offset + 3];
+    return true;
 }
 
 uint32_t
-EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t protocolNumber)
+EpcTftClassifier::Classify(Ptr<const Packet> p,
+                           EpcTft::Direction direction,
+                           uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION(this << p << p->GetSize() << direction);
 
-    Ptr<Packet> pCopy = p->Copy();
-
     Ipv4Address localAddressIpv4;
     Ipv4Address remoteAddressIpv4;
 
@@ -89,7 +115,7 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
     if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
     {
         Ipv4Header ipv4Header;
-        pCopy->RemoveHeader(ipv4Header);
+        p->PeekHeader(ipv4Header);
 
         if (direction == EpcTft::UPLINK)
         {
@@ -124,17 +150,18 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         {
             if (protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
             {
-                UdpHeader udpHeader;
-                pCopy->RemoveHeader(udpHeader);
+                uint16_t sourcePort = 0;
+                uint16_t destinationPort = 0;
+                PeekPorts(p, ipv4Header.GetSerializedSize(), sourcePort, destinationPort);
                 if (direction == EpcTft::UPLINK)
                 {
-                    localPort = udpHeader.GetSourcePort();
-                    remotePort = udpHeader.GetDestinationPort();
+                    localPort = sourcePort;
+                    remotePort = destinationPort;
                 }
                 else
                 {
-                    remotePort = udpHeader.GetSourcePort();
-                    localPort = udpHeader.GetDestinationPort();
+                    remotePort = sourcePort;
+                    localPort = destinationPort;
                 }
                 if (!isLastFragment)
                 {
@@ -149,17 +176,18 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
             }
             else if (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20)
             {
-                TcpHeader tcpHeader;
-                pCopy->RemoveHeader(tcpHeader);
+                uint16_t sourcePort = 0;
+                uint16_t destinationPort = 0;
+                PeekPorts(p, ipv4Header.GetSerializedSize(), sourcePort, destinationPort);
                 if (direction == EpcTft::UPLINK)
                 {
-                    localPort = tcpHeader.GetSourcePort();
-                    remotePort = tcpHeader.GetDestinationPort();
+                    localPort = sourcePort;
+                    remotePort = destinationPort;
                 }
                 else
                 {
-                    remotePort = tcpHeader.GetSourcePort();
-                    localPort = tcpHeader.GetDestinationPort();
+                    remotePort = sourcePort;
+                    localPort = destinationPort;
                 }
 
                 if (!isLastFragment)
@@ -207,7 +235,7 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
     else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
         Ipv6Header ipv6Header;
-        pCopy->RemoveHeader(ipv6Header);
+        p->PeekHeader(ipv6Header);
 
         if (direction == EpcTft::UPLINK)
         {
@@ -226,35 +254,20 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         protocol = ipv6Header.GetNextHeader();
         tos = ipv6Header.GetTrafficClass();
 
-        if (protocol == UdpL4Protocol::PROT_NUMBER)
+        if (protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
         {
-            UdpHeader udpHeader;
-            pCopy->RemoveHeader(udpHeader);
-
+            uint16_t sourcePort = 0;
+            uint16_t destinationPort = 0;
+            PeekPorts(p, ipv6Header.GetSerializedSize(), sourcePort, destinationPort);
             if (direction == EpcTft::UPLINK)
             {
-                localPort = udpHeader.GetSourcePort();
-                remotePort = udpHeader.GetDestinationPort();
+                localPort = sourcePort;
+                remotePort = destinationPort;
             }
             else
             {
-                remotePort = udpHeader.GetSourcePort();
-                localPort = udpHeader.GetDestinationPort();
-            }
-        }
-        else if (protocol == TcpL4Protocol::PROT_NUMBER)
-        {
-            TcpHeader tcpHeader;
-            pCopy->RemoveHeader(tcpHeader);
-            if (direction == EpcTft::UPLINK)
-            {
-                localPort = tcpHeader.GetSourcePort();
-                remotePort = tcpHeader.GetDestinationPort();
-            }
-            else
-            {
-                remotePort = tcpHeader.GetSourcePort();
-                localPort = tcpHeader.GetDestinationPort();
+                remotePort = sourcePort;
+                localPort = destinationPort;
             }
         }
     }
@@ -263,70 +276,119 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         NS_ABORT_MSG("EpcTftClassifier::Classify - Unknown IP type...");
     }
 
+    FlowKey key;
+    std::memset(&key, 0, sizeof(key));
     if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
     {
         NS_LOG_INFO("Classifying packet:"
                     << " localAddr=" << localAddressIpv4 << " remoteAddr=" << remoteAddressIpv4
                     << " localPort=" << localPort << " remotePort=" << remotePort << " tos=0x"
                     << (uint16_t)tos);
-
-        // now it is possible to classify the packet!
-        // we use a reverse iterator since filter priority is not implemented properly.
-        // This way, since the default bearer is expected to be added first, it will be evaluated
-        // last.
-        std::map<uint32_t, Ptr<EpcTft>>::const_reverse_iterator it;
-        NS_LOG_LOGIC("TFT MAP size: " << m_tftMap.size());
-
-        for (it = m_tftMap.rbegin(); it != m_tftMap.rend(); ++it)
-        {
-            NS_LOG_LOGIC("TFT id: " << it->first);
-            NS_LOG_LOGIC(" Ptr<EpcTft>: " << it->second);
-            Ptr<EpcTft> tft = it->second;
-            if (tft->Matches(direction,
-                             remoteAddressIpv4,
-                             localAddressIpv4,
-                             remotePort,
-                             localPort,
-                             tos))
-            {
-                NS_LOG_LOGIC("matches with TFT ID = " << it->first);
-                return it->first; // the id of the matching TFT
-            }
-        }
+        remoteAddressIpv4.Serialize(key.remoteAddress);
+        localAddressIpv4.Serialize(key.localAddress);
     }
-    else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
+    else
     {
         NS_LOG_INFO("Classifying packet:"
                     << " localAddr=" << localAddressIpv6 << " remoteAddr=" << remoteAddressIpv6
                     << " localPort=" << localPort << " remotePort=" << remotePort << " tos=0x"
                     << (uint16_t)tos);
+        remoteAddressIpv6.Serialize(key.remoteAddress);
+        localAddressIpv6.Serialize(key.localAddress);
+        key.ipv6 = true;
+    }
+    key.remotePort = remotePort;
+    key.localPort = localPort;
+    key.direction = direction;
+    key.tos = tos;
+
+    // the TFTs only need to be evaluated for the first packet of a flow
+    auto cached = m_flowCache.find(key);
+    if (cached != m_flowCache.end())
+    {
+        NS_LOG_LOGIC("cached flow, TFT ID = " << cached->second);
+        return cached->second;
+    }
 
-        // now it is possible to classify the packet!
-        // we use a reverse iterator since filter priority is not implemented properly.
-        // This way, since the default bearer is expected to be added first, it will be evaluated
-        // last.
-        std::map<uint32_t, Ptr<EpcTft>>::const_reverse_iterator it;
-        NS_LOG_LOGIC("TFT MAP size: " << m_tftMap.size());
+    uint32_t id = Match(key);
+    if (m_flowCache.size() >= MAX_CACHED_FLOWS)
+    {
+        NS_LOG_LOGIC("classification cache full, clearing it");
+        m_flowCache.clear();
+    }
+    m_flowCache.emplace(key, id);
+    return id;
+}
 
-        for (it = m_tftMap.rbegin(); it != m_tftMap.rend(); ++it)
+uint32_t
+EpcTftClassifier::Match(const FlowKey& key) const
+{
+    EpcTft::Direction direction = static_cast<EpcTft::Direction>(key.direction);
+
+    // we use a reverse iterator since filter priority is not implemented properly.
+    // This way, since the default bearer is expected to be added first, it will be evaluated
+    // last.
+    std::map<uint32_t, Ptr<EpcTft>>::const_reverse_iterator it;
+    NS_LOG_LOGIC("TFT MAP size: " << m_tftMap.size());
+
+    for (it = m_tftMap.rbegin(); it != m_tftMap.rend(); ++it)
+    {
+        NS_LOG_LOGIC("TFT id: " << it->first);
+        NS_LOG_LOGIC(" Ptr<EpcTft>: " << it->second);
+        Ptr<EpcTft> tft = it->second;
+        bool matches;
+        if (key.ipv6)
         {
-            NS_LOG_LOGIC("TFT id: " << it->first);
-            NS_LOG_LOGIC(" Ptr<EpcTft>: " << it->second);
-            Ptr<EpcTft> tft = it->second;
-            if (tft->Matches(direction,
-                             remoteAddressIpv6,
-                             localAddressIpv6,
-                             remotePort,
-                             localPort,
-                             tos))
-            {
-                NS_LOG_LOGIC("matches with TFT ID = " << it->first);
-                return it->first; // the id of the matching TFT
-            }
+            matches = tft->Matches(direction,
+                                   Ipv6Address::Deserialize(key.remoteAddress),
+                                   Ipv6Address::Deserialize(key.localAddress),
+                                   key.remotePort,
+                                   key.localPort,
+                                   key.tos);
+        }
+        else
+        {
+            matches = tft->Matches(direction,
+                                   Ipv4Address::Deserialize(key.remoteAddress),
+                                   Ipv4Address::Deserialize(key.localAddress),
+                                   key.remotePort,
+                                   key.localPort,
+                                   key.tos);
+        }
+        if (matches)
+        {
+            NS_LOG_LOGIC("matches with TFT ID = " << it->first);
+            return it->first; // the id of the matching TFT
         }
     }
     NS_LOG_LOGIC("no match");
     return 0; // no match
 }
 
+uint32_t
+EpcTftClassifier::GetCachedFlows() const
+{
+    return m_flowCache.size();
+}
+
+size_t
+EpcTftClassifier::FlowKeyHash::operator()(const FlowKey& key) const
+{
+    // FNV-1a over the fields of the key
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ data[i]) * 1099511628211ULL;
+        }
+    };
+    mix(key.remoteAddress, key.ipv6 ? 16 : 4);
+    mix(key.localAddress, key.ipv6 ? 16 : 4);
+    mix(reinterpret_cast<const uint8_t*>(&key.remotePort), sizeof(key.remotePort));
+    mix(reinterpret_cast<const uint8_t*>(&key.localPort), sizeof(key.localPort));
+    mix(&key.direction, 1);
+    mix(&key.tos, 1);
+    return hash;
+}
+
 } // namespace ns3
@@ -25,7 +25,9 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 
+#include <cstring>
 #include <map>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -48,6 +50,11 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * The result of the classification is cached per flow, i.e., per direction, remote and local
+ * address and port and type of service, so that the TFTs are only evaluated for the first
+ * packet of each flow. The cache is cleared whenever a TFT is added or deleted; TFTs must not
+ * be modified after they have been added to the classifier.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -71,7 +78,7 @@ class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
     void Delete(uint32_t id);
 
     /**
-     * classify an IP packet
+     * classify an IP packet. The headers are read in place, the packet is not copied.
      *
      * \param p the IP packet. The outmost header can only be an IPv4 or an IPv6 header.
      * \param direction the EPC TFT direction (can be downlink, uplink or bi-directional)
@@ -80,9 +87,61 @@ class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
      * \return the identifier (>0) of the first TFT that matches with the IP packet; 0 if no TFT
      * matched.
      */
-    uint32_t Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t protocolNumber);
+    uint32_t Classify(Ptr<const Packet> p, EpcTft::Direction direction, uint16_t protocolNumber);
+
+    /**
+     * \return the number of flows in the classification cache
+     */
+    uint32_t GetCachedFlows() const;
+
+    /// Maximum number of flows in the classification cache, which is cleared when it is full
+    static const uint32_t MAX_CACHED_FLOWS = 4096;
 
   protected:
+    /// Flow identifier used as classification cache key
+    struct FlowKey
+    {
+        uint8_t remoteAddress[16]; ///< remote IPv4 (first 4 bytes) or IPv6 address
+        uint8_t localAddress[16];  ///< local IPv4 (first 4 bytes) or IPv6 address
+        uint16_t remotePort;       ///< remote port
+        uint16_t localPort;        ///< local port
+        uint8_t direction;         ///< direction
+        uint8_t tos;               ///< type of service
+        bool ipv6;                 ///< whether the addresses are IPv6
+
+        /**
+         * \param other the flow key to compare with
+         * \return true if the keys identify the same flow
+         */
+        bool operator==(const FlowKey& other) const
+        {
+            return std::memcmp(remoteAddress, other.remoteAddress, sizeof(remoteAddress)) == 0 &&
+                   std::memcmp(localAddress, other.localAddress, sizeof(localAddress)) == 0 &&
+                   remotePort == other.remotePort && localPort == other.localPort &&
+                   direction == other.direction && tos == other.tos && ipv6 == other.ipv6;
+        }
+    };
+
+    /// Hash function of FlowKey
+    struct FlowKeyHash
+    {
+        /**
+         * \param key the flow key
+         * \return the hash of the key
+         */
+        size_t operator()(const FlowKey& key) const;
+    };
+
+    /**
+     * Look up the TFTs for the first one that matches a flow
+     *
+     * \param key the flow
+     * \return the identifier (>0) of the first TFT that matches; 0 if no TFT matched.
+     */
+    uint32_t Match(const FlowKey& key) const;
+
+    std::unordered_map<FlowKey, uint32_t, FlowKeyHash> m_flowCache; ///< classification cache
+
     std::map<uint32_t, Ptr<EpcTft>> m_tftMap; ///< TFT map
 
     std::map<std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>, std::pair<uint32_t, uint32_t>>
@@ -26,6 +26,10 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ns3
 {
 
@@ -2467,16 +2471,17 @@ NS_OBJECT_ENSURE_REGISTERED(EpcX2UeImsiSinrUpdateHeader);
 
 EpcX2UeImsiSinrUpdateHeader::EpcX2UeImsiSinrUpdateHeader()
     : m_numberOfIes(1 + 1),
-      m_headerLength(2 + 2)
+      m_headerLength(2 + 1 + 2),
+      m_fullReport(true)
 {
-    m_map.clear();
+    m_ueSinrList.clear();
 }
 
 EpcX2UeImsiSinrUpdateHeader::~EpcX2UeImsiSinrUpdateHeader()
 {
     m_numberOfIes = 0;
     m_headerLength = 0;
-    m_map.clear();
+    m_ueSinrList.clear();
 }
 
 TypeId
@@ -2507,15 +2512,22 @@ EpcX2UeImsiSinrUpdateHeader::Serialize(Buffer::Iterator start) const
     Buffer::Iterator i = start;
 
     i.WriteHtonU16(m_sourceCellId);
+    i.WriteU8(m_fullReport ? 1 : 0);
+    i.WriteHtonU16(m_ueSinrList.size()); // number of UEs
 
-    std::map<uint64_t, double>::size_type sz = m_map.size();
-    i.WriteHtonU16(sz); // number of elements in the map
-
-    for (std::map<uint64_t, double>::const_iterator iter = m_map.begin(); iter != m_map.end();
-         ++iter)
+    uint64_t lastImsi = 0;
+    for (const auto& item : m_ueSinrList)
     {
-        i.WriteHtonU64(iter->first);           // imsi
-        i.WriteHtonU64(pack754(iter->second)); // sinr
+        // IMSI difference, 7 bits per byte with the MSB set if more bytes follow
+        uint64_t delta = item.imsi - lastImsi;
+        lastImsi = item.imsi;
+        while (delta >= 0x80)
+        {
+            i.WriteU8((delta & 0x7f) | 0x80);
+            delta >>= 7;
+        }
+        i.WriteU8(delta);
+        i.WriteHtonU16(QuantizeSinr(item.sinr));
     }
 }
 
@@ -2525,20 +2537,38 @@ EpcX2UeImsiSinrUpdateHeader::Deserialize(Buffer::Iterator start)
     Buffer::Iterator i = start;
 
     m_headerLength = 0;
+    m_ueSinrList.clear();
 
     m_sourceCellId = i.ReadNtohU16();
-    m_headerLength += 2;
+    m_fullReport = i.ReadU8() != 0;
+    m_headerLength += 3;
     m_numberOfIes = 1;
 
-    int sz = i.ReadNtohU16();
-    for (int j = 0; j < sz; j++)
+    uint16_t sz = i.ReadNtohU16();
+    m_headerLength += 2;
+    m_ueSinrList.reserve(sz);
+    uint64_t lastImsi = 0;
+    for (uint16_t j = 0; j < sz; j++)
     {
-        uint64_t imsi = i.ReadNtohU64();
-        double sinr = unpack754(i.ReadNtohU64());
-        m_map[imsi] = sinr;
+        uint64_t delta = 0;
+        uint8_t byte;
+        uint32_t shift = 0;
+        do
+        {
+            byte = i.ReadU8();
+            delta |= (uint64_t)(byte & 0x7f) << shift;
+            shift += 7;
+            m_headerLength++;
+        } while (byte & 0x80);
+
+        EpcX2Sap::UeSinrItem item;
+        item.imsi = lastImsi + delta;
+        item.sinr = DequantizeSinr((int16_t)i.ReadNtohU16());
+        m_headerLength += 2;
+        lastImsi = item.imsi;
+        m_ueSinrList.push_back(item);
     }
 
-    m_headerLength += 2 + sz * 16;
     m_numberOfIes += 1 + sz;
 
     return GetSerializedSize();
@@ -2547,11 +2577,10 @@ EpcX2UeImsiSinrUpdateHeader::Deserialize(Buffer::Iterator start)
 void
 EpcX2UeImsiSinrUpdateHeader::Print(std::ostream& os) const
 {
-    os << "SourceCellId " << m_sourceCellId;
-    for (std::map<uint64_t, double>::const_iterator iter = m_map.begin(); iter != m_map.end();
-         ++iter)
+    os << "SourceCellId " << m_sourceCellId << " FullReport " << m_fullReport;
+    for (const auto& item : m_ueSinrList)
     {
-        os << " Imsi " << iter->first << " sinr " << 10 * std::log10(iter->second);
+        os << " Imsi " << item.imsi << " sinr " << 10 * std::log10(item.sinr);
     }
 }
 
@@ -2567,20 +2596,38 @@ EpcX2UeImsiSinrUpdateHeader::SetSourceCellId(uint16_t cellId)
     m_sourceCellId = cellId;
 }
 
-std::map<uint64_t, double>
-EpcX2UeImsiSinrUpdateHeader::GetUeImsiSinrMap() const
+const std::vector<EpcX2Sap::UeSinrItem>&
+EpcX2UeImsiSinrUpdateHeader::GetUeSinrList() const
 {
-    return m_map;
+    return m_ueSinrList;
 }
 
 void
-EpcX2UeImsiSinrUpdateHeader::SetUeImsiSinrMap(std::map<uint64_t, double> map)
+EpcX2UeImsiSinrUpdateHeader::SetUeSinrList(const std::vector<EpcX2Sap::UeSinrItem>& list)
+{
+    NS_ASSERT_MSG(list.size() <= std::numeric_limits<uint16_t>::max(), "Too many UEs");
+    m_ueSinrList = list;
+
+    uint64_t lastImsi = 0;
+    for (const auto& item : m_ueSinrList)
+    {
+        NS_ASSERT_MSG(item.imsi >= lastImsi, "UEs not in increasing IMSI order");
+        m_headerLength += GetVarintSize(item.imsi - lastImsi) + 2;
+        lastImsi = item.imsi;
+    }
+    m_numberOfIes += m_ueSinrList.size();
+}
+
+bool
+EpcX2UeImsiSinrUpdateHeader::IsFullReport() const
 {
-    m_map = map;
+    return m_fullReport;
+}
 
-    std::map<uint64_t, double>::size_type sz = m_map.size();
-    m_headerLength += sz * 16;
-    m_numberOfIes += sz;
+void
+EpcX2UeImsiSinrUpdateHeader::SetFullReport(bool fullReport)
+{
+    m_fullReport = fullReport;
 }
 
 uint32_t
@@ -2595,91 +2642,40 @@ EpcX2UeImsiSinrUpdateHeader::GetNumberOfIes() const
     return m_numberOfIes;
 }
 
-uint64_t
-EpcX2UeImsiSinrUpdateHeader::pack754(long double f)
+int16_t
+EpcX2UeImsiSinrUpdateHeader::QuantizeSinr(double sinr)
 {
-    uint16_t bits = 64;
-    uint16_t expbits = 11;
-    long double fnorm;
-    int shift;
-    long long sign, exp, significand;
-    unsigned significandbits = bits - expbits - 1; // -1 for sign bit
-
-    if (f == 0.0)
-        return 0; // get this special case out of the way
-
-    // check sign and begin normalization
-    if (f < 0)
+    // the smallest value is reserved for a null SINR
+    if (sinr <= 0)
     {
-        sign = 1;
-        fnorm = -f;
-    }
-    else
-    {
-        sign = 0;
-        fnorm = f;
+        return std::numeric_limits<int16_t>::min();
     }
+    double steps = std::round(10 * std::log10(sinr) / SINR_RESOLUTION_DB);
+    steps = std::max(steps, std::numeric_limits<int16_t>::min() + 1.0);
+    steps = std::min(steps, (double)std::numeric_limits<int16_t>::max());
+    return (int16_t)steps;
+}
 
-    // get the normalized form of f and track the exponent
-    shift = 0;
-    while (fnorm >= 2.0)
-    {
-        fnorm /= 2.0;
-        shift++;
-    }
-    while (fnorm < 1.0)
+double
+EpcX2UeImsiSinrUpdateHeader::DequantizeSinr(int16_t quantizedSinr)
+{
+    if (quantizedSinr == std::numeric_limits<int16_t>::min())
     {
-        fnorm *= 2.0;
-        shift--;
+        return 0;
     }
-    fnorm = fnorm - 1.0;
-
-    // calculate the binary form (non-float) of the significand data
-    significand = fnorm * ((1LL << significandbits) + 0.5f);
-
-    // get the biased exponent
-    exp = shift + ((1 << (expbits - 1)) - 1); // shift + bias
-
-    // return the final answer
-    return (sign << (bits - 1)) | (exp << (bits - expbits - 1)) | significand;
+    return std::pow(10, quantizedSinr * SINR_RESOLUTION_DB / 10);
 }
 
-long double
-EpcX2UeImsiSinrUpdateHeader::unpack754(uint64_t i)
+uint32_t
+EpcX2UeImsiSinrUpdateHeader::GetVarintSize(uint64_t value)
 {
-    uint16_t bits = 64;
-    uint16_t expbits = 11;
-    long double result;
-    long long shift;
-    unsigned bias;
-    unsigned significandbits = bits - expbits - 1; // -1 for sign bit
-
-    if (i == 0)
-        return 0.0;
-
-    // pull the significand
-    result = (i & ((1LL << significandbits) - 1)); // mask
-    result /= (1LL << significandbits);            // convert back to float
-    result += 1.0f;                                // add the one back on
-
-    // deal with the exponent
-    bias = (1 << (expbits - 1)) - 1;
-    shift = ((i >> significandbits) & ((1LL << expbits) - 1)) - bias;
-    while (shift > 0)
-    {
-        result *= 2.0;
-        shift--;
-    }
-    while (shift < 0)
+    uint32_t size = 1;
+    while (value >= 0x80)
     {
-        result /= 2.0;
-        shift++;
+        value >>= 7;
+        size++;
     }
-
-    // sign it
-    result *= (i >> (bits - 1)) & 1 ? -1.0 : 1.0;
-
-    return result;
+    return size;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -2806,4 +2802,225 @@ EpcX2ConnectionSwitchHeader::GetNumberOfIes() const
     return m_numberOfIes;
 }
 
+/////////////////////////////////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED(EpcX2RlcBufferStatusHeader);
+
+EpcX2RlcBufferStatusHeader::EpcX2RlcBufferStatusHeader()
+    : m_numberOfIes(1 + 1 + 1),
+      m_headerLength(4 + 2 + 4),
+      m_txQueueSize(0),
+      m_txQueueHolDelay(0),
+      m_retxQueueSize(0)
+{
+}
+
+EpcX2RlcBufferStatusHeader::~EpcX2RlcBufferStatusHeader()
+{
+    m_numberOfIes = 0;
+    m_headerLength = 0;
+    m_txQueueSize = 0;
+    m_txQueueHolDelay = 0;
+    m_retxQueueSize = 0;
+}
+
+TypeId
+EpcX2RlcBufferStatusHeader::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::EpcX2RlcBufferStatusHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("Lte")
+                            .AddConstructor<EpcX2RlcBufferStatusHeader>();
+    return tid;
+}
+
+TypeId
+EpcX2RlcBufferStatusHeader::GetInstanceTypeId(void) const
+{
+    return GetTypeId();
+}
+
+uint32_t
+EpcX2RlcBufferStatusHeader::GetSerializedSize(void) const
+{
+    return m_headerLength;
+}
+
+void
+EpcX2RlcBufferStatusHeader::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+
+    i.WriteHtonU32(m_txQueueSize);
+    i.WriteHtonU16(m_txQueueHolDelay);
+    i.WriteHtonU32(m_retxQueueSize);
+}
+
+uint32_t
+EpcX2RlcBufferStatusHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+
+    m_txQueueSize = i.ReadNtohU32();
+    m_txQueueHolDelay = i.ReadNtohU16();
+    m_retxQueueSize = i.ReadNtohU32();
+    m_numberOfIes = 3;
+    m_headerLength = 10;
+
+    return GetSerializedSize();
+}
+
+void
+EpcX2RlcBufferStatusHeader::Print(std::ostream& os) const
+{
+    os << "m_txQueueSize = " << m_txQueueSize;
+    os << " m_txQueueHolDelay = " << m_txQueueHolDelay;
+    os << " m_retxQueueSize = " << m_retxQueueSize;
+}
+
+uint32_t
+EpcX2RlcBufferStatusHeader::GetTxQueueSize() const
+{
+    return m_txQueueSize;
+}
+
+void
+EpcX2RlcBufferStatusHeader::SetTxQueueSize(uint32_t txQueueSize)
+{
+    m_txQueueSize = txQueueSize;
+}
+
+uint16_t
+EpcX2RlcBufferStatusHeader::GetTxQueueHolDelay() const
+{
+    return m_txQueueHolDelay;
+}
+
+void
+EpcX2RlcBufferStatusHeader::SetTxQueueHolDelay(uint16_t txQueueHolDelay)
+{
+    m_txQueueHolDelay = txQueueHolDelay;
+}
+
+uint32_t
+EpcX2RlcBufferStatusHeader::GetRetxQueueSize() const
+{
+    return m_retxQueueSize;
+}
+
+void
+EpcX2RlcBufferStatusHeader::SetRetxQueueSize(uint32_t retxQueueSize)
+{
+    m_retxQueueSize = retxQueueSize;
+}
+
+uint32_t
+EpcX2RlcBufferStatusHeader::GetLengthOfIes() const
+{
+    return m_headerLength;
+}
+
+uint32_t
+EpcX2RlcBufferStatusHeader::GetNumberOfIes() const
+{
+    return m_numberOfIes;
+}
+
+/////////////////////////////////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED(EpcX2PduBatchHeader);
+
+EpcX2PduBatchHeader::EpcX2PduBatchHeader()
+{
+}
+
+EpcX2PduBatchHeader::~EpcX2PduBatchHeader()
+{
+    m_pduSizes.clear();
+}
+
+TypeId
+EpcX2PduBatchHeader::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::EpcX2PduBatchHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("Lte")
+                            .AddConstructor<EpcX2PduBatchHeader>();
+    return tid;
+}
+
+TypeId
+EpcX2PduBatchHeader::GetInstanceTypeId(void) const
+{
+    return GetTypeId();
+}
+
+uint32_t
+EpcX2PduBatchHeader::GetSerializedSize(void) const
+{
+    return GetLengthOfIes();
+}
+
+void
+EpcX2PduBatchHeader::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+
+    i.WriteHtonU16(m_pduSizes.size());
+    for (auto size : m_pduSizes)
+    {
+        i.WriteHtonU16(size);
+    }
+}
+
+uint32_t
+EpcX2PduBatchHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+
+    uint16_t numberOfPdus = i.ReadNtohU16();
+    m_pduSizes.resize(numberOfPdus);
+    for (uint16_t j = 0; j < numberOfPdus; ++j)
+    {
+        m_pduSizes[j] = i.ReadNtohU16();
+    }
+
+    return GetSerializedSize();
+}
+
+void
+EpcX2PduBatchHeader::Print(std::ostream& os) const
+{
+    os << "NumberOfPdus = " << m_pduSizes.size();
+    os << " PduSizes =";
+    for (auto size : m_pduSizes)
+    {
+        os << " " << size;
+    }
+}
+
+void
+EpcX2PduBatchHeader::AddPdu(uint16_t size)
+{
+    m_pduSizes.push_back(size);
+}
+
+const std::vector<uint16_t>&
+EpcX2PduBatchHeader::GetPduSizes() const
+{
+    return m_pduSizes;
+}
+
+uint32_t
+EpcX2PduBatchHeader::GetLengthOfIes() const
+{
+    return 2 + 2 * m_pduSizes.size();
+}
+
+uint32_t
+EpcX2PduBatchHeader::GetNumberOfIes() const
+{
+    return 1 + m_pduSizes.size();
+}
+
 } // namespace ns3
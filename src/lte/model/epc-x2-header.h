@@ -109,7 +109,11 @@ class EpcX2Header : public Header
         SuccessfulOutcome = 1,
         UnsuccessfulOutcome = 2,
         McForwardDownlinkData = 3, // added for MC functionalities
-        McForwardUplinkData = 4
+        McForwardUplinkData = 4,
+        McRlcBufferStatus = 5,
+        McForwardRlcBuffer = 6,
+        McForwardDownlinkDataBatch = 7,
+        McForwardUplinkDataBatch = 8
     };
 
   private:
@@ -862,6 +866,15 @@ class EpcX2ResourceStatusUpdateHeader : public Header
         m_cellMeasurementResultList; ///< cell measurement result list
 };
 
+/**
+ * UE SINR update sent by a mmWave cell to the LTE coordinator.
+ *
+ * The UEs are encoded in increasing IMSI order, each one with the difference
+ * between its IMSI and the previous one as a variable length integer (7 bits
+ * per byte) followed by its SINR in dB quantized with a resolution of
+ * SINR_RESOLUTION_DB on 16 bits. The SINR of a UE therefore takes 3 bytes on
+ * the wire in most cases.
+ */
 class EpcX2UeImsiSinrUpdateHeader : public Header
 {
   public:
@@ -875,8 +888,24 @@ class EpcX2UeImsiSinrUpdateHeader : public Header
     virtual uint32_t Deserialize(Buffer::Iterator start);
     virtual void Print(std::ostream& os) const;
 
-    std::map<uint64_t, double> GetUeImsiSinrMap() const;
-    void SetUeImsiSinrMap(std::map<uint64_t, double> map);
+    /**
+     * \return the SINR of the UEs, in increasing IMSI order. After
+     *         deserialization the SINR values are the quantized ones.
+     */
+    const std::vector<EpcX2Sap::UeSinrItem>& GetUeSinrList() const;
+    /**
+     * \param list the SINR of the UEs, in increasing IMSI order
+     */
+    void SetUeSinrList(const std::vector<EpcX2Sap::UeSinrItem>& list);
+
+    /**
+     * \return true if all the UEs of the cell are included in the update
+     */
+    bool IsFullReport() const;
+    /**
+     * \param fullReport whether all the UEs of the cell are included in the update
+     */
+    void SetFullReport(bool fullReport);
 
     uint16_t GetSourceCellId() const;
     void SetSourceCellId(uint16_t sourceCellId);
@@ -884,16 +913,34 @@ class EpcX2UeImsiSinrUpdateHeader : public Header
     uint32_t GetLengthOfIes() const;
     uint32_t GetNumberOfIes() const;
 
+    /**
+     * Quantize a SINR as done on the wire
+     *
+     * \param sinr the SINR, in linear units
+     * \return the SINR in dB, in units of SINR_RESOLUTION_DB
+     */
+    static int16_t QuantizeSinr(double sinr);
+    /**
+     * \param quantizedSinr a SINR quantized by QuantizeSinr
+     * \return the SINR, in linear units
+     */
+    static double DequantizeSinr(int16_t quantizedSinr);
+
+    /// Resolution of the SINR on the wire, in dB
+    static constexpr double SINR_RESOLUTION_DB = 0.01;
+
   private:
+    /**
+     * \param value an unsigned integer
+     * \return the number of bytes of its variable length encoding
+     */
+    static uint32_t GetVarintSize(uint64_t value);
+
     uint32_t m_numberOfIes;
     uint32_t m_headerLength;
 
-    // from http://beej.us/guide/bgnet/examples/ieee754.c, to convert
-    // uint64_t to double and viceversa according to IEEE754 format
-    static uint64_t pack754(long double f);
-    static long double unpack754(uint64_t i);
-
-    std::map<uint64_t, double> m_map;
+    std::vector<EpcX2Sap::UeSinrItem> m_ueSinrList; ///< SINR of the UEs, in increasing IMSI order
+    bool m_fullReport;                               ///< whether all the UEs are included
     uint16_t m_sourceCellId;
 };
 
@@ -931,6 +978,81 @@ class EpcX2ConnectionSwitchHeader : public Header
     bool m_useMmWaveConnection;
 };
 
+/**
+ * Buffer status of the RLC entity of a split bearer in the secondary cell,
+ * sent over X2-U to the PDCP entity in the master cell
+ */
+class EpcX2RlcBufferStatusHeader : public Header
+{
+  public:
+    EpcX2RlcBufferStatusHeader();
+    virtual ~EpcX2RlcBufferStatusHeader();
+
+    static TypeId GetTypeId(void);
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+    uint32_t GetTxQueueSize() const;
+    void SetTxQueueSize(uint32_t txQueueSize);
+
+    uint16_t GetTxQueueHolDelay() const;
+    void SetTxQueueHolDelay(uint16_t txQueueHolDelay);
+
+    uint32_t GetRetxQueueSize() const;
+    void SetRetxQueueSize(uint32_t retxQueueSize);
+
+    uint32_t GetLengthOfIes() const;
+    uint32_t GetNumberOfIes() const;
+
+  private:
+    uint32_t m_numberOfIes;
+    uint32_t m_headerLength;
+
+    uint32_t m_txQueueSize;
+    uint16_t m_txQueueHolDelay;
+    uint32_t m_retxQueueSize;
+};
+
+/**
+ * Sizes of the PDUs carried back to back by a single X2-U message, e.g., the
+ * content of the RLC buffers forwarded in a secondary cell handover or the
+ * PDUs of a bearer aggregated by EpcX2
+ */
+class EpcX2PduBatchHeader : public Header
+{
+  public:
+    EpcX2PduBatchHeader();
+    virtual ~EpcX2PduBatchHeader();
+
+    static TypeId GetTypeId(void);
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+    /**
+     * Append a PDU to the batch
+     *
+     * \param size the size of the PDU
+     */
+    void AddPdu(uint16_t size);
+
+    /**
+     * \return the sizes of the PDUs, in the order they are carried in the message
+     */
+    const std::vector<uint16_t>& GetPduSizes() const;
+
+    uint32_t GetLengthOfIes() const;
+    uint32_t GetNumberOfIes() const;
+
+  private:
+    std::vector<uint16_t> m_pduSizes; ///< the size of each PDU of the batch
+};
+
 } // namespace ns3
 
 #endif // EPC_X2_HEADER_H
@@ -32,6 +32,7 @@
 
 #include <bitset>
 #include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -364,6 +365,19 @@ class EpcX2Sap
         Ptr<Packet> ueData;    ///< UE data
     };
 
+    /**
+     * \brief Parameters of the forwarding of the content of the RLC buffers of
+     * a bearer in a secondary cell handover, from the source eNB (sourceCellId)
+     * to the target eNB (targetCellId) using a GTP-U tunnel (gtpTeid)
+     */
+    struct UeDataBatchParams
+    {
+        uint16_t sourceCellId;           ///< source cell ID
+        uint16_t targetCellId;           ///< target cell ID
+        uint32_t gtpTeid;                ///< GTP TEID
+        std::vector<Ptr<Packet>> ueData; ///< the PDCP PDUs, in sequence number order
+    };
+
     struct SecondaryHandoverParams
     {
         uint64_t imsi;
@@ -379,11 +393,24 @@ class EpcX2Sap
         uint16_t oldEnbUeX2apId;
     };
 
+    /// SINR of a UE in a UE SINR update
+    struct UeSinrItem
+    {
+        uint64_t imsi; ///< IMSI of the UE
+        double sinr;   ///< SINR, in linear units
+    };
+
+    /**
+     * UE SINR update sent by a mmWave cell to the LTE coordinator. Unless
+     * fullReport is set, only the UEs whose SINR changed since the previous
+     * update are included.
+     */
     struct UeImsiSinrParams
     {
-        uint16_t sourceCellId;
-        uint16_t targetCellId;
-        std::map<uint64_t, double> ueImsiSinrMap;
+        uint16_t sourceCellId;              ///< the mmWave cell
+        uint16_t targetCellId;              ///< the LTE coordinator
+        bool fullReport;                    ///< whether all the UEs of the cell are included
+        std::vector<UeSinrItem> ueSinrList; ///< SINR of the UEs, in increasing IMSI order
     };
 
     struct HandoverFailedParams
@@ -401,6 +428,20 @@ class EpcX2Sap
         uint8_t drbid;
         bool useMmWaveConnection;
     };
+
+    /**
+     * \brief Parameters of the buffer status report sent by the RLC entity of a
+     * split bearer in the secondary cell to the PDCP entity in the master cell
+     */
+    struct RlcBufferStatusParams
+    {
+        uint16_t sourceCellId;    ///< source cell ID
+        uint16_t targetCellId;    ///< target cell ID
+        uint32_t gtpTeid;         ///< GTP TEID of the bearer
+        uint32_t txQueueSize;     ///< size of the RLC transmission queue, in bytes
+        uint16_t txQueueHolDelay; ///< head of line delay of the transmission queue, in ms
+        uint32_t retxQueueSize;   ///< size of the RLC retransmission queue, in bytes
+    };
 };
 
 /**
@@ -431,6 +472,8 @@ class EpcX2PdcpUser : public EpcX2Sap
      */
     // Receive a PDCP PDU in uplink from the MmWave eNB for transmission to CN
     virtual void ReceiveMcPdcpPdu(UeDataParams params) = 0;
+    // Receive the buffer status of the RLC entity in the MmWave eNB
+    virtual void ReceiveRlcBufferStatus(RlcBufferStatusParams params) = 0;
 };
 
 /**
@@ -446,6 +489,8 @@ class EpcX2RlcProvider : public EpcX2Sap
      */
     // Receive a PDCP SDU from RLC for uplink transmission to PDCP in LTE eNB
     virtual void ReceiveMcPdcpSdu(UeDataParams params) = 0;
+    // Send the buffer status of the RLC entity to the PDCP in LTE eNB
+    virtual void ReportRlcBufferStatus(RlcBufferStatusParams params) = 0;
 };
 
 /**
@@ -521,6 +566,9 @@ class EpcX2SapProvider : public EpcX2Sap
     // to forward the packets in the RLC buffers in the source cell as if they were generated by a
     // PDCP
     virtual void ForwardRlcPdu(UeDataParams params) = 0;
+    // to forward all the packets in the RLC buffers in the source cell, in as few X2-U messages
+    // as possible
+    virtual void ForwardRlcBuffer(UeDataBatchParams params) = 0;
 };
 
 /**
@@ -693,6 +741,8 @@ class EpcX2SpecificEpcX2SapProvider : public EpcX2SapProvider
 
     virtual void ForwardRlcPdu(UeDataParams params);
 
+    virtual void ForwardRlcBuffer(UeDataBatchParams params);
+
   private:
     EpcX2SpecificEpcX2SapProvider();
     C* m_x2; ///< owner class
@@ -861,6 +911,13 @@ EpcX2SpecificEpcX2SapProvider<C>::ForwardRlcPdu(UeDataParams params)
     m_x2->DoSendMcPdcpPdu(params);
 }
 
+template <class C>
+void
+EpcX2SpecificEpcX2SapProvider<C>::ForwardRlcBuffer(UeDataBatchParams params)
+{
+    m_x2->DoForwardRlcBuffer(params);
+}
+
 ///////////////////////////////////////
 
 template <class C>
@@ -1105,6 +1162,7 @@ class EpcX2RlcSpecificProvider : public EpcX2RlcProvider
 
     // Inherited
     virtual void ReceiveMcPdcpSdu(UeDataParams params);
+    virtual void ReportRlcBufferStatus(RlcBufferStatusParams params);
 
   private:
     EpcX2RlcSpecificProvider();
@@ -1129,6 +1187,13 @@ EpcX2RlcSpecificProvider<C>::ReceiveMcPdcpSdu(UeDataParams params)
     m_x2->DoReceiveMcPdcpSdu(params);
 }
 
+template <class C>
+void
+EpcX2RlcSpecificProvider<C>::ReportRlcBufferStatus(RlcBufferStatusParams params)
+{
+    m_x2->DoReportRlcBufferStatus(params);
+}
+
 /////////////////////////////////////////////
 template <class C>
 class EpcX2PdcpSpecificUser : public EpcX2PdcpUser
@@ -1138,6 +1203,7 @@ class EpcX2PdcpSpecificUser : public EpcX2PdcpUser
 
     // Inherited
     virtual void ReceiveMcPdcpPdu(UeDataParams params);
+    virtual void ReceiveRlcBufferStatus(RlcBufferStatusParams params);
 
   private:
     EpcX2PdcpSpecificUser();
@@ -1162,6 +1228,13 @@ EpcX2PdcpSpecificUser<C>::ReceiveMcPdcpPdu(UeDataParams params)
     m_pdcp->DoReceiveMcPdcpPdu(params);
 }
 
+template <class C>
+void
+EpcX2PdcpSpecificUser<C>::ReceiveRlcBufferStatus(RlcBufferStatusParams params)
+{
+    m_pdcp->DoReceiveRlcBufferStatus(params);
+}
+
 /////////////////////////////////////////////
 template <class C>
 class EpcX2RlcSpecificUser : public EpcX2RlcUser
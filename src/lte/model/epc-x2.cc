@@ -32,6 +32,10 @@
 #include "ns3/lte-pdcp-tag.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <limits>
 
 namespace ns3
 {
@@ -111,6 +115,11 @@ EpcX2::DoDispose(void)
 {
     NS_LOG_FUNCTION(this);
 
+    for (auto& batch : m_pendingBatches)
+    {
+        batch.second.flushEvent.Cancel();
+    }
+    m_pendingBatches.clear();
     m_x2InterfaceSockets.clear();
     m_x2InterfaceCellIds.clear();
     m_x2RlcUserMap.clear();
@@ -129,7 +138,24 @@ EpcX2::GetTypeId(void)
                             .AddTraceSource("RxPDU",
                                             "PDU received.",
                                             MakeTraceSourceAccessor(&EpcX2::m_rxPdu),
-                                            "ns3::EpcX2::ReceiveTracedCallback");
+                                            "ns3::EpcX2::ReceiveTracedCallback")
+                            .AddAttribute("MaxBatchSize",
+                                          "Maximum size, in bytes, of the PDUs carried by a "
+                                          "single X2-U message, plus 2 bytes per PDU for its "
+                                          "length, when the RLC buffers are forwarded in a "
+                                          "secondary cell handover or the PDUs of a MC bearer "
+                                          "are aggregated. A message must fit in a UDP datagram",
+                                          UintegerValue(8000),
+                                          MakeUintegerAccessor(&EpcX2::m_maxBatchSize),
+                                          MakeUintegerChecker<uint32_t>(1, 65000))
+                            .AddAttribute("AggregationWindow",
+                                          "Maximum time the PDUs of a MC bearer forwarded "
+                                          "over X2-U wait to be sent in a single message with "
+                                          "the following ones. Zero sends each PDU as soon as "
+                                          "it is received.",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&EpcX2::m_aggregationWindow),
+                                          MakeTimeChecker(Seconds(0)));
     return tid;
 }
 
@@ -518,7 +544,8 @@ EpcX2::RecvFromX2cSocket(Ptr<Socket> socket)
         NS_LOG_INFO("X2 SinrUpdateHeader header: " << x2ueSinrUpdateHeader);
 
         EpcX2SapUser::UeImsiSinrParams params;
-        params.ueImsiSinrMap = x2ueSinrUpdateHeader.GetUeImsiSinrMap();
+        params.ueSinrList = x2ueSinrUpdateHeader.GetUeSinrList();
+        params.fullReport = x2ueSinrUpdateHeader.IsFullReport();
         params.sourceCellId = x2ueSinrUpdateHeader.GetSourceCellId();
 
         m_x2SapUser->RecvUeSinrUpdate(params);
@@ -639,9 +666,63 @@ EpcX2::RecvFromX2uSocket(Ptr<Socket> socket)
                  << packet->GetSize() << " source " << params.sourceCellId << " target "
                  << params.targetCellId << " type " << gtpu.GetMessageType());
 
+    if (gtpu.GetMessageType() == EpcX2Header::McRlcBufferStatus)
+    {
+        EpcX2RlcBufferStatusHeader statusHeader;
+        packet->RemoveHeader(statusHeader);
+        NS_LOG_LOGIC("RLC buffer status: " << statusHeader);
+
+        EpcX2Sap::RlcBufferStatusParams statusParams;
+        statusParams.sourceCellId = cellsInfo->m_remoteCellId;
+        statusParams.targetCellId = cellsInfo->m_localCellId;
+        statusParams.gtpTeid = gtpu.GetTeid();
+        statusParams.txQueueSize = statusHeader.GetTxQueueSize();
+        statusParams.txQueueHolDelay = statusHeader.GetTxQueueHolDelay();
+        statusParams.retxQueueSize = statusHeader.GetRetxQueueSize();
+
+        auto pdcpUser = m_x2PdcpUserMap.find(statusParams.gtpTeid);
+        if (pdcpUser != m_x2PdcpUserMap.end())
+        {
+            pdcpUser->second->ReceiveRlcBufferStatus(statusParams);
+        }
+        else
+        {
+            NS_LOG_INFO("No PDCP entity for TEID " << statusParams.gtpTeid);
+        }
+    }
+    else if (gtpu.GetMessageType() == EpcX2Header::McForwardRlcBuffer ||
+             gtpu.GetMessageType() == EpcX2Header::McForwardDownlinkDataBatch ||
+             gtpu.GetMessageType() == EpcX2Header::McForwardUplinkDataBatch)
+    {
+        // split the batch and deliver the PDUs in the order they were sent
+        uint8_t messageType = gtpu.GetMessageType() == EpcX2Header::McForwardUplinkDataBatch
+                                  ? EpcX2Header::McForwardUplinkData
+                                  : EpcX2Header::McForwardDownlinkData;
+        EpcX2PduBatchHeader batchHeader;
+        packet->RemoveHeader(batchHeader);
+        NS_LOG_LOGIC("PDU batch: " << batchHeader);
+        uint32_t offset = 0;
+        for (auto size : batchHeader.GetPduSizes())
+        {
+            params.ueData = packet->CreateFragment(offset, size);
+            offset += size;
+            ReceiveUeData(params, messageType);
+        }
+    }
+    else
+    {
+        ReceiveUeData(params, gtpu.GetMessageType());
+    }
+}
+
+void
+EpcX2::ReceiveUeData(EpcX2SapUser::UeDataParams params, uint8_t messageType)
+{
+    NS_LOG_FUNCTION(this << params.gtpTeid << (uint32_t)messageType);
+
     if (m_teidToBeForwardedMap.find(params.gtpTeid) == m_teidToBeForwardedMap.end())
     {
-        if (gtpu.GetMessageType() == EpcX2Header::McForwardDownlinkData)
+        if (messageType == EpcX2Header::McForwardDownlinkData)
         {
             // add PdcpTag
             PdcpTag pdcpTag(Simulator::Now());
@@ -657,7 +738,7 @@ EpcX2::RecvFromX2uSocket(Ptr<Socket> socket)
                 NS_LOG_INFO("Not implemented: Forward to the other cell or to LTE");
             }
         }
-        else if (gtpu.GetMessageType() == EpcX2Header::McForwardUplinkData)
+        else if (messageType == EpcX2Header::McForwardUplinkData)
         {
             // call pdcp interface
             NS_LOG_INFO("Call PDCP interface");
@@ -670,9 +751,9 @@ EpcX2::RecvFromX2uSocket(Ptr<Socket> socket)
     }
     else // the packet was received during a secondary cell HO, forward to the target cell
     {
-        params.sourceCellId = cellsInfo->m_remoteCellId;
+        uint16_t localCellId = params.targetCellId;
         params.targetCellId = m_teidToBeForwardedMap.find(params.gtpTeid)->second;
-        NS_LOG_LOGIC("Forward from " << cellsInfo->m_localCellId << " to " << params.targetCellId);
+        NS_LOG_LOGIC("Forward from " << localCellId << " to " << params.targetCellId);
         DoSendMcPdcpPdu(params);
     }
 }
@@ -1234,6 +1315,19 @@ EpcX2::DoSendMcPdcpPdu(EpcX2Sap::UeDataParams params)
     NS_LOG_LOGIC("targetCellId = " << params.targetCellId);
     NS_LOG_LOGIC("gtpTeid = " << params.gtpTeid);
 
+    if (m_aggregationWindow.IsStrictlyPositive())
+    {
+        AggregatePdu(params, EpcX2Header::McForwardDownlinkData);
+    }
+    else
+    {
+        SendUeDataMessage(params, EpcX2Header::McForwardDownlinkData);
+    }
+}
+
+void
+EpcX2::SendUeDataMessage(EpcX2Sap::UeDataParams params, uint8_t messageType)
+{
     NS_ASSERT_MSG(m_x2InterfaceSockets.find(params.targetCellId) != m_x2InterfaceSockets.end(),
                   "Missing infos for targetCellId = " << params.targetCellId);
     Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets[params.targetCellId];
@@ -1246,7 +1340,7 @@ EpcX2::DoSendMcPdcpPdu(EpcX2Sap::UeDataParams params)
     // add a message type to the gtpu header, so that it is possible to distinguish at receiver
     GtpuHeader gtpu;
     gtpu.SetTeid(params.gtpTeid);
-    gtpu.SetMessageType(EpcX2Header::McForwardDownlinkData);
+    gtpu.SetMessageType(messageType);
     gtpu.SetLength(params.ueData->GetSize() + gtpu.GetSerializedSize() -
                    8); /// \todo This should be done in GtpuHeader
     NS_LOG_INFO("GTP-U header: " << gtpu);
@@ -1262,7 +1356,82 @@ EpcX2::DoSendMcPdcpPdu(EpcX2Sap::UeDataParams params)
 }
 
 void
-EpcX2::DoReceiveMcPdcpSdu(EpcX2Sap::UeDataParams params)
+EpcX2::AggregatePdu(EpcX2Sap::UeDataParams params, uint8_t messageType)
+{
+    NS_LOG_FUNCTION(this << params.gtpTeid << (uint32_t)messageType);
+
+    // the PDU and its length in the batch header
+    uint32_t size = params.ueData->GetSize() + 2;
+    auto key = std::make_pair(params.gtpTeid, messageType);
+    auto it = m_pendingBatches.find(key);
+    if (it != m_pendingBatches.end() &&
+        (it->second.params.targetCellId != params.targetCellId ||
+         it->second.bytes + size > m_maxBatchSize))
+    {
+        FlushPduBatch(params.gtpTeid, messageType);
+        it = m_pendingBatches.end();
+    }
+    if (it == m_pendingBatches.end())
+    {
+        PendingBatch& batch = m_pendingBatches[key];
+        batch.params.sourceCellId = params.sourceCellId;
+        batch.params.targetCellId = params.targetCellId;
+        batch.params.gtpTeid = params.gtpTeid;
+        batch.bytes = 0;
+        batch.flushEvent = Simulator::Schedule(m_aggregationWindow,
+                                               &EpcX2::FlushPduBatch,
+                                               this,
+                                               params.gtpTeid,
+                                               messageType);
+        it = m_pendingBatches.find(key);
+    }
+    it->second.params.ueData.push_back(params.ueData);
+    it->second.bytes += size;
+    NS_LOG_LOGIC("Batch of TEID " << params.gtpTeid << " has " << it->second.params.ueData.size()
+                                  << " PDUs, " << it->second.bytes << " bytes");
+
+    if (it->second.bytes >= m_maxBatchSize)
+    {
+        FlushPduBatch(params.gtpTeid, messageType);
+    }
+}
+
+void
+EpcX2::FlushPduBatch(uint32_t gtpTeid, uint8_t messageType)
+{
+    NS_LOG_FUNCTION(this << gtpTeid << (uint32_t)messageType);
+
+    auto it = m_pendingBatches.find(std::make_pair(gtpTeid, messageType));
+    if (it == m_pendingBatches.end())
+    {
+        return;
+    }
+    PendingBatch batch = it->second;
+    m_pendingBatches.erase(it);
+    batch.flushEvent.Cancel();
+
+    if (batch.params.ueData.size() == 1)
+    {
+        EpcX2Sap::UeDataParams params;
+        params.sourceCellId = batch.params.sourceCellId;
+        params.targetCellId = batch.params.targetCellId;
+        params.gtpTeid = gtpTeid;
+        params.ueData = batch.params.ueData.front();
+        SendUeDataMessage(params, messageType);
+    }
+    else if (!batch.params.ueData.empty())
+    {
+        SendPduBatch(batch.params,
+                     batch.params.ueData.cbegin(),
+                     batch.params.ueData.cend(),
+                     messageType == EpcX2Header::McForwardUplinkData
+                         ? EpcX2Header::McForwardUplinkDataBatch
+                         : EpcX2Header::McForwardDownlinkDataBatch);
+    }
+}
+
+void
+EpcX2::DoReportRlcBufferStatus(EpcX2Sap::RlcBufferStatusParams params)
 {
     NS_LOG_FUNCTION(this);
 
@@ -1276,27 +1445,118 @@ EpcX2::DoReceiveMcPdcpSdu(EpcX2Sap::UeDataParams params)
     Ptr<Socket> sourceSocket = socketInfo->m_localUserPlaneSocket;
     Ipv4Address targetIpAddr = socketInfo->m_remoteIpAddr;
 
-    NS_LOG_LOGIC("sourceSocket = " << sourceSocket);
-    NS_LOG_LOGIC("targetIpAddr = " << targetIpAddr);
+    EpcX2RlcBufferStatusHeader statusHeader;
+    statusHeader.SetTxQueueSize(params.txQueueSize);
+    statusHeader.SetTxQueueHolDelay(params.txQueueHolDelay);
+    statusHeader.SetRetxQueueSize(params.retxQueueSize);
+
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(statusHeader);
 
-    // add a message type to the gtpu header, so that it is possible to distinguish at receiver
     GtpuHeader gtpu;
     gtpu.SetTeid(params.gtpTeid);
-    gtpu.SetMessageType(EpcX2Header::McForwardUplinkData);
-    gtpu.SetLength(params.ueData->GetSize() + gtpu.GetSerializedSize() -
+    gtpu.SetMessageType(EpcX2Header::McRlcBufferStatus);
+    gtpu.SetLength(packet->GetSize() + gtpu.GetSerializedSize() -
                    8); /// \todo This should be done in GtpuHeader
-    NS_LOG_INFO("GTP-U header: " << gtpu);
+    packet->AddHeader(gtpu);
 
-    Ptr<Packet> packet = params.ueData;
+    EpcX2Tag tag(Simulator::Now());
+    packet->AddPacketTag(tag);
+
+    NS_LOG_INFO("Send RLC buffer status through X2 interface");
+    sourceSocket->SendTo(packet, 0, InetSocketAddress(targetIpAddr, m_x2uUdpPort));
+}
+
+void
+EpcX2::DoForwardRlcBuffer(EpcX2Sap::UeDataBatchParams params)
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_LOG_LOGIC("sourceCellId = " << params.sourceCellId);
+    NS_LOG_LOGIC("targetCellId = " << params.targetCellId);
+    NS_LOG_LOGIC("gtpTeid = " << params.gtpTeid);
+    NS_LOG_LOGIC("number of PDUs = " << params.ueData.size());
+
+    // fill each message up to m_maxBatchSize bytes, counting the length of
+    // each PDU in the batch header; larger PDUs are sent alone
+    auto begin = params.ueData.cbegin();
+    uint32_t batchSize = 0;
+    for (auto it = params.ueData.cbegin(); it != params.ueData.cend(); ++it)
+    {
+        uint32_t size = (*it)->GetSize() + 2;
+        if (it != begin && batchSize + size > m_maxBatchSize)
+        {
+            SendPduBatch(params, begin, it, EpcX2Header::McForwardRlcBuffer);
+            begin = it;
+            batchSize = 0;
+        }
+        batchSize += size;
+    }
+    if (begin != params.ueData.cend())
+    {
+        SendPduBatch(params, begin, params.ueData.cend(), EpcX2Header::McForwardRlcBuffer);
+    }
+}
+
+void
+EpcX2::SendPduBatch(const EpcX2Sap::UeDataBatchParams& params,
+                    std::vector<Ptr<Packet>>::const_iterator begin,
+                    std::vector<Ptr<Packet>>::const_iterator end,
+                    uint8_t messageType)
+{
+    NS_ASSERT_MSG(m_x2InterfaceSockets.find(params.targetCellId) != m_x2InterfaceSockets.end(),
+                  "Missing infos for targetCellId = " << params.targetCellId);
+    Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets[params.targetCellId];
+    Ptr<Socket> sourceSocket = socketInfo->m_localUserPlaneSocket;
+    Ipv4Address targetIpAddr = socketInfo->m_remoteIpAddr;
+
+    NS_ASSERT_MSG(end - begin <= std::numeric_limits<uint16_t>::max(),
+                  "Too many PDUs for an X2-U batch");
+    EpcX2PduBatchHeader batchHeader;
+    Ptr<Packet> packet = Create<Packet>();
+    for (auto it = begin; it != end; ++it)
+    {
+        NS_ASSERT_MSG((*it)->GetSize() <= std::numeric_limits<uint16_t>::max(),
+                      "PDU too large for an X2-U batch");
+        batchHeader.AddPdu((*it)->GetSize());
+        packet->AddAtEnd(*it);
+    }
+    packet->AddHeader(batchHeader);
+    NS_LOG_INFO("X2 PDU batch header: " << batchHeader);
+
+    GtpuHeader gtpu;
+    gtpu.SetTeid(params.gtpTeid);
+    gtpu.SetMessageType(messageType);
+    gtpu.SetLength(packet->GetSize() + gtpu.GetSerializedSize() -
+                   8); /// \todo This should be done in GtpuHeader
     packet->AddHeader(gtpu);
 
     EpcX2Tag tag(Simulator::Now());
     packet->AddPacketTag(tag);
 
-    NS_LOG_INFO("Forward MC UE DATA through X2 interface");
+    NS_LOG_INFO("Forward " << end - begin << " PDUs in a single message through X2 interface");
     sourceSocket->SendTo(packet, 0, InetSocketAddress(targetIpAddr, m_x2uUdpPort));
 }
 
+void
+EpcX2::DoReceiveMcPdcpSdu(EpcX2Sap::UeDataParams params)
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_LOG_LOGIC("sourceCellId = " << params.sourceCellId);
+    NS_LOG_LOGIC("targetCellId = " << params.targetCellId);
+    NS_LOG_LOGIC("gtpTeid = " << params.gtpTeid);
+
+    if (m_aggregationWindow.IsStrictlyPositive())
+    {
+        AggregatePdu(params, EpcX2Header::McForwardUplinkData);
+    }
+    else
+    {
+        SendUeDataMessage(params, EpcX2Header::McForwardUplinkData);
+    }
+}
+
 void
 EpcX2::DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params)
 {
@@ -1316,7 +1576,8 @@ EpcX2::DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params)
 
     // Build the X2 message
     EpcX2UeImsiSinrUpdateHeader x2imsiSinrHeader;
-    x2imsiSinrHeader.SetUeImsiSinrMap(params.ueImsiSinrMap);
+    x2imsiSinrHeader.SetUeSinrList(params.ueSinrList);
+    x2imsiSinrHeader.SetFullReport(params.fullReport);
     x2imsiSinrHeader.SetSourceCellId(params.sourceCellId);
 
     EpcX2Header x2Header;
@@ -27,6 +27,8 @@
 
 #include "ns3/callback.h"
 #include "ns3/epc-x2-sap.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/socket.h"
@@ -34,6 +36,7 @@
 #include "ns3/traced-value.h"
 
 #include <map>
+#include <utility>
 
 namespace ns3
 {
@@ -248,6 +251,15 @@ class EpcX2 : public Object
     virtual void DoSendUeData(EpcX2SapProvider::UeDataParams params);
     virtual void DoSendMcPdcpPdu(EpcX2SapProvider::UeDataParams params);
     virtual void DoReceiveMcPdcpSdu(EpcX2SapProvider::UeDataParams params);
+    virtual void DoReportRlcBufferStatus(EpcX2Sap::RlcBufferStatusParams params);
+    /**
+     * Send the content of the RLC buffers of a bearer to the target cell of a
+     * secondary cell handover, batching the PDUs in X2-U messages of at most
+     * m_maxBatchSize bytes
+     *
+     * \param params the PDUs, in sequence number order
+     */
+    virtual void DoForwardRlcBuffer(EpcX2Sap::UeDataBatchParams params);
     virtual void DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params);
     virtual void DoSendMcHandoverRequest(EpcX2SapProvider::SecondaryHandoverParams params);
     virtual void DoNotifyLteMmWaveHandoverCompleted(
@@ -278,6 +290,57 @@ class EpcX2 : public Object
     EpcX2RlcProvider* m_x2RlcProvider;
 
   private:
+    /**
+     * Deliver the UE data received over X2-U to the RLC or PDCP entity of the
+     * bearer, or forward them to the target cell of a secondary cell handover
+     *
+     * \param params the UE data
+     * \param messageType the GTP-U message type, i.e., an EpcX2Header::TypeOfMessage_t
+     */
+    void ReceiveUeData(EpcX2SapUser::UeDataParams params, uint8_t messageType);
+
+    /**
+     * Send a single PDU of a MC bearer in an X2-U message
+     *
+     * \param params the PDU and the TEID of its bearer
+     * \param messageType either McForwardDownlinkData or McForwardUplinkData
+     */
+    void SendUeDataMessage(EpcX2Sap::UeDataParams params, uint8_t messageType);
+
+    /**
+     * Send a batch of PDUs in a single X2-U message
+     *
+     * \param params the source and target cells and the TEID of the bearer
+     * \param begin the first PDU of the batch
+     * \param end past the last PDU of the batch
+     * \param messageType the GTP-U message type of the batch
+     */
+    void SendPduBatch(const EpcX2Sap::UeDataBatchParams& params,
+                      std::vector<Ptr<Packet>>::const_iterator begin,
+                      std::vector<Ptr<Packet>>::const_iterator end,
+                      uint8_t messageType);
+
+    /**
+     * Add a PDU to the batch pending for its bearer and direction. The batch
+     * is sent when m_aggregationWindow has elapsed since its first PDU, when
+     * it reaches m_maxBatchSize bytes or when the target cell of the bearer
+     * changes.
+     *
+     * \param params the PDU and the TEID of its bearer
+     * \param messageType either McForwardDownlinkData or McForwardUplinkData
+     */
+    void AggregatePdu(EpcX2Sap::UeDataParams params, uint8_t messageType);
+
+    /**
+     * Send the batch pending for a bearer and direction, if any. A batch with
+     * a single PDU is sent as a plain McForwardDownlinkData or
+     * McForwardUplinkData message.
+     *
+     * \param gtpTeid the TEID of the bearer
+     * \param messageType either McForwardDownlinkData or McForwardUplinkData
+     */
+    void FlushPduBatch(uint32_t gtpTeid, uint8_t messageType);
+
     /**
      * Map the targetCellId to the corresponding (sourceSocket, remoteIpAddr) to be used
      * to send the X2 message
@@ -298,6 +361,20 @@ class EpcX2 : public Object
 
     TracedCallback<uint16_t, uint16_t, uint32_t, uint64_t, bool> m_rxPdu;
 
+    uint32_t m_maxBatchSize;  ///< maximum size of the PDUs batched in one X2-U message, in bytes
+    Time m_aggregationWindow; ///< time a PDU of a MC bearer can wait for others, zero to disable
+
+    /// PDUs of a bearer waiting to be sent in a single X2-U message
+    struct PendingBatch
+    {
+        EpcX2Sap::UeDataBatchParams params; ///< the cells, TEID and PDUs of the batch
+        uint32_t bytes;                     ///< total size of the PDUs and their lengths
+        EventId flushEvent;                 ///< expiry of the aggregation window
+    };
+
+    /// Batches being aggregated, indexed by (gtpTeid, unbatched message type)
+    std::map<std::pair<uint32_t, uint8_t>, PendingBatch> m_pendingBatches;
+
     /**
      * Map the gtpTeid to the targetCellId to which the packet should be forwarded
      * during a secondary cell handover
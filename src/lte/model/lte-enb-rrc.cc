@@ -33,6 +33,7 @@
 
 #include "ns3/lte-pdcp-tag.h"
 #include <ns3/abort.h>
+#include <ns3/epc-x2-header.h>
 #include <ns3/eps-bearer-tag.h>
 #include <ns3/fatal-error.h>
 #include <ns3/log.h>
@@ -54,6 +55,10 @@
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
 namespace ns3
 {
 
@@ -162,6 +167,8 @@ UeManager::UeManager(Ptr<LteEnbRrc> rrc, uint16_t rnti, State s, uint8_t compone
       m_needPhyMacConfiguration(false),
       m_x2forwardingBufferSize(0),
       m_maxx2forwardingBufferSize(2 * 1024),
+      m_forwardedPdus(0),
+      m_forwardedBytes(0),
       m_allMmWaveInOutageAtInitialAccess(false),
       m_caSupportConfigured(false),
       m_pendingStartDataRadioBearers(false)
@@ -939,9 +946,10 @@ UeManager::RecvHandoverRequestAck(EpcX2SapUser::HandoverRequestAckParams params)
 
     // LL HO
     // Forward RlcTxBuffers to target eNodeb.
-    // TODO forwarding for secondary cell HO
     NS_LOG_INFO("m_drbMap size " << m_drbMap.size() << " in cell " << m_rrc->m_cellId
                                  << " forward RLC buffers");
+    m_forwardedPdus = 0;
+    m_forwardedBytes = 0;
     for (std::map<uint8_t, Ptr<LteDataRadioBearerInfo>>::iterator drbIt = m_drbMap.begin();
          drbIt != m_drbMap.end();
          ++drbIt)
@@ -967,6 +975,11 @@ UeManager::RecvHandoverRequestAck(EpcX2SapUser::HandoverRequestAckParams params)
             ForwardRlcBuffers(rlcIt->second->m_rlc, 0, rlcIt->second->gtpTeid, 0, 1, 0);
         }
     }
+    m_rrc->m_handoverDataForwardedTrace(m_imsi,
+                                        m_rrc->m_cellId,
+                                        params.targetCellId,
+                                        m_forwardedPdus,
+                                        m_forwardedBytes);
 }
 
 // This code from the LL HO implementation is refactored in a function
@@ -1148,7 +1161,15 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc,
                       "happened!");
     }
 
-    while (!m_x2forwardingBuffer.empty())
+    // in a secondary cell HO the PDUs are sent to the target RLC in batches, in SN order
+    EpcX2Sap::UeDataBatchParams batchParams;
+    batchParams.sourceCellId = m_rrc->m_cellId;
+    batchParams.targetCellId = m_targetCellId;
+    batchParams.gtpTeid = gtpTeid;
+
+    for (std::vector<Ptr<Packet>>::iterator bufferIt = m_x2forwardingBuffer.begin();
+         bufferIt != m_x2forwardingBuffer.end();
+         ++bufferIt)
     {
         NS_LOG_DEBUG(this << " Forwarding m_x2forwardingBuffer to target eNB, gtpTeid = "
                           << gtpTeid);
@@ -1158,7 +1179,7 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc,
         params.gtpTeid = gtpTeid;
         // Remove tags to get PDCP SDU from PDCP PDU.
         // Ptr<Packet> rlcSdu =  (*(m_x2forwardingBuffer.begin()))->Copy();
-        Ptr<Packet> rlcSdu = m_x2forwardingBuffer.at(0);
+        Ptr<Packet> rlcSdu = *bufferIt;
         // Tags to be removed from rlcSdu (from outer to inner)
         // LteRlcSduStatusTag rlcSduStatusTag;
         // RlcTag  rlcTag; //rlc layer timestamp
@@ -1196,6 +1217,8 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc,
                         rlcSdu->RemoveHeader(pdcpHeader); // remove pdcp header
 
                         NS_LOG_INFO("Forward to target cell in HO");
+                        m_forwardedPdus++;
+                        m_forwardedBytes += rlcSdu->GetSize();
                         m_rrc->m_x2SapProvider->SendUeData(params);
                         NS_LOG_LOGIC("sourceCellId = " << params.sourceCellId);
                         NS_LOG_LOGIC("targetCellId = " << params.targetCellId);
@@ -1206,12 +1229,7 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc,
                     else
                     {
                         NS_LOG_INFO("Forward to target cell RLC in HO");
-                        m_rrc->m_x2SapProvider->ForwardRlcPdu(params);
-                        NS_LOG_LOGIC("sourceCellId = " << params.sourceCellId);
-                        NS_LOG_LOGIC("targetCellId = " << params.targetCellId);
-                        NS_LOG_LOGIC("gtpTeid = " << params.gtpTeid);
-                        NS_LOG_LOGIC("ueData = " << params.ueData);
-                        NS_LOG_LOGIC("ueData size = " << params.ueData->GetSize());
+                        batchParams.ueData.push_back(rlcSdu);
                     }
                 }
                 else // the target eNB has no PDCP entity. Thus re-insert the packets in the
@@ -1234,9 +1252,66 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc,
         {
             NS_LOG_UNCOND("Too small, not forwarded");
         }
-        m_x2forwardingBufferSize -= (*(m_x2forwardingBuffer.begin()))->GetSize();
-        m_x2forwardingBuffer.erase(m_x2forwardingBuffer.begin());
-        NS_LOG_LOGIC(this << " After forwarding: buffer size = " << m_x2forwardingBufferSize);
+    }
+    m_x2forwardingBuffer.clear();
+    m_x2forwardingBufferSize = 0;
+
+    if (!batchParams.ueData.empty())
+    {
+        // the PDCP entity of the bearer is in the LTE eNB, and uses the SN
+        // length of LtePdcp
+        SortForwardedPdus(batchParams.ueData, LtePdcp::GetSnModulus());
+        for (std::vector<Ptr<Packet>>::iterator it = batchParams.ueData.begin();
+             it != batchParams.ueData.end();
+             ++it)
+        {
+            m_forwardedBytes += (*it)->GetSize();
+        }
+        m_forwardedPdus += batchParams.ueData.size();
+        NS_LOG_INFO("Forward " << batchParams.ueData.size() << " PDUs to target cell RLC in HO");
+        m_rrc->m_x2SapProvider->ForwardRlcBuffer(batchParams);
+    }
+}
+
+void
+UeManager::SortForwardedPdus(std::vector<Ptr<Packet>>& pdus, uint32_t snModulus)
+{
+    if (pdus.empty())
+    {
+        return;
+    }
+    // all the buffered PDUs are in a window of less than half the SN space around the first one:
+    // order them by their distance from the SN half the SN space before it
+    LtePdcpHeader pdcpHeader;
+    pdus.front()->PeekHeader(pdcpHeader);
+    uint16_t referenceSn = (pdcpHeader.GetSequenceNumber() + snModulus / 2) % snModulus;
+    std::vector<std::pair<uint16_t, Ptr<Packet>>> keyedPdus;
+    keyedPdus.reserve(pdus.size());
+    for (std::vector<Ptr<Packet>>::iterator it = pdus.begin(); it != pdus.end(); ++it)
+    {
+        (*it)->PeekHeader(pdcpHeader);
+        uint16_t key = (pdcpHeader.GetSequenceNumber() + snModulus - referenceSn) % snModulus;
+        keyedPdus.push_back(std::make_pair(key, *it));
+    }
+    std::stable_sort(keyedPdus.begin(),
+                     keyedPdus.end(),
+                     [](const std::pair<uint16_t, Ptr<Packet>>& a,
+                        const std::pair<uint16_t, Ptr<Packet>>& b) { return a.first < b.first; });
+
+    // the SDUs re-added from the txed buffer may already be in the forwarding buffer
+    pdus.clear();
+    for (std::vector<std::pair<uint16_t, Ptr<Packet>>>::iterator it = keyedPdus.begin();
+         it != keyedPdus.end();
+         ++it)
+    {
+        if (it == keyedPdus.begin() || it->first != (it - 1)->first)
+        {
+            pdus.push_back(it->second);
+        }
+        else
+        {
+            NS_LOG_DEBUG("Drop duplicate forwarded PDU, key " << it->first);
+        }
     }
 }
 
@@ -2130,6 +2205,20 @@ UeManager::RecvSecondaryCellHandoverCompleted(EpcX2Sap::SecondaryHandoverComplet
     m_rrc->m_x2SapProvider->SendUeContextRelease(ueCtxReleaseParams);
 }
 
+void
+UeManager::NotifyMmWaveSinr(double sinr)
+{
+    NS_LOG_FUNCTION(this << sinr);
+    for (auto it = m_drbMap.begin(); it != m_drbMap.end(); ++it)
+    {
+        Ptr<McEnbPdcp> pdcp = DynamicCast<McEnbPdcp>(it->second->m_pdcp);
+        if (pdcp)
+        {
+            pdcp->SetMmWaveSinr(sinr);
+        }
+    }
+}
+
 void
 UeManager::SendRrcConnectionSwitch(bool useMmWaveConnection)
 {
@@ -2670,9 +2759,8 @@ UeManager::SwitchToState(State newState)
                 {
                     uint16_t maxSinrCellId = m_rrc->m_bestMmWaveCellForImsiMap.at(m_imsi);
                     // get the SINR
-                    double maxSinrDb = 10 * std::log10(m_rrc->m_imsiCellSinrMap.find(m_imsi)
-                                                           ->second.find(maxSinrCellId)
-                                                           ->second);
+                    double maxSinrDb =
+                        10 * std::log10(m_rrc->m_ueSinrTable.GetSinr(m_imsi, maxSinrCellId));
                     if (maxSinrDb > m_rrc->m_outageThreshold)
                     {
                         // there is a MmWave cell to which the UE can connect
@@ -2958,6 +3046,7 @@ LteEnbRrc::LteEnbRrc()
       m_lastAllocatedConfigurationIndex(0),
       m_reconfigureUes(false),
       m_firstSibTime(16),
+      m_sinrUpdatesSinceFull(0),
       m_numNewSinrReports(0),
       m_numberOfComponentCarriers(0),
       m_carriersConfigured(false)
@@ -2972,7 +3061,7 @@ LteEnbRrc::LteEnbRrc()
     m_s1SapUser = new MemberEpcEnbS1SapUser<LteEnbRrc>(this);
     m_cphySapUser.push_back(new MemberLteEnbCphySapUser<LteEnbRrc>(this));
 
-    m_imsiCellSinrMap.clear();
+    m_ueSinrTable.Clear();
     m_x2_received_cnt = 0;
     m_switchEnabled = true;
     m_lteCellId = 0;
@@ -3244,7 +3333,9 @@ LteEnbRrc::GetTypeId(void)
                                           DYNAMIC_TTT,
                                           "DynamicTtt",
                                           THRESHOLD,
-                                          "Threshold"))
+                                          "Threshold",
+                                          PREDICTIVE,
+                                          "Predictive"))
             .AddAttribute("FixedTttValue",
                           "The value of TTT in case of fixed TTT handover (in ms)",
                           UintegerValue(110),
@@ -3272,6 +3363,26 @@ LteEnbRrc::GetTypeId(void)
                 DoubleValue(20),
                 MakeDoubleAccessor(&LteEnbRrc::m_maxDiffTttValue),
                 MakeDoubleChecker<double>()) // TODO set the proper value
+            .AddAttribute("PredictionHorizon",
+                          "How far ahead the SINR is predicted in case of predictive handover",
+                          TimeValue(MilliSeconds(50)),
+                          MakeTimeAccessor(&LteEnbRrc::m_predictionHorizon),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("SinrTrendWindow",
+                          "The number of SINR values of each UE and mmWave cell used to "
+                          "predict the SINR in case of predictive handover. A value is "
+                          "taken at each report of the cell, so that the window spans "
+                          "several report periods",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LteEnbRrc::m_sinrTrendWindow),
+                          MakeUintegerChecker<uint32_t>(2))
+            .AddAttribute("PredictiveOutageMargin",
+                          "How far above OutageThreshold the SINR of a target cell, both "
+                          "the last and the predicted one, must be in case of predictive "
+                          "handover [dB]",
+                          DoubleValue(2.0),
+                          MakeDoubleAccessor(&LteEnbRrc::m_predictiveOutageMargin),
+                          MakeDoubleChecker<double>(0.0))
             .AddAttribute("CrtPeriod",
                           "The periodicity of a CRT (us)",
                           IntegerValue(1600),
@@ -3283,6 +3394,20 @@ LteEnbRrc::GetTypeId(void)
                           BooleanValue(true),
                           MakeBooleanAccessor(&LteEnbRrc::m_reportAllUeMeas),
                           MakeBooleanChecker())
+            .AddAttribute("SinrReportThreshold",
+                          "Change of the SINR of a UE, in dB, since it was last reported to the "
+                          "LTE coordinator above which the MmWave eNB reports it again. With "
+                          "zero, every change larger than the quantization of the X2 message "
+                          "is reported",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&LteEnbRrc::m_sinrReportThreshold),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("SinrFullReportPeriod",
+                          "Number of UE SINR updates sent by the MmWave eNB to the LTE "
+                          "coordinator between two updates that include all the UEs",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&LteEnbRrc::m_sinrFullReportPeriod),
+                          MakeUintegerChecker<uint32_t>(1))
             // Trace sources
             .AddTraceSource("NewUeContext",
                             "Fired upon creation of a new UE context.",
@@ -3308,9 +3433,16 @@ LteEnbRrc::GetTypeId(void)
                             "trace fired when measurement report is received",
                             MakeTraceSourceAccessor(&LteEnbRrc::m_recvMeasurementReportTrace),
                             "ns3::LteEnbRrc::ReceiveReportTracedCallback")
+            .AddTraceSource("HandoverDataForwarded",
+                            "trace fired when the source cell of a handover has forwarded the "
+                            "buffered data of the UE to the target cell",
+                            MakeTraceSourceAccessor(&LteEnbRrc::m_handoverDataForwardedTrace),
+                            "ns3::LteEnbRrc::HandoverDataForwardedTracedCallback")
             .AddTraceSource("NotifyMmWaveSinr",
                             "trace fired when measurement report is received from mmWave cells, "
-                            "for each cell, for each UE",
+                            "for each cell, for each UE. The UEs whose SINR did not change, "
+                            "and which are not in a delta report, are traced with their last "
+                            "reported SINR",
                             MakeTraceSourceAccessor(&LteEnbRrc::m_notifyMmWaveSinrTrace),
                             "ns3::LteEnbRrc::NotifyMmWaveSinrTracedCallback");
     return tid;
@@ -3330,6 +3462,12 @@ LteEnbRrc::GetEpcX2SapUser()
     return m_x2SapUser;
 }
 
+const McUeSinrTable&
+LteEnbRrc::GetUeSinrTable() const
+{
+    return m_ueSinrTable;
+}
+
 void
 LteEnbRrc::SetEpcX2PdcpProvider(EpcX2PdcpProvider* s)
 {
@@ -3771,7 +3909,8 @@ LteEnbRrc::ConfigureCell(std::map<uint8_t, Ptr<ComponentCarrierEnb>> ccPhyConf)
      * SystemInformationPeriodicity attribute to configure this).
      */
     Simulator::Schedule(MilliSeconds(16), &LteEnbRrc::SendSystemInformation, this);
-    m_imsiCellSinrMap.clear();
+    m_ueSinrTable.Clear();
+    m_ueSinrTable.SetTrendWindow(m_handoverMode == PREDICTIVE ? m_sinrTrendWindow : 0);
     m_firstReport = true;
     m_configured = true;
 }
@@ -3863,7 +4002,8 @@ LteEnbRrc::ConfigureCell(std::map<uint8_t, MmWaveComponentCarrierConf> ccPhyConf
      */
     // mmWave module: Changed scheduling of initial system information to +2ms
     Simulator::Schedule(MilliSeconds(m_firstSibTime), &LteEnbRrc::SendSystemInformation, this);
-    m_imsiCellSinrMap.clear();
+    m_ueSinrTable.Clear();
+    m_ueSinrTable.SetTrendWindow(m_handoverMode == PREDICTIVE ? m_sinrTrendWindow : 0);
     m_firstReport = true;
     m_configured = true;
 }
@@ -3925,7 +4065,7 @@ LteEnbRrc::DoUpdateUeSinrEstimate(LteEnbCphySapUser::UeAssociatedSinrInfo info)
         // if (m_reportAllUeMeas == true)
         if (false)
         {
-            params.ueImsiSinrMap = info.ueImsiSinrMap;
+            BuildUeSinrUpdate(info.ueImsiSinrMap, params);
             m_ueImsiSinrMap.clear(); // delete the reports
         }
         else
@@ -3968,77 +4108,133 @@ LteEnbRrc::DoUpdateUeSinrEstimate(LteEnbCphySapUser::UeAssociatedSinrInfo info)
                         }
                     }
                 }
-                params.ueImsiSinrMap = ueImsiSinrMapToSend;
+                BuildUeSinrUpdate(ueImsiSinrMapToSend, params);
                 m_ueImsiSinrMap.clear(); // delete the reports
             }
+            else
+            {
+                return; // wait for the reports of the other CCs
+            }
         }
 
-        NS_LOG_INFO("number of SINR reported " << params.ueImsiSinrMap.size());
+        // nothing changed since the last update
+        if (!params.fullReport && params.ueSinrList.empty())
+        {
+            NS_LOG_INFO("no SINR change to report");
+            return;
+        }
+        NS_LOG_INFO("number of SINR reported " << params.ueSinrList.size());
         m_x2SapProvider->SendUeSinrUpdate(params);
     }
 }
 
+void
+LteEnbRrc::BuildUeSinrUpdate(const ImsiSinrMap& sinrMap,
+                             EpcX2SapProvider::UeImsiSinrParams& params)
+{
+    NS_LOG_FUNCTION(this);
+
+    params.fullReport = (m_sinrUpdatesSinceFull == 0);
+    m_sinrUpdatesSinceFull = (m_sinrUpdatesSinceFull + 1) % m_sinrFullReportPeriod;
+    params.ueSinrList.clear();
+    params.ueSinrList.reserve(sinrMap.size());
+    int32_t threshold =
+        std::floor(m_sinrReportThreshold / EpcX2UeImsiSinrUpdateHeader::SINR_RESOLUTION_DB);
+
+    // both the SINR map and m_lastReportedSinr are sorted by IMSI: merge them,
+    // dropping the UEs that are not in the cell anymore
+    std::vector<std::pair<uint64_t, int16_t>> lastReportedSinr;
+    lastReportedSinr.reserve(sinrMap.size());
+    auto last = m_lastReportedSinr.cbegin();
+    for (const auto& ue : sinrMap)
+    {
+        while (last != m_lastReportedSinr.cend() && last->first < ue.first)
+        {
+            ++last;
+        }
+        int16_t quantizedSinr = EpcX2UeImsiSinrUpdateHeader::QuantizeSinr(ue.second);
+        bool known = (last != m_lastReportedSinr.cend() && last->first == ue.first);
+        if (params.fullReport || !known ||
+            std::abs((int32_t)quantizedSinr - last->second) > threshold)
+        {
+            params.ueSinrList.push_back({ue.first, ue.second});
+            lastReportedSinr.emplace_back(ue.first, quantizedSinr);
+        }
+        else
+        {
+            lastReportedSinr.emplace_back(ue.first, last->second);
+        }
+    }
+    m_lastReportedSinr.swap(lastReportedSinr);
+}
+
 void
 LteEnbRrc::DoRecvUeSinrUpdate(EpcX2SapUser::UeImsiSinrParams params)
 {
     NS_LOG_FUNCTION(this);
     NS_LOG_LOGIC("Recv Ue SINR Update from cell " << params.sourceCellId);
     uint16_t mmWaveCellId = params.sourceCellId;
-    if (m_cellSinrMap.find(mmWaveCellId) != m_cellSinrMap.end())
-    { // update the entry
-        m_cellSinrMap[mmWaveCellId] = params.ueImsiSinrMap;
-        m_numNewSinrReports++;
-    }
-    else // add the entry
+    m_numNewSinrReports++;
+    if (params.fullReport)
     {
-        m_cellSinrMap.insert(std::pair<uint16_t, ImsiSinrMap>(mmWaveCellId, params.ueImsiSinrMap));
-        m_numNewSinrReports++;
+        // the UEs missing from a full report are not seen by the cell anymore
+        std::unordered_set<uint64_t> reportedImsis;
+        for (const auto& item : params.ueSinrList)
+        {
+            reportedImsis.insert(item.imsi);
+        }
+        for (uint64_t imsi : m_ueSinrTable.GetUes())
+        {
+            if (reportedImsis.find(imsi) == reportedImsis.end() &&
+                m_ueSinrTable.GetSinr(imsi, mmWaveCellId) > 0)
+            {
+                NS_LOG_LOGIC("Imsi " << imsi << " not reported by cell " << mmWaveCellId);
+                m_ueSinrTable.RemoveSinr(imsi, mmWaveCellId);
+            }
+        }
     }
-    // cycle on all the Imsi whose SINR is known in cell mmWaveCellId
-    for (std::map<uint64_t, double>::iterator imsiIter = params.ueImsiSinrMap.begin();
-         imsiIter != params.ueImsiSinrMap.end();
-         ++imsiIter)
+    // cycle on all the Imsi whose SINR changed in cell mmWaveCellId, the
+    // others keep their last reported SINR
+    for (const auto& item : params.ueSinrList)
     {
-        uint64_t imsi = imsiIter->first;
-        double sinr = imsiIter->second;
-
-        m_notifyMmWaveSinrTrace(imsi, mmWaveCellId, sinr);
+        uint64_t imsi = item.imsi;
+        double sinr = item.sinr;
 
         NS_LOG_LOGIC("Imsi " << imsi << " sinr " << sinr);
 
-        if (m_imsiCellSinrMap.find(imsi) != m_imsiCellSinrMap.end())
+        // the splitters of the split bearers use the SINR of the current mmWave cell
+        if (!m_ismmWave)
         {
-            if (m_imsiCellSinrMap[imsi].find(mmWaveCellId) != m_imsiCellSinrMap[imsi].end())
+            auto lastCellIt = m_lastMmWaveCell.find(imsi);
+            auto rntiIt = m_imsiRntiMap.find(imsi);
+            if (lastCellIt != m_lastMmWaveCell.end() && lastCellIt->second == mmWaveCellId &&
+                rntiIt != m_imsiRntiMap.end() && HasUeManager(rntiIt->second))
             {
-                // update the SINR measure
-                m_imsiCellSinrMap[imsi].find(mmWaveCellId)->second = sinr;
+                GetUeManager(rntiIt->second)->NotifyMmWaveSinr(sinr);
             }
-            else // new cell for this Imsi
-            {
-                // insert a new SINR measure
-                m_imsiCellSinrMap[imsi].insert(std::pair<uint16_t, double>(mmWaveCellId, sinr));
-            }
-        }
-        else // new imsi
-        {
-            CellSinrMap map;
-            map.insert(std::pair<uint16_t, double>(mmWaveCellId, sinr));
-            m_imsiCellSinrMap.insert(std::pair<uint64_t, CellSinrMap>(imsi, map));
         }
-    }
 
-    for (std::map<uint64_t, CellSinrMap>::iterator imsiIter = m_imsiCellSinrMap.begin();
-         imsiIter != m_imsiCellSinrMap.end();
-         ++imsiIter)
+        // update the SINR measure and the best cell of the UE
+        m_ueSinrTable.SetSinr(imsi, mmWaveCellId, sinr, Simulator::Now());
+    }
+    if (!m_notifyMmWaveSinrTrace.IsEmpty())
     {
-        NS_LOG_LOGIC("Imsi " << imsiIter->first);
-        for (CellSinrMap::iterator cellIter = imsiIter->second.begin();
-             cellIter != imsiIter->second.end();
-             ++cellIter)
+        // trace the SINR of each UE of the cell, also when it did not change
+        // and the UE is not in a delta report
+        for (uint64_t imsi : m_ueSinrTable.GetUes())
         {
-            NS_LOG_LOGIC("mmWaveCell " << cellIter->first << " sinr " << cellIter->second);
+            double sinr = m_ueSinrTable.GetSinr(imsi, mmWaveCellId);
+            if (sinr > 0)
+            {
+                m_notifyMmWaveSinrTrace(imsi, mmWaveCellId, sinr);
+            }
         }
     }
+    if (m_handoverMode == PREDICTIVE)
+    {
+        // one trend value per report, also for the SINR that did not change
+        m_ueSinrTable.SampleTrend(mmWaveCellId, Simulator::Now());
+    }
 
     if (!m_ismmWave && !m_interRatHoMode && m_firstReport)
     {
@@ -4054,6 +4250,9 @@ LteEnbRrc::DoRecvUeSinrUpdate(EpcX2SapUser::UeImsiSinrParams params)
         case THRESHOLD:
             NS_LOG_INFO("Handover Mode: Threshold");
             break;
+        case PREDICTIVE:
+            NS_LOG_INFO("Handover Mode: Predictive");
+            break;
         }
         Simulator::Schedule(MilliSeconds(0), &LteEnbRrc::TriggerUeAssociationUpdate, this);
     }
@@ -4065,12 +4264,11 @@ LteEnbRrc::DoRecvUeSinrUpdate(EpcX2SapUser::UeImsiSinrParams params)
 }
 
 void
-LteEnbRrc::TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
+LteEnbRrc::TttBasedHandover(uint64_t imsi,
                             double sinrDifference,
                             uint16_t maxSinrCellId,
                             double maxSinrDb)
 {
-    uint64_t imsi = imsiIter->first;
     bool alreadyAssociatedImsi = false;
     bool onHandoverImsi = true;
     // On RecvRrcConnectionRequest for a new RNTI, the Lte Enb RRC stores the imsi
@@ -4097,8 +4295,7 @@ LteEnbRrc::TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
     double currentSinrDb = 0;
     if (alreadyAssociatedImsi && m_lastMmWaveCell.find(imsi) != m_lastMmWaveCell.end())
     {
-        currentSinrDb =
-            10 * std::log10(m_imsiCellSinrMap.find(imsi)->second[m_lastMmWaveCell[imsi]]);
+        currentSinrDb = 10 * std::log10(m_ueSinrTable.GetSinr(imsi, m_lastMmWaveCell[imsi]));
         NS_LOG_DEBUG("Current SINR " << currentSinrDb);
     }
 
@@ -4108,13 +4305,15 @@ LteEnbRrc::TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
     {
         if (!m_interRatHoMode)
         {
-            if (GetUeManager(GetRntiFromImsi(imsi))->GetAllMmWaveInOutageAtInitialAccess())
+            uint16_t rnti = GetRntiFromImsi(imsi);
+            Ptr<UeManager> ueMan = GetUeManager(rnti);
+            if (ueMan->GetAllMmWaveInOutageAtInitialAccess())
             {
                 NS_LOG_INFO("Send connect to "
                             << maxSinrCellId
                             << ", for the first time at least one mmWave eNB is not in outage");
-                m_rrcSapUser->SendRrcConnectToMmWave(GetRntiFromImsi(imsi), maxSinrCellId);
-                GetUeManager(GetRntiFromImsi(imsi))->SetAllMmWaveInOutageAtInitialAccess(false);
+                m_rrcSapUser->SendRrcConnectToMmWave(rnti, maxSinrCellId);
+                ueMan->SetAllMmWaveInOutageAtInitialAccess(false);
             }
             else if (m_lastMmWaveCell[imsi] == maxSinrCellId && !onHandoverImsi)
             // it is on LTE, but now the last used MmWave cell is not in outage
@@ -4123,7 +4322,6 @@ LteEnbRrc::TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
                 NS_LOG_INFO("----- on LTE, switch to lastMmWaveCell "
                             << m_lastMmWaveCell[imsi] << " at time "
                             << Simulator::Now().GetSeconds());
-                Ptr<UeManager> ueMan = GetUeManager(GetRntiFromImsi(imsi));
                 bool useMmWaveConnection = true;
                 m_imsiUsingLte[imsi] = !useMmWaveConnection;
                 ueMan->SendRrcConnectionSwitch(useMmWaveConnection);
@@ -4206,7 +4404,7 @@ LteEnbRrc::TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
                 //  get the SINR for the scheduled targetCellId: if the diff is smaller than 3 dB
                 //  handover anyway
                 double originalTargetSinrDb =
-                    10 * std::log10(m_imsiCellSinrMap.find(imsi)->second[targetCellId]);
+                    10 * std::log10(m_ueSinrTable.GetSinr(imsi, targetCellId));
                 if (maxSinrDb - originalTargetSinrDb >
                     m_sinrThresholdDifference) // this parameter is the same as the one for
                                                // ThresholdBasedSecondaryCellHandover
@@ -4399,12 +4597,11 @@ LteEnbRrc::PerformHandover(uint64_t imsi)
 }
 
 void
-LteEnbRrc::ThresholdBasedSecondaryCellHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
+LteEnbRrc::ThresholdBasedSecondaryCellHandover(uint64_t imsi,
                                                double sinrDifference,
                                                uint16_t maxSinrCellId,
                                                double maxSinrDb)
 {
-    uint64_t imsi = imsiIter->first;
     bool alreadyAssociatedImsi = false;
     bool onHandoverImsi = true;
     // On RecvRrcConnectionRequest for a new RNTI, the Lte Enb RRC stores the imsi
@@ -4544,16 +4741,93 @@ LteEnbRrc::ThresholdBasedSecondaryCellHandover(std::map<uint64_t, CellSinrMap>::
     }
 }
 
+void
+LteEnbRrc::PredictiveHandover(uint64_t imsi,
+                              double sinrDifference,
+                              uint16_t maxSinrCellId,
+                              double maxSinrDb)
+{
+    auto setupCompleted = m_mmWaveCellSetupCompleted.find(imsi);
+    bool alreadyAssociatedImsi = setupCompleted != m_mmWaveCellSetupCompleted.end();
+    bool onHandoverImsi = !alreadyAssociatedImsi || !setupCompleted->second;
+    NS_LOG_INFO("PredictiveHandover: alreadyAssociatedImsi " << alreadyAssociatedImsi
+                                                             << " onHandoverImsi "
+                                                             << onHandoverImsi);
+
+    if (m_imsiUsingLte[imsi])
+    {
+        // the UE is recovering from an outage, there is no trend to follow
+        if (m_interRatHoMode)
+        {
+            ThresholdBasedInterRatHandover(imsi, sinrDifference, maxSinrCellId, maxSinrDb);
+        }
+        else
+        {
+            ThresholdBasedSecondaryCellHandover(imsi, sinrDifference, maxSinrCellId, maxSinrDb);
+        }
+        return;
+    }
+    if (!alreadyAssociatedImsi || onHandoverImsi)
+    {
+        return;
+    }
+
+    // the target must already be able to serve the UE, so that the handover is
+    // completed before the current cell degrades
+    uint16_t currentCellId = m_lastMmWaveCell[imsi];
+    Time predictionTime = Simulator::Now() + m_predictionHorizon;
+    double currentPredictedDb = m_ueSinrTable.PredictSinrDb(imsi, currentCellId, predictionTime);
+    uint16_t targetCellId = 0;
+    double targetPredictedDb = McUeSinrTable::MIN_SINR_DB;
+    double minTargetSinrDb = m_outageThreshold + m_predictiveOutageMargin;
+    for (uint16_t cellId : m_ueSinrTable.GetCells())
+    {
+        if (cellId == currentCellId ||
+            10 * std::log10(m_ueSinrTable.GetSinr(imsi, cellId)) < minTargetSinrDb)
+        {
+            continue;
+        }
+        double predictedDb = m_ueSinrTable.PredictSinrDb(imsi, cellId, predictionTime);
+        if (predictedDb < minTargetSinrDb)
+        {
+            continue;
+        }
+        if (targetCellId == 0 || predictedDb > targetPredictedDb)
+        {
+            targetCellId = cellId;
+            targetPredictedDb = predictedDb;
+        }
+    }
+    NS_LOG_INFO("Imsi " << imsi << " predicted SINR " << currentPredictedDb << " in current cell "
+                        << currentCellId << ", " << targetPredictedDb << " in cell "
+                        << targetCellId);
+
+    if (targetCellId != 0 &&
+        (targetPredictedDb - currentPredictedDb > m_sinrThresholdDifference ||
+         (currentPredictedDb < m_outageThreshold && targetPredictedDb > currentPredictedDb)))
+    {
+        NS_LOG_INFO("----- predictive handover from " << currentCellId << " to " << targetCellId
+                                                       << " at time "
+                                                       << Simulator::Now().GetSeconds());
+        // trigger ho via X2
+        EpcX2SapProvider::SecondaryHandoverParams params;
+        params.imsi = imsi;
+        params.targetCellId = targetCellId;
+        params.oldCellId = currentCellId;
+        m_x2SapProvider->SendMcHandoverRequest(params);
+
+        m_mmWaveCellSetupCompleted[imsi] = false;
+        m_bestMmWaveCellForImsiMap[imsi] = targetCellId;
+    }
+}
+
 void
 LteEnbRrc::TriggerUeAssociationUpdate()
 {
-    if (m_imsiCellSinrMap.size() > 0) // there are some entries
+    if (m_ueSinrTable.GetUes().size() > 0) // there are some entries
     {
-        for (std::map<uint64_t, CellSinrMap>::iterator imsiIter = m_imsiCellSinrMap.begin();
-             imsiIter != m_imsiCellSinrMap.end();
-             ++imsiIter)
+        for (uint64_t imsi : m_ueSinrTable.GetUes())
         {
-            uint64_t imsi = imsiIter->first;
             long double maxSinr = 0;
             long double currentSinr = 0;
             uint16_t maxSinrCellId = 0;
@@ -4579,22 +4853,10 @@ LteEnbRrc::TriggerUeAssociationUpdate()
             NS_LOG_INFO("alreadyAssociatedImsi " << alreadyAssociatedImsi << " onHandoverImsi "
                                                  << onHandoverImsi);
 
-            for (CellSinrMap::iterator cellIter = imsiIter->second.begin();
-                 cellIter != imsiIter->second.end();
-                 ++cellIter)
-            {
-                NS_LOG_INFO("Cell " << cellIter->first << " reports "
-                                    << 10 * std::log10(cellIter->second));
-                if (cellIter->second > maxSinr)
-                {
-                    maxSinr = cellIter->second;
-                    maxSinrCellId = cellIter->first;
-                }
-                if (m_lastMmWaveCell[imsi] == cellIter->first)
-                {
-                    currentSinr = cellIter->second;
-                }
-            }
+            // the best cell is kept up to date by m_ueSinrTable as the reports arrive
+            maxSinr = m_ueSinrTable.GetBestSinr(imsi);
+            maxSinrCellId = m_ueSinrTable.GetBestCell(imsi);
+            currentSinr = m_ueSinrTable.GetSinr(imsi, m_lastMmWaveCell[imsi]);
             long double sinrDifference = std::abs(
                 10 * (std::log10((long double)maxSinr) - std::log10((long double)currentSinr)));
             long double maxSinrDb = 10 * std::log10((long double)maxSinr);
@@ -4643,14 +4905,18 @@ LteEnbRrc::TriggerUeAssociationUpdate()
                 m_bestMmWaveCellForImsiMap[imsi] = maxSinrCellId;
                 if (m_handoverMode == THRESHOLD)
                 {
-                    ThresholdBasedSecondaryCellHandover(imsiIter,
+                    ThresholdBasedSecondaryCellHandover(imsi,
                                                         sinrDifference,
                                                         maxSinrCellId,
                                                         maxSinrDb);
                 }
                 else if (m_handoverMode == FIXED_TTT || m_handoverMode == DYNAMIC_TTT)
                 {
-                    TttBasedHandover(imsiIter, sinrDifference, maxSinrCellId, maxSinrDb);
+                    TttBasedHandover(imsi, sinrDifference, maxSinrCellId, maxSinrDb);
+                }
+                else if (m_handoverMode == PREDICTIVE)
+                {
+                    PredictiveHandover(imsi, sinrDifference, maxSinrCellId, maxSinrDb);
                 }
                 else
                 {
@@ -4664,12 +4930,11 @@ LteEnbRrc::TriggerUeAssociationUpdate()
 }
 
 void
-LteEnbRrc::ThresholdBasedInterRatHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
+LteEnbRrc::ThresholdBasedInterRatHandover(uint64_t imsi,
                                           double sinrDifference,
                                           uint16_t maxSinrCellId,
                                           double maxSinrDb)
 {
-    uint64_t imsi = imsiIter->first;
     bool alreadyAssociatedImsi = false;
     bool onHandoverImsi = true;
     // On RecvRrcConnectionRequest for a new RNTI, the Lte Enb RRC stores the imsi
@@ -4773,13 +5038,10 @@ void
 LteEnbRrc::UpdateUeHandoverAssociation()
 {
     // TODO rules for possible ho of each UE
-    if (m_imsiCellSinrMap.size() > 0) // there are some entries
+    if (m_ueSinrTable.GetUes().size() > 0) // there are some entries
     {
-        for (std::map<uint64_t, CellSinrMap>::iterator imsiIter = m_imsiCellSinrMap.begin();
-             imsiIter != m_imsiCellSinrMap.end();
-             ++imsiIter)
+        for (uint64_t imsi : m_ueSinrTable.GetUes())
         {
-            uint64_t imsi = imsiIter->first;
             long double maxSinr = 0;
             long double currentSinr = 0;
             uint16_t maxSinrCellId = 0;
@@ -4803,22 +5065,10 @@ LteEnbRrc::UpdateUeHandoverAssociation()
             NS_LOG_INFO("alreadyAssociatedImsi " << alreadyAssociatedImsi << " onHandoverImsi "
                                                  << onHandoverImsi);
 
-            for (CellSinrMap::iterator cellIter = imsiIter->second.begin();
-                 cellIter != imsiIter->second.end();
-                 ++cellIter)
-            {
-                NS_LOG_INFO("Cell " << cellIter->first << " reports "
-                                    << 10 * std::log10(cellIter->second));
-                if (cellIter->second > maxSinr)
-                {
-                    maxSinr = cellIter->second;
-                    maxSinrCellId = cellIter->first;
-                }
-                if (m_lastMmWaveCell[imsi] == cellIter->first)
-                {
-                    currentSinr = cellIter->second;
-                }
-            }
+            // the best cell is kept up to date by m_ueSinrTable as the reports arrive
+            maxSinr = m_ueSinrTable.GetBestSinr(imsi);
+            maxSinrCellId = m_ueSinrTable.GetBestCell(imsi);
+            currentSinr = m_ueSinrTable.GetSinr(imsi, m_lastMmWaveCell[imsi]);
 
             long double sinrDifference = std::abs(
                 10 * (std::log10((long double)maxSinr) - std::log10((long double)currentSinr)));
@@ -4871,15 +5121,16 @@ LteEnbRrc::UpdateUeHandoverAssociation()
             {
                 if (m_handoverMode == THRESHOLD)
                 {
-                    ThresholdBasedInterRatHandover(imsiIter,
-                                                   sinrDifference,
-                                                   maxSinrCellId,
-                                                   maxSinrDb);
+                    ThresholdBasedInterRatHandover(imsi, sinrDifference, maxSinrCellId, maxSinrDb);
                 }
                 else if (m_handoverMode == FIXED_TTT || m_handoverMode == DYNAMIC_TTT)
                 {
                     m_bestMmWaveCellForImsiMap[imsi] = maxSinrCellId;
-                    TttBasedHandover(imsiIter, sinrDifference, maxSinrCellId, maxSinrDb);
+                    TttBasedHandover(imsi, sinrDifference, maxSinrCellId, maxSinrDb);
+                }
+                else if (m_handoverMode == PREDICTIVE)
+                {
+                    PredictiveHandover(imsi, sinrDifference, maxSinrCellId, maxSinrDb);
                 }
                 else
                 {
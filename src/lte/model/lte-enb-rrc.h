@@ -51,6 +51,7 @@
 #include <ns3/lte-rlc-am.h>
 #include <ns3/lte-rlc.h>
 #include <ns3/lte-rrc-sap.h>
+#include <ns3/mc-ue-sinr-table.h>
 #include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/traced-callback.h>
@@ -257,6 +258,14 @@ class UeManager : public Object
 
     void SendRrcConnectionSwitch(bool useMmWaveConnection);
 
+    /**
+     * Forward the last SINR of the UE in its secondary (mmWave) cell to the
+     * splitters of the MC PDCP entities of its split bearers
+     *
+     * \param sinr the SINR, in linear units
+     */
+    void NotifyMmWaveSinr(double sinr);
+
     /**
      * Take the necessary actions in response to the reception of an X2 HO preparation failure
      * message
@@ -448,6 +457,16 @@ class UeManager : public Object
      */
     void RecvSecondaryCellHandoverCompleted(EpcX2SapUser::SecondaryHandoverCompletedParams params);
 
+    /**
+     * Sort the PDCP PDUs forwarded to the target RLC of a secondary cell HO by
+     * sequence number, and remove the duplicates. The PDUs must be within half
+     * the SN space of the first one.
+     *
+     * \param pdus the PDUs, with their PDCP header
+     * \param snModulus the number of PDCP sequence numbers of the bearer
+     */
+    static void SortForwardedPdus(std::vector<Ptr<Packet>>& pdus, uint32_t snModulus);
+
   private:
     // Lossless HO: merge 2 buffers into 1 with increment order.
     std::vector<LteRlcAm::RetxPdu> MergeBuffers(std::vector<LteRlcAm::RetxPdu> first,
@@ -472,6 +491,7 @@ class UeManager : public Object
                            bool mcMmToMmWaveForwarding,
                            uint8_t bid);
 
+
     bool m_firstConnection;
     bool m_receivedLteMmWaveHandoverCompleted;
     uint16_t m_queuedHandoverRequestCellId;
@@ -695,6 +715,8 @@ class UeManager : public Object
     std::vector<Ptr<Packet>> m_x2forwardingBuffer;
     uint32_t m_x2forwardingBufferSize;
     uint32_t m_maxx2forwardingBufferSize;
+    uint32_t m_forwardedPdus;  ///< PDUs forwarded over X2 by ForwardRlcBuffers
+    uint64_t m_forwardedBytes; ///< bytes forwarded over X2 by ForwardRlcBuffers
 
     // this variable is set to true if on initial access, for mc devices, all the mmWave eNBs are in
     // outage
@@ -785,6 +807,12 @@ class LteEnbRrc : public Object
      */
     EpcX2SapUser* GetEpcX2SapUser();
 
+    /**
+     * Get the SINR of the UEs towards the mmWave cells, as reported over X2
+     * \return the SINR table of the coordinator
+     */
+    const McUeSinrTable& GetUeSinrTable() const;
+
     /**
      * Set the X2 PDCP Provider this RRC should pass to PDCP layers
      * \param s the X2 PDCP Provider to be stored in this RRC entity
@@ -1246,6 +1274,22 @@ class LteEnbRrc : public Object
                                                    uint16_t cellId,
                                                    long double sinr);
 
+    /**
+     * TracedCallback signature for the forwarding of the buffered data of a
+     * UE to the target cell of a handover.
+     *
+     * \param [in] imsi
+     * \param [in] cellId
+     * \param [in] targetCellId
+     * \param [in] pdus the number of forwarded PDUs
+     * \param [in] bytes the number of forwarded bytes
+     */
+    typedef void (*HandoverDataForwardedTracedCallback)(uint64_t imsi,
+                                                        uint16_t cellId,
+                                                        uint16_t targetCellId,
+                                                        uint32_t pdus,
+                                                        uint64_t bytes);
+
     /**
      * Different secondary cell handover modes
      */
@@ -1253,7 +1297,8 @@ class LteEnbRrc : public Object
     {
         FIXED_TTT = 1,
         DYNAMIC_TTT = 2,
-        THRESHOLD = 3
+        THRESHOLD = 3,
+        PREDICTIVE = 4
     };
 
     struct HandoverEventInfo
@@ -1518,6 +1563,16 @@ class LteEnbRrc : public Object
 
     // Internal methods
 
+    /**
+     * Fill the UE SINR update for the LTE coordinator with the UEs whose
+     * quantized SINR changed by more than m_sinrReportThreshold since it was
+     * last reported, or with all the UEs every m_sinrFullReportPeriod updates
+     *
+     * \param sinrMap the SINR of the UEs of the cell
+     * \param params the update
+     */
+    void BuildUeSinrUpdate(const ImsiSinrMap& sinrMap, EpcX2SapProvider::UeImsiSinrParams& params);
+
     void EnableSwitching(uint64_t imsi);
     bool m_switchEnabled;
 
@@ -1645,28 +1700,46 @@ class LteEnbRrc : public Object
 
     /**
      * Trigger an handover according to certain conditions on the SINR
-     * @params the iterator on m_imsiCellSinrMap
+     * @params the imsi of the UE
      * @params the sinrDifference between the current and the maxSinr cell
      * @params the CellId of the maximum SINR cell
      * @params the value of the SINR for this cell
      */
-    void ThresholdBasedSecondaryCellHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
+    void ThresholdBasedSecondaryCellHandover(uint64_t imsi,
                                              double sinrDifference,
                                              uint16_t maxSinrCellId,
                                              double maxSinrDb);
 
     /**
      * Trigger an handover according to certain conditions on the SINR and the TTT
-     * @params the iterator on m_imsiCellSinrMap
+     * @params the imsi of the UE
      * @params the sinrDifference between the current and the maxSinr cell
      * @params the CellId of the maximum SINR cell
      * @params the value of the SINR for this cell
      */
-    void TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
+    void TttBasedHandover(uint64_t imsi,
                           double sinrDifference,
                           uint16_t maxSinrCellId,
                           double maxSinrDb);
 
+    /**
+     * Trigger an handover when the SINR predicted from the trend of the last
+     * reports, PredictionHorizon ahead, of another cell exceeds the one of the
+     * current cell by HoSinrDifference, or the current cell is predicted to be
+     * in outage. The handover is thus started before the current link
+     * degrades. The last and the predicted SINR of the target cell must be
+     * PredictiveOutageMargin above OutageThreshold, so that a cell at the edge
+     * of the outage is not selected.
+     * @params the imsi of the UE
+     * @params the sinrDifference between the current and the maxSinr cell
+     * @params the CellId of the maximum SINR cell
+     * @params the value of the SINR for this cell
+     */
+    void PredictiveHandover(uint64_t imsi,
+                            double sinrDifference,
+                            uint16_t maxSinrCellId,
+                            double maxSinrDb);
+
     /**
      * Compute the TTT according to the sinrDifference and the dynamic handover algorithm
      */
@@ -1687,12 +1760,12 @@ class LteEnbRrc : public Object
     /**
      * Trigger an handover according to certain conditions on the SINR (for single-connectivity
      * devices)
-     * @params the iterator on m_imsiCellSinrMap
+     * @params the imsi of the UE
      * @params the sinrDifference between the current and the maxSinr cell
      * @params the CellId of the maximum SINR cell
      * @params the value of the SINR for this cell
      */
-    void ThresholdBasedInterRatHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
+    void ThresholdBasedInterRatHandover(uint64_t imsi,
                                         double sinrDifference,
                                         uint16_t maxSinrCellId,
                                         double maxSinrDb);
@@ -1921,6 +1994,12 @@ class LteEnbRrc : public Object
         m_recvMeasurementReportTrace;
 
     TracedCallback<uint64_t, uint16_t, long double> m_notifyMmWaveSinrTrace;
+    /**
+     * The `HandoverDataForwarded` trace source. Fired when the source cell of
+     * a handover has forwarded the buffered data of the UE to the target
+     * cell. Exporting IMSI, cell ID, target cell ID, PDUs and bytes.
+     */
+    TracedCallback<uint64_t, uint16_t, uint16_t, uint32_t, uint64_t> m_handoverDataForwardedTrace;
 
     // mc
     bool m_ismmWave;
@@ -1934,15 +2013,19 @@ class LteEnbRrc : public Object
         m_ueImsiSinrMap;    // this map contains the ueImsiSinrMap reports sent by the CCs
     bool m_reportAllUeMeas; // if true, the MmWave eNB reports to the coordinator all the received
                             // UE measures, i.e. one per CC
+    double m_sinrReportThreshold;    ///< SINR change that triggers the report of a UE, in dB
+    uint32_t m_sinrFullReportPeriod; ///< number of SINR updates between full updates
+    uint32_t m_sinrUpdatesSinceFull; ///< SINR updates sent since the last full update
+    /// quantized SINR last reported to the coordinator for each UE, in increasing IMSI order
+    std::vector<std::pair<uint64_t, int16_t>> m_lastReportedSinr;
 
     // for LTE eNBs
-    std::map<uint16_t, ImsiSinrMap> m_cellSinrMap;
     uint16_t m_numNewSinrReports;
     std::map<uint64_t, uint16_t> m_bestMmWaveCellForImsiMap;
     std::map<uint64_t, uint16_t> m_lastMmWaveCell;
     std::map<uint64_t, bool> m_mmWaveCellSetupCompleted;
     std::map<uint64_t, bool> m_imsiUsingLte;
-    std::map<uint64_t, CellSinrMap> m_imsiCellSinrMap;
+    McUeSinrTable m_ueSinrTable; ///< SINR of the UEs towards the mmWave cells and their best cell
     std::map<uint64_t, uint16_t> m_imsiRntiMap;
     std::map<uint16_t, uint64_t> m_rntiImsiMap;
 
@@ -1961,6 +2044,11 @@ class LteEnbRrc : public Object
     double m_minDiffTttValue;
     double m_maxDiffTttValue;
 
+    // predictive handover management
+    Time m_predictionHorizon;   ///< how far ahead the SINR is predicted
+    uint32_t m_sinrTrendWindow;      ///< number of SINR values used for the SINR trend
+    double m_predictiveOutageMargin; ///< margin of the target cell above the outage [dB]
+
     int m_crtPeriod;
 
     uint32_t m_x2_received_cnt;
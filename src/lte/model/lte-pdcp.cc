@@ -140,6 +140,12 @@ LtePdcp::GetLtePdcpSapProvider()
     return m_pdcpSapProvider;
 }
 
+uint32_t
+LtePdcp::GetSnModulus()
+{
+    return m_maxPdcpSn + 1;
+}
+
 void
 LtePdcp::SetLteRlcSapProvider(LteRlcSapProvider* s)
 {
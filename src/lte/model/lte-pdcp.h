@@ -78,6 +78,12 @@ class LtePdcp : public Object // SimpleRefCount<LtePdcp>
      */
     LtePdcpSapProvider* GetLtePdcpSapProvider();
 
+    /**
+     * \return the number of sequence numbers of the data PDUs, i.e., 2 to the
+     * power of their length
+     */
+    static uint32_t GetSnModulus();
+
     /**
      *
      *
@@ -34,6 +34,7 @@
 #include "ns3/lte-rlc-am-header.h"
 #include "ns3/lte-rlc-sdu-status-tag.h"
 #include "ns3/lte-rlc-tag.h"
+#include "ns3/profiler.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 
@@ -318,6 +319,7 @@ void
 LteRlcAm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParams)
 {
     NS_LOG_FUNCTION(this << m_rnti << (uint32_t)m_lcid << txOpParams.bytes);
+    NS_PROFILE_SCOPE("lte", "LteRlcAm::DoNotifyTxOpportunity");
 
     if (txOpParams.bytes < 4)
     {
@@ -2859,6 +2861,8 @@ LteRlcAm::DoReportBufferStatus(void)
         r.statusPduSize = 0;
     }
 
+    NotifyPdcpBufferStatus(r.txQueueSize, r.retxQueueSize, txonQueueHolDelay);
+
     if (r.txQueueSize != 0 || r.retxQueueSize != 0 || r.statusPduSize != 0)
     {
         NS_LOG_INFO("Send ReportBufferStatus: " << r.txQueueSize << ", " << r.txQueueHolDelay
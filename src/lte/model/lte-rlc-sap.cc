@@ -31,4 +31,9 @@ LteRlcSapUser::~LteRlcSapUser()
 {
 }
 
+void
+LteRlcSapUser::NotifyTxBufferStatus(uint32_t txQueueSize, uint16_t txQueueHolDelay)
+{
+}
+
 } // namespace ns3
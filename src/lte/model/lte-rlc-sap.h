@@ -75,6 +75,16 @@ class LteRlcSapUser
      * \param p the PDCP PDU
      */
     virtual void ReceivePdcpPdu(Ptr<Packet> p) = 0;
+
+    /**
+     * Called by the RLC entity to notify the PDCP entity of the occupancy of its
+     * buffers, every time it is reported to the MAC. It is used by the PDCP
+     * entities of split bearers to select the RLC entity to transmit a PDU with.
+     *
+     * \param txQueueSize the size of the transmission and retransmission queues, in bytes
+     * \param txQueueHolDelay the head of line delay of the transmission queue, in ms
+     */
+    virtual void NotifyTxBufferStatus(uint32_t txQueueSize, uint16_t txQueueHolDelay);
 };
 
 /// LteRlcSpecificLteRlcSapProvider
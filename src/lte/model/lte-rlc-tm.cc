@@ -27,6 +27,7 @@
 
 #include "ns3/log.h"
 #include "ns3/lte-rlc-tag.h"
+#include "ns3/profiler.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -124,6 +125,7 @@ LteRlcTm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
 {
     NS_LOG_FUNCTION(this << m_rnti << (uint32_t)m_lcid << txOpParams.bytes
                          << (uint32_t)txOpParams.layer << (uint32_t)txOpParams.harqId);
+    NS_PROFILE_SCOPE("lte", "LteRlcTm::DoNotifyTxOpportunity");
 
     // 5.1.1.1 Transmit operations
     // 5.1.1.1.1 General
@@ -34,6 +34,7 @@
 #include "ns3/lte-rlc-header.h"
 #include "ns3/lte-rlc-sdu-status-tag.h"
 #include "ns3/lte-rlc-tag.h"
+#include "ns3/profiler.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -188,6 +189,7 @@ LteRlcUmLowLat::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txO
 {
     NS_LOG_FUNCTION(this << m_rnti << (uint32_t)m_lcid << txOpParams.bytes
                          << (uint32_t)txOpParams.componentCarrierId);
+    NS_PROFILE_SCOPE("lte", "LteRlcUmLowLat::DoNotifyTxOpportunity");
 
     if (txOpParams.bytes <= 2)
     {
@@ -1228,6 +1230,7 @@ LteRlcUmLowLat::DoReportBufferStatus(void)
         r.retxQueueSize = 0;
         r.retxQueueHolDelay = 0;
         r.statusPduSize = 0;
+        NotifyPdcpBufferStatus(r.txQueueSize, 0, holDelay);
 
         for (unsigned i = 0; i < m_txBuffer.size(); i++)
         {
@@ -28,6 +28,7 @@
 #include "ns3/lte-rlc-header.h"
 #include "ns3/lte-rlc-sdu-status-tag.h"
 #include "ns3/lte-rlc-tag.h"
+#include "ns3/profiler.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -158,6 +159,7 @@ void
 LteRlcUm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParams)
 {
     NS_LOG_FUNCTION(this << m_rnti << (uint32_t)m_lcid << txOpParams.bytes);
+    NS_PROFILE_SCOPE("lte", "LteRlcUm::DoNotifyTxOpportunity");
 
     if (txOpParams.bytes <= 2)
     {
@@ -1211,6 +1213,7 @@ LteRlcUm::DoReportBufferStatus(void)
 
     NS_LOG_LOGIC("Send ReportBufferStatus = " << r.txQueueSize << ", " << r.txQueueHolDelay);
     m_macSapProvider->ReportBufferStatus(r);
+    NotifyPdcpBufferStatus(r.txQueueSize, 0, holDelay);
 }
 
 void
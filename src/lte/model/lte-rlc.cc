@@ -27,6 +27,8 @@
 #include "ns3/log.h"
 #include "ns3/lte-rlc-tag.h"
 #include "ns3/simulator.h"
+
+#include <algorithm>
 //#include "lte-mac-sap.h"
 #include "ns3/lte-rlc-sap.h"
 
@@ -105,7 +107,9 @@ LteRlc::LteRlc()
       m_macSapProvider(0),
       m_rnti(0),
       m_lcid(0),
-      isMc(false) // TODO refactor this!!
+      isMc(false), // TODO refactor this!!
+      m_epcX2RlcProvider(0),
+      m_lastMcBufferStatusTime(Seconds(-1))
 {
     NS_LOG_FUNCTION(this);
     m_rlcSapProvider = new LteRlcSpecificLteRlcSapProvider<LteRlc>(this);
@@ -135,7 +139,17 @@ LteRlc::GetTypeId(void)
                             .AddTraceSource("TxCompletedCallback",
                                             "PDU acked.",
                                             MakeTraceSourceAccessor(&LteRlc::m_txCompletedCallback),
-                                            "ns3::LteRlc::RetransmissionCountCallback");
+                                            "ns3::LteRlc::RetransmissionCountCallback")
+                            .AddAttribute("McBufferStatusInterval",
+                                          "Minimum interval between the buffer status reports "
+                                          "sent over X2 to the PDCP entity of a split bearer. "
+                                          "Zero disables the reports, which are only needed "
+                                          "by the splitters that use the buffer status, e.g., "
+                                          "ns3::McPdcpQueueDelaySplitter, which cannot be used "
+                                          "without them",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&LteRlc::m_mcBufferStatusInterval),
+                                          MakeTimeChecker());
     return tid;
 }
 
@@ -146,6 +160,7 @@ LteRlc::DoDispose()
     delete m_rlcSapProvider;
     delete m_epcX2RlcUser;
     delete m_macSapUser;
+    m_mcBufferStatusEvent.Cancel();
 }
 
 void
@@ -215,6 +230,63 @@ LteRlc::GetEpcX2RlcUser()
     return m_epcX2RlcUser;
 }
 
+void
+LteRlc::NotifyPdcpBufferStatus(uint32_t txQueueSize, uint32_t retxQueueSize, Time txQueueHolDelay)
+{
+    uint16_t holDelayMs = std::min<int64_t>(txQueueHolDelay.GetMilliSeconds(), UINT16_MAX);
+    if (!isMc)
+    {
+        if (m_rlcSapUser != 0)
+        {
+            m_rlcSapUser->NotifyTxBufferStatus(txQueueSize + retxQueueSize, holDelayMs);
+        }
+        return;
+    }
+
+    m_mcBufferStatus.sourceCellId = m_ueDataParams.sourceCellId;
+    m_mcBufferStatus.targetCellId = m_ueDataParams.targetCellId;
+    m_mcBufferStatus.gtpTeid = m_ueDataParams.gtpTeid;
+    m_mcBufferStatus.txQueueSize = txQueueSize;
+    m_mcBufferStatus.txQueueHolDelay = holDelayMs;
+    m_mcBufferStatus.retxQueueSize = retxQueueSize;
+
+    if (m_epcX2RlcProvider == 0 || m_mcBufferStatusInterval.IsZero() ||
+        m_mcBufferStatusEvent.IsRunning())
+    {
+        return; // the pending report will carry the last status
+    }
+    Time next = m_lastMcBufferStatusTime + m_mcBufferStatusInterval;
+    if (Simulator::Now() >= next)
+    {
+        SendMcBufferStatus();
+    }
+    else
+    {
+        m_mcBufferStatusEvent =
+            Simulator::Schedule(next - Simulator::Now(), &LteRlc::SendMcBufferStatus, this);
+    }
+}
+
+void
+LteRlc::SendMcBufferStatus()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_lastMcBufferStatusTime >= Seconds(0) &&
+        m_mcBufferStatus.txQueueSize == m_sentBufferStatus.txQueueSize &&
+        m_mcBufferStatus.retxQueueSize == m_sentBufferStatus.retxQueueSize &&
+        m_mcBufferStatus.txQueueHolDelay == m_sentBufferStatus.txQueueHolDelay &&
+        m_mcBufferStatus.gtpTeid == m_sentBufferStatus.gtpTeid)
+    {
+        return; // nothing new to report
+    }
+    NS_LOG_LOGIC("Send buffer status to cell " << m_mcBufferStatus.targetCellId << ": "
+                                               << m_mcBufferStatus.txQueueSize << ", "
+                                               << m_mcBufferStatus.retxQueueSize);
+    m_lastMcBufferStatusTime = Simulator::Now();
+    m_sentBufferStatus = m_mcBufferStatus;
+    m_epcX2RlcProvider->ReportRlcBufferStatus(m_mcBufferStatus);
+}
+
 ////////////////////////////////////////
 
 NS_OBJECT_ENSURE_REGISTERED(LteRlcSm);
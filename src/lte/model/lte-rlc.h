@@ -25,6 +25,7 @@
 #ifndef LTE_RLC_H
 #define LTE_RLC_H
 
+#include "ns3/event-id.h"
 #include "ns3/lte-mac-sap.h"
 #include "ns3/lte-rlc-sap.h"
 #include "ns3/nstime.h"
@@ -216,6 +217,17 @@ class LteRlc : public Object
 
     virtual void DoSendMcPdcpSdu(EpcX2Sap::UeDataParams params) = 0;
 
+    /**
+     * Notify the PDCP entity of the buffer status reported to the MAC. If the
+     * PDCP entity is in a remote cell, the status is sent over X2, at most once
+     * per McBufferStatusInterval, if the interval is not zero.
+     *
+     * \param txQueueSize the size of the transmission queue, in bytes
+     * \param retxQueueSize the size of the retransmission queue, in bytes
+     * \param txQueueHolDelay the head of line delay of the transmission queue
+     */
+    void NotifyPdcpBufferStatus(uint32_t txQueueSize, uint32_t retxQueueSize, Time txQueueHolDelay);
+
     LteMacSapUser* m_macSapUser;         ///< MAC SAP user
     LteMacSapProvider* m_macSapProvider; ///< MAC SAP provider
 
@@ -240,6 +252,18 @@ class LteRlc : public Object
     bool isMc;
     EpcX2RlcProvider* m_epcX2RlcProvider;
     EpcX2RlcUser* m_epcX2RlcUser;
+
+  private:
+    /**
+     * Send the last buffer status to the PDCP entity in the remote cell
+     */
+    void SendMcBufferStatus();
+
+    Time m_mcBufferStatusInterval;                      ///< minimum interval of the X2 reports
+    Time m_lastMcBufferStatusTime;                      ///< time of the last X2 report
+    EventId m_mcBufferStatusEvent;                      ///< pending X2 report
+    EpcX2Sap::RlcBufferStatusParams m_mcBufferStatus;   ///< last buffer status
+    EpcX2Sap::RlcBufferStatusParams m_sentBufferStatus; ///< last buffer status sent over X2
 };
 
 /**
@@ -143,6 +143,7 @@ LteUeRrc::LteUeRrc()
       m_imsi(0),
       m_rnti(0),
       m_cellId(0),
+      m_handoverSourceCellId(0),
       m_useRlcSm(true),
       m_connectionPending(false),
       m_hasReceivedMib(false),
@@ -294,6 +295,11 @@ LteUeRrc::GetTypeId(void)
                             "trace fired upon failure of a handover procedure",
                             MakeTraceSourceAccessor(&LteUeRrc::m_handoverEndErrorTrace),
                             "ns3::LteUeRrc::ImsiCidRntiTracedCallback")
+            .AddTraceSource("HandoverInterruption",
+                            "trace fired upon successful termination of a handover procedure, "
+                            "with the time elapsed since the handover command",
+                            MakeTraceSourceAccessor(&LteUeRrc::m_handoverInterruptionTrace),
+                            "ns3::LteUeRrc::HandoverInterruptionTracedCallback")
             .AddTraceSource("SCarrierConfigured",
                             "trace fired after configuring secondary carriers",
                             MakeTraceSourceAccessor(&LteUeRrc::m_sCarrierConfiguredTrace),
@@ -805,6 +811,10 @@ LteUeRrc::DoNotifyRandomAccessSuccessful()
 
         SwitchToState(CONNECTED_NORMALLY);
         m_handoverEndOkTrace(m_imsi, m_cellId, m_rnti);
+        m_handoverInterruptionTrace(m_imsi,
+                                    m_handoverSourceCellId,
+                                    m_cellId,
+                                    Simulator::Now() - m_handoverStartTime);
         if (m_isSecondaryRRC) // an handover for secondary cells has happened.
         // this trace is used to keep a consistent trace of the cell to which the UE is connected
         {
@@ -1192,6 +1202,8 @@ LteUeRrc::DoRecvRrcConnectionReconfiguration(LteRrcSap::RrcConnectionReconfigura
             SwitchToState(CONNECTED_HANDOVER);
             const LteRrcSap::MobilityControlInfo& mci = msg.mobilityControlInfo;
             m_handoverStartTrace(m_imsi, m_cellId, m_rnti, mci.targetPhysCellId);
+            m_handoverStartTime = Simulator::Now();
+            m_handoverSourceCellId = m_cellId;
             // We should reset the MACs and PHYs for all the component carriers
             for (uint16_t i = 0; i < m_numberOfComponentCarriers; i++)
             {
@@ -1547,7 +1559,7 @@ LteUeRrc::DoRecvRrcConnectionSwitch(LteRrcSap::RrcConnectionSwitch msg)
                     {
                         pdcp->SetMmWaveRnti(m_mmWaveRnti);
                         pdcp->SetMmWaveRlcSapProvider(rlc->GetLteRlcSapProvider());
-                        rlc->SetLteRlcSapUser(pdcp->GetLteRlcSapUser());
+                        rlc->SetLteRlcSapUser(pdcp->GetMmWaveRlcSapUser());
                     }
                     rlc->Initialize();
                     m_rlcMap.find(*iter)->second->m_rlc = rlc;
@@ -2070,7 +2082,7 @@ LteUeRrc::DoNotifySecondaryCellHandover(uint16_t oldRnti,
                 {
                     pdcp->SetMmWaveRnti(m_mmWaveRnti);
                     pdcp->SetMmWaveRlcSapProvider(rlc->GetLteRlcSapProvider());
-                    rlc->SetLteRlcSapUser(pdcp->GetLteRlcSapUser());
+                    rlc->SetLteRlcSapUser(pdcp->GetMmWaveRlcSapUser());
                 }
                 rlc->Initialize();
 
@@ -2433,7 +2445,7 @@ LteUeRrc::ApplyRadioResourceConfigDedicated(LteRrcSap::RadioResourceConfigDedica
                     {
                         pdcp->SetMmWaveRnti(m_mmWaveRnti);
                         pdcp->SetMmWaveRlcSapProvider(rlc->GetLteRlcSapProvider());
-                        rlc->SetLteRlcSapUser(pdcp->GetLteRlcSapUser());
+                        rlc->SetLteRlcSapUser(pdcp->GetMmWaveRlcSapUser());
                     }
                     rlc->Initialize();
 
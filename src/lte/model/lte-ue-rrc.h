@@ -378,6 +378,20 @@ class LteUeRrc : public Object
                                         State oldState,
                                         State newState);
 
+    /**
+     * TracedCallback signature for handover interruption events.
+     *
+     * \param [in] imsi
+     * \param [in] sourceCellId
+     * \param [in] targetCellId
+     * \param [in] interruption the time from the handover command to the
+     *             connection to the target cell
+     */
+    typedef void (*HandoverInterruptionTracedCallback)(uint64_t imsi,
+                                                       uint16_t sourceCellId,
+                                                       uint16_t targetCellId,
+                                                       Time interruption);
+
     /**
      * TracedCallback signature for secondary carrier configuration events.
      *
@@ -803,6 +817,8 @@ class LteUeRrc : public Object
      * The `CellId` attribute. Serving cell identifier.
      */
     uint16_t m_cellId;
+    uint16_t m_handoverSourceCellId; ///< cell that sent the last handover command
+    Time m_handoverStartTime;        ///< time of the reception of the last handover command
 
     /**
      * The `Srb0` attribute. SignalingRadioBearerInfo for SRB0.
@@ -914,6 +930,12 @@ class LteUeRrc : public Object
      * procedure. Exporting IMSI, cell ID, and RNTI.
      */
     TracedCallback<uint64_t, uint16_t, uint16_t> m_handoverEndErrorTrace;
+    /**
+     * The `HandoverInterruption` trace source. Fired upon successful
+     * termination of a handover procedure. Exporting IMSI, source cell ID,
+     * target cell ID and the time elapsed since the handover command.
+     */
+    TracedCallback<uint64_t, uint16_t, uint16_t, Time> m_handoverInterruptionTrace;
     /**
      * The `SCarrierConfigured` trace source. Fired after the configuration
      * of secondary carriers received through RRC Connection Reconfiguration
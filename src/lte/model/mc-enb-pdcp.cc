@@ -22,12 +22,17 @@
 
 #include "ns3/mc-enb-pdcp.h"
 
+#include "ns3/abort.h"
 #include "ns3/epc-x2-sap.h"
 #include "ns3/log.h"
 #include "ns3/lte-pdcp-header.h"
 #include "ns3/lte-pdcp-sap.h"
 #include "ns3/lte-pdcp-tag.h"
+#include "ns3/lte-rlc.h"
+#include "ns3/object-factory.h"
+#include "ns3/pointer.h"
 #include "ns3/simulator.h"
+#include "ns3/type-id.h"
 
 namespace ns3
 {
@@ -41,6 +46,7 @@ class McPdcpSpecificLteRlcSapUser : public LteRlcSapUser
 
     // Interface provided to lower RLC entity (implemented from LteRlcSapUser)
     virtual void ReceivePdcpPdu(Ptr<Packet> p);
+    virtual void NotifyTxBufferStatus(uint32_t txQueueSize, uint16_t txQueueHolDelay);
 
   private:
     McPdcpSpecificLteRlcSapUser();
@@ -62,6 +68,12 @@ McPdcpSpecificLteRlcSapUser::ReceivePdcpPdu(Ptr<Packet> p)
     m_pdcp->DoReceivePdu(p);
 }
 
+void
+McPdcpSpecificLteRlcSapUser::NotifyTxBufferStatus(uint32_t txQueueSize, uint16_t txQueueHolDelay)
+{
+    m_pdcp->DoNotifyTxBufferStatus(txQueueSize, txQueueHolDelay);
+}
+
 ///////////////////////////////////////
 
 NS_OBJECT_ENSURE_REGISTERED(McEnbPdcp);
@@ -80,6 +92,9 @@ McEnbPdcp::McEnbPdcp()
     m_pdcpSapProvider = new LtePdcpSpecificLtePdcpSapProvider<McEnbPdcp>(this);
     m_rlcSapUser = new McPdcpSpecificLteRlcSapUser(this);
     m_epcX2PdcpUser = new EpcX2PdcpSpecificUser<McEnbPdcp>(this);
+    m_ueDataParams.sourceCellId = 0;
+    m_ueDataParams.targetCellId = 0;
+    m_ueDataParams.gtpTeid = 0;
 }
 
 McEnbPdcp::~McEnbPdcp()
@@ -99,7 +114,21 @@ McEnbPdcp::GetTypeId(void)
                             .AddTraceSource("RxPDU",
                                             "PDU received.",
                                             MakeTraceSourceAccessor(&McEnbPdcp::m_rxPdu),
-                                            "ns3::McEnbPdcp::PduRxTracedCallback");
+                                            "ns3::McEnbPdcp::PduRxTracedCallback")
+                            .AddAttribute("SplitterType",
+                                          "The type of the splitter that selects the LTE or "
+                                          "mmWave RLC entity of each PDU. The default one only "
+                                          "switches between them.",
+                                          TypeIdValue(McPdcpSplitter::GetTypeId()),
+                                          MakeTypeIdAccessor(&McEnbPdcp::SetSplitterType,
+                                                             &McEnbPdcp::GetSplitterType),
+                                          MakeTypeIdChecker())
+                            .AddAttribute("Splitter",
+                                          "The splitter that selects the RLC entity of each PDU.",
+                                          TypeId::ATTR_GET,
+                                          PointerValue(),
+                                          MakePointerAccessor(&McEnbPdcp::m_splitter),
+                                          MakePointerChecker<McPdcpSplitter>());
     return tid;
 }
 
@@ -110,6 +139,7 @@ McEnbPdcp::DoDispose()
     delete (m_pdcpSapProvider);
     delete (m_rlcSapUser);
     delete (m_epcX2PdcpUser);
+    m_splitter = 0;
 }
 
 void
@@ -194,9 +224,53 @@ McEnbPdcp::SetStatus(Status s)
 void
 McEnbPdcp::SetUeDataParams(EpcX2Sap::UeDataParams params)
 {
+    if (params.targetCellId != m_ueDataParams.targetCellId)
+    {
+        // the remote RLC entity is a new one
+        m_splitter->ResetLeg(McPdcpSplitter::MMWAVE_LEG);
+    }
     m_ueDataParams = params;
 }
 
+void
+McEnbPdcp::SetSplitterType(TypeId type)
+{
+    NS_LOG_FUNCTION(this << type);
+    ObjectFactory factory;
+    factory.SetTypeId(type);
+    m_splitterType = type;
+    m_splitter = factory.Create<McPdcpSplitter>();
+    if (m_splitter->UsesBufferStatus())
+    {
+        // the remote RLC entities are created with the default interval
+        TypeId::AttributeInformation info;
+        LteRlc::GetTypeId().LookupAttributeByName("McBufferStatusInterval", &info);
+        Time interval = DynamicCast<const TimeValue>(info.initialValue)->Get();
+        NS_ABORT_MSG_IF(interval.IsZero(),
+                        type.GetName() << " needs the buffer status of the mmWave RLC entity, "
+                                       << "set ns3::LteRlc::McBufferStatusInterval to enable "
+                                       << "its X2 reports");
+    }
+}
+
+TypeId
+McEnbPdcp::GetSplitterType() const
+{
+    return m_splitterType;
+}
+
+Ptr<McPdcpSplitter>
+McEnbPdcp::GetSplitter() const
+{
+    return m_splitter;
+}
+
+void
+McEnbPdcp::SetMmWaveSinr(double sinr)
+{
+    m_splitter->SetSinr(McPdcpSplitter::MMWAVE_LEG, sinr);
+}
+
 ////////////////////////////////////////
 
 void
@@ -222,7 +296,9 @@ McEnbPdcp::DoTransmitPdcpSdu(Ptr<Packet> p)
     params.rnti = m_rnti;
     params.lcid = m_lcid;
 
-    if (m_epcX2PdcpProvider == 0 || (!m_useMmWaveConnection))
+    m_splitter->SetLegAvailable(McPdcpSplitter::MMWAVE_LEG,
+                                m_epcX2PdcpProvider != 0 && m_useMmWaveConnection);
+    if (m_splitter->SelectLeg(p->GetSize()) == McPdcpSplitter::LTE_LEG)
     {
         NS_LOG_INFO(this << " McEnbPdcp: Tx packet to downlink local stack");
 
@@ -238,7 +314,7 @@ McEnbPdcp::DoTransmitPdcpSdu(Ptr<Packet> p)
 
         m_rlcSapProvider->TransmitPdcpPdu(params);
     }
-    else if (m_useMmWaveConnection)
+    else
     {
         // Do not add sender time stamp: we are not interested in adding X2 delay for MC connections
         NS_LOG_INFO(this << " McEnbPdcp: Tx packet to downlink MmWave stack on remote cell "
@@ -247,10 +323,6 @@ McEnbPdcp::DoTransmitPdcpSdu(Ptr<Packet> p)
         m_txPdu(m_rnti, m_lcid, p->GetSize());
         m_epcX2PdcpProvider->SendMcPdcpPdu(m_ueDataParams);
     }
-    else
-    {
-        NS_FATAL_ERROR("Invalid combination");
-    }
 }
 
 void
@@ -297,6 +369,21 @@ McEnbPdcp::DoReceiveMcPdcpPdu(EpcX2Sap::UeDataParams params)
     DoReceivePdu(params.ueData);
 }
 
+void
+McEnbPdcp::DoNotifyTxBufferStatus(uint32_t txQueueSize, uint16_t txQueueHolDelay)
+{
+    m_splitter->NotifyBufferStatus(McPdcpSplitter::LTE_LEG, txQueueSize, txQueueHolDelay);
+}
+
+void
+McEnbPdcp::DoReceiveRlcBufferStatus(EpcX2Sap::RlcBufferStatusParams params)
+{
+    NS_LOG_FUNCTION(this << m_mmWaveRnti << (uint32_t)m_lcid << params.txQueueSize);
+    m_splitter->NotifyBufferStatus(McPdcpSplitter::MMWAVE_LEG,
+                                   params.txQueueSize + params.retxQueueSize,
+                                   params.txQueueHolDelay);
+}
+
 void
 McEnbPdcp::SwitchConnection(bool useMmWaveConnection)
 {
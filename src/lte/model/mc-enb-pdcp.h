@@ -31,6 +31,7 @@
 #include <ns3/lte-pdcp-sap.h>
 #include <ns3/lte-pdcp.h>
 #include <ns3/lte-rlc-sap.h>
+#include <ns3/mc-pdcp-splitter.h>
 
 namespace ns3
 {
@@ -184,6 +185,31 @@ class McEnbPdcp : public LtePdcp
      */
     bool GetUseMmWaveConnection() const;
 
+    /**
+     * Set the type of the splitter that selects the RLC entity, local (LTE) or
+     * remote (mmWave), of each PDU, and create a new splitter
+     *
+     * \param type the TypeId of a subclass of McPdcpSplitter
+     */
+    void SetSplitterType(TypeId type);
+
+    /**
+     * \return the type of the splitter
+     */
+    TypeId GetSplitterType() const;
+
+    /**
+     * \return the splitter that selects the RLC entity of each PDU
+     */
+    Ptr<McPdcpSplitter> GetSplitter() const;
+
+    /**
+     * Set the last SINR of the UE in the mmWave eNB, used by the splitter
+     *
+     * \param sinr the SINR, in linear units
+     */
+    void SetMmWaveSinr(double sinr);
+
   protected:
     // Interface provided to upper RRC entity
     virtual void DoTransmitPdcpSdu(Ptr<Packet> p);
@@ -212,8 +238,22 @@ class McEnbPdcp : public LtePdcp
      */
     TracedCallback<uint16_t, uint8_t, uint32_t, uint64_t> m_rxPdu;
 
+    /**
+     * Buffer status of the local RLC entity
+     *
+     * \param txQueueSize the size of the transmission and retransmission queues, in bytes
+     * \param txQueueHolDelay the head of line delay of the transmission queue, in ms
+     */
+    virtual void DoNotifyTxBufferStatus(uint32_t txQueueSize, uint16_t txQueueHolDelay);
+
     // Interface provided to EpcX2 entity
     virtual void DoReceiveMcPdcpPdu(EpcX2Sap::UeDataParams params);
+    /**
+     * Buffer status of the remote RLC entity, received over X2
+     *
+     * \param params the buffer status
+     */
+    virtual void DoReceiveRlcBufferStatus(EpcX2Sap::RlcBufferStatusParams params);
 
     EpcX2PdcpProvider* m_epcX2PdcpProvider;
     EpcX2PdcpUser* m_epcX2PdcpUser;
@@ -234,6 +274,9 @@ class McEnbPdcp : public LtePdcp
     static const uint16_t m_maxPdcpSn = 4095;
 
     bool m_useMmWaveConnection;
+
+    TypeId m_splitterType;          ///< type of the splitter
+    Ptr<McPdcpSplitter> m_splitter; ///< selects the RLC entity of each PDU
 };
 
 } // namespace ns3
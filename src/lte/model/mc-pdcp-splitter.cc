@@ -0,0 +1,368 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mc-pdcp-splitter.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("McPdcpSplitter");
+
+NS_OBJECT_ENSURE_REGISTERED(McPdcpSplitter);
+
+McPdcpSplitter::McPdcpSplitter()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto leg : {LTE_LEG, MMWAVE_LEG})
+    {
+        m_legs[leg].available = false;
+        m_legs[leg].txBytes = 0;
+        ResetLeg(leg);
+    }
+    m_legs[LTE_LEG].available = true;
+}
+
+McPdcpSplitter::~McPdcpSplitter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+McPdcpSplitter::GetTypeId(void)
+{
+    static TypeId tid =
+        TypeId("ns3::McPdcpSplitter")
+            .SetParent<Object>()
+            .SetGroupName("Lte")
+            .AddConstructor<McPdcpSplitter>()
+            .AddAttribute("DrainRateWindow",
+                          "Duration of the windows over which the drain rate of the RLC "
+                          "buffer of each leg is measured",
+                          TimeValue(MilliSeconds(10)),
+                          MakeTimeAccessor(&McPdcpSplitter::m_rateWindow),
+                          MakeTimeChecker())
+            .AddAttribute("DrainRateAlpha",
+                          "Weight of the last window in the moving average of the drain rate",
+                          DoubleValue(0.25),
+                          MakeDoubleAccessor(&McPdcpSplitter::m_rateAlpha),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddTraceSource("LegSelected",
+                            "Leg selected for the transmission of a PDU.",
+                            MakeTraceSourceAccessor(&McPdcpSplitter::m_legSelectedTrace),
+                            "ns3::McPdcpSplitter::LegSelectedTracedCallback");
+    return tid;
+}
+
+McPdcpSplitter::Leg
+McPdcpSplitter::SelectLeg(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    Leg leg;
+    if (!m_legs[MMWAVE_LEG].available)
+    {
+        leg = LTE_LEG;
+    }
+    else if (!m_legs[LTE_LEG].available)
+    {
+        leg = MMWAVE_LEG;
+    }
+    else
+    {
+        leg = DoSelectLeg(size);
+    }
+    NS_LOG_LOGIC("PDU of " << size << " bytes through leg " << leg);
+    m_legs[leg].queueBytes += size;
+    m_legs[leg].txBytes += size;
+    m_legSelectedTrace(leg, size);
+    return leg;
+}
+
+void
+McPdcpSplitter::SetLegAvailable(Leg leg, bool available)
+{
+    if (m_legs[leg].available != available)
+    {
+        NS_LOG_FUNCTION(this << leg << available);
+        m_legs[leg].available = available;
+        m_legs[LTE_LEG].txBytes = 0;
+        m_legs[MMWAVE_LEG].txBytes = 0;
+        DoResetPolicy();
+    }
+}
+
+bool
+McPdcpSplitter::IsLegAvailable(Leg leg) const
+{
+    return m_legs[leg].available;
+}
+
+void
+McPdcpSplitter::NotifyBufferStatus(Leg leg, uint32_t txQueueSize, uint16_t txQueueHolDelay)
+{
+    NS_LOG_FUNCTION(this << leg << txQueueSize << txQueueHolDelay);
+    LegState& state = m_legs[leg];
+    Time now = Simulator::Now();
+
+    // the bytes sent since the last report that are not in the buffer anymore have been drained
+    if (state.queueBytes > txQueueSize)
+    {
+        state.drainedBytes += state.queueBytes - txQueueSize;
+    }
+    if (state.windowStart.IsNegative())
+    {
+        state.windowStart = now;
+    }
+    else if (now - state.windowStart >= m_rateWindow)
+    {
+        double rate = state.drainedBytes / (now - state.windowStart).GetSeconds();
+        state.drainRate =
+            state.drainRate > 0 ? (1 - m_rateAlpha) * state.drainRate + m_rateAlpha * rate : rate;
+        state.drainedBytes = 0;
+        state.windowStart = now;
+        NS_LOG_LOGIC("Drain rate of leg " << leg << ": " << state.drainRate << " bytes/s");
+    }
+
+    state.queueBytes = txQueueSize;
+    state.holDelay = MilliSeconds(txQueueHolDelay);
+    state.lastReport = now;
+}
+
+void
+McPdcpSplitter::SetSinr(Leg leg, double sinr)
+{
+    NS_LOG_FUNCTION(this << leg << sinr);
+    m_legs[leg].sinr = sinr;
+    m_legs[leg].sinrKnown = true;
+}
+
+void
+McPdcpSplitter::ResetLeg(Leg leg)
+{
+    NS_LOG_FUNCTION(this << leg);
+    LegState& state = m_legs[leg];
+    state.queueBytes = 0;
+    state.holDelay = Seconds(0);
+    state.lastReport = Seconds(-1);
+    state.drainRate = 0;
+    state.drainedBytes = 0;
+    state.windowStart = Seconds(-1);
+    state.sinr = 0;
+    state.sinrKnown = false;
+}
+
+Time
+McPdcpSplitter::GetEstimatedDelay(Leg leg) const
+{
+    const LegState& state = m_legs[leg];
+    if (state.drainRate <= 0)
+    {
+        return Seconds(0);
+    }
+    return state.holDelay + Seconds(state.queueBytes / state.drainRate);
+}
+
+uint32_t
+McPdcpSplitter::GetQueueBytes(Leg leg) const
+{
+    return m_legs[leg].queueBytes;
+}
+
+bool
+McPdcpSplitter::UsesBufferStatus() const
+{
+    return false;
+}
+
+McPdcpSplitter::Leg
+McPdcpSplitter::DoSelectLeg(uint32_t size)
+{
+    return MMWAVE_LEG;
+}
+
+void
+McPdcpSplitter::DoResetPolicy()
+{
+}
+
+////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED(McPdcpRoundRobinSplitter);
+
+McPdcpRoundRobinSplitter::McPdcpRoundRobinSplitter()
+    : m_nextLeg(MMWAVE_LEG)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+McPdcpRoundRobinSplitter::~McPdcpRoundRobinSplitter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+McPdcpRoundRobinSplitter::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::McPdcpRoundRobinSplitter")
+                            .SetParent<McPdcpSplitter>()
+                            .SetGroupName("Lte")
+                            .AddConstructor<McPdcpRoundRobinSplitter>();
+    return tid;
+}
+
+McPdcpSplitter::Leg
+McPdcpRoundRobinSplitter::DoSelectLeg(uint32_t size)
+{
+    Leg leg = m_nextLeg;
+    m_nextLeg = (leg == LTE_LEG) ? MMWAVE_LEG : LTE_LEG;
+    return leg;
+}
+
+void
+McPdcpRoundRobinSplitter::DoResetPolicy()
+{
+    m_nextLeg = MMWAVE_LEG;
+}
+
+////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED(McPdcpWeightedSplitter);
+
+McPdcpWeightedSplitter::McPdcpWeightedSplitter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+McPdcpWeightedSplitter::~McPdcpWeightedSplitter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+McPdcpWeightedSplitter::GetTypeId(void)
+{
+    static TypeId tid =
+        TypeId("ns3::McPdcpWeightedSplitter")
+            .SetParent<McPdcpSplitter>()
+            .SetGroupName("Lte")
+            .AddConstructor<McPdcpWeightedSplitter>()
+            .AddAttribute("MmWaveWeight",
+                          "Fraction of the bytes sent through the mmWave leg",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(&McPdcpWeightedSplitter::m_mmWaveWeight),
+                          MakeDoubleChecker<double>(0.0, 1.0));
+    return tid;
+}
+
+McPdcpSplitter::Leg
+McPdcpWeightedSplitter::DoSelectLeg(uint32_t size)
+{
+    // send the PDU through the leg that keeps the split closer to the weight
+    double total = m_legs[LTE_LEG].txBytes + m_legs[MMWAVE_LEG].txBytes + size;
+    double mmWaveShare = m_mmWaveWeight * total;
+    double mmWaveError = std::abs(mmWaveShare - (m_legs[MMWAVE_LEG].txBytes + size));
+    double lteError = std::abs(mmWaveShare - m_legs[MMWAVE_LEG].txBytes);
+    return mmWaveError <= lteError ? MMWAVE_LEG : LTE_LEG;
+}
+
+////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED(McPdcpQueueDelaySplitter);
+
+McPdcpQueueDelaySplitter::McPdcpQueueDelaySplitter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+McPdcpQueueDelaySplitter::~McPdcpQueueDelaySplitter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+McPdcpQueueDelaySplitter::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::McPdcpQueueDelaySplitter")
+                            .SetParent<McPdcpSplitter>()
+                            .SetGroupName("Lte")
+                            .AddConstructor<McPdcpQueueDelaySplitter>();
+    return tid;
+}
+
+bool
+McPdcpQueueDelaySplitter::UsesBufferStatus() const
+{
+    return true;
+}
+
+McPdcpSplitter::Leg
+McPdcpQueueDelaySplitter::DoSelectLeg(uint32_t size)
+{
+    if (m_legs[LTE_LEG].drainRate > 0 && m_legs[MMWAVE_LEG].drainRate > 0)
+    {
+        return GetEstimatedDelay(LTE_LEG) < GetEstimatedDelay(MMWAVE_LEG) ? LTE_LEG : MMWAVE_LEG;
+    }
+    return m_legs[LTE_LEG].queueBytes < m_legs[MMWAVE_LEG].queueBytes ? LTE_LEG : MMWAVE_LEG;
+}
+
+////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED(McPdcpSinrSplitter);
+
+McPdcpSinrSplitter::McPdcpSinrSplitter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+McPdcpSinrSplitter::~McPdcpSinrSplitter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+McPdcpSinrSplitter::GetTypeId(void)
+{
+    static TypeId tid =
+        TypeId("ns3::McPdcpSinrSplitter")
+            .SetParent<McPdcpSplitter>()
+            .SetGroupName("Lte")
+            .AddConstructor<McPdcpSinrSplitter>()
+            .AddAttribute("SinrThreshold",
+                          "SINR of the mmWave leg below which the LTE leg is used [dB]",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&McPdcpSinrSplitter::m_sinrThreshold),
+                          MakeDoubleChecker<double>());
+    return tid;
+}
+
+McPdcpSplitter::Leg
+McPdcpSinrSplitter::DoSelectLeg(uint32_t size)
+{
+    const LegState& mmWave = m_legs[MMWAVE_LEG];
+    if (mmWave.sinrKnown && 10 * std::log10(mmWave.sinr) < m_sinrThreshold)
+    {
+        return LTE_LEG;
+    }
+    return MMWAVE_LEG;
+}
+
+} // namespace ns3
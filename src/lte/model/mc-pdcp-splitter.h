@@ -0,0 +1,256 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MC_PDCP_SPLITTER_H
+#define MC_PDCP_SPLITTER_H
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup lte
+ *
+ * Selects the RLC entity, either the LTE or the mmWave one, that each PDU of
+ * a split bearer is transmitted with, in the MC PDCP entities of the eNB and
+ * of the UE.
+ *
+ * The splitter keeps the state of each leg: whether it can be used, the last
+ * buffer status reported by its RLC entity (over X2 for the remote RLC entity
+ * of the eNB) plus the bytes sent since then, an estimate of the rate at
+ * which the RLC buffer is drained and the last SINR, if known. When only one
+ * leg is available all the PDUs are sent through it. Otherwise the choice is
+ * delegated to DoSelectLeg, which in this class always returns the mmWave
+ * leg, i.e., the bearer is switched, not split, as in the original MC setup.
+ */
+class McPdcpSplitter : public Object
+{
+  public:
+    /// The RLC entities a PDU can be transmitted with
+    enum Leg
+    {
+        LTE_LEG = 0,
+        MMWAVE_LEG = 1
+    };
+
+    McPdcpSplitter();
+    virtual ~McPdcpSplitter();
+    static TypeId GetTypeId(void);
+
+    /**
+     * Select the leg to transmit a PDU with and account for its size
+     *
+     * \param size the size of the PDU
+     * \return the selected leg
+     */
+    Leg SelectLeg(uint32_t size);
+
+    /**
+     * Set whether a leg can be used. The per-leg counters of the policies are
+     * reset when the availability of a leg changes.
+     *
+     * \param leg the leg
+     * \param available true if PDUs can be sent through the leg
+     */
+    void SetLegAvailable(Leg leg, bool available);
+
+    /**
+     * \param leg the leg
+     * \return true if PDUs can be sent through the leg
+     */
+    bool IsLegAvailable(Leg leg) const;
+
+    /**
+     * Update the buffer status of the RLC entity of a leg
+     *
+     * \param leg the leg
+     * \param txQueueSize the size of the transmission and retransmission queues, in bytes
+     * \param txQueueHolDelay the head of line delay of the transmission queue, in ms
+     */
+    void NotifyBufferStatus(Leg leg, uint32_t txQueueSize, uint16_t txQueueHolDelay);
+
+    /**
+     * Set the last SINR of a leg
+     *
+     * \param leg the leg
+     * \param sinr the SINR, in linear units
+     */
+    void SetSinr(Leg leg, double sinr);
+
+    /**
+     * Forget the buffer status and the SINR of a leg, e.g., after the RLC entity
+     * of the leg has been replaced by a handover
+     *
+     * \param leg the leg
+     */
+    void ResetLeg(Leg leg);
+
+    /**
+     * \param leg the leg
+     * \return the estimated queuing delay of a new PDU in the RLC entity of the
+     *         leg, or zero if the drain rate of the leg is not known yet
+     */
+    Time GetEstimatedDelay(Leg leg) const;
+
+    /**
+     * \param leg the leg
+     * \return the estimated number of bytes in the RLC buffer of the leg
+     */
+    uint32_t GetQueueBytes(Leg leg) const;
+
+    /**
+     * \return true if DoSelectLeg relies on the buffer status reports of the
+     *         mmWave leg
+     */
+    virtual bool UsesBufferStatus() const;
+
+    /**
+     * TracedCallback signature for the selection of a leg.
+     *
+     * \param [in] leg the selected leg
+     * \param [in] size the size of the PDU
+     */
+    typedef void (*LegSelectedTracedCallback)(uint8_t leg, uint32_t size);
+
+  protected:
+    /**
+     * Select the leg to transmit a PDU with, when both are available
+     *
+     * \param size the size of the PDU
+     * \return the selected leg
+     */
+    virtual Leg DoSelectLeg(uint32_t size);
+
+    /**
+     * Called when the availability of a leg changes, to reset the state of the policy
+     */
+    virtual void DoResetPolicy();
+
+    /// State of a leg
+    struct LegState
+    {
+        bool available;        ///< whether PDUs can be sent through the leg
+        uint32_t queueBytes;   ///< last reported buffer size plus the bytes sent since
+        Time holDelay;         ///< last reported head of line delay
+        Time lastReport;       ///< time of the last buffer status report
+        double drainRate;      ///< estimated drain rate of the buffer, in bytes/s
+        uint64_t drainedBytes; ///< bytes drained since windowStart
+        Time windowStart;      ///< start of the current rate estimation window
+        double sinr;           ///< last SINR, in linear units
+        bool sinrKnown;        ///< whether the SINR has been reported
+        uint64_t txBytes;      ///< bytes sent through the leg since the last policy reset
+    };
+
+    LegState m_legs[2]; ///< the state of the LTE and mmWave legs
+
+  private:
+    Time m_rateWindow;  ///< duration of the drain rate estimation windows
+    double m_rateAlpha; ///< weight of the last window in the drain rate estimate
+
+    /// Trace fired for each PDU with the selected leg and the size of the PDU
+    TracedCallback<uint8_t, uint32_t> m_legSelectedTrace;
+};
+
+/**
+ * \ingroup lte
+ *
+ * Alternates the two legs, one PDU each.
+ */
+class McPdcpRoundRobinSplitter : public McPdcpSplitter
+{
+  public:
+    McPdcpRoundRobinSplitter();
+    virtual ~McPdcpRoundRobinSplitter();
+    static TypeId GetTypeId(void);
+
+  protected:
+    virtual Leg DoSelectLeg(uint32_t size) override;
+    virtual void DoResetPolicy() override;
+
+  private:
+    Leg m_nextLeg; ///< the leg of the next PDU
+};
+
+/**
+ * \ingroup lte
+ *
+ * Splits the bytes of the bearer between the legs according to a fixed
+ * weight, sending each PDU through the leg that is furthest behind its share.
+ */
+class McPdcpWeightedSplitter : public McPdcpSplitter
+{
+  public:
+    McPdcpWeightedSplitter();
+    virtual ~McPdcpWeightedSplitter();
+    static TypeId GetTypeId(void);
+
+  protected:
+    virtual Leg DoSelectLeg(uint32_t size) override;
+
+  private:
+    double m_mmWaveWeight; ///< fraction of the bytes sent through the mmWave leg
+};
+
+/**
+ * \ingroup lte
+ *
+ * Sends each PDU through the leg with the smallest estimated queuing delay,
+ * computed from the RLC buffer status and drain rate of each leg. Until the
+ * drain rate of both legs is known, the leg with the shortest buffer is used.
+ * The buffer status of the mmWave leg of the eNB is only reported over X2
+ * when ns3::LteRlc::McBufferStatusInterval is not zero, McEnbPdcp aborts
+ * otherwise.
+ */
+class McPdcpQueueDelaySplitter : public McPdcpSplitter
+{
+  public:
+    McPdcpQueueDelaySplitter();
+    virtual ~McPdcpQueueDelaySplitter();
+    static TypeId GetTypeId(void);
+
+    virtual bool UsesBufferStatus() const override;
+
+  protected:
+    virtual Leg DoSelectLeg(uint32_t size) override;
+};
+
+/**
+ * \ingroup lte
+ *
+ * Sends the PDUs through the mmWave leg while its last reported SINR is above
+ * a threshold, and through the LTE leg otherwise. The mmWave leg is used
+ * until its SINR is known.
+ */
+class McPdcpSinrSplitter : public McPdcpSplitter
+{
+  public:
+    McPdcpSinrSplitter();
+    virtual ~McPdcpSinrSplitter();
+    static TypeId GetTypeId(void);
+
+  protected:
+    virtual Leg DoSelectLeg(uint32_t size) override;
+
+  private:
+    double m_sinrThreshold; ///< SINR threshold of the mmWave leg, in dB
+};
+
+} // namespace ns3
+
+#endif // MC_PDCP_SPLITTER_H
@@ -26,9 +26,13 @@
 #include "ns3/lte-pdcp-header.h"
 #include "ns3/lte-pdcp-sap.h"
 #include "ns3/lte-pdcp-tag.h"
+#include "ns3/object-factory.h"
+#include "ns3/pointer.h"
 #include "ns3/seq-ts-header.h"
 #include "ns3/simulator.h"
 
+#include <limits>
+
 namespace ns3
 {
 
@@ -37,18 +41,22 @@ NS_LOG_COMPONENT_DEFINE("McUePdcp");
 class McUePdcpSpecificLteRlcSapUser : public LteRlcSapUser
 {
   public:
-    McUePdcpSpecificLteRlcSapUser(McUePdcp* pdcp);
+    McUePdcpSpecificLteRlcSapUser(McUePdcp* pdcp, McPdcpSplitter::Leg leg);
 
     // Interface provided to lower RLC entity (implemented from LteRlcSapUser)
     virtual void ReceivePdcpPdu(Ptr<Packet> p);
+    virtual void NotifyTxBufferStatus(uint32_t txQueueSize, uint16_t txQueueHolDelay);
 
   private:
     McUePdcpSpecificLteRlcSapUser();
     McUePdcp* m_pdcp;
+    McPdcpSplitter::Leg m_leg; ///< the RLC entity this SAP is offered to
 };
 
-McUePdcpSpecificLteRlcSapUser::McUePdcpSpecificLteRlcSapUser(McUePdcp* pdcp)
-    : m_pdcp(pdcp)
+McUePdcpSpecificLteRlcSapUser::McUePdcpSpecificLteRlcSapUser(McUePdcp* pdcp,
+                                                             McPdcpSplitter::Leg leg)
+    : m_pdcp(pdcp),
+      m_leg(leg)
 {
 }
 
@@ -62,6 +70,13 @@ McUePdcpSpecificLteRlcSapUser::ReceivePdcpPdu(Ptr<Packet> p)
     m_pdcp->DoReceivePdu(p);
 }
 
+void
+McUePdcpSpecificLteRlcSapUser::NotifyTxBufferStatus(uint32_t txQueueSize,
+                                                    uint16_t txQueueHolDelay)
+{
+    m_pdcp->DoNotifyTxBufferStatus(m_leg, txQueueSize, txQueueHolDelay);
+}
+
 ///////////////////////////////////////
 
 NS_OBJECT_ENSURE_REGISTERED(McUePdcp);
@@ -69,15 +84,22 @@ NS_OBJECT_ENSURE_REGISTERED(McUePdcp);
 McUePdcp::McUePdcp()
     : m_pdcpSapUser(0),
       m_rlcSapProvider(0),
+      m_mmWaveRlcSapProvider(0),
       m_rnti(0),
       m_lcid(0),
       m_txSequenceNumber(0),
       m_rxSequenceNumber(0),
+      m_lastSubmittedCount(std::numeric_limits<uint32_t>::max()),
+      m_nextRxCount(0),
+      m_reorderingCount(0),
+      m_numHeldPdus(0),
+      m_reorderingStats(),
       m_useMmWaveConnection(false)
 {
     NS_LOG_FUNCTION(this);
     m_pdcpSapProvider = new LtePdcpSpecificLtePdcpSapProvider<McUePdcp>(this);
-    m_rlcSapUser = new McUePdcpSpecificLteRlcSapUser(this);
+    m_rlcSapUser = new McUePdcpSpecificLteRlcSapUser(this, McPdcpSplitter::LTE_LEG);
+    m_mmWaveRlcSapUser = new McUePdcpSpecificLteRlcSapUser(this, McPdcpSplitter::MMWAVE_LEG);
 }
 
 McUePdcp::~McUePdcp()
@@ -103,7 +125,36 @@ McUePdcp::GetTypeId(void)
                                           "Use LTE for uplink",
                                           BooleanValue(false),
                                           MakeBooleanAccessor(&McUePdcp::m_alwaysLteUplink),
-                                          MakeBooleanChecker());
+                                          MakeBooleanChecker())
+                            .AddAttribute("EnableReordering",
+                                          "Deliver the received PDUs in order, holding the "
+                                          "ones received out of order until the missing ones "
+                                          "are received or t-Reordering expires. Only useful "
+                                          "when the PDUs of the bearer are split between the "
+                                          "LTE and mmWave legs",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&McUePdcp::m_reordering),
+                                          MakeBooleanChecker())
+                            .AddAttribute("ReorderingTimer",
+                                          "Duration of t-Reordering",
+                                          TimeValue(MilliSeconds(100)),
+                                          MakeTimeAccessor(&McUePdcp::m_tReordering),
+                                          MakeTimeChecker())
+                            .AddAttribute("SplitterType",
+                                          "The type of the splitter that selects the LTE or "
+                                          "mmWave RLC entity of each uplink PDU. The default one "
+                                          "only switches between them.",
+                                          TypeIdValue(McPdcpSplitter::GetTypeId()),
+                                          MakeTypeIdAccessor(&McUePdcp::SetSplitterType,
+                                                             &McUePdcp::GetSplitterType),
+                                          MakeTypeIdChecker())
+                            .AddAttribute("Splitter",
+                                          "The splitter that selects the RLC entity of each "
+                                          "uplink PDU.",
+                                          TypeId::ATTR_GET,
+                                          PointerValue(),
+                                          MakePointerAccessor(&McUePdcp::m_splitter),
+                                          MakePointerChecker<McPdcpSplitter>());
     return tid;
 }
 
@@ -113,6 +164,11 @@ McUePdcp::DoDispose()
     NS_LOG_FUNCTION(this);
     delete (m_pdcpSapProvider);
     delete (m_rlcSapUser);
+    delete (m_mmWaveRlcSapUser);
+    m_splitter = 0;
+    m_reorderingTimer.Cancel();
+    m_reorderingBuffer.clear();
+    m_numHeldPdus = 0;
 }
 
 void
@@ -171,6 +227,13 @@ McUePdcp::GetLteRlcSapUser()
     return m_rlcSapUser;
 }
 
+LteRlcSapUser*
+McUePdcp::GetMmWaveRlcSapUser()
+{
+    NS_LOG_FUNCTION(this);
+    return m_mmWaveRlcSapUser;
+}
+
 McUePdcp::Status
 McUePdcp::GetStatus()
 {
@@ -219,20 +282,19 @@ McUePdcp::DoTransmitPdcpSdu(Ptr<Packet> p)
     params.pdcpPdu = p;
 
     // WARN TODO hack: always use LTE for uplink (i.e. TCP acks)
-    if (m_mmWaveRlcSapProvider == 0 || (!m_useMmWaveConnection) || m_alwaysLteUplink)
+    m_splitter->SetLegAvailable(McPdcpSplitter::MMWAVE_LEG,
+                                m_mmWaveRlcSapProvider != 0 && m_useMmWaveConnection &&
+                                    !m_alwaysLteUplink);
+    if (m_splitter->SelectLeg(p->GetSize()) == McPdcpSplitter::LTE_LEG)
     {
         NS_LOG_INFO(this << " McUePdcp: Tx packet to uplink primary stack");
         m_rlcSapProvider->TransmitPdcpPdu(params);
     }
-    else if (m_useMmWaveConnection)
+    else
     {
         NS_LOG_INFO(this << " McUePdcp: Tx packet to uplink secondary stack");
         m_mmWaveRlcSapProvider->TransmitPdcpPdu(params);
     }
-    else
-    {
-        NS_FATAL_ERROR("Invalid combination");
-    }
 }
 
 void
@@ -269,13 +331,13 @@ McUePdcp::DoReceivePdu(Ptr<Packet> p)
             m_rxSequenceNumber = 0;
         }
 
-        if (p->GetSize() > 20 + 8 + 12)
+        if (m_reordering)
+        {
+            ReorderPdu(pdcpHeader.GetSequenceNumber(), p);
+        }
+        else
         {
-            LtePdcpSapUser::ReceivePdcpSduParameters params;
-            params.pdcpSdu = p;
-            params.rnti = m_rnti;
-            params.lcid = m_lcid;
-            m_pdcpSapUser->ReceivePdcpSdu(params);
+            DeliverSdu(p);
         }
     }
     else
@@ -284,10 +346,163 @@ McUePdcp::DoReceivePdu(Ptr<Packet> p)
     }
 }
 
+void
+McUePdcp::ReorderPdu(uint16_t sn, Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << sn);
+    if (m_reorderingBuffer.empty())
+    {
+        m_reorderingBuffer.resize(m_maxPdcpSn + 1);
+    }
+
+    // PDUs more than half the SN space behind the next expected one have already
+    // been delivered or given up, see section 5.1.2.1.4 in TS 36.323
+    uint32_t expectedSn = (m_lastSubmittedCount + 1) & m_maxPdcpSn;
+    uint32_t offset = (sn + m_maxPdcpSn + 1 - expectedSn) & m_maxPdcpSn;
+    if (offset >= m_reorderingWindow || m_reorderingBuffer[sn])
+    {
+        NS_LOG_LOGIC("Discard duplicate or late PDU with SN " << sn << ", expected "
+                                                              << expectedSn);
+        m_reorderingStats.duplicatePdus++;
+        return;
+    }
+
+    uint32_t count = m_lastSubmittedCount + 1 + offset;
+    m_reorderingBuffer[sn] = p;
+    m_numHeldPdus++;
+    if (count >= m_nextRxCount)
+    {
+        m_nextRxCount = count + 1;
+    }
+
+    if (offset > 0)
+    {
+        NS_LOG_LOGIC("Hold PDU with SN " << sn << ", expected " << expectedSn);
+        m_reorderingStats.heldPdus++;
+    }
+    else
+    {
+        DeliverInOrderPdus();
+    }
+    UpdateReorderingTimer();
+}
+
+void
+McUePdcp::DeliverInOrderPdus()
+{
+    uint16_t sn = (m_lastSubmittedCount + 1) & m_maxPdcpSn;
+    while (m_reorderingBuffer[sn])
+    {
+        Ptr<Packet> p = m_reorderingBuffer[sn];
+        m_reorderingBuffer[sn] = 0;
+        m_numHeldPdus--;
+        m_lastSubmittedCount++;
+        DeliverSdu(p);
+        sn = (m_lastSubmittedCount + 1) & m_maxPdcpSn;
+    }
+}
+
+void
+McUePdcp::DeliverSdu(Ptr<Packet> p)
+{
+    if (p->GetSize() > 20 + 8 + 12)
+    {
+        LtePdcpSapUser::ReceivePdcpSduParameters params;
+        params.pdcpSdu = p;
+        params.rnti = m_rnti;
+        params.lcid = m_lcid;
+        m_pdcpSapUser->ReceivePdcpSdu(params);
+    }
+}
+
+void
+McUePdcp::UpdateReorderingTimer()
+{
+    if (m_reorderingTimer.IsRunning() &&
+        static_cast<int32_t>(m_reorderingCount - 1 - m_lastSubmittedCount) <= 0)
+    {
+        NS_LOG_LOGIC("Stop t-Reordering, missing PDUs received");
+        m_reorderingTimer.Cancel();
+    }
+    if (!m_reorderingTimer.IsRunning() && m_numHeldPdus > 0)
+    {
+        NS_LOG_LOGIC("Start t-Reordering, " << m_numHeldPdus << " PDUs held");
+        m_reorderingCount = m_nextRxCount;
+        m_reorderingTimer =
+            Simulator::Schedule(m_tReordering, &McUePdcp::ReorderingTimerExpired, this);
+    }
+}
+
+void
+McUePdcp::ReorderingTimerExpired()
+{
+    NS_LOG_FUNCTION(this << m_lastSubmittedCount << m_reorderingCount);
+    m_reorderingStats.timerExpiries++;
+
+    // give up the missing PDUs received before the timer was started
+    while (m_lastSubmittedCount + 1 < m_reorderingCount)
+    {
+        m_lastSubmittedCount++;
+        uint16_t sn = m_lastSubmittedCount & m_maxPdcpSn;
+        if (m_reorderingBuffer[sn])
+        {
+            Ptr<Packet> p = m_reorderingBuffer[sn];
+            m_reorderingBuffer[sn] = 0;
+            m_numHeldPdus--;
+            m_reorderingStats.flushedPdus++;
+            DeliverSdu(p);
+        }
+    }
+    DeliverInOrderPdus();
+    UpdateReorderingTimer();
+}
+
+McUePdcp::ReorderingStats
+McUePdcp::GetReorderingStats() const
+{
+    return m_reorderingStats;
+}
+
+uint32_t
+McUePdcp::GetNumHeldPdus() const
+{
+    return m_numHeldPdus;
+}
+
 void
 McUePdcp::SwitchConnection(bool useMmWaveConnection)
 {
     m_useMmWaveConnection = useMmWaveConnection;
 }
 
+void
+McUePdcp::SetSplitterType(TypeId type)
+{
+    NS_LOG_FUNCTION(this << type);
+    ObjectFactory factory;
+    factory.SetTypeId(type);
+    m_splitterType = type;
+    m_splitter = factory.Create<McPdcpSplitter>();
+}
+
+TypeId
+McUePdcp::GetSplitterType() const
+{
+    return m_splitterType;
+}
+
+Ptr<McPdcpSplitter>
+McUePdcp::GetSplitter() const
+{
+    return m_splitter;
+}
+
+void
+McUePdcp::DoNotifyTxBufferStatus(McPdcpSplitter::Leg leg,
+                                 uint32_t txQueueSize,
+                                 uint16_t txQueueHolDelay)
+{
+    m_splitter->NotifyBufferStatus(leg, txQueueSize, txQueueHolDelay);
+}
+
 } // namespace ns3
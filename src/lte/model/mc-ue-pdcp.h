@@ -23,12 +23,17 @@
 #ifndef MC_UE_PDCP_H
 #define MC_UE_PDCP_H
 
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traced-value.h"
 #include <ns3/lte-pdcp-sap.h>
 #include <ns3/lte-pdcp.h>
 #include <ns3/lte-rlc-sap.h>
+#include <ns3/mc-pdcp-splitter.h>
+
+#include <vector>
 
 namespace ns3
 {
@@ -37,6 +42,10 @@ namespace ns3
  * MC UE PDCP entity. It has 2 interfaces to the 2 RLC layers
  * Note: there is a single IMSI and lcid (no problem in having the same
  * in the 2 eNBs), but 2 rnti.
+ *
+ * The received PDUs are delivered as they arrive. When the PDUs of the bearer
+ * are split between the two legs, the EnableReordering attribute delivers
+ * them in order, as in section 5.1.2.1.4 of TS 36.323.
  */
 class McUePdcp : public LtePdcp
 {
@@ -105,6 +114,13 @@ class McUePdcp : public LtePdcp
      */
     void SetMmWaveRlcSapProvider(LteRlcSapProvider* s);
 
+    /**
+     *
+     *
+     * \return the RLC SAP User interface offered to the MmWave RLC by this MC_PDCP
+     */
+    LteRlcSapUser* GetMmWaveRlcSapUser();
+
     static const uint16_t MAX_PDCP_SN = 4096;
 
     /**
@@ -159,6 +175,43 @@ class McUePdcp : public LtePdcp
      */
     void SwitchConnection(bool useMmWaveConnection);
 
+    /// Counters of the reordering of the received PDUs
+    struct ReorderingStats
+    {
+        uint64_t heldPdus;      ///< PDUs received out of order and held in the window
+        uint64_t flushedPdus;   ///< held PDUs delivered at the expiry of t-Reordering
+        uint64_t duplicatePdus; ///< PDUs discarded as duplicate or outside the window
+        uint64_t timerExpiries; ///< expiries of t-Reordering
+    };
+
+    /**
+     * \return the counters of the reordering of the received PDUs
+     */
+    ReorderingStats GetReorderingStats() const;
+
+    /**
+     * \return the number of PDUs currently held in the reordering window
+     */
+    uint32_t GetNumHeldPdus() const;
+
+    /**
+     * Set the type of the splitter that selects the RLC entity, LTE or mmWave,
+     * of each uplink PDU, and create a new splitter
+     *
+     * \param type the TypeId of a subclass of McPdcpSplitter
+     */
+    void SetSplitterType(TypeId type);
+
+    /**
+     * \return the type of the splitter
+     */
+    TypeId GetSplitterType() const;
+
+    /**
+     * \return the splitter that selects the RLC entity of each uplink PDU
+     */
+    Ptr<McPdcpSplitter> GetSplitter() const;
+
   protected:
     // Interface provided to upper RRC entity
     virtual void DoTransmitPdcpSdu(Ptr<Packet> p);
@@ -169,7 +222,19 @@ class McUePdcp : public LtePdcp
     // Interface provided to lower RLC entity
     virtual void DoReceivePdu(Ptr<Packet> p);
 
+    /**
+     * Buffer status of the LTE or mmWave RLC entity
+     *
+     * \param leg the RLC entity
+     * \param txQueueSize the size of the transmission and retransmission queues, in bytes
+     * \param txQueueHolDelay the head of line delay of the transmission queue, in ms
+     */
+    virtual void DoNotifyTxBufferStatus(McPdcpSplitter::Leg leg,
+                                        uint32_t txQueueSize,
+                                        uint16_t txQueueHolDelay);
+
     LteRlcSapUser* m_rlcSapUser;
+    LteRlcSapUser* m_mmWaveRlcSapUser;
     LteRlcSapProvider* m_rlcSapProvider;
     LteRlcSapProvider* m_mmWaveRlcSapProvider;
 
@@ -200,8 +265,56 @@ class McUePdcp : public LtePdcp
      */
     static const uint16_t m_maxPdcpSn = 4095;
 
+    /**
+     * Reordering window. See section 7.2 in TS 36.323
+     */
+    static const uint16_t m_reorderingWindow = 2048;
+
+    /**
+     * Insert a received PDU in the reordering window and deliver the PDUs that are in order
+     *
+     * \param sn the sequence number of the PDU
+     * \param p the PDU, without the PDCP header
+     */
+    void ReorderPdu(uint16_t sn, Ptr<Packet> p);
+
+    /**
+     * Deliver the PDUs held in the reordering window from the one following the
+     * last delivered PDU, until the first missing one
+     */
+    void DeliverInOrderPdus();
+
+    /**
+     * Deliver a SDU to the upper layer
+     *
+     * \param p the SDU
+     */
+    void DeliverSdu(Ptr<Packet> p);
+
+    /**
+     * Start or stop t-Reordering after a change of the reordering window.
+     * See section 5.1.2.1.4 in TS 36.323
+     */
+    void UpdateReorderingTimer();
+
+    /// Deliver the held PDUs up to the COUNT that started t-Reordering, at its expiry
+    void ReorderingTimerExpired();
+
+    bool m_reordering;                           ///< whether the PDUs are delivered in order
+    Time m_tReordering;                          ///< duration of t-Reordering
+    EventId m_reorderingTimer;                   ///< t-Reordering
+    uint32_t m_lastSubmittedCount;               ///< COUNT of the last PDU delivered
+    uint32_t m_nextRxCount;                      ///< COUNT following the highest received one
+    uint32_t m_reorderingCount;                  ///< Reordering_PDCP_RX_COUNT
+    std::vector<Ptr<Packet>> m_reorderingBuffer; ///< held PDUs, indexed by SN
+    uint32_t m_numHeldPdus;                      ///< number of PDUs in m_reorderingBuffer
+    ReorderingStats m_reorderingStats;           ///< reordering counters
+
     bool m_useMmWaveConnection;
     bool m_alwaysLteUplink;
+
+    TypeId m_splitterType;          ///< type of the splitter
+    Ptr<McPdcpSplitter> m_splitter; ///< selects the RLC entity of each uplink PDU
 };
 
 } // namespace ns3
@@ -0,0 +1,313 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mc-ue-sinr-table.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("McUeSinrTable");
+
+McUeSinrTable::McUeSinrTable()
+    : m_trendWindow(0)
+{
+}
+
+void
+McUeSinrTable::SetTrendWindow(uint32_t samples)
+{
+    NS_LOG_FUNCTION(this << samples);
+    NS_ASSERT_MSG(m_rows.empty(), "The trend window must be set before any SINR");
+    m_trendWindow = samples;
+}
+
+void
+McUeSinrTable::Clear()
+{
+    m_rows.clear();
+    m_rowIndex.clear();
+    m_imsis.clear();
+    m_cells.clear();
+    m_cellColumns.clear();
+}
+
+void
+McUeSinrTable::SetSinr(uint64_t imsi, uint16_t cellId, double sinr, Time time)
+{
+    NS_LOG_FUNCTION(this << imsi << cellId << sinr << time);
+
+    if (cellId >= m_cellColumns.size())
+    {
+        m_cellColumns.resize(cellId + 1, NO_COLUMN);
+    }
+    uint32_t column = m_cellColumns[cellId];
+    if (column == NO_COLUMN)
+    {
+        column = m_cells.size();
+        m_cellColumns[cellId] = column;
+        m_cells.push_back(cellId);
+    }
+
+    auto index = m_rowIndex.emplace(imsi, m_rows.size());
+    if (index.second)
+    {
+        m_rows.push_back(UeRow{std::vector<double>(), NO_COLUMN, std::vector<SinrHistory>()});
+        m_imsis.insert(std::lower_bound(m_imsis.begin(), m_imsis.end(), imsi), imsi);
+    }
+    UeRow& row = m_rows[index.first->second];
+    if (column >= row.sinr.size())
+    {
+        row.sinr.resize(m_cells.size(), 0);
+    }
+
+    double oldSinr = row.sinr[column];
+    row.sinr[column] = sinr;
+    if (row.bestColumn == column && sinr < oldSinr)
+    {
+        // the best cell got worse, another one may be better now
+        UpdateBestColumn(row);
+    }
+    else if (row.bestColumn != column &&
+             IsBetter(sinr,
+                      column,
+                      row.bestColumn == NO_COLUMN ? 0 : row.sinr[row.bestColumn],
+                      row.bestColumn))
+    {
+        row.bestColumn = column;
+    }
+    NS_LOG_LOGIC("Best cell of imsi " << imsi << " is " << GetBestCell(imsi));
+
+    if (m_trendWindow > 0)
+    {
+        if (column >= row.history.size())
+        {
+            row.history.resize(m_cells.size(), SinrHistory{{}, 0});
+        }
+        AddSample(row.history[column], time, sinr);
+    }
+}
+
+void
+McUeSinrTable::SampleTrend(uint16_t cellId, Time time)
+{
+    NS_LOG_FUNCTION(this << cellId << time);
+
+    if (cellId >= m_cellColumns.size())
+    {
+        return;
+    }
+    uint32_t column = m_cellColumns[cellId];
+    for (UeRow& row : m_rows)
+    {
+        // the UEs without history are not reported by the cell, or have been removed
+        if (column < row.history.size() && !row.history[column].samples.empty())
+        {
+            AddSample(row.history[column], time, row.sinr[column]);
+        }
+    }
+}
+
+void
+McUeSinrTable::RemoveSinr(uint64_t imsi, uint16_t cellId)
+{
+    NS_LOG_FUNCTION(this << imsi << cellId);
+
+    auto index = m_rowIndex.find(imsi);
+    if (index == m_rowIndex.end() || cellId >= m_cellColumns.size())
+    {
+        return;
+    }
+    UeRow& row = m_rows[index->second];
+    uint32_t column = m_cellColumns[cellId];
+    if (column < row.sinr.size())
+    {
+        row.sinr[column] = 0;
+        if (row.bestColumn == column)
+        {
+            UpdateBestColumn(row);
+        }
+    }
+    if (column < row.history.size())
+    {
+        row.history[column] = SinrHistory{{}, 0};
+    }
+}
+
+const McUeSinrTable::UeRow*
+McUeSinrTable::FindRow(uint64_t imsi) const
+{
+    auto it = m_rowIndex.find(imsi);
+    return it == m_rowIndex.end() ? nullptr : &m_rows[it->second];
+}
+
+bool
+McUeSinrTable::HasUe(uint64_t imsi) const
+{
+    return FindRow(imsi) != nullptr;
+}
+
+double
+McUeSinrTable::GetSinr(uint64_t imsi, uint16_t cellId) const
+{
+    const UeRow* row = FindRow(imsi);
+    if (row == nullptr || cellId >= m_cellColumns.size())
+    {
+        return 0;
+    }
+    uint32_t column = m_cellColumns[cellId];
+    return column < row->sinr.size() ? row->sinr[column] : 0;
+}
+
+uint16_t
+McUeSinrTable::GetBestCell(uint64_t imsi) const
+{
+    const UeRow* row = FindRow(imsi);
+    if (row == nullptr || row->bestColumn == NO_COLUMN)
+    {
+        return 0;
+    }
+    return m_cells[row->bestColumn];
+}
+
+double
+McUeSinrTable::GetBestSinr(uint64_t imsi) const
+{
+    const UeRow* row = FindRow(imsi);
+    if (row == nullptr || row->bestColumn == NO_COLUMN)
+    {
+        return 0;
+    }
+    return row->sinr[row->bestColumn];
+}
+
+double
+McUeSinrTable::PredictSinrDb(uint64_t imsi, uint16_t cellId, Time time) const
+{
+    double lastSinrDb = std::max(10 * std::log10(GetSinr(imsi, cellId)), MIN_SINR_DB);
+    const UeRow* row = FindRow(imsi);
+    if (row == nullptr || cellId >= m_cellColumns.size())
+    {
+        return lastSinrDb;
+    }
+    uint32_t column = m_cellColumns[cellId];
+    if (column >= row->history.size() || row->history[column].samples.size() < 2)
+    {
+        return lastSinrDb;
+    }
+
+    // least squares line through the SINR values, in dB
+    const std::vector<std::pair<double, double>>& samples = row->history[column].samples;
+    double meanTime = 0;
+    double meanSinrDb = 0;
+    for (const auto& sample : samples)
+    {
+        meanTime += sample.first;
+        meanSinrDb += sample.second;
+    }
+    meanTime /= samples.size();
+    meanSinrDb /= samples.size();
+    double covariance = 0;
+    double variance = 0;
+    for (const auto& sample : samples)
+    {
+        covariance += (sample.first - meanTime) * (sample.second - meanSinrDb);
+        variance += (sample.first - meanTime) * (sample.first - meanTime);
+    }
+    if (variance == 0)
+    {
+        return lastSinrDb;
+    }
+    double predictedDb = meanSinrDb + covariance / variance * (time.GetSeconds() - meanTime);
+    NS_LOG_LOGIC("Imsi " << imsi << " cell " << cellId << " last SINR " << lastSinrDb
+                         << " dB predicted SINR " << predictedDb << " dB");
+    return std::max(predictedDb, MIN_SINR_DB);
+}
+
+const std::vector<uint64_t>&
+McUeSinrTable::GetUes() const
+{
+    return m_imsis;
+}
+
+const std::vector<uint16_t>&
+McUeSinrTable::GetCells() const
+{
+    return m_cells;
+}
+
+void
+McUeSinrTable::AddSample(SinrHistory& history, Time time, double sinr) const
+{
+    std::pair<double, double> sample(time.GetSeconds(),
+                                     std::max(10 * std::log10(sinr), MIN_SINR_DB));
+    if (history.samples.size() < m_trendWindow)
+    {
+        if (!history.samples.empty() && history.samples.back().first == sample.first)
+        {
+            history.samples.back() = sample;
+            return;
+        }
+        history.samples.reserve(m_trendWindow);
+        history.samples.push_back(sample);
+    }
+    else
+    {
+        uint32_t last = (history.next + m_trendWindow - 1) % m_trendWindow;
+        if (history.samples[last].first == sample.first)
+        {
+            history.samples[last] = sample;
+            return;
+        }
+        history.samples[history.next] = sample;
+        history.next = (history.next + 1) % m_trendWindow;
+    }
+}
+
+bool
+McUeSinrTable::IsBetter(double sinr, uint32_t column, double bestSinr, uint32_t bestColumn) const
+{
+    if (sinr <= 0)
+    {
+        return false;
+    }
+    if (bestColumn == NO_COLUMN || sinr > bestSinr)
+    {
+        return true;
+    }
+    return sinr == bestSinr && m_cells[column] < m_cells[bestColumn];
+}
+
+void
+McUeSinrTable::UpdateBestColumn(UeRow& row) const
+{
+    row.bestColumn = NO_COLUMN;
+    double bestSinr = 0;
+    for (uint32_t column = 0; column < row.sinr.size(); ++column)
+    {
+        if (IsBetter(row.sinr[column], column, bestSinr, row.bestColumn))
+        {
+            row.bestColumn = column;
+            bestSinr = row.sinr[column];
+        }
+    }
+}
+
+} // namespace ns3
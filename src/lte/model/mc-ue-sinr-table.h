@@ -0,0 +1,206 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MC_UE_SINR_TABLE_H
+#define MC_UE_SINR_TABLE_H
+
+#include "ns3/nstime.h"
+
+#include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup lte
+ *
+ * SINR of the UEs towards each mmWave cell, as reported to the LTE
+ * coordinator, and the best cell of each UE.
+ *
+ * The table has one row per UE, stored contiguously in the order the UEs are
+ * added and found through a hash map from the IMSI, and one column per
+ * mmWave cell. The best cell of each UE
+ * is updated with each SINR, and the SINR of the UE towards all the cells is
+ * scanned only when the SINR of its best cell decreases. The best cell is the
+ * one with the highest positive SINR, the one with the lowest cell ID among
+ * those with the same SINR. The SINR of a UE towards a cell that did not
+ * report it is zero.
+ *
+ * When a trend window is set, the table also keeps the last SINR values of
+ * each UE towards each cell, in dB, and extrapolates their trend with a least
+ * squares line, to predict the SINR of the UE a short time ahead.
+ */
+class McUeSinrTable
+{
+  public:
+    McUeSinrTable();
+
+    /// Remove all the UEs and cells
+    void Clear();
+
+    /**
+     * Set the number of SINR values of each UE and cell used to compute the
+     * SINR trend. Call it before setting any SINR.
+     *
+     * \param samples the number of SINR values, zero to disable the trend
+     */
+    void SetTrendWindow(uint32_t samples);
+
+    /**
+     * Set the SINR of a UE towards a cell, adding the UE and the cell if needed
+     *
+     * \param imsi the IMSI of the UE
+     * \param cellId the cell ID
+     * \param sinr the SINR, in linear units
+     * \param time the time of the SINR measurement
+     */
+    void SetSinr(uint64_t imsi, uint16_t cellId, double sinr, Time time);
+
+    /**
+     * Add the current SINR of each UE towards a cell to its trend, once per
+     * report of the cell, so that the trend follows the SINR values that did
+     * not change since the last report. A value set by SetSinr at the same
+     * time is not sampled twice. This is a no-op without a trend window.
+     *
+     * \param cellId the cell ID of the reporting cell
+     * \param time the time of the report
+     */
+    void SampleTrend(uint16_t cellId, Time time);
+
+    /**
+     * Forget the SINR of a UE towards a cell, and its trend, e.g., when the
+     * cell does not report the UE anymore. The SINR becomes zero.
+     *
+     * \param imsi the IMSI of the UE
+     * \param cellId the cell ID
+     */
+    void RemoveSinr(uint64_t imsi, uint16_t cellId);
+
+    /**
+     * \param imsi the IMSI of a UE
+     * \return true if a SINR of the UE has been set
+     */
+    bool HasUe(uint64_t imsi) const;
+
+    /**
+     * \param imsi the IMSI of a UE
+     * \param cellId the cell ID
+     * \return the SINR of the UE towards the cell, zero if unknown
+     */
+    double GetSinr(uint64_t imsi, uint16_t cellId) const;
+
+    /**
+     * \param imsi the IMSI of a UE
+     * \return the cell ID of the best cell of the UE, zero if no cell has a positive SINR
+     */
+    uint16_t GetBestCell(uint64_t imsi) const;
+
+    /**
+     * \param imsi the IMSI of a UE
+     * \return the SINR of the UE towards its best cell, zero if there is no best cell
+     */
+    double GetBestSinr(uint64_t imsi) const;
+
+    /**
+     * Extrapolate the SINR of a UE towards a cell from the trend of its last
+     * values. Without a trend window, or with a single value, this is the
+     * last SINR.
+     *
+     * \param imsi the IMSI of a UE
+     * \param cellId the cell ID
+     * \param time the time of the prediction
+     * \return the predicted SINR, in dB, not lower than MIN_SINR_DB
+     */
+    double PredictSinrDb(uint64_t imsi, uint16_t cellId, Time time) const;
+
+    /**
+     * \return the IMSI of the UEs in the table, in increasing order
+     */
+    const std::vector<uint64_t>& GetUes() const;
+
+    /**
+     * \return the cell IDs of the cells in the table
+     */
+    const std::vector<uint16_t>& GetCells() const;
+
+    /// SINR used for the trend of null or very low SINR values [dB]
+    static constexpr double MIN_SINR_DB = -100.0;
+
+  private:
+    /// Column of the UE rows without a best cell
+    static constexpr uint32_t NO_COLUMN = UINT32_MAX;
+
+    /// Last SINR values of a UE towards a cell, as a circular buffer
+    struct SinrHistory
+    {
+        std::vector<std::pair<double, double>> samples; ///< time [s] and SINR [dB] of each value
+        uint32_t next;                                  ///< position of the next value once full
+    };
+
+    /// SINR of a UE towards each cell
+    struct UeRow
+    {
+        std::vector<double> sinr;         ///< SINR towards each column, may be shorter than m_cells
+        uint32_t bestColumn;              ///< column of the best cell, or NO_COLUMN
+        std::vector<SinrHistory> history; ///< SINR history of each column, if trend is enabled
+    };
+
+    /**
+     * \param imsi the IMSI of a UE
+     * \return the row of the UE, or nullptr if no SINR of the UE has been set
+     */
+    const UeRow* FindRow(uint64_t imsi) const;
+
+    /**
+     * Add a SINR value to a history, replacing the last value if it has the
+     * same time
+     *
+     * \param history the history
+     * \param time the time of the value
+     * \param sinr the SINR
+     */
+    void AddSample(SinrHistory& history, Time time, double sinr) const;
+
+    /**
+     * \param sinr a SINR
+     * \param column the column of the SINR
+     * \param bestSinr the SINR of the best cell so far
+     * \param bestColumn the column of the best cell so far, or NO_COLUMN
+     * \return true if the SINR of column is better than the best one so far
+     */
+    bool IsBetter(double sinr, uint32_t column, double bestSinr, uint32_t bestColumn) const;
+
+    /**
+     * Find the best cell of a UE by scanning all its SINR values
+     *
+     * \param row the row of the UE
+     */
+    void UpdateBestColumn(UeRow& row) const;
+
+    std::vector<UeRow> m_rows;                         ///< rows of the UEs, in order of addition
+    std::unordered_map<uint64_t, uint32_t> m_rowIndex; ///< row of each UE, indexed by IMSI
+    std::vector<uint64_t> m_imsis;                     ///< IMSI of the UEs, in increasing order
+    std::vector<uint16_t> m_cells;                     ///< cell ID of each column
+    std::vector<uint32_t> m_cellColumns; ///< column of each cell, indexed by cell ID
+    uint32_t m_trendWindow;              ///< SINR values used for the trend, zero if disabled
+};
+
+} // namespace ns3
+
+#endif // MC_UE_SINR_TABLE_H
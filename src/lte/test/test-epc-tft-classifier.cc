@@ -204,6 +204,87 @@ EpcTftClassifierTestCase::DoRun(void)
     NS_TEST_ASSERT_MSG_EQ(obtainedTftId, (uint16_t)m_tftId, "bad classification of UDP packet");
 }
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case to check that the flow cache of the Tft Classifier is used
+ * for the packets of the same flow and is invalidated when TFTs are added or deleted.
+ */
+class EpcTftClassifierCacheTestCase : public TestCase
+{
+  public:
+    EpcTftClassifierCacheTestCase();
+
+  private:
+    /**
+     * Classify a downlink UDP packet
+     * \param c the EPC TFT classifier
+     * \param remotePort the remote port
+     * \returns the TFT ID
+     */
+    static uint32_t Classify(Ptr<EpcTftClassifier> c, uint16_t remotePort);
+
+    virtual void DoRun(void);
+};
+
+EpcTftClassifierCacheTestCase::EpcTftClassifierCacheTestCase()
+    : TestCase("Check the flow cache of the TFT classifier")
+{
+}
+
+uint32_t
+EpcTftClassifierCacheTestCase::Classify(Ptr<EpcTftClassifier> c, uint16_t remotePort)
+{
+    Ptr<Packet> p = Create<Packet>();
+    UdpHeader udpHeader;
+    udpHeader.SetSourcePort(remotePort);
+    udpHeader.SetDestinationPort(1234);
+    p->AddHeader(udpHeader);
+    Ipv4Header ipHeader;
+    ipHeader.SetSource(Ipv4Address("1.1.1.1"));
+    ipHeader.SetDestination(Ipv4Address("7.0.0.2"));
+    ipHeader.SetPayloadSize(8); // Full UDP header
+    ipHeader.SetProtocol(UdpL4Protocol::PROT_NUMBER);
+    p->AddHeader(ipHeader);
+    return c->Classify(p, EpcTft::DOWNLINK, Ipv4L3Protocol::PROT_NUMBER);
+}
+
+void
+EpcTftClassifierCacheTestCase::DoRun(void)
+{
+    Ptr<EpcTftClassifier> c = Create<EpcTftClassifier>();
+    c->Add(EpcTft::Default(), 1);
+
+    NS_TEST_ASSERT_MSG_EQ(Classify(c, 5000), 1, "bad classification of UDP packet");
+    NS_TEST_ASSERT_MSG_EQ(Classify(c, 5000), 1, "bad classification of cached UDP packet");
+    NS_TEST_ASSERT_MSG_EQ(c->GetCachedFlows(), 1, "flow not cached");
+    NS_TEST_ASSERT_MSG_EQ(Classify(c, 5001), 1, "bad classification of UDP packet");
+    NS_TEST_ASSERT_MSG_EQ(c->GetCachedFlows(), 2, "flow not cached");
+
+    Ptr<EpcTft> tft = Create<EpcTft>();
+    EpcTft::PacketFilter pf;
+    pf.remotePortStart = 5000;
+    pf.remotePortEnd = 5000;
+    tft->Add(pf);
+    c->Add(tft, 2);
+    NS_TEST_ASSERT_MSG_EQ(c->GetCachedFlows(), 0, "cache not cleared when adding a TFT");
+    NS_TEST_ASSERT_MSG_EQ(Classify(c, 5000), 2, "stale classification after adding a TFT");
+    NS_TEST_ASSERT_MSG_EQ(Classify(c, 5001), 1, "bad classification of UDP packet");
+
+    c->Delete(2);
+    NS_TEST_ASSERT_MSG_EQ(c->GetCachedFlows(), 0, "cache not cleared when deleting a TFT");
+    NS_TEST_ASSERT_MSG_EQ(Classify(c, 5000), 1, "stale classification after deleting a TFT");
+
+    for (uint32_t i = 0; i <= EpcTftClassifier::MAX_CACHED_FLOWS; ++i)
+    {
+        Classify(c, 10000 + i);
+    }
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(c->GetCachedFlows(),
+                                EpcTftClassifier::MAX_CACHED_FLOWS,
+                                "cache size not bounded");
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -230,6 +311,8 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite()
     // the format '0::ffff:1.2.3.4' is not supported by the Ipv6Address class
     /////////////////////////////////////////////////////////////////////////////////
 
+    AddTestCase(new EpcTftClassifierCacheTestCase(), TestCase::QUICK);
+
     for (bool useIpv6 : {false, true})
     {
         //////////////////////////
@@ -0,0 +1,533 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/epc-x2-header.h"
+#include "ns3/epc-x2.h"
+#include "ns3/epc-gtpu-header.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/log.h"
+#include "ns3/lte-enb-rrc.h"
+#include "ns3/lte-pdcp-header.h"
+#include "ns3/lte-pdcp.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TestEpcX2PduBatch");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check the coding and decoding of a batch of PDCP PDUs carried by a single
+ * X2-U message, as done when the RLC buffers are forwarded in a secondary
+ * cell handover.
+ */
+class EpcX2PduBatchTestCase : public TestCase
+{
+  public:
+    EpcX2PduBatchTestCase();
+    virtual ~EpcX2PduBatchTestCase();
+
+  private:
+    virtual void DoRun(void);
+};
+
+EpcX2PduBatchTestCase::EpcX2PduBatchTestCase()
+    : TestCase("Check X2-U PDU batch coding and decoding")
+{
+}
+
+EpcX2PduBatchTestCase::~EpcX2PduBatchTestCase()
+{
+}
+
+void
+EpcX2PduBatchTestCase::DoRun(void)
+{
+    // PDCP PDUs of different sizes, the last one across the SN wrap around
+    std::vector<uint16_t> sns = {4094, 4095, 0};
+    std::vector<uint32_t> sizes = {1400, 40, 700};
+    std::vector<Ptr<Packet>> pdus;
+    for (uint32_t i = 0; i < sns.size(); ++i)
+    {
+        Ptr<Packet> p = Create<Packet>(sizes[i]);
+        LtePdcpHeader pdcpHeader;
+        pdcpHeader.SetDcBit(LtePdcpHeader::DATA_PDU);
+        pdcpHeader.SetSequenceNumber(sns[i]);
+        p->AddHeader(pdcpHeader);
+        pdus.push_back(p);
+    }
+
+    EpcX2PduBatchHeader txHeader;
+    Ptr<Packet> message = Create<Packet>();
+    for (auto pdu : pdus)
+    {
+        txHeader.AddPdu(pdu->GetSize());
+        message->AddAtEnd(pdu);
+    }
+    message->AddHeader(txHeader);
+    NS_TEST_ASSERT_MSG_EQ(txHeader.GetSerializedSize(), 2 + 2 * pdus.size(), "Wrong header size");
+
+    EpcX2PduBatchHeader rxHeader;
+    message->RemoveHeader(rxHeader);
+    NS_TEST_ASSERT_MSG_EQ(rxHeader.GetPduSizes().size(), pdus.size(), "Wrong number of PDUs");
+
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < rxHeader.GetPduSizes().size(); ++i)
+    {
+        uint16_t size = rxHeader.GetPduSizes()[i];
+        NS_TEST_ASSERT_MSG_EQ(size, pdus[i]->GetSize(), "Wrong PDU size");
+        Ptr<Packet> pdu = message->CreateFragment(offset, size);
+        offset += size;
+        LtePdcpHeader pdcpHeader;
+        pdu->RemoveHeader(pdcpHeader);
+        NS_TEST_ASSERT_MSG_EQ(pdcpHeader.GetSequenceNumber(), sns[i], "Wrong PDU order");
+        NS_TEST_ASSERT_MSG_EQ(pdu->GetSize(), sizes[i], "Wrong PDU payload");
+    }
+    NS_TEST_ASSERT_MSG_EQ(offset, message->GetSize(), "Trailing bytes in the message");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check that EpcX2 aggregates the PDUs of a MC bearer within the aggregation
+ * window into single X2-U messages, and delivers them in order at the peer.
+ */
+class EpcX2AggregationTestCase : public TestCase, public EpcX2RlcUser, public EpcX2PdcpUser
+{
+  public:
+    EpcX2AggregationTestCase();
+    virtual ~EpcX2AggregationTestCase();
+
+    // EpcX2RlcUser
+    virtual void SendMcPdcpSdu(EpcX2Sap::UeDataParams params);
+    // EpcX2PdcpUser
+    virtual void ReceiveMcPdcpPdu(EpcX2Sap::UeDataParams params);
+    virtual void ReceiveRlcBufferStatus(EpcX2Sap::RlcBufferStatusParams params);
+
+  private:
+    virtual void DoRun(void);
+
+    /**
+     * Send PDUs of increasing size through the X2 interface
+     *
+     * \param x2 the sending X2 entity
+     * \param pdus the number of PDUs
+     * \param downlink true to send them as downlink PDUs, false as uplink
+     */
+    void SendPdus(Ptr<EpcX2> x2, uint32_t pdus, bool downlink);
+
+    /**
+     * Count the X2-U messages received by the peer
+     *
+     * \param sourceCellId the source cell
+     * \param targetCellId the target cell
+     * \param bytes the size of the message
+     * \param delay the delay of the message, in ns
+     * \param data true for X2-U messages
+     */
+    void RxMessage(uint16_t sourceCellId,
+                   uint16_t targetCellId,
+                   uint32_t bytes,
+                   uint64_t delay,
+                   bool data);
+
+    uint32_t m_messages;                  ///< X2-U messages received
+    std::vector<uint32_t> m_downlinkPdus; ///< size of the downlink PDUs received
+    std::vector<uint32_t> m_uplinkPdus;   ///< size of the uplink PDUs received
+};
+
+/// Size of the first PDU sent by the aggregation test, the others are one byte larger each
+static const uint32_t BASE_PDU_SIZE = 1000;
+/// TEID of the bearer used by the aggregation test
+static const uint32_t TEID = 7;
+
+EpcX2AggregationTestCase::EpcX2AggregationTestCase()
+    : TestCase("Check the aggregation of the PDUs of a MC bearer in X2-U messages"),
+      m_messages(0)
+{
+}
+
+EpcX2AggregationTestCase::~EpcX2AggregationTestCase()
+{
+}
+
+void
+EpcX2AggregationTestCase::SendMcPdcpSdu(EpcX2Sap::UeDataParams params)
+{
+    m_downlinkPdus.push_back(params.ueData->GetSize());
+}
+
+void
+EpcX2AggregationTestCase::ReceiveMcPdcpPdu(EpcX2Sap::UeDataParams params)
+{
+    m_uplinkPdus.push_back(params.ueData->GetSize());
+}
+
+void
+EpcX2AggregationTestCase::ReceiveRlcBufferStatus(EpcX2Sap::RlcBufferStatusParams params)
+{
+}
+
+void
+EpcX2AggregationTestCase::SendPdus(Ptr<EpcX2> x2, uint32_t pdus, bool downlink)
+{
+    for (uint32_t i = 0; i < pdus; ++i)
+    {
+        EpcX2Sap::UeDataParams params;
+        params.sourceCellId = 1;
+        params.targetCellId = 2;
+        params.gtpTeid = TEID;
+        params.ueData = Create<Packet>(BASE_PDU_SIZE + i);
+        if (downlink)
+        {
+            x2->GetEpcX2PdcpProvider()->SendMcPdcpPdu(params);
+        }
+        else
+        {
+            x2->GetEpcX2RlcProvider()->ReceiveMcPdcpSdu(params);
+        }
+    }
+}
+
+void
+EpcX2AggregationTestCase::RxMessage(uint16_t sourceCellId,
+                                    uint16_t targetCellId,
+                                    uint32_t bytes,
+                                    uint64_t delay,
+                                    bool data)
+{
+    m_messages++;
+}
+
+void
+EpcX2AggregationTestCase::DoRun(void)
+{
+    NodeContainer enbs;
+    enbs.Create(2);
+    InternetStackHelper internet;
+    internet.Install(enbs);
+    SimpleNetDeviceHelper deviceHelper;
+    NetDeviceContainer devices = deviceHelper.Install(enbs);
+    Ipv4AddressHelper addressHelper("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer addresses = addressHelper.Assign(devices);
+
+    std::vector<Ptr<EpcX2>> x2(2);
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        x2[i] = CreateObject<EpcX2>();
+        x2[i]->SetAttribute("AggregationWindow", TimeValue(MilliSeconds(1)));
+        // three PDUs and their lengths in the batch header
+        x2[i]->SetAttribute("MaxBatchSize", UintegerValue(3 * (BASE_PDU_SIZE + 2) + 3));
+        enbs.Get(i)->AggregateObject(x2[i]);
+    }
+    x2[0]->AddX2Interface(1, addresses.GetAddress(0), 2, addresses.GetAddress(1));
+    x2[1]->AddX2Interface(2, addresses.GetAddress(1), 1, addresses.GetAddress(0));
+    x2[1]->SetMcEpcX2RlcUser(TEID, this);
+    x2[1]->SetMcEpcX2PdcpUser(TEID, this);
+    x2[1]->TraceConnectWithoutContext("RxPDU",
+                                      MakeCallback(&EpcX2AggregationTestCase::RxMessage, this));
+
+    // the first three downlink PDUs fill a batch, the other two are sent at the
+    // end of the window; the uplink PDU is sent alone
+    Simulator::Schedule(MilliSeconds(10),
+                        &EpcX2AggregationTestCase::SendPdus,
+                        this,
+                        x2[0],
+                        5,
+                        true);
+    Simulator::Schedule(MilliSeconds(20),
+                        &EpcX2AggregationTestCase::SendPdus,
+                        this,
+                        x2[0],
+                        1,
+                        false);
+    Simulator::Stop(MilliSeconds(50));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_messages, 3, "Wrong number of X2-U messages");
+    NS_TEST_ASSERT_MSG_EQ(m_downlinkPdus.size(), 5, "Wrong number of downlink PDUs");
+    for (uint32_t i = 0; i < m_downlinkPdus.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_downlinkPdus[i], BASE_PDU_SIZE + i, "Wrong downlink PDU");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_uplinkPdus.size(), 1, "Wrong number of uplink PDUs");
+    NS_TEST_ASSERT_MSG_EQ(m_uplinkPdus[0], BASE_PDU_SIZE, "Wrong uplink PDU");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check that the PDUs forwarded in a secondary cell handover are sorted by
+ * PDCP sequence number across the wrap around, and that the duplicates are
+ * dropped.
+ */
+class EpcX2ForwardedPduSortTestCase : public TestCase
+{
+  public:
+    EpcX2ForwardedPduSortTestCase();
+    virtual ~EpcX2ForwardedPduSortTestCase();
+
+  private:
+    virtual void DoRun(void);
+};
+
+EpcX2ForwardedPduSortTestCase::EpcX2ForwardedPduSortTestCase()
+    : TestCase("Check the sorting of the PDUs forwarded in a secondary cell handover")
+{
+}
+
+EpcX2ForwardedPduSortTestCase::~EpcX2ForwardedPduSortTestCase()
+{
+}
+
+void
+EpcX2ForwardedPduSortTestCase::DoRun(void)
+{
+    // the PDUs re-added from the txed buffer follow the ones of the tx buffer;
+    // the payload size tells the copies apart
+    uint32_t snModulus = LtePdcp::GetSnModulus();
+    NS_TEST_ASSERT_MSG_EQ(snModulus, 4096, "Wrong PDCP SN length");
+    std::vector<uint16_t> sns = {4094, 1, 4095, 0, 1, 4094, 2};
+    std::vector<Ptr<Packet>> pdus;
+    for (uint32_t i = 0; i < sns.size(); ++i)
+    {
+        Ptr<Packet> p = Create<Packet>(100 + i);
+        LtePdcpHeader pdcpHeader;
+        pdcpHeader.SetDcBit(LtePdcpHeader::DATA_PDU);
+        pdcpHeader.SetSequenceNumber(sns[i]);
+        p->AddHeader(pdcpHeader);
+        pdus.push_back(p);
+    }
+
+    UeManager::SortForwardedPdus(pdus, snModulus);
+
+    std::vector<uint16_t> sortedSns = {4094, 4095, 0, 1, 2};
+    std::vector<uint32_t> sortedSizes = {100, 102, 103, 101, 106};
+    NS_TEST_ASSERT_MSG_EQ(pdus.size(), sortedSns.size(), "Duplicates not dropped");
+    for (uint32_t i = 0; i < pdus.size(); ++i)
+    {
+        LtePdcpHeader pdcpHeader;
+        pdus[i]->RemoveHeader(pdcpHeader);
+        NS_TEST_ASSERT_MSG_EQ(pdcpHeader.GetSequenceNumber(), sortedSns[i], "Wrong PDU order");
+        NS_TEST_ASSERT_MSG_EQ(pdus[i]->GetSize(), sortedSizes[i], "Wrong copy of a duplicate");
+    }
+
+    // a shorter SN space wraps earlier
+    pdus.clear();
+    for (uint16_t sn : {30, 1, 31, 0})
+    {
+        Ptr<Packet> p = Create<Packet>(10);
+        LtePdcpHeader pdcpHeader;
+        pdcpHeader.SetSequenceNumber(sn);
+        p->AddHeader(pdcpHeader);
+        pdus.push_back(p);
+    }
+    UeManager::SortForwardedPdus(pdus, 32);
+    sortedSns = {30, 31, 0, 1};
+    for (uint32_t i = 0; i < pdus.size(); ++i)
+    {
+        LtePdcpHeader pdcpHeader;
+        pdus[i]->PeekHeader(pdcpHeader);
+        NS_TEST_ASSERT_MSG_EQ(pdcpHeader.GetSequenceNumber(), sortedSns[i], "Wrong PDU order");
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check that EpcX2 splits the RLC buffers forwarded in a secondary cell
+ * handover into X2-U messages of at most MaxBatchSize bytes, and delivers
+ * the PDUs in order at the peer.
+ */
+class EpcX2ForwardRlcBufferTestCase : public TestCase, public EpcX2RlcUser
+{
+  public:
+    EpcX2ForwardRlcBufferTestCase();
+    virtual ~EpcX2ForwardRlcBufferTestCase();
+
+    // EpcX2RlcUser
+    virtual void SendMcPdcpSdu(EpcX2Sap::UeDataParams params);
+
+  private:
+    virtual void DoRun(void);
+
+    /**
+     * Forward a RLC buffer and check the X2-U messages and the PDUs received
+     *
+     * \param maxBatchSize the MaxBatchSize of the X2 entities
+     * \param sizes the sizes of the PDUs
+     * \param messages the expected number of X2-U messages
+     */
+    void CheckForwarding(uint32_t maxBatchSize, std::vector<uint32_t> sizes, uint32_t messages);
+
+    /**
+     * Record the size of the X2-U messages received by the peer
+     *
+     * \param sourceCellId the source cell
+     * \param targetCellId the target cell
+     * \param bytes the size of the message
+     * \param delay the delay of the message, in ns
+     * \param data true for X2-U messages
+     */
+    void RxMessage(uint16_t sourceCellId,
+                   uint16_t targetCellId,
+                   uint32_t bytes,
+                   uint64_t delay,
+                   bool data);
+
+    std::vector<uint32_t> m_messages; ///< size of the X2-U messages received
+    std::vector<uint32_t> m_pdus;     ///< size of the PDUs received
+};
+
+EpcX2ForwardRlcBufferTestCase::EpcX2ForwardRlcBufferTestCase()
+    : TestCase("Check the X2-U messages of the RLC buffers forwarded in a secondary cell handover")
+{
+}
+
+EpcX2ForwardRlcBufferTestCase::~EpcX2ForwardRlcBufferTestCase()
+{
+}
+
+void
+EpcX2ForwardRlcBufferTestCase::SendMcPdcpSdu(EpcX2Sap::UeDataParams params)
+{
+    m_pdus.push_back(params.ueData->GetSize());
+}
+
+void
+EpcX2ForwardRlcBufferTestCase::RxMessage(uint16_t sourceCellId,
+                                         uint16_t targetCellId,
+                                         uint32_t bytes,
+                                         uint64_t delay,
+                                         bool data)
+{
+    m_messages.push_back(bytes);
+}
+
+void
+EpcX2ForwardRlcBufferTestCase::CheckForwarding(uint32_t maxBatchSize,
+                                               std::vector<uint32_t> sizes,
+                                               uint32_t messages)
+{
+    m_messages.clear();
+    m_pdus.clear();
+
+    NodeContainer enbs;
+    enbs.Create(2);
+    InternetStackHelper internet;
+    internet.Install(enbs);
+    SimpleNetDeviceHelper deviceHelper;
+    NetDeviceContainer devices = deviceHelper.Install(enbs);
+    Ipv4AddressHelper addressHelper("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer addresses = addressHelper.Assign(devices);
+    // the fragments of the large messages would overflow the ARP pending queue
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    std::vector<Ptr<EpcX2>> x2(2);
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        x2[i] = CreateObject<EpcX2>();
+        x2[i]->SetAttribute("MaxBatchSize", UintegerValue(maxBatchSize));
+        enbs.Get(i)->AggregateObject(x2[i]);
+    }
+    x2[0]->AddX2Interface(1, addresses.GetAddress(0), 2, addresses.GetAddress(1));
+    x2[1]->AddX2Interface(2, addresses.GetAddress(1), 1, addresses.GetAddress(0));
+    x2[1]->SetMcEpcX2RlcUser(TEID, this);
+    x2[1]->TraceConnectWithoutContext(
+        "RxPDU",
+        MakeCallback(&EpcX2ForwardRlcBufferTestCase::RxMessage, this));
+
+    EpcX2Sap::UeDataBatchParams params;
+    params.sourceCellId = 1;
+    params.targetCellId = 2;
+    params.gtpTeid = TEID;
+    for (auto size : sizes)
+    {
+        params.ueData.push_back(Create<Packet>(size));
+    }
+    Simulator::Schedule(MilliSeconds(10),
+                        &EpcX2SapProvider::ForwardRlcBuffer,
+                        x2[0]->GetEpcX2SapProvider(),
+                        params);
+    Simulator::Stop(MilliSeconds(50));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_messages.size(), messages, "Wrong number of X2-U messages");
+    // the GTP-U header and the PDU count are not part of the batch size, and
+    // a larger PDU is sent alone
+    uint32_t maxPduSize = *std::max_element(sizes.begin(), sizes.end());
+    uint32_t maxMessageSize =
+        std::max(maxBatchSize, maxPduSize + 2) + GtpuHeader().GetSerializedSize() + 2;
+    for (auto bytes : m_messages)
+    {
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(bytes, maxMessageSize, "X2-U message too large");
+    }
+    NS_TEST_ASSERT_MSG_EQ((m_pdus == sizes), true, "PDUs lost or reordered");
+
+    Simulator::Destroy();
+}
+
+void
+EpcX2ForwardRlcBufferTestCase::DoRun(void)
+{
+    // two PDUs per message, the one larger than MaxBatchSize alone
+    CheckForwarding(2500, {1000, 1001, 3000, 1002, 1003, 1004}, 4);
+
+    // the lengths in the batch header count towards the size, so that a
+    // message of small PDUs fits in a UDP datagram: 21666 PDUs per message
+    CheckForwarding(65000, std::vector<uint32_t>(40000, 1), 2);
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * X2-U PDU batch test suite.
+ */
+class EpcX2PduBatchTestSuite : public TestSuite
+{
+  public:
+    EpcX2PduBatchTestSuite();
+};
+
+static EpcX2PduBatchTestSuite g_epcX2PduBatchTestSuite;
+
+EpcX2PduBatchTestSuite::EpcX2PduBatchTestSuite()
+    : TestSuite("epc-x2-pdu-batch", UNIT)
+{
+    AddTestCase(new EpcX2PduBatchTestCase, TestCase::QUICK);
+    AddTestCase(new EpcX2AggregationTestCase, TestCase::QUICK);
+    AddTestCase(new EpcX2ForwardedPduSortTestCase, TestCase::QUICK);
+    AddTestCase(new EpcX2ForwardRlcBufferTestCase, TestCase::QUICK);
+}
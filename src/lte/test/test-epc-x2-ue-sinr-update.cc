@@ -0,0 +1,272 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/epc-x2-header.h"
+#include "ns3/epc-x2-sap.h"
+#include "ns3/log.h"
+#include "ns3/lte-enb-rrc.h"
+#include "ns3/mc-ue-sinr-table.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TestEpcX2UeSinrUpdate");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check the coding and decoding of the UE SINR updates sent by the mmWave
+ * cells to the LTE coordinator.
+ */
+class EpcX2UeSinrUpdateTestCase : public TestCase
+{
+  public:
+    EpcX2UeSinrUpdateTestCase();
+    virtual ~EpcX2UeSinrUpdateTestCase();
+
+  private:
+    virtual void DoRun(void);
+};
+
+EpcX2UeSinrUpdateTestCase::EpcX2UeSinrUpdateTestCase()
+    : TestCase("Check X2 UE SINR update coding and decoding")
+{
+}
+
+EpcX2UeSinrUpdateTestCase::~EpcX2UeSinrUpdateTestCase()
+{
+}
+
+void
+EpcX2UeSinrUpdateTestCase::DoRun(void)
+{
+    // close IMSIs, a large gap, a null SINR and values out of the coded range
+    std::vector<EpcX2Sap::UeSinrItem> list = {{1, 100.0},
+                                              {2, 0.5},
+                                              {3, 0.0},
+                                              {1000000, 1e-40},
+                                              {1000001, 1e40}};
+    EpcX2UeImsiSinrUpdateHeader txHeader;
+    txHeader.SetSourceCellId(5);
+    txHeader.SetFullReport(false);
+    txHeader.SetUeSinrList(list);
+
+    // 3 bytes per UE, plus 2 for the IMSI gap of 999997 that needs 3 bytes
+    NS_TEST_ASSERT_MSG_EQ(txHeader.GetSerializedSize(),
+                          2 + 1 + 2 + 3 * list.size() + 2,
+                          "Wrong header size");
+
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(txHeader);
+    NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), txHeader.GetSerializedSize(), "Wrong packet size");
+
+    EpcX2UeImsiSinrUpdateHeader rxHeader;
+    packet->RemoveHeader(rxHeader);
+    NS_TEST_ASSERT_MSG_EQ(rxHeader.GetSourceCellId(), 5, "Wrong source cell");
+    NS_TEST_ASSERT_MSG_EQ(rxHeader.IsFullReport(), false, "Wrong full report flag");
+    NS_TEST_ASSERT_MSG_EQ(rxHeader.GetSerializedSize(),
+                          txHeader.GetSerializedSize(),
+                          "Wrong deserialized size");
+
+    const std::vector<EpcX2Sap::UeSinrItem>& rxList = rxHeader.GetUeSinrList();
+    NS_TEST_ASSERT_MSG_EQ(rxList.size(), list.size(), "Wrong number of UEs");
+    double maxErrorDb = EpcX2UeImsiSinrUpdateHeader::SINR_RESOLUTION_DB / 2 + 1e-9;
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(rxList[i].imsi, list[i].imsi, "Wrong IMSI");
+        NS_TEST_ASSERT_MSG_EQ_TOL(10 * std::log10(rxList[i].sinr),
+                                  10 * std::log10(list[i].sinr),
+                                  maxErrorDb,
+                                  "SINR not within the quantization error");
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxList[2].sinr, 0.0, "Null SINR not preserved");
+    NS_TEST_ASSERT_MSG_EQ(rxList[3].imsi, 1000000, "Wrong IMSI after a large gap");
+    NS_TEST_ASSERT_MSG_GT(rxList[3].sinr, 0.0, "Low SINR decoded as null");
+    NS_TEST_ASSERT_MSG_LT(rxList[3].sinr, 1e-30, "Low SINR not saturated");
+    NS_TEST_ASSERT_MSG_EQ(rxList[4].imsi, 1000001, "Wrong IMSI");
+    NS_TEST_ASSERT_MSG_GT(rxList[4].sinr, 1e30, "High SINR not saturated");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check that the LTE coordinator keeps the SINR of the UEs missing from a
+ * delta report, and forgets the SINR of the UEs missing from a full report.
+ * The NotifyMmWaveSinr trace reports each UE of the cell at every update.
+ */
+class EpcX2UeSinrFullReportTestCase : public TestCase
+{
+  public:
+    EpcX2UeSinrFullReportTestCase();
+    virtual ~EpcX2UeSinrFullReportTestCase();
+
+  private:
+    virtual void DoRun(void);
+
+    /**
+     * Deliver a UE SINR update to the coordinator
+     *
+     * \param rrc the RRC of the coordinator
+     * \param sourceCellId the mmWave cell sending the update
+     * \param fullReport whether the update is a full report
+     * \param list the SINR of the UEs in the update
+     */
+    void RecvUpdate(Ptr<LteEnbRrc> rrc,
+                    uint16_t sourceCellId,
+                    bool fullReport,
+                    std::vector<EpcX2Sap::UeSinrItem> list);
+
+    /**
+     * Sink of the NotifyMmWaveSinr trace of the coordinator
+     *
+     * \param imsi the IMSI of the UE
+     * \param cellId the mmWave cell
+     * \param sinr the SINR of the UE
+     */
+    void NotifyMmWaveSinr(uint64_t imsi, uint16_t cellId, long double sinr);
+
+    /**
+     * Check the SINR traced since the last check
+     *
+     * \param cellId the mmWave cell expected in the trace
+     * \param expected the expected SINR of the UEs, in increasing IMSI order
+     */
+    void CheckTraced(uint16_t cellId, std::vector<EpcX2Sap::UeSinrItem> expected);
+
+    std::vector<EpcX2Sap::UeSinrItem> m_traced; //!< SINR traced since the last check
+    std::vector<uint16_t> m_tracedCellIds;      //!< cells traced since the last check
+};
+
+EpcX2UeSinrFullReportTestCase::EpcX2UeSinrFullReportTestCase()
+    : TestCase("Check the expiry of the UE SINR missing from a full report")
+{
+}
+
+EpcX2UeSinrFullReportTestCase::~EpcX2UeSinrFullReportTestCase()
+{
+}
+
+void
+EpcX2UeSinrFullReportTestCase::RecvUpdate(Ptr<LteEnbRrc> rrc,
+                                          uint16_t sourceCellId,
+                                          bool fullReport,
+                                          std::vector<EpcX2Sap::UeSinrItem> list)
+{
+    EpcX2SapUser::UeImsiSinrParams params;
+    params.sourceCellId = sourceCellId;
+    params.fullReport = fullReport;
+    params.ueSinrList = list;
+    rrc->GetEpcX2SapUser()->RecvUeSinrUpdate(params);
+}
+
+void
+EpcX2UeSinrFullReportTestCase::NotifyMmWaveSinr(uint64_t imsi, uint16_t cellId, long double sinr)
+{
+    m_traced.push_back({imsi, static_cast<double>(sinr)});
+    m_tracedCellIds.push_back(cellId);
+}
+
+void
+EpcX2UeSinrFullReportTestCase::CheckTraced(uint16_t cellId,
+                                           std::vector<EpcX2Sap::UeSinrItem> expected)
+{
+    NS_TEST_ASSERT_MSG_EQ(m_traced.size(), expected.size(), "Wrong number of traced UEs");
+    for (uint32_t i = 0; i < std::min(m_traced.size(), expected.size()); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_tracedCellIds[i], cellId, "Wrong traced cell");
+        NS_TEST_ASSERT_MSG_EQ(m_traced[i].imsi, expected[i].imsi, "Wrong traced IMSI");
+        NS_TEST_ASSERT_MSG_EQ(m_traced[i].sinr, expected[i].sinr, "Wrong traced SINR");
+    }
+    m_traced.clear();
+    m_tracedCellIds.clear();
+}
+
+void
+EpcX2UeSinrFullReportTestCase::DoRun(void)
+{
+    Ptr<LteEnbRrc> rrc = CreateObject<LteEnbRrc>();
+    const McUeSinrTable& table = rrc->GetUeSinrTable();
+    rrc->TraceConnectWithoutContext(
+        "NotifyMmWaveSinr",
+        MakeCallback(&EpcX2UeSinrFullReportTestCase::NotifyMmWaveSinr, this));
+
+    RecvUpdate(rrc, 5, true, {{1, 10.0}, {2, 20.0}});
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(1, 5), 10.0, "Wrong SINR of IMSI 1");
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(2, 5), 20.0, "Wrong SINR of IMSI 2");
+    CheckTraced(5, {{1, 10.0}, {2, 20.0}});
+
+    // a delta report only carries the changed SINR, the trace reports all the UEs
+    RecvUpdate(rrc, 5, false, {{1, 12.0}});
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(1, 5), 12.0, "Delta report not applied");
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(2, 5), 20.0, "SINR missing from a delta report lost");
+    CheckTraced(5, {{1, 12.0}, {2, 20.0}});
+
+    // a full report of another cell does not touch the SINR towards cell 5
+    RecvUpdate(rrc, 6, true, {{2, 30.0}});
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(1, 5), 12.0, "SINR towards another cell lost");
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(2, 5), 20.0, "SINR towards another cell lost");
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(2, 6), 30.0, "Wrong SINR of IMSI 2");
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(2), 6, "Wrong best cell of IMSI 2");
+    CheckTraced(6, {{2, 30.0}});
+
+    // IMSI 2 is not seen by cell 5 anymore
+    RecvUpdate(rrc, 5, true, {{1, 12.0}});
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(1, 5), 12.0, "Wrong SINR of IMSI 1");
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(2, 5), 0.0, "SINR missing from a full report kept");
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(2, 6), 30.0, "Wrong SINR of IMSI 2");
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(1), 5, "Wrong best cell of IMSI 1");
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(2), 6, "Wrong best cell of IMSI 2");
+    CheckTraced(5, {{1, 12.0}});
+
+    // IMSI 1 is not seen by any cell anymore
+    RecvUpdate(rrc, 5, true, {});
+    CheckTraced(5, {});
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(1, 5), 0.0, "SINR missing from a full report kept");
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(1), 0, "Best cell of an unseen UE");
+
+    rrc->Dispose();
+    rrc = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * X2 UE SINR update test suite.
+ */
+class EpcX2UeSinrUpdateTestSuite : public TestSuite
+{
+  public:
+    EpcX2UeSinrUpdateTestSuite();
+};
+
+static EpcX2UeSinrUpdateTestSuite g_epcX2UeSinrUpdateTestSuite;
+
+EpcX2UeSinrUpdateTestSuite::EpcX2UeSinrUpdateTestSuite()
+    : TestSuite("epc-x2-ue-sinr-update", UNIT)
+{
+    AddTestCase(new EpcX2UeSinrUpdateTestCase, TestCase::QUICK);
+    AddTestCase(new EpcX2UeSinrFullReportTestCase, TestCase::QUICK);
+}
@@ -0,0 +1,205 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/mc-enb-pdcp.h"
+#include "ns3/mc-pdcp-splitter.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TestMcPdcpSplitter");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test the leg selection of the split-bearer PDCP splitters.
+ */
+class McPdcpSplitterTestCase : public TestCase
+{
+  public:
+    McPdcpSplitterTestCase();
+    virtual ~McPdcpSplitterTestCase();
+
+  private:
+    virtual void DoRun(void);
+
+    /// Check that only the LTE leg is used while the mmWave leg is unavailable
+    void CheckFallback();
+    /// Check that the round robin splitter alternates the legs
+    void CheckRoundRobin();
+    /// Check that the weighted splitter follows its weight
+    void CheckWeighted();
+    /// Check that the queue delay splitter picks the shortest queue
+    void CheckQueueDelay();
+    /// Check that the SINR splitter moves to LTE below its threshold
+    void CheckSinr();
+};
+
+McPdcpSplitterTestCase::McPdcpSplitterTestCase()
+    : TestCase("Leg selection of the MC PDCP splitters")
+{
+}
+
+McPdcpSplitterTestCase::~McPdcpSplitterTestCase()
+{
+}
+
+void
+McPdcpSplitterTestCase::CheckFallback()
+{
+    Ptr<McPdcpSplitter> splitter = CreateObject<McPdcpRoundRobinSplitter>();
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(splitter->SelectLeg(100),
+                              McPdcpSplitter::LTE_LEG,
+                              "PDU sent through an unavailable leg");
+    }
+
+    // the default splitter switches the whole bearer to the mmWave leg
+    Ptr<McPdcpSplitter> switcher = CreateObject<McPdcpSplitter>();
+    switcher->SetLegAvailable(McPdcpSplitter::MMWAVE_LEG, true);
+    NS_TEST_ASSERT_MSG_EQ(switcher->SelectLeg(100),
+                          McPdcpSplitter::MMWAVE_LEG,
+                          "Bearer not switched to the mmWave leg");
+    switcher->SetLegAvailable(McPdcpSplitter::MMWAVE_LEG, false);
+    NS_TEST_ASSERT_MSG_EQ(switcher->SelectLeg(100),
+                          McPdcpSplitter::LTE_LEG,
+                          "Bearer not switched back to the LTE leg");
+}
+
+void
+McPdcpSplitterTestCase::CheckRoundRobin()
+{
+    Ptr<McPdcpSplitter> splitter = CreateObject<McPdcpRoundRobinSplitter>();
+    splitter->SetLegAvailable(McPdcpSplitter::MMWAVE_LEG, true);
+    McPdcpSplitter::Leg last = splitter->SelectLeg(100);
+    for (uint32_t i = 0; i < 9; ++i)
+    {
+        McPdcpSplitter::Leg leg = splitter->SelectLeg(100);
+        NS_TEST_ASSERT_MSG_NE(leg, last, "Round robin splitter used the same leg twice");
+        last = leg;
+    }
+}
+
+void
+McPdcpSplitterTestCase::CheckWeighted()
+{
+    Ptr<McPdcpSplitter> splitter = CreateObject<McPdcpWeightedSplitter>();
+    splitter->SetAttribute("MmWaveWeight", DoubleValue(0.75));
+    splitter->SetLegAvailable(McPdcpSplitter::MMWAVE_LEG, true);
+    uint32_t mmWavePdus = 0;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        if (splitter->SelectLeg(1000) == McPdcpSplitter::MMWAVE_LEG)
+        {
+            mmWavePdus++;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(mmWavePdus, 75, "Split does not follow the weight");
+}
+
+void
+McPdcpSplitterTestCase::CheckQueueDelay()
+{
+    // the eNB only accepts the splitter if the remote RLC reports its buffer
+    Config::SetDefault("ns3::LteRlc::McBufferStatusInterval", TimeValue(MilliSeconds(5)));
+    Ptr<McEnbPdcp> pdcp = CreateObject<McEnbPdcp>();
+    pdcp->SetAttribute("SplitterType", TypeIdValue(McPdcpQueueDelaySplitter::GetTypeId()));
+    NS_TEST_ASSERT_MSG_EQ(pdcp->GetSplitter()->UsesBufferStatus(),
+                          true,
+                          "Buffer status not needed by the queue delay splitter");
+    Config::SetDefault("ns3::LteRlc::McBufferStatusInterval", TimeValue(Seconds(0)));
+
+    Ptr<McPdcpSplitter> splitter = CreateObject<McPdcpQueueDelaySplitter>();
+    splitter->SetLegAvailable(McPdcpSplitter::MMWAVE_LEG, true);
+    splitter->NotifyBufferStatus(McPdcpSplitter::LTE_LEG, 1000, 10);
+    splitter->NotifyBufferStatus(McPdcpSplitter::MMWAVE_LEG, 100, 1);
+    NS_TEST_ASSERT_MSG_EQ(splitter->SelectLeg(500),
+                          McPdcpSplitter::MMWAVE_LEG,
+                          "Longest queue selected");
+    NS_TEST_ASSERT_MSG_EQ(splitter->GetQueueBytes(McPdcpSplitter::MMWAVE_LEG),
+                          600,
+                          "PDU not accounted in the queue of the leg");
+    NS_TEST_ASSERT_MSG_EQ(splitter->SelectLeg(500),
+                          McPdcpSplitter::MMWAVE_LEG,
+                          "Longest queue selected");
+    NS_TEST_ASSERT_MSG_EQ(splitter->SelectLeg(500),
+                          McPdcpSplitter::LTE_LEG,
+                          "Longest queue selected");
+}
+
+void
+McPdcpSplitterTestCase::CheckSinr()
+{
+    Ptr<McPdcpSplitter> splitter = CreateObject<McPdcpSinrSplitter>();
+    splitter->SetAttribute("SinrThreshold", DoubleValue(3.0));
+    splitter->SetLegAvailable(McPdcpSplitter::MMWAVE_LEG, true);
+    NS_TEST_ASSERT_MSG_EQ(splitter->SelectLeg(100),
+                          McPdcpSplitter::MMWAVE_LEG,
+                          "mmWave leg not used before the SINR is known");
+    splitter->SetSinr(McPdcpSplitter::MMWAVE_LEG, 1.0); // 0 dB
+    NS_TEST_ASSERT_MSG_EQ(splitter->SelectLeg(100),
+                          McPdcpSplitter::LTE_LEG,
+                          "mmWave leg used below the SINR threshold");
+    splitter->SetSinr(McPdcpSplitter::MMWAVE_LEG, 10.0); // 10 dB
+    NS_TEST_ASSERT_MSG_EQ(splitter->SelectLeg(100),
+                          McPdcpSplitter::MMWAVE_LEG,
+                          "mmWave leg not used above the SINR threshold");
+    splitter->ResetLeg(McPdcpSplitter::MMWAVE_LEG);
+    splitter->SetSinr(McPdcpSplitter::MMWAVE_LEG, 0.5);
+    splitter->SetLegAvailable(McPdcpSplitter::LTE_LEG, false);
+    NS_TEST_ASSERT_MSG_EQ(splitter->SelectLeg(100),
+                          McPdcpSplitter::MMWAVE_LEG,
+                          "Unavailable LTE leg used");
+}
+
+void
+McPdcpSplitterTestCase::DoRun(void)
+{
+    CheckFallback();
+    CheckRoundRobin();
+    CheckWeighted();
+    CheckQueueDelay();
+    CheckSinr();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * MC PDCP splitter test suite.
+ */
+class McPdcpSplitterTestSuite : public TestSuite
+{
+  public:
+    McPdcpSplitterTestSuite();
+};
+
+static McPdcpSplitterTestSuite g_mcPdcpSplitterTestSuite;
+
+McPdcpSplitterTestSuite::McPdcpSplitterTestSuite()
+    : TestSuite("mc-pdcp-splitter", UNIT)
+{
+    NS_LOG_FUNCTION(this);
+    AddTestCase(new McPdcpSplitterTestCase, TestCase::QUICK);
+}
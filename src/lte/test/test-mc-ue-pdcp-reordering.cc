@@ -0,0 +1,258 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/lte-pdcp-header.h"
+#include "ns3/lte-pdcp-sap.h"
+#include "ns3/mc-ue-pdcp.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TestMcUePdcpReordering");
+
+/// Size of the payload of the PDU with SN 0, the one of the others is increased by the SN
+static const uint32_t BASE_SDU_SIZE = 100;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test the in-order delivery of the PDUs received by the MC UE PDCP from the
+ * LTE and mmWave RLC entities, and the expiry of t-Reordering.
+ */
+class McUePdcpReorderingTestCase : public TestCase, public LtePdcpSapUser
+{
+  public:
+    McUePdcpReorderingTestCase();
+    virtual ~McUePdcpReorderingTestCase();
+
+    // LtePdcpSapUser
+    virtual void ReceivePdcpSdu(ReceivePdcpSduParameters params);
+
+  private:
+    virtual void DoRun(void);
+
+    /**
+     * Send a PDU to the PDCP through one of its RLC SAPs
+     *
+     * \param sn the sequence number of the PDU
+     * \param mmWave true to use the SAP of the mmWave RLC entity
+     */
+    void ReceivePdu(uint16_t sn, bool mmWave);
+
+    /**
+     * Check the PDUs delivered and held so far
+     *
+     * \param delivered the expected number of delivered SDUs
+     * \param held the expected number of held PDUs
+     */
+    void CheckDelivered(uint32_t delivered, uint32_t held);
+
+    Ptr<McUePdcp> m_pdcp;              ///< the PDCP under test
+    std::vector<uint16_t> m_delivered; ///< SN of the delivered SDUs
+};
+
+McUePdcpReorderingTestCase::McUePdcpReorderingTestCase()
+    : TestCase("In-order delivery of the PDUs of a split bearer at the MC UE PDCP")
+{
+}
+
+McUePdcpReorderingTestCase::~McUePdcpReorderingTestCase()
+{
+}
+
+void
+McUePdcpReorderingTestCase::ReceivePdcpSdu(ReceivePdcpSduParameters params)
+{
+    m_delivered.push_back(params.pdcpSdu->GetSize() - BASE_SDU_SIZE);
+}
+
+void
+McUePdcpReorderingTestCase::ReceivePdu(uint16_t sn, bool mmWave)
+{
+    Ptr<Packet> p = Create<Packet>(BASE_SDU_SIZE + sn);
+    LtePdcpHeader pdcpHeader;
+    pdcpHeader.SetDcBit(LtePdcpHeader::DATA_PDU);
+    pdcpHeader.SetSequenceNumber(sn);
+    p->AddHeader(pdcpHeader);
+    if (mmWave)
+    {
+        m_pdcp->GetMmWaveRlcSapUser()->ReceivePdcpPdu(p);
+    }
+    else
+    {
+        m_pdcp->GetLteRlcSapUser()->ReceivePdcpPdu(p);
+    }
+}
+
+void
+McUePdcpReorderingTestCase::CheckDelivered(uint32_t delivered, uint32_t held)
+{
+    NS_TEST_ASSERT_MSG_EQ(m_delivered.size(), delivered, "Wrong number of delivered SDUs");
+    for (uint32_t i = 1; i < m_delivered.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_GT(m_delivered[i], m_delivered[i - 1], "SDUs delivered out of order");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_pdcp->GetNumHeldPdus(), held, "Wrong number of held PDUs");
+}
+
+void
+McUePdcpReorderingTestCase::DoRun(void)
+{
+    m_pdcp = CreateObject<McUePdcp>();
+    m_pdcp->SetAttribute("EnableReordering", BooleanValue(true));
+    m_pdcp->SetAttribute("ReorderingTimer", TimeValue(MilliSeconds(50)));
+    m_pdcp->SetLtePdcpSapUser(this);
+
+    // SN 2 and 3 overtake SN 1 on the mmWave leg
+    ReceivePdu(0, false);
+    ReceivePdu(2, true);
+    ReceivePdu(3, true);
+    CheckDelivered(1, 2);
+    ReceivePdu(1, false);
+    CheckDelivered(4, 0);
+
+    // duplicate forwarded during a secondary cell handover
+    ReceivePdu(2, false);
+    CheckDelivered(4, 0);
+
+    // SN 4 is lost: SN 5 is delivered at the expiry of t-Reordering, and SN 4
+    // is discarded when it arrives late
+    Simulator::Schedule(MilliSeconds(10), &McUePdcpReorderingTestCase::ReceivePdu, this, 5, true);
+    Simulator::Schedule(MilliSeconds(30),
+                        &McUePdcpReorderingTestCase::CheckDelivered,
+                        this,
+                        4,
+                        1);
+    Simulator::Schedule(MilliSeconds(70),
+                        &McUePdcpReorderingTestCase::CheckDelivered,
+                        this,
+                        5,
+                        0);
+    Simulator::Schedule(MilliSeconds(80), &McUePdcpReorderingTestCase::ReceivePdu, this, 4, false);
+    Simulator::Schedule(MilliSeconds(80), &McUePdcpReorderingTestCase::ReceivePdu, this, 6, false);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_delivered.size(), 6, "Wrong number of delivered SDUs");
+    NS_TEST_ASSERT_MSG_EQ(m_delivered.back(), 6, "Wrong last delivered SDU");
+    McUePdcp::ReorderingStats stats = m_pdcp->GetReorderingStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.heldPdus, 3, "Wrong number of held PDUs");
+    NS_TEST_ASSERT_MSG_EQ(stats.flushedPdus, 1, "Wrong number of flushed PDUs");
+    NS_TEST_ASSERT_MSG_EQ(stats.duplicatePdus, 2, "Wrong number of duplicate PDUs");
+    NS_TEST_ASSERT_MSG_EQ(stats.timerExpiries, 1, "Wrong number of t-Reordering expiries");
+
+    m_pdcp->Dispose();
+    m_pdcp = 0;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test the reordering across the wrap around of the PDCP sequence numbers.
+ */
+class McUePdcpReorderingWrapTestCase : public TestCase, public LtePdcpSapUser
+{
+  public:
+    McUePdcpReorderingWrapTestCase();
+    virtual ~McUePdcpReorderingWrapTestCase();
+
+    // LtePdcpSapUser
+    virtual void ReceivePdcpSdu(ReceivePdcpSduParameters params);
+
+  private:
+    virtual void DoRun(void);
+
+    uint32_t m_delivered; ///< number of delivered SDUs
+    uint16_t m_nextSn;    ///< SN of the next SDU expected in order
+};
+
+McUePdcpReorderingWrapTestCase::McUePdcpReorderingWrapTestCase()
+    : TestCase("In-order delivery across the wrap around of the PDCP SN"),
+      m_delivered(0),
+      m_nextSn(0)
+{
+}
+
+McUePdcpReorderingWrapTestCase::~McUePdcpReorderingWrapTestCase()
+{
+}
+
+void
+McUePdcpReorderingWrapTestCase::ReceivePdcpSdu(ReceivePdcpSduParameters params)
+{
+    uint16_t sn = params.pdcpSdu->GetSize() - BASE_SDU_SIZE;
+    NS_TEST_EXPECT_MSG_EQ(sn, m_nextSn % 256, "SDU delivered out of order");
+    m_nextSn++;
+    m_delivered++;
+}
+
+void
+McUePdcpReorderingWrapTestCase::DoRun(void)
+{
+    Ptr<McUePdcp> pdcp = CreateObject<McUePdcp>();
+    pdcp->SetAttribute("EnableReordering", BooleanValue(true));
+    pdcp->SetLtePdcpSapUser(this);
+
+    // the PDUs of each pair are swapped, over more than one SN cycle
+    const uint32_t pdus = 5000;
+    for (uint32_t i = 0; i < pdus; ++i)
+    {
+        uint16_t sn = (i % 2 == 0 ? i + 1 : i - 1) % 4096;
+        Ptr<Packet> p = Create<Packet>(BASE_SDU_SIZE + sn % 256);
+        LtePdcpHeader pdcpHeader;
+        pdcpHeader.SetDcBit(LtePdcpHeader::DATA_PDU);
+        pdcpHeader.SetSequenceNumber(sn);
+        p->AddHeader(pdcpHeader);
+        pdcp->GetLteRlcSapUser()->ReceivePdcpPdu(p);
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(m_delivered, pdus, "Wrong number of delivered SDUs");
+    NS_TEST_ASSERT_MSG_EQ(pdcp->GetReorderingStats().heldPdus, pdus / 2, "Wrong held PDUs");
+    NS_TEST_ASSERT_MSG_EQ(pdcp->GetReorderingStats().duplicatePdus, 0, "Wrong duplicate PDUs");
+
+    pdcp->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * MC UE PDCP reordering test suite.
+ */
+class McUePdcpReorderingTestSuite : public TestSuite
+{
+  public:
+    McUePdcpReorderingTestSuite();
+};
+
+static McUePdcpReorderingTestSuite g_mcUePdcpReorderingTestSuite;
+
+McUePdcpReorderingTestSuite::McUePdcpReorderingTestSuite()
+    : TestSuite("mc-ue-pdcp-reordering", UNIT)
+{
+    NS_LOG_FUNCTION(this);
+    AddTestCase(new McUePdcpReorderingTestCase, TestCase::QUICK);
+    AddTestCase(new McUePdcpReorderingWrapTestCase, TestCase::QUICK);
+}
@@ -0,0 +1,330 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/mc-ue-sinr-table.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <map>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TestMcUeSinrTable");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check that the best cell kept by McUeSinrTable as the SINR values are
+ * updated is the one found by scanning all the cells of each UE.
+ */
+class McUeSinrTableTestCase : public TestCase
+{
+  public:
+    McUeSinrTableTestCase();
+    virtual ~McUeSinrTableTestCase();
+
+  private:
+    virtual void DoRun(void);
+};
+
+McUeSinrTableTestCase::McUeSinrTableTestCase()
+    : TestCase("Incremental best cell of the UEs in the MC UE SINR table")
+{
+}
+
+McUeSinrTableTestCase::~McUeSinrTableTestCase()
+{
+}
+
+void
+McUeSinrTableTestCase::DoRun(void)
+{
+    McUeSinrTable table;
+
+    // ties go to the lowest cell ID, null SINR values are never the best
+    table.SetSinr(1, 5, 0, Seconds(0));
+    NS_TEST_ASSERT_MSG_EQ(table.HasUe(1), true, "UE not added");
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(1), 0, "Null SINR selected");
+    table.SetSinr(1, 5, 2.0, Seconds(0));
+    table.SetSinr(1, 3, 2.0, Seconds(0));
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(1), 3, "Tie not broken by cell ID");
+    table.SetSinr(1, 3, 1.0, Seconds(0));
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(1), 5, "Best cell not updated on decrease");
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(1, 4), 0, "Unknown SINR not null");
+    table.RemoveSinr(1, 5);
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(1, 5), 0, "Removed SINR not null");
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(1), 3, "Best cell not updated on removal");
+    table.RemoveSinr(1, 4);
+    table.RemoveSinr(2, 3);
+    NS_TEST_ASSERT_MSG_EQ(table.GetSinr(1, 3), 1.0, "Removal of an unknown SINR");
+    NS_TEST_ASSERT_MSG_EQ(table.HasUe(2), false, "Unknown UE found");
+
+    // random updates of sparse IMSIs, checked against a scan of all the cells
+    const uint16_t cells = 12;
+    const uint64_t ues = 50;
+    const uint64_t firstImsi = 310150000000000;
+    std::map<uint64_t, std::map<uint16_t, double>> reference;
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    random->SetStream(1);
+    table.Clear();
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        uint64_t imsi = firstImsi + random->GetInteger(1, ues) * 7919;
+        uint16_t cellId = random->GetInteger(1, cells);
+        double sinr = random->GetInteger(0, 20) / 4.0; // frequent ties and null values
+        if (random->GetInteger(0, 9) == 0 && table.HasUe(imsi))
+        {
+            table.RemoveSinr(imsi, cellId);
+            sinr = 0;
+        }
+        else
+        {
+            table.SetSinr(imsi, cellId, sinr, Seconds(0));
+        }
+        reference[imsi][cellId] = sinr;
+
+        double maxSinr = 0;
+        uint16_t maxSinrCellId = 0;
+        for (const auto& cell : reference[imsi])
+        {
+            if (cell.second > maxSinr)
+            {
+                maxSinr = cell.second;
+                maxSinrCellId = cell.first;
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(imsi), maxSinrCellId, "Wrong best cell");
+        NS_TEST_ASSERT_MSG_EQ(table.GetBestSinr(imsi), maxSinr, "Wrong best SINR");
+    }
+    NS_TEST_ASSERT_MSG_EQ(table.GetUes().size(), reference.size(), "Wrong number of UEs");
+    auto ue = reference.begin();
+    for (uint64_t imsi : table.GetUes())
+    {
+        NS_TEST_ASSERT_MSG_EQ(imsi, ue->first, "UEs not in increasing IMSI order");
+        ++ue;
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check the SINR predicted by McUeSinrTable from the trend of the last SINR
+ * values of a UE towards a cell.
+ */
+class McUeSinrTrendTestCase : public TestCase
+{
+  public:
+    McUeSinrTrendTestCase();
+    virtual ~McUeSinrTrendTestCase();
+
+  private:
+    virtual void DoRun(void);
+};
+
+McUeSinrTrendTestCase::McUeSinrTrendTestCase()
+    : TestCase("SINR trend prediction in the MC UE SINR table")
+{
+}
+
+McUeSinrTrendTestCase::~McUeSinrTrendTestCase()
+{
+}
+
+void
+McUeSinrTrendTestCase::DoRun(void)
+{
+    McUeSinrTable table;
+    table.SetTrendWindow(4);
+
+    // a single value is its own prediction
+    table.SetSinr(1, 2, 100.0, MilliSeconds(0));
+    NS_TEST_ASSERT_MSG_EQ_TOL(table.PredictSinrDb(1, 2, MilliSeconds(50)),
+                              20.0,
+                              1e-9,
+                              "Wrong prediction from a single value");
+    NS_TEST_ASSERT_MSG_EQ(table.PredictSinrDb(1, 3, MilliSeconds(50)),
+                          McUeSinrTable::MIN_SINR_DB,
+                          "Unknown SINR not predicted as the minimum");
+
+    // the SINR decreases by 1 dB every 10 ms, the older values leave the window
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        double sinrDb = (i < 4 ? 40.0 : 20.0 - i);
+        table.SetSinr(1, 2, std::pow(10, sinrDb / 10), MilliSeconds(10 * i));
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(table.PredictSinrDb(1, 2, MilliSeconds(140)),
+                              6.0,
+                              1e-6,
+                              "Wrong linear extrapolation");
+    NS_TEST_ASSERT_MSG_EQ_TOL(table.PredictSinrDb(1, 2, Seconds(100)),
+                              McUeSinrTable::MIN_SINR_DB,
+                              1e-9,
+                              "Prediction not saturated");
+    NS_TEST_ASSERT_MSG_EQ(table.GetBestCell(1), 2, "Trend changed the best cell");
+
+    // the SINR values that are not reported again are sampled at each report
+    // of their cell, a value set at the time of the report is not sampled twice
+    McUeSinrTable sampled;
+    sampled.SetTrendWindow(4);
+    sampled.SetSinr(1, 2, 100.0, MilliSeconds(0));
+    sampled.SetSinr(1, 3, 100.0, MilliSeconds(0));
+    sampled.SetSinr(1, 2, 10.0, MilliSeconds(10));
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        sampled.SampleTrend(2, MilliSeconds(10 * i));
+        sampled.SampleTrend(3, MilliSeconds(10 * i));
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(sampled.PredictSinrDb(1, 3, MilliSeconds(40)),
+                              20.0,
+                              1e-9,
+                              "Constant SINR not followed");
+    // 20 dB at 0 ms and 10 dB at 10, 20 and 30 ms
+    NS_TEST_ASSERT_MSG_EQ_TOL(sampled.PredictSinrDb(1, 2, MilliSeconds(40)),
+                              5.0,
+                              1e-6,
+                              "Wrong trend of the sampled SINR");
+    sampled.SampleTrend(2, MilliSeconds(40));
+    sampled.SampleTrend(2, MilliSeconds(50));
+    NS_TEST_ASSERT_MSG_EQ_TOL(sampled.PredictSinrDb(1, 2, MilliSeconds(60)),
+                              10.0,
+                              1e-9,
+                              "Old report not left out of the window");
+    sampled.SampleTrend(4, MilliSeconds(60));
+    NS_TEST_ASSERT_MSG_EQ(sampled.PredictSinrDb(1, 4, MilliSeconds(60)),
+                          McUeSinrTable::MIN_SINR_DB,
+                          "Unknown SINR sampled");
+
+    // the trend of a removed SINR restarts from the next value
+    table.RemoveSinr(1, 2);
+    NS_TEST_ASSERT_MSG_EQ(table.PredictSinrDb(1, 2, MilliSeconds(140)),
+                          McUeSinrTable::MIN_SINR_DB,
+                          "Removed SINR still predicted");
+    table.SetSinr(1, 2, 10.0, MilliSeconds(100));
+    NS_TEST_ASSERT_MSG_EQ_TOL(table.PredictSinrDb(1, 2, MilliSeconds(140)),
+                              10.0,
+                              1e-9,
+                              "Trend not restarted after a removal");
+
+    // a null SINR is a sharp drop towards the minimum
+    table.SetSinr(1, 2, 0, MilliSeconds(100));
+    NS_TEST_ASSERT_MSG_LT(table.PredictSinrDb(1, 2, MilliSeconds(110)),
+                          McUeSinrTable::MIN_SINR_DB / 2,
+                          "Null SINR not predicted as a drop");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Check the SINR predicted by McUeSinrTable when a mmWave cell reports the
+ * SINR values every UpdateUeSinrEstimatePeriod, with delta reports, and the
+ * prediction looks PredictionHorizon ahead, as done by the LTE coordinator.
+ */
+class McUeSinrReportPeriodTestCase : public TestCase
+{
+  public:
+    McUeSinrReportPeriodTestCase();
+    virtual ~McUeSinrReportPeriodTestCase();
+
+  private:
+    virtual void DoRun(void);
+};
+
+McUeSinrReportPeriodTestCase::McUeSinrReportPeriodTestCase()
+    : TestCase("SINR trend prediction from the periodic reports of a cell")
+{
+}
+
+McUeSinrReportPeriodTestCase::~McUeSinrReportPeriodTestCase()
+{
+}
+
+void
+McUeSinrReportPeriodTestCase::DoRun(void)
+{
+    // the default SinrTrendWindow, UpdateUeSinrEstimatePeriod and PredictionHorizon
+    const uint32_t window = 8;
+    const Time reportPeriod = MicroSeconds(25600);
+    const Time horizon = MilliSeconds(50);
+    McUeSinrTable table;
+    table.SetTrendWindow(window);
+
+    // cell 2 reports IMSI 1 fading by 1 dB per report, IMSI 2 constant at
+    // 20 dB after the first full report, and IMSI 3 constant at 20 dB until a
+    // step to 17 dB in the last report
+    const uint32_t numReports = 12;
+    Time now;
+    for (uint32_t i = 0; i < numReports; ++i)
+    {
+        now = reportPeriod * i;
+        table.SetSinr(1, 2, std::pow(10, (30.0 - i) / 10), now);
+        if (i == 0)
+        {
+            table.SetSinr(2, 2, 100.0, now);
+            table.SetSinr(3, 2, 100.0, now);
+        }
+        else if (i == numReports - 1)
+        {
+            table.SetSinr(3, 2, std::pow(10, 1.7), now);
+        }
+        table.SampleTrend(2, now);
+    }
+
+    double lastSinrDb = 30.0 - (numReports - 1);
+    NS_TEST_ASSERT_MSG_EQ_TOL(table.PredictSinrDb(1, 2, now + horizon),
+                              lastSinrDb - horizon.GetSeconds() / reportPeriod.GetSeconds(),
+                              1e-6,
+                              "Wrong trend of the SINR reported at each period");
+    NS_TEST_ASSERT_MSG_EQ_TOL(table.PredictSinrDb(2, 2, now + horizon),
+                              20.0,
+                              1e-6,
+                              "SINR missing from the delta reports not predicted as constant");
+
+    // the step is one of the window values, it is not extrapolated as a slope
+    // over the last report period: 18.75 dB at the last report, -0.25 dB per report
+    double predicted = table.PredictSinrDb(3, 2, now + horizon);
+    NS_TEST_ASSERT_MSG_EQ_TOL(predicted,
+                              18.75 - 0.25 * horizon.GetSeconds() / reportPeriod.GetSeconds(),
+                              1e-6,
+                              "Wrong trend of a step");
+    NS_TEST_ASSERT_MSG_GT(predicted, 17.0, "Step amplified by the prediction");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * MC UE SINR table test suite.
+ */
+class McUeSinrTableTestSuite : public TestSuite
+{
+  public:
+    McUeSinrTableTestSuite();
+};
+
+static McUeSinrTableTestSuite g_mcUeSinrTableTestSuite;
+
+McUeSinrTableTestSuite::McUeSinrTableTestSuite()
+    : TestSuite("mc-ue-sinr-table", UNIT)
+{
+    AddTestCase(new McUeSinrTableTestCase, TestCase::QUICK);
+    AddTestCase(new McUeSinrTrendTestCase, TestCase::QUICK);
+    AddTestCase(new McUeSinrReportPeriodTestCase, TestCase::QUICK);
+}
@@ -504,6 +504,10 @@ main(int argc, char* argv[])
         Config::SetDefault("ns3::LteEnbRrc::SecondaryCellHandoverMode",
                            EnumValue(LteEnbRrc::DYNAMIC_TTT));
         break;
+    case 4:
+        Config::SetDefault("ns3::LteEnbRrc::SecondaryCellHandoverMode",
+                           EnumValue(LteEnbRrc::PREDICTIVE));
+        break;
     }
 
     Config::SetDefault("ns3::LteEnbRrc::FixedTttValue", UintegerValue(150));
@@ -20,6 +20,7 @@
 
 #include "core-network-stats-calculator.h"
 
+#include "ns3/boolean.h"
 #include "ns3/nstime.h"
 #include "ns3/string.h"
 #include <ns3/log.h>
@@ -38,6 +39,9 @@ namespace mmwave
 NS_OBJECT_ENSURE_REGISTERED(CoreNetworkStatsCalculator);
 
 CoreNetworkStatsCalculator::CoreNetworkStatsCalculator()
+    : m_asyncOutput(false),
+      m_x2Stream(NO_STREAM),
+      m_mmeStream(NO_STREAM)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -65,7 +69,13 @@ CoreNetworkStatsCalculator::GetTypeId(void)
                 "Name of the file where the packet rx on S1-MME at eNB or MME side will be logged.",
                 StringValue("MmeStats.txt"),
                 MakeStringAccessor(&CoreNetworkStatsCalculator::SetMmeOutputFilename),
-                MakeStringChecker());
+                MakeStringChecker())
+            .AddAttribute("AsyncOutput",
+                          "If true, the stats are written to disk by the background "
+                          "MmWaveTraceWriter thread",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CoreNetworkStatsCalculator::m_asyncOutput),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -75,6 +85,32 @@ CoreNetworkStatsCalculator::DoDispose()
     NS_LOG_FUNCTION(this);
 }
 
+void
+CoreNetworkStatsCalculator::WriteX2Packet(std::ostream& os, const PacketRecord& record)
+{
+    os << record.m_time << " " << record.m_sourceCellId << " " << record.m_targetCellId << " "
+       << record.m_size << " " << record.m_delay << " " << record.m_data << "\n";
+}
+
+void
+CoreNetworkStatsCalculator::WriteMmePacket(std::ostream& os, const PacketRecord& record)
+{
+    os << record.m_time << " " << record.m_sourceCellId << " " << record.m_targetCellId << " "
+       << record.m_size << " " << record.m_delay << "\n";
+}
+
+void
+CoreNetworkStatsCalculator::UpdateWriter(void)
+{
+    Ptr<MmWaveTraceWriter> writer = MmWaveTraceWriter::Get();
+    if (writer != m_writer)
+    {
+        m_writer = writer;
+        m_x2Stream = NO_STREAM;
+        m_mmeStream = NO_STREAM;
+    }
+}
+
 void
 CoreNetworkStatsCalculator::LogX2Packet(std::string path,
                                         uint16_t sourceCellId,
@@ -85,13 +121,33 @@ CoreNetworkStatsCalculator::LogX2Packet(std::string path,
 {
     NS_LOG_FUNCTION(this << "LogX2Packet" << sourceCellId << targetCellId << size << delay);
 
+    PacketRecord record;
+    record.m_time = Simulator::Now().GetNanoSeconds() / 1.0e9;
+    record.m_sourceCellId = sourceCellId;
+    record.m_targetCellId = targetCellId;
+    record.m_size = size;
+    record.m_delay = delay;
+    record.m_data = data;
+
+    if (m_asyncOutput)
+    {
+        UpdateWriter();
+        if (m_x2Stream == NO_STREAM)
+        {
+            m_x2Stream = m_writer->OpenStream(GetX2OutputFilename(), "");
+        }
+        m_writer->Write<PacketRecord, &CoreNetworkStatsCalculator::WriteX2Packet>(m_x2Stream,
+                                                                                  record);
+        return;
+    }
+
     if (!m_x2OutFile.is_open())
     {
         m_x2OutFile.open(GetX2OutputFilename().c_str());
     }
 
-    m_x2OutFile << Simulator::Now().GetNanoSeconds() / 1.0e9 << " " << sourceCellId << " "
-                << targetCellId << " " << size << " " << delay << " " << data << std::endl;
+    WriteX2Packet(m_x2OutFile, record);
+    m_x2OutFile.flush();
 }
 
 void
@@ -103,13 +159,33 @@ CoreNetworkStatsCalculator::LogMmePacket(std::string path,
 {
     NS_LOG_FUNCTION(this << "LogX2Packet" << sourceCellId << targetCellId << size << delay);
 
+    PacketRecord record;
+    record.m_time = Simulator::Now().GetNanoSeconds() / 1.0e9;
+    record.m_sourceCellId = sourceCellId;
+    record.m_targetCellId = targetCellId;
+    record.m_size = size;
+    record.m_delay = delay;
+    record.m_data = false;
+
+    if (m_asyncOutput)
+    {
+        UpdateWriter();
+        if (m_mmeStream == NO_STREAM)
+        {
+            m_mmeStream = m_writer->OpenStream(GetMmeOutputFilename(), "");
+        }
+        m_writer->Write<PacketRecord, &CoreNetworkStatsCalculator::WriteMmePacket>(m_mmeStream,
+                                                                                   record);
+        return;
+    }
+
     if (!m_mmeOutFile.is_open())
     {
         m_mmeOutFile.open(GetMmeOutputFilename().c_str());
     }
 
-    m_mmeOutFile << Simulator::Now().GetNanoSeconds() / 1.0e9 << " " << sourceCellId << " "
-                 << targetCellId << " " << size << " " << delay << std::endl;
+    WriteMmePacket(m_mmeOutFile, record);
+    m_mmeOutFile.flush();
 }
 
 std::string
@@ -21,6 +21,8 @@
 #ifndef CORE_NETWORK_STATS_CALCULATOR_H_
 #define CORE_NETWORK_STATS_CALCULATOR_H_
 
+#include "mmwave-trace-writer.h"
+
 #include "ns3/basic-data-calculators.h"
 #include "ns3/lte-common.h"
 #include "ns3/object.h"
@@ -64,11 +66,40 @@ class CoreNetworkStatsCalculator : public Object
     void SetMmeOutputFilename(std::string outputFilename);
 
   private:
+    /**
+     * Record of a packet received on the X2 or S1-MME interfaces
+     */
+    struct PacketRecord
+    {
+        double m_time;           //!< reception time in seconds
+        uint16_t m_sourceCellId; //!< the source cell ID
+        uint16_t m_targetCellId; //!< the target cell ID
+        uint32_t m_size;         //!< the packet size
+        uint64_t m_delay;        //!< the delay
+        bool m_data;             //!< data or control packet (X2 only)
+    };
+
+    static void WriteX2Packet(std::ostream& os, const PacketRecord& record);
+    static void WriteMmePacket(std::ostream& os, const PacketRecord& record);
+
+    /**
+     * Refresh the streams of the shared writer if it has been recreated since
+     * the last record, i.e., after a Simulator::Destroy
+     */
+    void UpdateWriter(void);
+
     std::string m_mmeOutFileName;
     std::string m_x2OutFileName;
 
     std::ofstream m_x2OutFile;
     std::ofstream m_mmeOutFile;
+
+    static const uint16_t NO_STREAM = 0xFFFF;
+
+    bool m_asyncOutput;              //!< use the background trace writer
+    Ptr<MmWaveTraceWriter> m_writer; //!< writer owning the async streams
+    uint16_t m_x2Stream;             //!< writer stream of the X2 file
+    uint16_t m_mmeStream;            //!< writer stream of the S1-MME file
 };
 
 } // namespace mmwave
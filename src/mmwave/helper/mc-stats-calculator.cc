@@ -20,6 +20,7 @@
 
 #include "mc-stats-calculator.h"
 
+#include "ns3/boolean.h"
 #include "ns3/nstime.h"
 #include "ns3/string.h"
 #include <ns3/log.h>
@@ -40,7 +41,11 @@ NS_OBJECT_ENSURE_REGISTERED(McStatsCalculator);
 McStatsCalculator::McStatsCalculator()
     : m_lteOutputFilename("LteSwitchStats.txt"),
       m_mmWaveOutputFilename("MmWaveSwitchStats.txt"),
-      m_cellInTimeFilename("CellIdStats.txt")
+      m_cellInTimeFilename("CellIdStats.txt"),
+      m_asyncOutput(false),
+      m_lteStream(NO_STREAM),
+      m_mmWaveStream(NO_STREAM),
+      m_cellInTimeStream(NO_STREAM)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -84,7 +89,13 @@ McStatsCalculator::GetTypeId(void)
                           "Name of the file where the MmWave Switch will be saved.",
                           StringValue("CellIdStats.txt"),
                           MakeStringAccessor(&McStatsCalculator::SetCellIdInTimeOutputFilename),
-                          MakeStringChecker());
+                          MakeStringChecker())
+            .AddAttribute("AsyncOutput",
+                          "If true, the stats are written to disk by the background "
+                          "MmWaveTraceWriter thread",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&McStatsCalculator::m_asyncOutput),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -132,45 +143,94 @@ McStatsCalculator::GetCellIdInTimeOutputFilename()
 }
 
 void
-McStatsCalculator::SwitchToLte(uint64_t imsi, uint16_t cellId, uint16_t rnti)
+McStatsCalculator::WriteSwitch(std::ostream& os, const SwitchRecord& record)
 {
-    NS_LOG_FUNCTION(this << "SwitchToLte" << cellId << imsi << rnti);
+    os << (record.m_toLte ? "SwitchToLte " : "SwitchToMmWave ") << record.m_time << " "
+       << record.m_imsi << " " << record.m_cellId << " " << record.m_rnti << " "
+       << "\n";
+}
+
+void
+McStatsCalculator::WriteCellIdInTime(std::ostream& os, const SwitchRecord& record)
+{
+    os << record.m_time << " " << record.m_imsi << " " << record.m_cellId << " " << record.m_rnti
+       << " "
+       << "\n";
+}
 
-    if (!m_lteOutFile.is_open())
+void
+McStatsCalculator::ReportSwitch(const SwitchRecord& record)
+{
+    if (m_asyncOutput)
     {
-        m_lteOutFile.open(GetLteOutputFilename().c_str());
+        Ptr<MmWaveTraceWriter> writer = MmWaveTraceWriter::Get();
+        if (writer != m_writer)
+        {
+            m_writer = writer;
+            m_lteStream = NO_STREAM;
+            m_mmWaveStream = NO_STREAM;
+            m_cellInTimeStream = NO_STREAM;
+        }
+        uint16_t& stream = record.m_toLte ? m_lteStream : m_mmWaveStream;
+        if (stream == NO_STREAM)
+        {
+            stream = m_writer->OpenStream(
+                record.m_toLte ? GetLteOutputFilename() : GetMmWaveOutputFilename(),
+                "");
+        }
+        if (m_cellInTimeStream == NO_STREAM)
+        {
+            m_cellInTimeStream = m_writer->OpenStream(GetCellIdInTimeOutputFilename(), "");
+        }
+        m_writer->Write<SwitchRecord, &McStatsCalculator::WriteSwitch>(stream, record);
+        m_writer->Write<SwitchRecord, &McStatsCalculator::WriteCellIdInTime>(m_cellInTimeStream,
+                                                                             record);
+        return;
     }
 
-    m_lteOutFile << "SwitchToLte " << Simulator::Now().GetNanoSeconds() / 1.0e9 << " " << imsi
-                 << " " << cellId << " " << rnti << " " << std::endl;
+    std::ofstream& outFile = record.m_toLte ? m_lteOutFile : m_mmWaveOutFile;
+    if (!outFile.is_open())
+    {
+        outFile.open(record.m_toLte ? GetLteOutputFilename().c_str()
+                                    : GetMmWaveOutputFilename().c_str());
+    }
+    WriteSwitch(outFile, record);
+    outFile.flush();
 
     if (!m_cellInTimeOutFile.is_open())
     {
         m_cellInTimeOutFile.open(GetCellIdInTimeOutputFilename().c_str());
     }
-    m_cellInTimeOutFile << Simulator::Now().GetNanoSeconds() / 1.0e9 << " " << imsi << " " << cellId
-                        << " " << rnti << " " << std::endl;
+    WriteCellIdInTime(m_cellInTimeOutFile, record);
+    m_cellInTimeOutFile.flush();
 }
 
 void
-McStatsCalculator::SwitchToMmWave(uint64_t imsi, uint16_t cellId, uint16_t rnti)
+McStatsCalculator::SwitchToLte(uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << "SwitchToMmWave " << cellId << imsi << rnti);
+    NS_LOG_FUNCTION(this << "SwitchToLte" << cellId << imsi << rnti);
 
-    if (!m_mmWaveOutFile.is_open())
-    {
-        m_mmWaveOutFile.open(GetMmWaveOutputFilename().c_str());
-    }
+    SwitchRecord record;
+    record.m_time = Simulator::Now().GetNanoSeconds() / 1.0e9;
+    record.m_imsi = imsi;
+    record.m_cellId = cellId;
+    record.m_rnti = rnti;
+    record.m_toLte = true;
+    ReportSwitch(record);
+}
 
-    m_mmWaveOutFile << "SwitchToMmWave " << Simulator::Now().GetNanoSeconds() / 1.0e9 << " " << imsi
-                    << " " << cellId << " " << rnti << " " << std::endl;
+void
+McStatsCalculator::SwitchToMmWave(uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+    NS_LOG_FUNCTION(this << "SwitchToMmWave " << cellId << imsi << rnti);
 
-    if (!m_cellInTimeOutFile.is_open())
-    {
-        m_cellInTimeOutFile.open(GetCellIdInTimeOutputFilename().c_str());
-    }
-    m_cellInTimeOutFile << Simulator::Now().GetNanoSeconds() / 1.0e9 << " " << imsi << " " << cellId
-                        << " " << rnti << " " << std::endl;
+    SwitchRecord record;
+    record.m_time = Simulator::Now().GetNanoSeconds() / 1.0e9;
+    record.m_imsi = imsi;
+    record.m_cellId = cellId;
+    record.m_rnti = rnti;
+    record.m_toLte = false;
+    ReportSwitch(record);
 }
 
 } // namespace mmwave
@@ -21,6 +21,8 @@
 #ifndef MC_STATS_CALCULATOR_H_
 #define MC_STATS_CALCULATOR_H_
 
+#include "mmwave-trace-writer.h"
+
 #include "ns3/basic-data-calculators.h"
 #include "ns3/lte-common.h"
 #include "ns3/object.h"
@@ -70,6 +72,28 @@ class McStatsCalculator : public Object
     void SwitchToMmWave(uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   private:
+    /**
+     * Record of a switch between LTE and mmWave
+     */
+    struct SwitchRecord
+    {
+        double m_time;     //!< time of the switch in seconds
+        uint64_t m_imsi;   //!< the IMSI
+        uint16_t m_cellId; //!< the new cell ID
+        uint16_t m_rnti;   //!< the RNTI in the new cell
+        bool m_toLte;      //!< true for SwitchToLte, false for SwitchToMmWave
+    };
+
+    static void WriteSwitch(std::ostream& os, const SwitchRecord& record);
+    static void WriteCellIdInTime(std::ostream& os, const SwitchRecord& record);
+
+    /**
+     * Write a switch event either synchronously or through the trace writer
+     * \param record the switch event
+     */
+    void ReportSwitch(const SwitchRecord& record);
+
+
     /**
      * Name of the file where the downlink PDCP statistics will be saved
      */
@@ -85,6 +109,14 @@ class McStatsCalculator : public Object
     std::ofstream m_lteOutFile;
     std::ofstream m_mmWaveOutFile;
     std::ofstream m_cellInTimeOutFile;
+
+    static const uint16_t NO_STREAM = 0xFFFF;
+
+    bool m_asyncOutput;              //!< use the background trace writer
+    Ptr<MmWaveTraceWriter> m_writer; //!< writer owning the async streams
+    uint16_t m_lteStream;            //!< writer stream of the LTE switch file
+    uint16_t m_mmWaveStream;         //!< writer stream of the mmWave switch file
+    uint16_t m_cellInTimeStream;     //!< writer stream of the cell ID file
 };
 
 } // namespace mmwave
@@ -44,6 +44,10 @@
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-ue-net-device.h>
 #include <ns3/lte-ue-rrc.h>
+#include <ns3/node-list.h>
+#include <ns3/node.h>
+#include <ns3/object-map.h>
+#include <ns3/pointer.h>
 
 namespace ns3
 {
@@ -88,26 +92,23 @@ struct McMmWaveBoundCallbackArgument : public SimpleRefCount<McMmWaveBoundCallba
 /**
  * Callback function for DL TX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  */
 void
 DlTxPduCallback(Ptr<MmWaveBoundCallbackArgument> arg,
-                std::string path,
                 uint16_t rnti,
                 uint8_t lcid,
                 uint32_t packetSize)
 {
-    NS_LOG_FUNCTION(path << rnti << (uint16_t)lcid << packetSize);
+    NS_LOG_FUNCTION(arg->imsi << rnti << (uint16_t)lcid << packetSize);
     arg->stats->DlTxPdu(arg->cellId, arg->imsi, rnti, lcid, packetSize);
 }
 
 /**
  * Callback function for DL RX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
@@ -115,32 +116,29 @@ DlTxPduCallback(Ptr<MmWaveBoundCallbackArgument> arg,
  */
 void
 DlRxPduCallback(Ptr<MmWaveBoundCallbackArgument> arg,
-                std::string path,
                 uint16_t rnti,
                 uint8_t lcid,
                 uint32_t packetSize,
                 uint64_t delay)
 {
-    NS_LOG_FUNCTION(path << rnti << (uint16_t)lcid << packetSize << delay);
+    NS_LOG_FUNCTION(arg->imsi << rnti << (uint16_t)lcid << packetSize << delay);
     arg->stats->DlRxPdu(arg->cellId, arg->imsi, rnti, lcid, packetSize, delay);
 }
 
 /**
  * Callback function for UL TX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  */
 void
 UlTxPduCallback(Ptr<MmWaveBoundCallbackArgument> arg,
-                std::string path,
                 uint16_t rnti,
                 uint8_t lcid,
                 uint32_t packetSize)
 {
-    NS_LOG_FUNCTION(path << rnti << (uint16_t)lcid << packetSize);
+    NS_LOG_FUNCTION(arg->imsi << rnti << (uint16_t)lcid << packetSize);
 
     arg->stats->UlTxPdu(arg->cellId, arg->imsi, rnti, lcid, packetSize);
 }
@@ -148,7 +146,6 @@ UlTxPduCallback(Ptr<MmWaveBoundCallbackArgument> arg,
 /**
  * Callback function for UL RX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
@@ -156,41 +153,138 @@ UlTxPduCallback(Ptr<MmWaveBoundCallbackArgument> arg,
  */
 void
 UlRxPduCallback(Ptr<MmWaveBoundCallbackArgument> arg,
-                std::string path,
                 uint16_t rnti,
                 uint8_t lcid,
                 uint32_t packetSize,
                 uint64_t delay)
 {
-    NS_LOG_FUNCTION(path << rnti << (uint16_t)lcid << packetSize << delay);
+    NS_LOG_FUNCTION(arg->imsi << rnti << (uint16_t)lcid << packetSize << delay);
 
     arg->stats->UlRxPdu(arg->cellId, arg->imsi, rnti, lcid, packetSize, delay);
 }
 
 void
 SwitchToLteCallback(Ptr<McMmWaveBoundCallbackArgument> arg,
-                    std::string path,
                     uint64_t imsi,
                     uint16_t cellId,
                     uint16_t rnti)
 {
-    NS_LOG_FUNCTION(path << rnti << cellId << imsi);
+    NS_LOG_FUNCTION(rnti << cellId << imsi);
 
     arg->stats->SwitchToLte(imsi, cellId, rnti);
 }
 
 void
 SwitchToMmWaveCallback(Ptr<McMmWaveBoundCallbackArgument> arg,
-                       std::string path,
                        uint64_t imsi,
                        uint16_t cellId,
                        uint16_t rnti)
 {
-    NS_LOG_FUNCTION(path << rnti << cellId << imsi);
+    NS_LOG_FUNCTION(rnti << cellId << imsi);
 
     arg->stats->SwitchToMmWave(imsi, cellId, rnti);
 }
 
+/**
+ * \param enbRrc the LteEnbRrc
+ * \param rnti the RNTI of the UE
+ * \return the UeManager of the UE in the UeMap of the RRC, or nullptr
+ */
+static Ptr<Object>
+GetUeManager(Ptr<Object> enbRrc, uint16_t rnti)
+{
+    ObjectMapValue ueMap;
+    if (!enbRrc || !enbRrc->GetAttributeFailSafe("UeMap", ueMap))
+    {
+        return nullptr;
+    }
+    return ueMap.Get(rnti);
+}
+
+/**
+ * \param object the object
+ * \param name the name of a PointerValue attribute of the object
+ * \return the object pointed to by the attribute, or nullptr
+ */
+static Ptr<Object>
+GetPointerAttribute(Ptr<Object> object, std::string name)
+{
+    PointerValue value;
+    if (!object || !object->GetAttributeFailSafe(name, value))
+    {
+        return nullptr;
+    }
+    return value.Get<Object>();
+}
+
+/**
+ * \param owner the RRC of the UE or the UeManager
+ * \param srb Srb0 or Srb1
+ * \param entity LteRlc or LtePdcp
+ * \return the RLC or PDCP entity of the signaling radio bearer, or nullptr
+ */
+static Ptr<Object>
+GetSrbEntity(Ptr<Object> owner, std::string srb, std::string entity)
+{
+    return GetPointerAttribute(GetPointerAttribute(owner, srb), entity);
+}
+
+/**
+ * \param owner the RRC of the UE or the UeManager
+ * \param map DataRadioBearerMap or DataRadioRlcMap
+ * \param entity LteRlc or LtePdcp
+ * \return the RLC or PDCP entities of the radio bearers in the map
+ */
+static std::vector<Ptr<Object>>
+GetBearerEntities(Ptr<Object> owner, std::string map, std::string entity)
+{
+    std::vector<Ptr<Object>> entities;
+    ObjectMapValue bearers;
+    if (!owner || !owner->GetAttributeFailSafe(map, bearers))
+    {
+        return entities;
+    }
+    for (auto it = bearers.Begin(); it != bearers.End(); ++it)
+    {
+        Ptr<Object> object = GetPointerAttribute(it->second, entity);
+        if (object)
+        {
+            entities.push_back(object);
+        }
+    }
+    return entities;
+}
+
+/**
+ * Connect a sink without context to a trace source of an entity, if any
+ * \param entity the RLC or PDCP entity, possibly nullptr
+ * \param source the name of the trace source
+ * \param cb the sink
+ */
+static void
+ConnectEntity(Ptr<Object> entity, std::string source, const CallbackBase& cb)
+{
+    if (entity)
+    {
+        entity->TraceConnectWithoutContext(source, cb);
+    }
+}
+
+/**
+ * Disconnect a sink without context from a trace source of an entity, if any
+ * \param entity the RLC or PDCP entity, possibly nullptr
+ * \param source the name of the trace source
+ * \param cb the sink
+ */
+static void
+DisconnectEntity(Ptr<Object> entity, std::string source, const CallbackBase& cb)
+{
+    if (entity)
+    {
+        entity->TraceDisconnectWithoutContext(source, cb);
+    }
+}
+
 MmWaveBearerStatsConnector::MmWaveBearerStatsConnector()
     : m_connected(false),
       m_enbHandoverStartFilename("EnbHandoverStartStats.txt"),
@@ -291,6 +385,7 @@ void
 MmWaveBearerStatsConnector::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_ueManagerByCellIdRnti.clear();
 }
 
 void
@@ -320,179 +415,195 @@ MmWaveBearerStatsConnector::EnsureConnected()
     NS_LOG_FUNCTION(this);
     if (!m_connected)
     {
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteEnbRrc/NewUeContext",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyNewUeContextEnb, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessSuccessful",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/MmWaveUeRrc/RandomAccessSuccessful",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionReconfiguration",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyConnectionReconfigurationEnb,
-                              this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyConnectionReconfigurationUe,
-                              this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/MmWaveUeRrc/ConnectionReconfiguration",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyConnectionReconfigurationUe,
-                              this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteEnbRrc/HandoverStart",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyHandoverStartEnb, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteUeRrc/HandoverStart",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyHandoverStartUe, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/MmWaveUeRrc/HandoverStart",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyHandoverStartUe, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteEnbRrc/HandoverEndOk",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyHandoverEndOkEnb, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndOk",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyHandoverEndOkUe, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/MmWaveUeRrc/HandoverEndOk",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyHandoverEndOkUe, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteUeRrc/SwitchToMmWave",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifySwitchToMmWaveUe, this));
-        // mmWave SINR from RT, LTE SINR from the PHY callbacks
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteEnbRrc/NotifyMmWaveSinr",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyMmWaveSinr, this));
-        Config::ConnectFailSafe(
-            "/NodeList/*/DeviceList/*/LteUePhy/ReportCurrentCellRsrpSinr",
-            MakeBoundCallback(&MmWaveBearerStatsConnector::NotifyLteSinr, this));
+        // Bind the sinks directly to the RRC and PHY of each device instead of
+        // matching a wildcard Config path per trace source. The sinks get the
+        // RRC as a bound argument, not a context string to be parsed at each
+        // event. It is bound as a raw pointer, as the trace sources of the RRC
+        // hold the callbacks.
+        for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node)
+        {
+            for (uint32_t i = 0; i < (*node)->GetNDevices(); ++i)
+            {
+                Ptr<NetDevice> device = (*node)->GetDevice(i);
+                Ptr<Object> enbRrc = GetPointerAttribute(device, "LteEnbRrc");
+                if (enbRrc)
+                {
+                    Object* rrc = PeekPointer(enbRrc);
+                    enbRrc->TraceConnectWithoutContext(
+                        "NewUeContext",
+                        MakeBoundCallback(&NotifyNewUeContextEnb, this, rrc));
+                    enbRrc->TraceConnectWithoutContext(
+                        "ConnectionReconfiguration",
+                        MakeBoundCallback(&NotifyConnectionReconfigurationEnb, this, rrc));
+                    enbRrc->TraceConnectWithoutContext(
+                        "HandoverStart",
+                        MakeBoundCallback(&NotifyHandoverStartEnb, this, rrc));
+                    enbRrc->TraceConnectWithoutContext(
+                        "HandoverEndOk",
+                        MakeBoundCallback(&NotifyHandoverEndOkEnb, this, rrc));
+                    // mmWave SINR from RT
+                    enbRrc->TraceConnectWithoutContext("NotifyMmWaveSinr",
+                                                       MakeBoundCallback(&NotifyMmWaveSinr, this));
+                }
+                for (std::string owner : {"LteUeRrc", "MmWaveUeRrc"})
+                {
+                    Ptr<Object> ueRrc = GetPointerAttribute(device, owner);
+                    if (!ueRrc)
+                    {
+                        continue;
+                    }
+                    Object* rrc = PeekPointer(ueRrc);
+                    ueRrc->TraceConnectWithoutContext(
+                        "RandomAccessSuccessful",
+                        MakeBoundCallback(&NotifyRandomAccessSuccessfulUe, this, rrc));
+                    ueRrc->TraceConnectWithoutContext(
+                        "ConnectionReconfiguration",
+                        MakeBoundCallback(&NotifyConnectionReconfigurationUe, this, rrc));
+                    ueRrc->TraceConnectWithoutContext(
+                        "HandoverStart",
+                        MakeBoundCallback(&NotifyHandoverStartUe, this, rrc));
+                    ueRrc->TraceConnectWithoutContext(
+                        "HandoverEndOk",
+                        MakeBoundCallback(&NotifyHandoverEndOkUe, this, rrc));
+                    if (owner == "LteUeRrc")
+                    {
+                        ueRrc->TraceConnectWithoutContext(
+                            "SwitchToMmWave",
+                            MakeBoundCallback(&NotifySwitchToMmWaveUe, this, rrc));
+                    }
+                }
+                // LTE SINR from the PHY callbacks
+                Ptr<Object> uePhy = GetPointerAttribute(device, "LteUePhy");
+                if (uePhy)
+                {
+                    uePhy->TraceConnectWithoutContext("ReportCurrentCellRsrpSinr",
+                                                      MakeBoundCallback(&NotifyLteSinr, this));
+                }
+            }
+        }
         m_connected = true;
     }
 }
 
 void
 MmWaveBearerStatsConnector::NotifyRandomAccessSuccessfulUe(MmWaveBearerStatsConnector* c,
-                                                           std::string context,
+                                                           Object* ueRrc,
                                                            uint64_t imsi,
                                                            uint16_t cellId,
                                                            uint16_t rnti)
 {
-    c->ConnectSrb0Traces(context, imsi, cellId, rnti);
+    c->ConnectSrb0Traces(ueRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyConnectionSetupUe(MmWaveBearerStatsConnector* c,
-                                                    std::string context,
+                                                    Object* ueRrc,
                                                     uint64_t imsi,
                                                     uint16_t cellId,
                                                     uint16_t rnti)
 {
-    c->ConnectSrb1TracesUe(context, imsi, cellId, rnti);
+    c->ConnectSrb1TracesUe(ueRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyConnectionReconfigurationUe(MmWaveBearerStatsConnector* c,
-                                                              std::string context,
+                                                              Object* ueRrc,
                                                               uint64_t imsi,
                                                               uint16_t cellId,
                                                               uint16_t rnti)
 {
-    c->ConnectTracesUeIfFirstTime(context, imsi, cellId, rnti);
+    c->ConnectTracesUeIfFirstTime(ueRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyHandoverStartUe(MmWaveBearerStatsConnector* c,
-                                                  std::string context,
+                                                  Object* ueRrc,
                                                   uint64_t imsi,
                                                   uint16_t cellId,
                                                   uint16_t rnti,
                                                   uint16_t targetCellId)
 {
     c->PrintUeStartHandover(imsi, cellId, targetCellId, rnti);
-    c->DisconnectTracesUe(context, imsi, cellId, rnti);
+    c->DisconnectTracesUe(ueRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyHandoverEndOkUe(MmWaveBearerStatsConnector* c,
-                                                  std::string context,
+                                                  Object* ueRrc,
                                                   uint64_t imsi,
                                                   uint16_t cellId,
                                                   uint16_t rnti)
 {
     c->PrintUeEndHandover(imsi, cellId, rnti);
-    c->ConnectSrb1TracesUe(context, imsi, cellId, rnti);
-    c->ConnectDrbTracesUe(context, imsi, cellId, rnti);
+    c->ConnectSrb1TracesUe(ueRrc, imsi, cellId, rnti);
+    c->ConnectDrbTracesUe(ueRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyNewUeContextEnb(MmWaveBearerStatsConnector* c,
-                                                  std::string context,
+                                                  Object* enbRrc,
                                                   uint16_t cellId,
                                                   uint16_t rnti)
 {
-    c->StoreUeManagerPath(context, cellId, rnti);
+    c->StoreUeManager(enbRrc, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyConnectionReconfigurationEnb(MmWaveBearerStatsConnector* c,
-                                                               std::string context,
+                                                               Object* enbRrc,
                                                                uint64_t imsi,
                                                                uint16_t cellId,
                                                                uint16_t rnti)
 {
-    c->ConnectTracesEnbIfFirstTime(context, imsi, cellId, rnti);
+    c->ConnectTracesEnbIfFirstTime(enbRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyHandoverStartEnb(MmWaveBearerStatsConnector* c,
-                                                   std::string context,
+                                                   Object* enbRrc,
                                                    uint64_t imsi,
                                                    uint16_t cellId,
                                                    uint16_t rnti,
                                                    uint16_t targetCellId)
 {
     c->PrintEnbStartHandover(imsi, cellId, targetCellId, rnti);
-    c->DisconnectTracesEnb(context, imsi, cellId, rnti);
+    c->DisconnectTracesEnb(enbRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyHandoverEndOkEnb(MmWaveBearerStatsConnector* c,
-                                                   std::string context,
+                                                   Object* enbRrc,
                                                    uint64_t imsi,
                                                    uint16_t cellId,
                                                    uint16_t rnti)
 {
     c->PrintEnbEndHandover(imsi, cellId, rnti);
-    c->ConnectSrb1TracesEnb(context, imsi, cellId, rnti);
-    c->ConnectDrbTracesEnb(context, imsi, cellId, rnti);
+    c->ConnectSrb1TracesEnb(enbRrc, imsi, cellId, rnti);
+    c->ConnectDrbTracesEnb(enbRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifySwitchToMmWaveUe(MmWaveBearerStatsConnector* c,
-                                                   std::string context,
+                                                   Object* ueRrc,
                                                    uint64_t imsi,
                                                    uint16_t cellId,
                                                    uint16_t rnti)
 {
-    c->ConnectSecondaryTracesUe(context, imsi, cellId, rnti);
+    c->ConnectSecondaryTracesUe(ueRrc, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifySecondaryMmWaveEnbAvailable(MmWaveBearerStatsConnector* c,
-                                                              std::string context,
+                                                              Object* ueManager,
                                                               uint64_t imsi,
                                                               uint16_t cellId,
                                                               uint16_t rnti)
 {
-    c->ConnectSecondaryTracesEnb(context, imsi, cellId, rnti);
+    c->ConnectSecondaryTracesEnb(ueManager, imsi, cellId, rnti);
 }
 
 void
 MmWaveBearerStatsConnector::NotifyMmWaveSinr(MmWaveBearerStatsConnector* c,
-                                             std::string context,
                                              uint64_t imsi,
                                              uint16_t cellId,
                                              long double sinr)
@@ -514,7 +625,6 @@ MmWaveBearerStatsConnector::PrintMmWaveSinr(uint64_t imsi, uint16_t cellId, long
 
 void
 MmWaveBearerStatsConnector::NotifyLteSinr(MmWaveBearerStatsConnector* c,
-                                          std::string context,
                                           uint16_t cellId,
                                           uint16_t rnti,
                                           double rsrp,
@@ -682,39 +792,38 @@ MmWaveBearerStatsConnector::PrintUeEndHandover(uint64_t imsi, uint16_t targetCel
 }
 
 void
-MmWaveBearerStatsConnector::StoreUeManagerPath(std::string context, uint16_t cellId, uint16_t rnti)
+MmWaveBearerStatsConnector::StoreUeManager(Ptr<Object> enbRrc, uint16_t cellId, uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context << cellId << rnti);
-    std::ostringstream ueManagerPath;
-    ueManagerPath << context.substr(0, context.rfind("/")) << "/UeMap/" << (uint32_t)rnti;
+    NS_LOG_FUNCTION(this << enbRrc << cellId << rnti);
+    Ptr<Object> ueManager = GetUeManager(enbRrc, rnti);
+    NS_ASSERT_MSG(ueManager, "No UeManager for RNTI " << rnti << " in cell " << cellId);
     CellIdRnti key;
     key.cellId = cellId;
     key.rnti = rnti;
-    m_ueManagerPathByCellIdRnti[key] = ueManagerPath.str();
+    m_ueManagerByCellIdRnti[key] = ueManager;
 
     if (m_rlcStats)
     {
-        Config::ConnectFailSafe(ueManagerPath.str() + "/SecondaryRlcCreated",
-                                MakeBoundCallback(&NotifySecondaryMmWaveEnbAvailable, this));
+        ueManager->TraceConnectWithoutContext(
+            "SecondaryRlcCreated",
+            MakeBoundCallback(&NotifySecondaryMmWaveEnbAvailable, this, PeekPointer(ueManager)));
     }
 }
 
 void
-MmWaveBearerStatsConnector::ConnectSrb0Traces(std::string context,
+MmWaveBearerStatsConnector::ConnectSrb0Traces(Ptr<Object> ueRrc,
                                               uint64_t imsi,
                                               uint16_t cellId,
                                               uint16_t rnti)
 {
     NS_LOG_FUNCTION(this << imsi << cellId << rnti);
-    std::string ueRrcPath = context.substr(0, context.rfind("/"));
     CellIdRnti key;
     key.cellId = cellId;
     key.rnti = rnti;
-    std::map<CellIdRnti, std::string>::iterator it = m_ueManagerPathByCellIdRnti.find(key);
-    NS_ASSERT(it != m_ueManagerPathByCellIdRnti.end());
-    std::string ueManagerPath = it->second;
-    NS_LOG_LOGIC(this << " ueManagerPath: " << ueManagerPath);
-    m_ueManagerPathByCellIdRnti.erase(it);
+    std::map<CellIdRnti, Ptr<Object>>::iterator it = m_ueManagerByCellIdRnti.find(key);
+    NS_ASSERT(it != m_ueManagerByCellIdRnti.end());
+    Ptr<Object> ueManager = it->second;
+    m_ueManagerByCellIdRnti.erase(it);
 
     if (m_rlcStats)
     {
@@ -724,30 +833,40 @@ MmWaveBearerStatsConnector::ConnectSrb0Traces(std::string context,
         arg->stats = m_rlcStats;
 
         // diconnect eventually previously connected SRB0 both at UE and eNB
-        Config::Disconnect(ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                           MakeBoundCallback(&UlTxPduCallback, arg));
-        Config::Disconnect(ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                           MakeBoundCallback(&DlRxPduCallback, arg));
-        Config::Disconnect(ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                           MakeBoundCallback(&DlTxPduCallback, arg));
-        Config::Disconnect(ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                           MakeBoundCallback(&UlRxPduCallback, arg));
+        DisconnectEntity(GetSrbEntity(ueRrc, "Srb0", "LteRlc"),
+                         "TxPDU",
+                         MakeBoundCallback(&UlTxPduCallback, arg));
+        DisconnectEntity(GetSrbEntity(ueRrc, "Srb0", "LteRlc"),
+                         "RxPDU",
+                         MakeBoundCallback(&DlRxPduCallback, arg));
+        DisconnectEntity(GetSrbEntity(ueManager, "Srb0", "LteRlc"),
+                         "TxPDU",
+                         MakeBoundCallback(&DlTxPduCallback, arg));
+        DisconnectEntity(GetSrbEntity(ueManager, "Srb0", "LteRlc"),
+                         "RxPDU",
+                         MakeBoundCallback(&UlRxPduCallback, arg));
 
         // connect SRB0 both at UE and eNB
-        Config::ConnectFailSafe(ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                                MakeBoundCallback(&UlTxPduCallback, arg));
-        Config::ConnectFailSafe(ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                                MakeBoundCallback(&DlRxPduCallback, arg));
-        Config::ConnectFailSafe(ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
-        Config::ConnectFailSafe(ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueRrc, "Srb0", "LteRlc"),
+                      "TxPDU",
+                      MakeBoundCallback(&UlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueRrc, "Srb0", "LteRlc"),
+                      "RxPDU",
+                      MakeBoundCallback(&DlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb0", "LteRlc"),
+                      "TxPDU",
+                      MakeBoundCallback(&DlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb0", "LteRlc"),
+                      "RxPDU",
+                      MakeBoundCallback(&UlRxPduCallback, arg));
 
         // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-        Config::ConnectFailSafe(ueManagerPath + "/Srb1/LteRlc/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
-        Config::ConnectFailSafe(ueManagerPath + "/Srb1/LteRlc/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb1", "LteRlc"),
+                      "TxPDU",
+                      MakeBoundCallback(&DlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb1", "LteRlc"),
+                      "RxPDU",
+                      MakeBoundCallback(&UlRxPduCallback, arg));
     }
     if (m_pdcpStats)
     {
@@ -757,41 +876,40 @@ MmWaveBearerStatsConnector::ConnectSrb0Traces(std::string context,
         arg->stats = m_pdcpStats;
 
         // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-        Config::ConnectFailSafe(ueManagerPath + "/Srb1/LtePdcp/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
-        Config::ConnectFailSafe(ueManagerPath + "/Srb1/LtePdcp/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb1", "LtePdcp"),
+                      "RxPDU",
+                      MakeBoundCallback(&UlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb1", "LtePdcp"),
+                      "TxPDU",
+                      MakeBoundCallback(&DlTxPduCallback, arg));
     }
 }
 
 void
-MmWaveBearerStatsConnector::ConnectTracesUeIfFirstTime(std::string context,
+MmWaveBearerStatsConnector::ConnectTracesUeIfFirstTime(Ptr<Object> ueRrc,
                                                        uint64_t imsi,
                                                        uint16_t cellId,
                                                        uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context);
+    NS_LOG_FUNCTION(this << ueRrc << imsi << cellId << rnti);
 
     // Connect PDCP and RLC traces for SRB1
     if (m_imsiSeenUeSrb.find(imsi) == m_imsiSeenUeSrb.end())
     {
         m_imsiSeenUeSrb.insert(imsi);
-        ConnectSrb1TracesUe(context, imsi, cellId, rnti);
+        ConnectSrb1TracesUe(ueRrc, imsi, cellId, rnti);
     }
 
-    std::string basePath = context.substr(0, context.rfind("/"));
-    Config::MatchContainer rlc_container =
-        Config::LookupMatches(basePath + "/DataRadioBearerMap/*/LteRlc/");
-    uint16_t numberOfRlc = rlc_container.GetN();
+    uint16_t numberOfRlc = GetBearerEntities(ueRrc, "DataRadioBearerMap", "LteRlc").size();
 
     // Connect PDCP and RLC for data radio bearers
     std::map<uint64_t, uint16_t>::iterator it = m_imsiSeenUeDrb.find(imsi);
-    if (m_imsiSeenUeDrb.find(imsi) == m_imsiSeenUeDrb.end() && rlc_container.GetN() > 0)
+    if (m_imsiSeenUeDrb.find(imsi) == m_imsiSeenUeDrb.end() && numberOfRlc > 0)
     {
         // If it is the first time for this imsi
         NS_LOG_DEBUG("Insert imsi " + std::to_string(imsi));
         m_imsiSeenUeDrb.insert(m_imsiSeenUeDrb.end(), std::pair<uint64_t, uint16_t>(imsi, 1));
-        ConnectDrbTracesUe(context, imsi, cellId, rnti);
+        ConnectDrbTracesUe(ueRrc, imsi, cellId, rnti);
     }
     else
     {
@@ -800,8 +918,8 @@ MmWaveBearerStatsConnector::ConnectTracesUeIfFirstTime(std::string context,
             // If this imsi has already been connected but a new DRB is established
             NS_LOG_DEBUG("There is a new RLC. Call ConnectDrbTracesUe to connect the traces.");
             it->second++; // TODO Check if there could be more than one RLC to connect
-            DisconnectDrbTracesUe(context, imsi, cellId, rnti);
-            ConnectDrbTracesUe(context, imsi, cellId, rnti);
+            DisconnectDrbTracesUe(ueRrc, imsi, cellId, rnti);
+            ConnectDrbTracesUe(ueRrc, imsi, cellId, rnti);
         }
         else
         {
@@ -813,39 +931,34 @@ MmWaveBearerStatsConnector::ConnectTracesUeIfFirstTime(std::string context,
 }
 
 void
-MmWaveBearerStatsConnector::ConnectTracesEnbIfFirstTime(std::string context,
+MmWaveBearerStatsConnector::ConnectTracesEnbIfFirstTime(Ptr<Object> enbRrc,
                                                         uint64_t imsi,
                                                         uint16_t cellId,
                                                         uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context);
+    NS_LOG_FUNCTION(this << enbRrc << imsi << cellId << rnti);
 
     // NB SRB1 traces are already connected
 
     // Connect PDCP and RLC for data radio bearers
     // Look for the RLCs
-    std::string basePath =
-        context.substr(0, context.rfind("/")) + "/UeMap/" + std::to_string((uint32_t)rnti);
-    Config::MatchContainer rlc_container =
-        Config::LookupMatches(basePath + "/DataRadioBearerMap/*/LteRlc/");
-
-    if (m_imsiSeenEnbDrb.find(imsi) == m_imsiSeenEnbDrb.end() && rlc_container.GetN() > 0)
+    Ptr<Object> ueManager = GetUeManager(enbRrc, rnti);
+    if (m_imsiSeenEnbDrb.find(imsi) == m_imsiSeenEnbDrb.end() &&
+        !GetBearerEntities(ueManager, "DataRadioBearerMap", "LteRlc").empty())
     {
         // it is executed only if there exist at least one rlc layer
         m_imsiSeenEnbDrb.insert(imsi);
-        ConnectDrbTracesEnb(context, imsi, cellId, rnti);
+        ConnectDrbTracesEnb(enbRrc, imsi, cellId, rnti);
     }
 }
 
 void
-MmWaveBearerStatsConnector::ConnectDrbTracesUe(std::string context,
+MmWaveBearerStatsConnector::ConnectDrbTracesUe(Ptr<Object> ueRrc,
                                                uint64_t imsi,
                                                uint16_t cellId,
                                                uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context);
-    NS_LOG_LOGIC(this << "expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
-    std::string basePath = context.substr(0, context.rfind("/"));
+    NS_LOG_FUNCTION(this << ueRrc << imsi << cellId << rnti);
     if (m_rlcStats)
     {
         Ptr<MmWaveBoundCallbackArgument> arg = Create<MmWaveBoundCallbackArgument>();
@@ -856,10 +969,11 @@ MmWaveBearerStatsConnector::ConnectDrbTracesUe(std::string context,
         m_rlcDrbDlRxCb[imsi] = MakeBoundCallback(&DlRxPduCallback, arg);
         m_rlcDrbUlTxCb[imsi] = MakeBoundCallback(&UlTxPduCallback, arg);
 
-        Config::ConnectFailSafe(basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-                                m_rlcDrbUlTxCb.at(imsi));
-        Config::ConnectFailSafe(basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-                                m_rlcDrbDlRxCb.at(imsi));
+        for (const auto& rlc : GetBearerEntities(ueRrc, "DataRadioBearerMap", "LteRlc"))
+        {
+            rlc->TraceConnectWithoutContext("TxPDU", m_rlcDrbUlTxCb.at(imsi));
+            rlc->TraceConnectWithoutContext("RxPDU", m_rlcDrbDlRxCb.at(imsi));
+        }
     }
     if (m_pdcpStats)
     {
@@ -871,33 +985,33 @@ MmWaveBearerStatsConnector::ConnectDrbTracesUe(std::string context,
         m_pdcpDrbDlRxCb[imsi] = MakeBoundCallback(&DlRxPduCallback, arg);
         m_pdcpDrbUlTxCb[imsi] = MakeBoundCallback(&UlTxPduCallback, arg);
 
-        Config::ConnectFailSafe(basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-                                m_pdcpDrbDlRxCb.at(imsi));
-        Config::ConnectFailSafe(basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-                                m_pdcpDrbUlTxCb.at(imsi));
+        for (const auto& pdcp : GetBearerEntities(ueRrc, "DataRadioBearerMap", "LtePdcp"))
+        {
+            pdcp->TraceConnectWithoutContext("RxPDU", m_pdcpDrbDlRxCb.at(imsi));
+            pdcp->TraceConnectWithoutContext("TxPDU", m_pdcpDrbUlTxCb.at(imsi));
+        }
     }
 }
 
 void
-MmWaveBearerStatsConnector::ConnectSrb1TracesUe(std::string ueRrcPath,
+MmWaveBearerStatsConnector::ConnectSrb1TracesUe(Ptr<Object> ueRrc,
                                                 uint64_t imsi,
                                                 uint16_t cellId,
                                                 uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << ueRrcPath);
-    NS_LOG_LOGIC(this << "expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
-    std::string basePath = ueRrcPath.substr(0, ueRrcPath.rfind("/"));
-    NS_LOG_FUNCTION(this << imsi << cellId << rnti);
+    NS_LOG_FUNCTION(this << ueRrc << imsi << cellId << rnti);
     if (m_rlcStats)
     {
         Ptr<MmWaveBoundCallbackArgument> arg = Create<MmWaveBoundCallbackArgument>();
         arg->imsi = imsi;
         arg->cellId = cellId;
         arg->stats = m_rlcStats;
-        Config::ConnectFailSafe(basePath + "/Srb1/LteRlc/TxPDU",
-                                MakeBoundCallback(&UlTxPduCallback, arg));
-        Config::ConnectFailSafe(basePath + "/Srb1/LteRlc/RxPDU",
-                                MakeBoundCallback(&DlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueRrc, "Srb1", "LteRlc"),
+                      "TxPDU",
+                      MakeBoundCallback(&UlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueRrc, "Srb1", "LteRlc"),
+                      "RxPDU",
+                      MakeBoundCallback(&DlRxPduCallback, arg));
     }
     if (m_pdcpStats)
     {
@@ -905,46 +1019,50 @@ MmWaveBearerStatsConnector::ConnectSrb1TracesUe(std::string ueRrcPath,
         arg->imsi = imsi;
         arg->cellId = cellId;
         arg->stats = m_pdcpStats;
-        Config::ConnectFailSafe(basePath + "/Srb1/LtePdcp/RxPDU",
-                                MakeBoundCallback(&DlRxPduCallback, arg));
-        Config::ConnectFailSafe(basePath + "/Srb1/LtePdcp/TxPDU",
-                                MakeBoundCallback(&UlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueRrc, "Srb1", "LtePdcp"),
+                      "RxPDU",
+                      MakeBoundCallback(&DlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueRrc, "Srb1", "LtePdcp"),
+                      "TxPDU",
+                      MakeBoundCallback(&UlTxPduCallback, arg));
     }
-    if (m_mcStats)
+    if (m_mcStats && ueRrc)
     {
         Ptr<McMmWaveBoundCallbackArgument> arg = Create<McMmWaveBoundCallbackArgument>();
         arg->stats = m_mcStats;
-        Config::ConnectFailSafe(basePath + "/SwitchToLte",
-                                MakeBoundCallback(&SwitchToLteCallback, arg));
-        Config::ConnectFailSafe(basePath + "/SwitchToMmWave",
-                                MakeBoundCallback(&SwitchToMmWaveCallback, arg));
+        ueRrc->TraceConnectWithoutContext("SwitchToLte",
+                                          MakeBoundCallback(&SwitchToLteCallback, arg));
+        ueRrc->TraceConnectWithoutContext("SwitchToMmWave",
+                                          MakeBoundCallback(&SwitchToMmWaveCallback, arg));
     }
 }
 
 void
-MmWaveBearerStatsConnector::ConnectSrb1TracesEnb(std::string context,
+MmWaveBearerStatsConnector::ConnectSrb1TracesEnb(Ptr<Object> enbRrc,
                                                  uint64_t imsi,
                                                  uint16_t cellId,
                                                  uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context);
-    NS_LOG_LOGIC(this << "expected context  should match /NodeList/*/DeviceList/*/LteEnbRrc/");
-    std::ostringstream basePath;
-    basePath << context.substr(0, context.rfind("/")) << "/UeMap/" << (uint32_t)rnti;
+    NS_LOG_FUNCTION(this << enbRrc << imsi << cellId << rnti);
+    Ptr<Object> ueManager = GetUeManager(enbRrc, rnti);
     if (m_rlcStats)
     {
         Ptr<MmWaveBoundCallbackArgument> arg = Create<MmWaveBoundCallbackArgument>();
         arg->imsi = imsi;
         arg->cellId = cellId;
         arg->stats = m_rlcStats;
-        Config::ConnectFailSafe(basePath.str() + "/Srb0/LteRlc/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
-        Config::ConnectFailSafe(basePath.str() + "/Srb0/LteRlc/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
-        Config::ConnectFailSafe(basePath.str() + "/Srb1/LteRlc/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
-        Config::ConnectFailSafe(basePath.str() + "/Srb1/LteRlc/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb0", "LteRlc"),
+                      "RxPDU",
+                      MakeBoundCallback(&UlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb0", "LteRlc"),
+                      "TxPDU",
+                      MakeBoundCallback(&DlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb1", "LteRlc"),
+                      "RxPDU",
+                      MakeBoundCallback(&UlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb1", "LteRlc"),
+                      "TxPDU",
+                      MakeBoundCallback(&DlTxPduCallback, arg));
     }
     if (m_pdcpStats)
     {
@@ -952,104 +1070,92 @@ MmWaveBearerStatsConnector::ConnectSrb1TracesEnb(std::string context,
         arg->imsi = imsi;
         arg->cellId = cellId;
         arg->stats = m_pdcpStats;
-        Config::ConnectFailSafe(basePath.str() + "/Srb1/LtePdcp/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
-        Config::ConnectFailSafe(basePath.str() + "/Srb1/LtePdcp/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb1", "LtePdcp"),
+                      "TxPDU",
+                      MakeBoundCallback(&DlTxPduCallback, arg));
+        ConnectEntity(GetSrbEntity(ueManager, "Srb1", "LtePdcp"),
+                      "RxPDU",
+                      MakeBoundCallback(&UlRxPduCallback, arg));
     }
 }
 
 void
-MmWaveBearerStatsConnector::ConnectDrbTracesEnb(std::string context,
+MmWaveBearerStatsConnector::ConnectDrbTracesEnb(Ptr<Object> enbRrc,
                                                 uint64_t imsi,
                                                 uint16_t cellId,
                                                 uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context);
-    NS_LOG_LOGIC(this << "expected context  should match /NodeList/*/DeviceList/*/LteEnbRrc/");
-    std::ostringstream basePath;
-    basePath << context.substr(0, context.rfind("/")) << "/UeMap/" << (uint32_t)rnti;
+    NS_LOG_FUNCTION(this << enbRrc << imsi << cellId << rnti);
+    Ptr<Object> ueManager = GetUeManager(enbRrc, rnti);
     if (m_rlcStats)
     {
-        Ptr<MmWaveBoundCallbackArgument> arg = Create<MmWaveBoundCallbackArgument>();
-        arg->imsi = imsi;
-        arg->cellId = cellId;
-        arg->stats = m_rlcStats;
-        Config::ConnectFailSafe(basePath.str() + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
-        Config::ConnectFailSafe(basePath.str() + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
+        for (const auto& rlc : GetBearerEntities(ueManager, "DataRadioBearerMap", "LteRlc"))
+        {
+            ConnectBearerTraces(rlc, m_rlcStats, imsi, cellId, false);
+        }
     }
     if (m_pdcpStats)
     {
-        Ptr<MmWaveBoundCallbackArgument> arg = Create<MmWaveBoundCallbackArgument>();
-        arg->imsi = imsi;
-        arg->cellId = cellId;
-        arg->stats = m_pdcpStats;
-        Config::ConnectFailSafe(basePath.str() + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
-        Config::ConnectFailSafe(basePath.str() + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
+        for (const auto& pdcp : GetBearerEntities(ueManager, "DataRadioBearerMap", "LtePdcp"))
+        {
+            ConnectBearerTraces(pdcp, m_pdcpStats, imsi, cellId, false);
+        }
     }
 }
 
 void
-MmWaveBearerStatsConnector::DisconnectTracesUe(std::string context,
+MmWaveBearerStatsConnector::DisconnectTracesUe(Ptr<Object> ueRrc,
                                                uint64_t imsi,
                                                uint16_t cellId,
                                                uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context);
-    NS_LOG_LOGIC(this << "expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
-    std::string basePath = context.substr(0, context.rfind("/"));
-    Config::MatchContainer objects =
-        Config::LookupMatches(basePath + "/DataRadioBearerMap/*/LteRlc/");
-    NS_LOG_LOGIC("basePath " << basePath);
+    NS_LOG_FUNCTION(this << ueRrc << imsi << cellId << rnti);
 
-    if (m_mcStats)
+    if (m_mcStats && ueRrc)
     {
         Ptr<McMmWaveBoundCallbackArgument> arg = Create<McMmWaveBoundCallbackArgument>();
         arg->stats = m_mcStats;
-        Config::Disconnect(basePath + "/SwitchToLte", MakeBoundCallback(&SwitchToLteCallback, arg));
-        Config::Disconnect(basePath + "/SwitchToMmWave",
-                           MakeBoundCallback(&SwitchToMmWaveCallback, arg));
+        ueRrc->TraceDisconnectWithoutContext("SwitchToLte",
+                                             MakeBoundCallback(&SwitchToLteCallback, arg));
+        ueRrc->TraceDisconnectWithoutContext("SwitchToMmWave",
+                                             MakeBoundCallback(&SwitchToMmWaveCallback, arg));
     }
 }
 
 void
-MmWaveBearerStatsConnector::DisconnectDrbTracesUe(std::string context,
+MmWaveBearerStatsConnector::DisconnectDrbTracesUe(Ptr<Object> ueRrc,
                                                   uint64_t imsi,
                                                   uint16_t cellId,
                                                   uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context);
-    NS_LOG_LOGIC(this << "expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
-    std::string basePath = context.substr(0, context.rfind("/"));
-    NS_LOG_LOGIC("basePath " << basePath);
+    NS_LOG_FUNCTION(this << ueRrc << imsi << cellId << rnti);
 
     if (m_rlcStats)
     {
-        Config::MatchContainer rlc_container =
-            Config::LookupMatches(basePath + "/DataRadioBearerMap/*/LteRlc/");
-        NS_LOG_LOGIC("Number of RLC to disconnect " << rlc_container.GetN());
-
-        rlc_container.Disconnect("RxPDU", m_rlcDrbDlRxCb.at(imsi));
-        rlc_container.Disconnect("TxPDU", m_rlcDrbUlTxCb.at(imsi));
+        std::vector<Ptr<Object>> rlcs = GetBearerEntities(ueRrc, "DataRadioBearerMap", "LteRlc");
+        NS_LOG_LOGIC("Number of RLC to disconnect " << rlcs.size());
+        for (const auto& rlc : rlcs)
+        {
+            rlc->TraceDisconnectWithoutContext("RxPDU", m_rlcDrbDlRxCb.at(imsi));
+            rlc->TraceDisconnectWithoutContext("TxPDU", m_rlcDrbUlTxCb.at(imsi));
+        }
     }
 
     if (m_pdcpStats)
     {
-        Config::MatchContainer pdcp_container =
-            Config::LookupMatches(basePath + "/DataRadioBearerMap/*/LtePdcp/");
-        NS_LOG_LOGIC("Number of PDCP to disconnect " << pdcp_container.GetN());
-
-        pdcp_container.Disconnect("RxPDU", m_pdcpDrbDlRxCb.at(imsi));
-        pdcp_container.Disconnect("TxPDU", m_pdcpDrbUlTxCb.at(imsi));
+        std::vector<Ptr<Object>> pdcps =
+            GetBearerEntities(ueRrc, "DataRadioBearerMap", "LtePdcp");
+        NS_LOG_LOGIC("Number of PDCP to disconnect " << pdcps.size());
+        for (const auto& pdcp : pdcps)
+        {
+            pdcp->TraceDisconnectWithoutContext("RxPDU", m_pdcpDrbDlRxCb.at(imsi));
+            pdcp->TraceDisconnectWithoutContext("TxPDU", m_pdcpDrbUlTxCb.at(imsi));
+        }
     }
 }
 
 void
-MmWaveBearerStatsConnector::DisconnectTracesEnb(std::string context,
+MmWaveBearerStatsConnector::DisconnectTracesEnb(Ptr<Object> enbRrc,
                                                 uint64_t imsi,
                                                 uint16_t cellId,
                                                 uint16_t rnti)
@@ -1058,57 +1164,62 @@ MmWaveBearerStatsConnector::DisconnectTracesEnb(std::string context,
 }
 
 void
-MmWaveBearerStatsConnector::ConnectSecondaryTracesUe(std::string context,
+MmWaveBearerStatsConnector::ConnectSecondaryTracesUe(Ptr<Object> ueRrc,
                                                      uint64_t imsi,
                                                      uint16_t cellId,
                                                      uint16_t rnti)
 {
-    NS_LOG_LOGIC(this << context);
-    NS_LOG_LOGIC(this << "expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
-    std::string basePath = context.substr(0, context.rfind("/"));
-    Config::MatchContainer objects = Config::LookupMatches(basePath + "/DataRadioRlcMap/*");
-    NS_LOG_LOGIC("basePath " << basePath);
+    NS_LOG_FUNCTION(this << ueRrc << imsi << cellId << rnti);
 
     if (m_rlcStats)
     {
-        Ptr<MmWaveBoundCallbackArgument> arg = Create<MmWaveBoundCallbackArgument>();
-        arg->imsi = imsi;
-        arg->cellId = cellId;
-        arg->stats = m_rlcStats;
         // for MC devices
-        Config::ConnectFailSafe(basePath + "/DataRadioRlcMap/*/LteRlc/TxPDU",
-                                MakeBoundCallback(&UlTxPduCallback, arg));
-        Config::ConnectFailSafe(basePath + "/DataRadioRlcMap/*/LteRlc/RxPDU",
-                                MakeBoundCallback(&DlRxPduCallback, arg));
+        for (const auto& rlc : GetBearerEntities(ueRrc, "DataRadioRlcMap", "LteRlc"))
+        {
+            ConnectBearerTraces(rlc, m_rlcStats, imsi, cellId, true);
+        }
     }
 }
 
 void
-MmWaveBearerStatsConnector::ConnectSecondaryTracesEnb(std::string context,
+MmWaveBearerStatsConnector::ConnectSecondaryTracesEnb(Ptr<Object> ueManager,
                                                       uint64_t imsi,
                                                       uint16_t cellId,
                                                       uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this << context);
-    NS_LOG_LOGIC(
-        this << "expected context should match /NodeList/*/DeviceList/*/LteEnbRrc/UeMap/*");
-    std::ostringstream basePath;
-    basePath << context.substr(0, context.rfind("/"));
-    Config::MatchContainer objects =
-        Config::LookupMatches(basePath.str() + "/DataRadioRlcMap/*/LteRlc/");
-    NS_LOG_LOGIC("basePath " << basePath.str());
+    NS_LOG_FUNCTION(this << ueManager << imsi << cellId << rnti);
 
     if (m_rlcStats)
     {
-        Ptr<MmWaveBoundCallbackArgument> arg = Create<MmWaveBoundCallbackArgument>();
-        arg->imsi = imsi;
-        arg->cellId = cellId;
-        arg->stats = m_rlcStats;
         // for MC devices
-        Config::ConnectFailSafe(basePath.str() + "/DataRadioRlcMap/*/LteRlc/RxPDU",
-                                MakeBoundCallback(&UlRxPduCallback, arg));
-        Config::ConnectFailSafe(basePath.str() + "/DataRadioRlcMap/*/LteRlc/TxPDU",
-                                MakeBoundCallback(&DlTxPduCallback, arg));
+        for (const auto& rlc : GetBearerEntities(ueManager, "DataRadioRlcMap", "LteRlc"))
+        {
+            ConnectBearerTraces(rlc, m_rlcStats, imsi, cellId, false);
+        }
+    }
+}
+
+void
+MmWaveBearerStatsConnector::ConnectBearerTraces(Ptr<Object> entity,
+                                                Ptr<MmWaveBearerStatsCalculator> stats,
+                                                uint64_t imsi,
+                                                uint16_t cellId,
+                                                bool ueSide)
+{
+    NS_LOG_FUNCTION(entity << imsi << cellId << ueSide);
+    Ptr<MmWaveBoundCallbackArgument> arg = Create<MmWaveBoundCallbackArgument>();
+    arg->imsi = imsi;
+    arg->cellId = cellId;
+    arg->stats = stats;
+    if (ueSide)
+    {
+        entity->TraceConnectWithoutContext("TxPDU", MakeBoundCallback(&UlTxPduCallback, arg));
+        entity->TraceConnectWithoutContext("RxPDU", MakeBoundCallback(&DlRxPduCallback, arg));
+    }
+    else
+    {
+        entity->TraceConnectWithoutContext("TxPDU", MakeBoundCallback(&DlTxPduCallback, arg));
+        entity->TraceConnectWithoutContext("RxPDU", MakeBoundCallback(&UlRxPduCallback, arg));
     }
 }
 
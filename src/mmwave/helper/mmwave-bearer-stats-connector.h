@@ -109,19 +109,36 @@ class MmWaveBearerStatsConnector : public Object
      */
     void EnsureConnected();
 
+    /**
+     * Connects the TxPDU and RxPDU trace sources of an RLC or PDCP entity to
+     * a calculator, with the IMSI and cell ID bound as integers. No Config
+     * path is involved, so this can also be used on entities created at
+     * runtime, e.g., the RLC of a secondary mmWave cell.
+     * \param entity the LteRlc or LtePdcp instance
+     * \param stats the statistics calculator
+     * \param imsi the IMSI of the UE
+     * \param cellId the cell ID
+     * \param ueSide true if the entity belongs to the UE, i.e., TX is UL and RX is DL
+     */
+    static void ConnectBearerTraces(Ptr<Object> entity,
+                                    Ptr<MmWaveBearerStatsCalculator> stats,
+                                    uint64_t imsi,
+                                    uint16_t cellId,
+                                    bool ueSide);
+
     // trace sinks, to be used with MakeBoundCallback
 
     /**
      * Function hooked to RandomAccessSuccessful trace source at UE RRC,
      * which is fired upon successful completion of the random access procedure
      * \param c
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      */
     static void NotifyRandomAccessSuccessfulUe(MmWaveBearerStatsConnector* c,
-                                               std::string context,
+                                               Object* ueRrc,
                                                uint64_t imsi,
                                                uint16_t cellid,
                                                uint16_t rnti);
@@ -129,13 +146,13 @@ class MmWaveBearerStatsConnector : public Object
     /**
      * Sink connected source of UE Connection Setup trace. Not used.
      * \param c
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      */
     static void NotifyConnectionSetupUe(MmWaveBearerStatsConnector* c,
-                                        std::string context,
+                                        Object* ueRrc,
                                         uint64_t imsi,
                                         uint16_t cellid,
                                         uint16_t rnti);
@@ -144,13 +161,13 @@ class MmWaveBearerStatsConnector : public Object
      * Function hooked to ConnectionReconfiguration trace source at UE RRC,
      * which is fired upon RRC connection reconfiguration
      * \param c
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      */
     static void NotifyConnectionReconfigurationUe(MmWaveBearerStatsConnector* c,
-                                                  std::string context,
+                                                  Object* ueRrc,
                                                   uint64_t imsi,
                                                   uint16_t cellid,
                                                   uint16_t rnti);
@@ -159,14 +176,14 @@ class MmWaveBearerStatsConnector : public Object
      * Function hooked to HandoverStart trace source at UE RRC,
      * which is fired upon start of a handover procedure
      * \param c
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      * \param targetCellId
      */
     static void NotifyHandoverStartUe(MmWaveBearerStatsConnector* c,
-                                      std::string context,
+                                      Object* ueRrc,
                                       uint64_t imsi,
                                       uint16_t cellid,
                                       uint16_t rnti,
@@ -176,13 +193,13 @@ class MmWaveBearerStatsConnector : public Object
      * Function hooked to HandoverStart trace source at UE RRC,
      * which is fired upon successful termination of a handover procedure
      * \param c
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      */
     static void NotifyHandoverEndOkUe(MmWaveBearerStatsConnector* c,
-                                      std::string context,
+                                      Object* ueRrc,
                                       uint64_t imsi,
                                       uint16_t cellid,
                                       uint16_t rnti);
@@ -191,12 +208,12 @@ class MmWaveBearerStatsConnector : public Object
      * Function hooked to NewUeContext trace source at eNB RRC,
      * which is fired upon creation of a new UE context
      * \param c
-     * \param context
+     * \param enbRrc the RRC of the eNB
      * \param cellid
      * \param rnti
      */
     static void NotifyNewUeContextEnb(MmWaveBearerStatsConnector* c,
-                                      std::string context,
+                                      Object* enbRrc,
                                       uint16_t cellid,
                                       uint16_t rnti);
 
@@ -204,13 +221,13 @@ class MmWaveBearerStatsConnector : public Object
      * Function hooked to ConnectionReconfiguration trace source at eNB RRC,
      * which is fired upon RRC connection reconfiguration
      * \param c
-     * \param context
+     * \param enbRrc the RRC of the eNB
      * \param imsi
      * \param cellid
      * \param rnti
      */
     static void NotifyConnectionReconfigurationEnb(MmWaveBearerStatsConnector* c,
-                                                   std::string context,
+                                                   Object* enbRrc,
                                                    uint64_t imsi,
                                                    uint16_t cellid,
                                                    uint16_t rnti);
@@ -219,14 +236,14 @@ class MmWaveBearerStatsConnector : public Object
      * Function hooked to HandoverStart trace source at eNB RRC,
      * which is fired upon start of a handover procedure
      * \param c
-     * \param context
+     * \param enbRrc the RRC of the eNB
      * \param imsi
      * \param cellid
      * \param rnti
      * \param targetCellId
      */
     static void NotifyHandoverStartEnb(MmWaveBearerStatsConnector* c,
-                                       std::string context,
+                                       Object* enbRrc,
                                        uint64_t imsi,
                                        uint16_t cellid,
                                        uint16_t rnti,
@@ -236,38 +253,36 @@ class MmWaveBearerStatsConnector : public Object
      * Function hooked to HandoverEndOk trace source at eNB RRC,
      * which is fired upon successful termination of a handover procedure
      * \param c
-     * \param context
+     * \param enbRrc the RRC of the eNB
      * \param imsi
      * \param cellid
      * \param rnti
      */
     static void NotifyHandoverEndOkEnb(MmWaveBearerStatsConnector* c,
-                                       std::string context,
+                                       Object* enbRrc,
                                        uint64_t imsi,
                                        uint16_t cellid,
                                        uint16_t rnti);
 
     // TODO doc
     static void NotifySwitchToMmWaveUe(MmWaveBearerStatsConnector* c,
-                                       std::string context,
+                                       Object* ueRrc,
                                        uint64_t imsi,
                                        uint16_t cellId,
                                        uint16_t rnti);
 
     static void NotifySecondaryMmWaveEnbAvailable(MmWaveBearerStatsConnector* c,
-                                                  std::string context,
+                                                  Object* ueManager,
                                                   uint64_t imsi,
                                                   uint16_t cellId,
                                                   uint16_t rnti);
 
     static void NotifyMmWaveSinr(MmWaveBearerStatsConnector* c,
-                                 std::string context,
                                  uint64_t imsi,
                                  uint16_t cellId,
                                  long double sinr);
     void PrintMmWaveSinr(uint64_t imsi, uint16_t cellId, long double sinr);
     static void NotifyLteSinr(MmWaveBearerStatsConnector* c,
-                              std::string context,
                               uint16_t cellId,
                               uint16_t rnti,
                               double rsrp,
@@ -293,32 +308,32 @@ class MmWaveBearerStatsConnector : public Object
 
   private:
     /**
-     * Creates UE Manager path and stores it in m_ueManagerPathByCellIdRnti
-     * \param ueManagerPath
+     * Stores the UE Manager of a new UE context in m_ueManagerByCellIdRnti
+     * \param enbRrc the LteEnbRrc that fired the NewUeContext trace source
      * \param cellId
      * \param rnti
      */
-    void StoreUeManagerPath(std::string ueManagerPath, uint16_t cellId, uint16_t rnti);
+    void StoreUeManager(Ptr<Object> enbRrc, uint16_t cellId, uint16_t rnti);
 
     /**
      * Connects Srb0 trace sources at UE and eNB to RLC and PDCP calculators,
      * and Srb1 trace sources at eNB to RLC and PDCP calculators,
-     * \param ueRrcPath
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellId
      * \param rnti
      */
-    void ConnectSrb0Traces(std::string ueRrcPath, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    void ConnectSrb0Traces(Ptr<Object> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
     /**
      * Connects all trace sources at UE to RLC and PDCP calculators.
      * This function can connect traces only once for UE.
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      */
-    void ConnectTracesUeIfFirstTime(std::string context,
+    void ConnectTracesUeIfFirstTime(Ptr<Object> ueRrc,
                                     uint64_t imsi,
                                     uint16_t cellid,
                                     uint16_t rnti);
@@ -326,87 +341,87 @@ class MmWaveBearerStatsConnector : public Object
     /**
      * Connects all trace sources at eNB to RLC and PDCP calculators.
      * This function can connect traces only once for eNB.
-     * \param context
+     * \param enbRrc the RRC of the eNB
      * \param imsi
      * \param cellid
      * \param rnti
      */
-    void ConnectTracesEnbIfFirstTime(std::string context,
+    void ConnectTracesEnbIfFirstTime(Ptr<Object> enbRrc,
                                      uint64_t imsi,
                                      uint16_t cellid,
                                      uint16_t rnti);
 
     /**
      * Connects DRBs trace sources at UE to RLC and PDCP calculators.
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      */
-    void ConnectDrbTracesUe(std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+    void ConnectDrbTracesUe(Ptr<Object> ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
     /**
      * Connects SRB1 trace sources at UE to RLC and PDCP calculators
-     * \param ueRrcPath
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellId
      * \param rnti
      */
-    void ConnectSrb1TracesUe(std::string ueRrcPath, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    void ConnectSrb1TracesUe(Ptr<Object> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
     /**
      * Disconnects all trace sources at UE to RLC and PDCP calculators.
      * Function is not implemented.
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      */
-    void DisconnectTracesUe(std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+    void DisconnectTracesUe(Ptr<Object> ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
     /**
      * Disconnects DRB trace sources at UE to RLC and PDCP calculators.
      * Function is not implemented.
-     * \param context
+     * \param ueRrc the RRC of the UE
      * \param imsi
      * \param cellid
      * \param rnti
      */
-    void DisconnectDrbTracesUe(std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+    void DisconnectDrbTracesUe(Ptr<Object> ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
     /**
      * Connects SRB1 trace sources at eNB to RLC and PDCP calculators
-     * \param context
+     * \param enbRrc the RRC of the eNB
      * \param imsi
      * \param cellid
      * \param rnti
      */
-    void ConnectSrb1TracesEnb(std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+    void ConnectSrb1TracesEnb(Ptr<Object> enbRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
     /**
      * Connects DRBs trace sources at eNB to RLC and PDCP calculators
-     * \param context
+     * \param enbRrc the RRC of the eNB
      * \param imsi
      * \param cellid
      * \param rnti
      */
-    void ConnectDrbTracesEnb(std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+    void ConnectDrbTracesEnb(Ptr<Object> enbRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
     /**
      * Disconnects all trace sources at eNB to RLC and PDCP calculators.
      * Function is not implemented.
-     * \param context
+     * \param enbRrc the RRC of the eNB
      * \param imsi
      * \param cellid
      * \param rnti
      */
-    void DisconnectTracesEnb(std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+    void DisconnectTracesEnb(Ptr<Object> enbRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
-    void ConnectSecondaryTracesUe(std::string context,
+    void ConnectSecondaryTracesUe(Ptr<Object> ueRrc,
                                   uint64_t imsi,
                                   uint16_t cellId,
                                   uint16_t rnti);
-    void ConnectSecondaryTracesEnb(std::string context,
+    void ConnectSecondaryTracesEnb(Ptr<Object> ueManager,
                                    uint64_t imsi,
                                    uint16_t cellId,
                                    uint16_t rnti);
@@ -442,7 +457,7 @@ class MmWaveBearerStatsConnector : public Object
         m_imsiSeenEnbDrb; //!< stores all eNBs for which RLC and PDCP traces for DRBs were connected
 
     /**
-     * Struct used as key in m_ueManagerPathByCellIdRnti map
+     * Struct used as key in m_ueManagerByCellIdRnti map
      */
     struct CellIdRnti
     {
@@ -456,9 +471,9 @@ class MmWaveBearerStatsConnector : public Object
     friend bool operator<(const CellIdRnti& a, const CellIdRnti& b);
 
     /**
-     * List UE Manager Paths by CellIdRnti
+     * List UE Managers by CellIdRnti
      */
-    std::map<CellIdRnti, std::string> m_ueManagerPathByCellIdRnti;
+    std::map<CellIdRnti, Ptr<Object>> m_ueManagerByCellIdRnti;
 
     std::string m_enbHandoverStartFilename;
     std::string m_enbHandoverEndFilename;
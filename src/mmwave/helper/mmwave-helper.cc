@@ -49,11 +49,16 @@
 #include <ns3/lte-enb-component-carrier-manager.h>
 #include <ns3/lte-spectrum-phy.h>
 #include <ns3/lte-ue-component-carrier-manager.h>
+#include <ns3/lte-ue-mac.h>
+#include <ns3/lte-ue-phy.h>
 #include <ns3/mmwave-beamforming-model.h>
+#include <ns3/mmwave-component-carrier-ue.h>
 #include <ns3/mmwave-lte-rrc-protocol-real.h>
 #include <ns3/mmwave-propagation-loss-model.h>
 #include <ns3/mmwave-rrc-protocol-ideal.h>
+#include <ns3/mmwave-ue-mac.h>
 #include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/node-list.h>
 #include <ns3/object-map.h>
 #include <ns3/pointer.h>
 #include <ns3/string.h>
@@ -2993,12 +2998,136 @@ MmWaveHelper::EnableTraces(void)
     EnableMcTraces();
 }
 
+int64_t
+MmWaveHelper::AssignStreams(NetDeviceContainer c, int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    int64_t currentStream = stream;
+    for (NetDeviceContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        Ptr<NetDevice> netDevice = (*i);
+        if (Ptr<MmWaveEnbNetDevice> mmWaveEnb = DynamicCast<MmWaveEnbNetDevice>(netDevice))
+        {
+            for (const auto& cc : mmWaveEnb->GetCcMap())
+            {
+                Ptr<MmWaveComponentCarrierEnb> ccEnb =
+                    DynamicCast<MmWaveComponentCarrierEnb>(cc.second);
+                currentStream += ccEnb->GetPhy()->AssignStreams(currentStream);
+            }
+        }
+        else if (Ptr<MmWaveUeNetDevice> mmWaveUe = DynamicCast<MmWaveUeNetDevice>(netDevice))
+        {
+            for (const auto& cc : mmWaveUe->GetCcMap())
+            {
+                Ptr<MmWaveComponentCarrierUe> ccUe =
+                    DynamicCast<MmWaveComponentCarrierUe>(cc.second);
+                currentStream += ccUe->GetPhy()->AssignStreams(currentStream);
+                currentStream += ccUe->GetMac()->AssignStreams(currentStream);
+            }
+        }
+        else if (Ptr<McUeNetDevice> mcUe = DynamicCast<McUeNetDevice>(netDevice))
+        {
+            for (const auto& cc : mcUe->GetMmWaveCcMap())
+            {
+                currentStream += cc.second->GetPhy()->AssignStreams(currentStream);
+                currentStream += cc.second->GetMac()->AssignStreams(currentStream);
+            }
+            for (const auto& cc : mcUe->GetLteCcMap())
+            {
+                Ptr<LteUePhy> ltePhy = cc.second->GetPhy();
+                currentStream += ltePhy->GetDownlinkSpectrumPhy()->AssignStreams(currentStream);
+                currentStream += ltePhy->GetUplinkSpectrumPhy()->AssignStreams(currentStream);
+                currentStream += cc.second->GetMac()->AssignStreams(currentStream);
+            }
+        }
+        else if (Ptr<LteEnbNetDevice> lteEnb = DynamicCast<LteEnbNetDevice>(netDevice))
+        {
+            for (const auto& cc : lteEnb->GetCcMap())
+            {
+                Ptr<LteEnbPhy> ltePhy = cc.second->GetPhy();
+                currentStream += ltePhy->GetDownlinkSpectrumPhy()->AssignStreams(currentStream);
+                currentStream += ltePhy->GetUplinkSpectrumPhy()->AssignStreams(currentStream);
+            }
+        }
+    }
+    if (m_phyStats)
+    {
+        currentStream += m_phyStats->AssignStreams(currentStream);
+    }
+    return (currentStream - stream);
+}
+
+/**
+ * Collect the component carriers of the mmWave eNB devices installed so far.
+ * The trace sinks are bound to their PHY and MAC directly, which avoids
+ * matching wildcard Config paths over all the nodes and passing a context
+ * string to the sinks at every event.
+ */
+static std::vector<Ptr<MmWaveComponentCarrierEnb>>
+GetInstalledEnbCcs(void)
+{
+    std::vector<Ptr<MmWaveComponentCarrierEnb>> ccs;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node)
+    {
+        for (uint32_t i = 0; i < (*node)->GetNDevices(); ++i)
+        {
+            Ptr<MmWaveEnbNetDevice> enb = DynamicCast<MmWaveEnbNetDevice>((*node)->GetDevice(i));
+            if (enb)
+            {
+                for (const auto& cc : enb->GetCcMap())
+                {
+                    ccs.push_back(DynamicCast<MmWaveComponentCarrierEnb>(cc.second));
+                }
+            }
+        }
+    }
+    return ccs;
+}
+
+/**
+ * Collect the component carriers of the mmWave UE devices installed so far
+ * \param includeMc whether to include the mmWave carriers of the MC UE devices
+ */
+static std::vector<Ptr<MmWaveComponentCarrierUe>>
+GetInstalledUeCcs(bool includeMc)
+{
+    std::vector<Ptr<MmWaveComponentCarrierUe>> ccs;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node)
+    {
+        for (uint32_t i = 0; i < (*node)->GetNDevices(); ++i)
+        {
+            Ptr<NetDevice> device = (*node)->GetDevice(i);
+            if (Ptr<MmWaveUeNetDevice> ue = DynamicCast<MmWaveUeNetDevice>(device))
+            {
+                for (const auto& cc : ue->GetCcMap())
+                {
+                    ccs.push_back(DynamicCast<MmWaveComponentCarrierUe>(cc.second));
+                }
+            }
+            else if (Ptr<McUeNetDevice> mcUe = DynamicCast<McUeNetDevice>(device))
+            {
+                if (includeMc)
+                {
+                    for (const auto& cc : mcUe->GetMmWaveCcMap())
+                    {
+                        ccs.push_back(cc.second);
+                    }
+                }
+            }
+        }
+    }
+    return ccs;
+}
+
 void
 MmWaveHelper::EnableEnbSchedTrace()
 {
-    Config::ConnectWithoutContextFailSafe(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/MmWaveEnbMac/SchedulingTraceEnb",
-        MakeBoundCallback(&MmWaveMacTrace::ReportEnbSchedulingInfo, m_enbStats));
+    for (const auto& cc : GetInstalledEnbCcs())
+    {
+        cc->GetMac()->TraceConnectWithoutContext(
+            "SchedulingTraceEnb",
+            MakeBoundCallback(&MmWaveMacTrace::ReportEnbSchedulingInfo, m_enbStats));
+    }
 }
 
 // TODO traces for MC
@@ -3010,34 +3139,40 @@ MmWaveHelper::EnableDlPhyTrace(void)
     // Config::Connect ("/NodeList/*/DeviceList/*/MmWaveUePhy/ReportCurrentCellRsrpSinr",
     //      MakeBoundCallback (&MmWavePhyTrace::ReportCurrentCellRsrpSinrCallback, m_phyStats));
 
-    Config::ConnectWithoutContextFailSafe(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/MmWaveEnbPhy/ReportDlPhyTransmission",
-        MakeBoundCallback(&MmWavePhyTrace::ReportDlPhyTransmissionCallback, m_phyStats));
-
-    // regulare mmWave UE device
-    Config::ConnectFailSafe(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/MmWaveUePhy/DlSpectrumPhy/RxPacketTraceUe",
-        MakeBoundCallback(&MmWavePhyTrace::RxPacketTraceUeCallback, m_phyStats));
+    for (const auto& cc : GetInstalledEnbCcs())
+    {
+        cc->GetPhy()->TraceConnectWithoutContext(
+            "ReportDlPhyTransmission",
+            MakeBoundCallback(&MmWavePhyTrace::ReportDlPhyTransmissionCallback, m_phyStats));
+    }
 
-    // MC ue device
-    Config::ConnectFailSafe(
-        "/NodeList/*/DeviceList/*/MmWaveComponentCarrierMapUe/*/MmWaveUePhy/DlSpectrumPhy/"
-        "RxPacketTraceUe",
-        MakeBoundCallback(&MmWavePhyTrace::RxPacketTraceUeCallback, m_phyStats));
+    // regular mmWave UE and MC UE devices
+    for (const auto& cc : GetInstalledUeCcs(true))
+    {
+        cc->GetPhy()->GetDlSpectrumPhy()->TraceConnectWithoutContext(
+            "RxPacketTraceUe",
+            MakeBoundCallback(&MmWavePhyTrace::RxPacketTraceUeCallbackWithoutContext, m_phyStats));
+    }
 }
 
 void
 MmWaveHelper::EnableUlPhyTrace(void)
 {
     NS_LOG_FUNCTION_NOARGS();
-    Config::ConnectWithoutContextFailSafe(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/MmWaveUePhy/ReportUlPhyTransmission",
-        MakeBoundCallback(&MmWavePhyTrace::ReportUlPhyTransmissionCallback, m_phyStats));
+    for (const auto& cc : GetInstalledUeCcs(false))
+    {
+        cc->GetPhy()->TraceConnectWithoutContext(
+            "ReportUlPhyTransmission",
+            MakeBoundCallback(&MmWavePhyTrace::ReportUlPhyTransmissionCallback, m_phyStats));
+    }
 
-    Config::ConnectFailSafe(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/MmWaveEnbPhy/DlSpectrumPhy/"
-        "RxPacketTraceEnb",
-        MakeBoundCallback(&MmWavePhyTrace::RxPacketTraceEnbCallback, m_phyStats));
+    for (const auto& cc : GetInstalledEnbCcs())
+    {
+        cc->GetPhy()->GetDlSpectrumPhy()->TraceConnectWithoutContext(
+            "RxPacketTraceEnb",
+            MakeBoundCallback(&MmWavePhyTrace::RxPacketTraceEnbCallbackWithoutContext,
+                              m_phyStats));
+    }
 }
 
 void
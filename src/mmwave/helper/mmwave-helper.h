@@ -255,6 +255,19 @@ class MmWaveHelper : public Object
 
     void EnableTraces();
 
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by the PHY and MAC of the mmWave, MC UE and LTE eNB devices in c,
+     * and by the traces of the helper. Return the number of streams (possibly
+     * zero) that have been assigned.
+     *
+     * \param c NetDeviceContainer of the set of net devices for which the
+     *          random variables should be modified
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this helper
+     */
+    int64_t AssignStreams(NetDeviceContainer c, int64_t stream);
+
     void SetSchedulerType(std::string type);
     std::string GetSchedulerType() const;
 
@@ -34,9 +34,13 @@
 
 #include "mmwave-phy-trace.h"
 
+#include <ns3/boolean.h>
 #include <ns3/log.h>
 #include <ns3/simulator.h>
+#include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <limits>
 #include <stdio.h>
 
 namespace ns3
@@ -58,18 +62,69 @@ std::string MmWavePhyTrace::m_ulPhyTraceFilename{};
 std::ofstream MmWavePhyTrace::m_dlPhyTraceFile{};
 std::string MmWavePhyTrace::m_dlPhyTraceFilename{};
 
+bool MmWavePhyTrace::m_asyncOutput = false;
+Ptr<MmWaveTraceWriter> MmWavePhyTrace::m_writer = nullptr;
+uint16_t MmWavePhyTrace::m_rxPacketTraceStream = MmWavePhyTrace::NO_STREAM;
+uint16_t MmWavePhyTrace::m_ulPhyTraceStream = MmWavePhyTrace::NO_STREAM;
+uint16_t MmWavePhyTrace::m_dlPhyTraceStream = MmWavePhyTrace::NO_STREAM;
+
+static const char* RX_PACKET_TRACE_HEADER =
+    "DL/UL\ttime\tframe\tsubF\tslot\t1stSym\tsymbol#"
+    "\tcellId\trnti\tccId\ttbSize\tmcs\trv\tSINR(dB)\tcorrupt\tTBler";
+
+static const char* PHY_TRANSMISSION_TRACE_HEADER =
+    "frame\tsubF\tslot\trnti\tfirstSym\tnumSym\ttype\ttddMode\tretxNum\tccId";
+
+static const char* RX_AGGREGATE_HEADER =
+    "DL/UL\tstart\tend\tcellId\trnti\tnumTb\ttbBytes\tretx\tcorrupt\tBLER"
+    "\tmeanSINR(dB)\tminSINR(dB)\tmcsHistogram";
+
+MmWavePhyTrace::RxAggregate::RxAggregate()
+    : m_numTb(0),
+      m_numCorrupt(0),
+      m_numRetx(0),
+      m_tbBytes(0),
+      m_sinrSum(0.0),
+      m_sinrMin(std::numeric_limits<double>::infinity())
+{
+    m_mcsHistogram.fill(0);
+}
+
 MmWavePhyTrace::MmWavePhyTrace()
+    : m_rxAggregation(false),
+      m_rxReservoirSize(0),
+      m_rxReservoirSeen(0)
 {
+    m_rxReservoirRng = CreateObject<UniformRandomVariable>();
 }
 
 MmWavePhyTrace::~MmWavePhyTrace()
 {
+    m_rxWindowEvent.Cancel();
+    m_rxFlushEvent.Cancel();
     if (m_rxPacketTraceFile.is_open())
     {
         m_rxPacketTraceFile.close();
     }
 }
 
+void
+MmWavePhyTrace::DoDispose(void)
+{
+    NS_LOG_FUNCTION(this);
+    FlushRxAggregates();
+    m_rxFlushEvent.Cancel();
+    Object::DoDispose();
+}
+
+int64_t
+MmWavePhyTrace::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_rxReservoirRng->SetStream(stream);
+    return 1;
+}
+
 TypeId
 MmWavePhyTrace::GetTypeId(void)
 {
@@ -92,6 +147,34 @@ MmWavePhyTrace::GetTypeId(void)
                           StringValue("DlPhyTransmissionTrace.txt"),
                           MakeStringAccessor(&MmWavePhyTrace::SetDlPhyTxOutputFilename),
                           MakeStringChecker())
+            .AddAttribute("AsyncOutput",
+                          "If true, the traces are formatted and written to disk by the "
+                          "background MmWaveTraceWriter thread",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&MmWavePhyTrace::SetAsyncOutput),
+                          MakeBooleanChecker())
+            .AddAttribute("RxAggregation",
+                          "If true, the PHY receptions are aggregated per UE and aggregation "
+                          "window instead of being traced one line per TB",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&MmWavePhyTrace::m_rxAggregation),
+                          MakeBooleanChecker())
+            .AddAttribute("RxAggregationWindow",
+                          "Duration of the aggregation window of the PHY receptions",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&MmWavePhyTrace::m_rxAggregationWindow),
+                          MakeTimeChecker(NanoSeconds(1)))
+            .AddAttribute("RxReservoirSize",
+                          "Number of raw PHY receptions sampled (uniformly at random) in each "
+                          "aggregation window and written to the PHY reception trace",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MmWavePhyTrace::m_rxReservoirSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("RxAggregationFilename",
+                          "Name of the file where the aggregated PHY receptions will be saved.",
+                          StringValue("RxPacketTraceAggregated.txt"),
+                          MakeStringAccessor(&MmWavePhyTrace::m_rxAggregateFilename),
+                          MakeStringChecker())
 
         ;
     return tid;
@@ -118,6 +201,196 @@ MmWavePhyTrace::SetDlPhyTxOutputFilename(std::string fileName)
     m_dlPhyTraceFilename = fileName;
 }
 
+void
+MmWavePhyTrace::SetAsyncOutput(bool async)
+{
+    NS_LOG_INFO("Asynchronous PHY trace output: " << async);
+    m_asyncOutput = async;
+}
+
+void
+MmWavePhyTrace::UpdateWriter(void)
+{
+    Ptr<MmWaveTraceWriter> writer = MmWaveTraceWriter::Get();
+    if (writer != m_writer)
+    {
+        m_writer = writer;
+        m_rxPacketTraceStream = NO_STREAM;
+        m_ulPhyTraceStream = NO_STREAM;
+        m_dlPhyTraceStream = NO_STREAM;
+    }
+}
+
+void
+MmWavePhyTrace::WriteRxPacketTrace(std::ostream& os, const RxPacketTraceRecord& record)
+{
+    const RxPacketTraceParams& params = record.m_params;
+    os << (record.m_downlink ? "DL\t" : "UL\t") << record.m_time << "\t" << params.m_frameNum
+       << "\t" << +params.m_sfNum << "\t" << +params.m_slotNum << "\t" << +params.m_symStart
+       << "\t" << +params.m_numSym << "\t" << params.m_cellId << "\t" << params.m_rnti << "\t"
+       << +params.m_ccId << "\t" << params.m_tbSize << "\t" << +params.m_mcs << "\t"
+       << +params.m_rv << "\t" << 10 * std::log10(params.m_sinr)
+       << (record.m_downlink ? "\t" : " \t") << params.m_corrupt << "\t" << params.m_tbler
+       << "\n";
+}
+
+void
+MmWavePhyTrace::WritePhyTransmissionTrace(std::ostream& os, const PhyTransmissionTraceParams& param)
+{
+    os << +param.m_frameNum << "\t" << +param.m_sfNum << "\t" << +param.m_slotNum << "\t"
+       << +param.m_rnti << "\t" << +param.m_symStart << "\t" << +param.m_numSym << "\t"
+       << +param.m_ttiType << "\t" << +param.m_tddMode << "\t" << +param.m_rv << "\t"
+       << +param.m_ccId << "\n";
+}
+
+void
+MmWavePhyTrace::ReportRxPacketTrace(const RxPacketTraceRecord& record)
+{
+    if (m_asyncOutput)
+    {
+        UpdateWriter();
+        if (m_rxPacketTraceStream == NO_STREAM)
+        {
+            m_rxPacketTraceStream =
+                m_writer->OpenStream(m_rxPacketTraceFilename, RX_PACKET_TRACE_HEADER);
+        }
+        m_writer->Write<RxPacketTraceRecord, &MmWavePhyTrace::WriteRxPacketTrace>(
+            m_rxPacketTraceStream,
+            record);
+        return;
+    }
+
+    if (!m_rxPacketTraceFile.is_open())
+    {
+        m_rxPacketTraceFile.open(m_rxPacketTraceFilename.c_str());
+        m_rxPacketTraceFile << RX_PACKET_TRACE_HEADER << std::endl;
+        if (!m_rxPacketTraceFile.is_open())
+        {
+            NS_FATAL_ERROR("Could not open tracefile");
+        }
+    }
+    WriteRxPacketTrace(m_rxPacketTraceFile, record);
+    m_rxPacketTraceFile.flush();
+}
+
+void
+MmWavePhyTrace::AggregateRxPacketTrace(const RxPacketTraceRecord& record)
+{
+    if (m_rxFlushEvent.IsExpired())
+    {
+        // bound to a raw pointer, as a Ptr held by the event would keep this
+        // object alive through m_rxFlushEvent
+        m_rxFlushEvent = Simulator::ScheduleDestroy(&MmWavePhyTrace::FlushRxAggregates, this);
+    }
+
+    Time now = Simulator::Now();
+    if (now >= m_rxWindowStart + m_rxAggregationWindow)
+    {
+        FlushRxAggregates();
+        // align the windows to multiples of their duration
+        m_rxWindowStart = m_rxAggregationWindow * (now / m_rxAggregationWindow).GetHigh();
+    }
+    if (!m_rxWindowEvent.IsRunning())
+    {
+        // write the window when it expires, even if no other TB is received
+        m_rxWindowEvent = Simulator::Schedule(m_rxWindowStart + m_rxAggregationWindow - now,
+                                              &MmWavePhyTrace::FlushRxAggregates,
+                                              this);
+    }
+
+    const RxPacketTraceParams& params = record.m_params;
+    RxAggregate& aggregate = m_rxAggregates[RxAggregateKey(record.m_downlink,
+                                                           static_cast<uint16_t>(params.m_cellId),
+                                                           params.m_rnti)];
+    aggregate.m_numTb++;
+    aggregate.m_numCorrupt += params.m_corrupt ? 1 : 0;
+    aggregate.m_numRetx += params.m_rv > 0 ? 1 : 0;
+    aggregate.m_tbBytes += params.m_tbSize;
+    // average the linear SINR, converted to dB when the window is written
+    aggregate.m_sinrSum += params.m_sinr;
+    aggregate.m_sinrMin = std::min(aggregate.m_sinrMin, params.m_sinr);
+    aggregate.m_mcsHistogram[std::min(params.m_mcs, RxAggregate::MAX_MCS)]++;
+
+    // reservoir sampling (algorithm R) of the raw records of the window
+    if (m_rxReservoirSize > 0)
+    {
+        m_rxReservoirSeen++;
+        if (m_rxReservoir.size() < m_rxReservoirSize)
+        {
+            m_rxReservoir.push_back(record);
+        }
+        else
+        {
+            uint64_t slot = m_rxReservoirRng->GetInteger(0, m_rxReservoirSeen - 1);
+            if (slot < m_rxReservoirSize)
+            {
+                m_rxReservoir[slot] = record;
+            }
+        }
+    }
+}
+
+void
+MmWavePhyTrace::FlushRxAggregates(void)
+{
+    NS_LOG_FUNCTION(this);
+    m_rxWindowEvent.Cancel();
+    if (m_rxAggregates.empty())
+    {
+        return;
+    }
+
+    if (!m_rxAggregateFile.is_open())
+    {
+        m_rxAggregateFile.open(m_rxAggregateFilename.c_str());
+        if (!m_rxAggregateFile.is_open())
+        {
+            NS_FATAL_ERROR("Could not open tracefile");
+        }
+        m_rxAggregateFile << RX_AGGREGATE_HEADER << std::endl;
+    }
+
+    double start = m_rxWindowStart.GetSeconds();
+    double end = (m_rxWindowStart + m_rxAggregationWindow).GetSeconds();
+    for (const auto& entry : m_rxAggregates)
+    {
+        const RxAggregate& aggregate = entry.second;
+        m_rxAggregateFile << (std::get<0>(entry.first) ? "DL\t" : "UL\t") << start << "\t" << end
+                          << "\t" << std::get<1>(entry.first) << "\t" << std::get<2>(entry.first)
+                          << "\t" << aggregate.m_numTb << "\t" << aggregate.m_tbBytes << "\t"
+                          << aggregate.m_numRetx << "\t" << aggregate.m_numCorrupt << "\t"
+                          << static_cast<double>(aggregate.m_numCorrupt) / aggregate.m_numTb
+                          << "\t" << 10 * std::log10(aggregate.m_sinrSum / aggregate.m_numTb)
+                          << "\t" << 10 * std::log10(aggregate.m_sinrMin) << "\t";
+        // histogram as a comma-separated list of mcs:count, zero bins omitted
+        bool first = true;
+        for (uint8_t mcs = 0; mcs <= RxAggregate::MAX_MCS; mcs++)
+        {
+            if (aggregate.m_mcsHistogram[mcs] > 0)
+            {
+                m_rxAggregateFile << (first ? "" : ",") << +mcs << ":"
+                                  << aggregate.m_mcsHistogram[mcs];
+                first = false;
+            }
+        }
+        m_rxAggregateFile << "\n";
+    }
+    m_rxAggregateFile.flush();
+    m_rxAggregates.clear();
+
+    std::sort(m_rxReservoir.begin(),
+              m_rxReservoir.end(),
+              [](const RxPacketTraceRecord& a, const RxPacketTraceRecord& b) {
+                  return a.m_time < b.m_time;
+              });
+    for (const auto& record : m_rxReservoir)
+    {
+        ReportRxPacketTrace(record);
+    }
+    m_rxReservoir.clear();
+    m_rxReservoirSeen = 0;
+}
+
 void
 MmWavePhyTrace::ReportCurrentCellRsrpSinrCallback(Ptr<MmWavePhyTrace> phyStats,
                                                   std::string path,
@@ -196,6 +469,20 @@ void
 MmWavePhyTrace::ReportUlPhyTransmissionCallback(Ptr<MmWavePhyTrace> phyStats,
                                                 PhyTransmissionTraceParams param)
 {
+    if (m_asyncOutput)
+    {
+        UpdateWriter();
+        if (m_ulPhyTraceStream == NO_STREAM)
+        {
+            m_ulPhyTraceStream =
+                m_writer->OpenStream(m_ulPhyTraceFilename, PHY_TRANSMISSION_TRACE_HEADER);
+        }
+        m_writer->Write<PhyTransmissionTraceParams, &MmWavePhyTrace::WritePhyTransmissionTrace>(
+            m_ulPhyTraceStream,
+            param);
+        return;
+    }
+
     if (!m_ulPhyTraceFile.is_open())
     {
         m_ulPhyTraceFile.open(m_ulPhyTraceFilename.c_str());
@@ -203,22 +490,32 @@ MmWavePhyTrace::ReportUlPhyTransmissionCallback(Ptr<MmWavePhyTrace> phyStats,
         {
             NS_FATAL_ERROR("Could not open tracefile");
         }
-        m_ulPhyTraceFile
-            << "frame\tsubF\tslot\trnti\tfirstSym\tnumSym\ttype\ttddMode\tretxNum\tccId"
-            << std::endl;
+        m_ulPhyTraceFile << PHY_TRANSMISSION_TRACE_HEADER << std::endl;
     }
 
     // Trace the UL PHY transmission info
-    m_ulPhyTraceFile << +param.m_frameNum << "\t" << +param.m_sfNum << "\t" << +param.m_slotNum
-                     << "\t" << +param.m_rnti << "\t" << +param.m_symStart << "\t"
-                     << +param.m_numSym << "\t" << +param.m_ttiType << "\t" << +param.m_tddMode
-                     << "\t" << +param.m_rv << "\t" << +param.m_ccId << std::endl;
+    WritePhyTransmissionTrace(m_ulPhyTraceFile, param);
+    m_ulPhyTraceFile.flush();
 }
 
 void
 MmWavePhyTrace::ReportDlPhyTransmissionCallback(Ptr<MmWavePhyTrace> phyStats,
                                                 PhyTransmissionTraceParams param)
 {
+    if (m_asyncOutput)
+    {
+        UpdateWriter();
+        if (m_dlPhyTraceStream == NO_STREAM)
+        {
+            m_dlPhyTraceStream =
+                m_writer->OpenStream(m_dlPhyTraceFilename, PHY_TRANSMISSION_TRACE_HEADER);
+        }
+        m_writer->Write<PhyTransmissionTraceParams, &MmWavePhyTrace::WritePhyTransmissionTrace>(
+            m_dlPhyTraceStream,
+            param);
+        return;
+    }
+
     if (!m_dlPhyTraceFile.is_open())
     {
         m_dlPhyTraceFile.open(m_dlPhyTraceFilename.c_str());
@@ -226,16 +523,12 @@ MmWavePhyTrace::ReportDlPhyTransmissionCallback(Ptr<MmWavePhyTrace> phyStats,
         {
             NS_FATAL_ERROR("Could not open tracefile");
         }
-        m_dlPhyTraceFile
-            << "frame\tsubF\tslot\trnti\tfirstSym\tnumSym\ttype\ttddMode\tretxNum\tccId"
-            << std::endl;
+        m_dlPhyTraceFile << PHY_TRANSMISSION_TRACE_HEADER << std::endl;
     }
 
     // Trace the DL PHY transmission info
-    m_dlPhyTraceFile << +param.m_frameNum << "\t" << +param.m_sfNum << "\t" << +param.m_slotNum
-                     << "\t" << +param.m_rnti << "\t" << +param.m_symStart << "\t"
-                     << +param.m_numSym << "\t" << +param.m_ttiType << "\t" << +param.m_tddMode
-                     << "\t" << +param.m_rv << "\t" << +param.m_ccId << std::endl;
+    WritePhyTransmissionTrace(m_dlPhyTraceFile, param);
+    m_dlPhyTraceFile.flush();
 }
 
 void
@@ -243,25 +536,33 @@ MmWavePhyTrace::RxPacketTraceUeCallback(Ptr<MmWavePhyTrace> phyStats,
                                         std::string path,
                                         RxPacketTraceParams params)
 {
-    if (!m_rxPacketTraceFile.is_open())
+    RxPacketTraceUeCallbackWithoutContext(phyStats, params);
+}
+
+void
+MmWavePhyTrace::RxPacketTraceEnbCallback(Ptr<MmWavePhyTrace> phyStats,
+                                         std::string path,
+                                         RxPacketTraceParams params)
+{
+    RxPacketTraceEnbCallbackWithoutContext(phyStats, params);
+}
+
+void
+MmWavePhyTrace::RxPacketTraceUeCallbackWithoutContext(Ptr<MmWavePhyTrace> phyStats,
+                                                      RxPacketTraceParams params)
+{
+    RxPacketTraceRecord record;
+    record.m_params = params;
+    record.m_time = Simulator::Now().GetSeconds();
+    record.m_downlink = true;
+    if (phyStats->m_rxAggregation)
     {
-        m_rxPacketTraceFile.open(m_rxPacketTraceFilename.c_str());
-        m_rxPacketTraceFile << "DL/"
-                               "UL\ttime\tframe\tsubF\tslot\t1stSym\tsymbol#"
-                               "\tcellId\trnti\tccId\ttbSize\tmcs\trv\tSINR(dB)\tcorrupt\tTBler"
-                            << std::endl;
-        if (!m_rxPacketTraceFile.is_open())
-        {
-            NS_FATAL_ERROR("Could not open tracefile");
-        }
+        phyStats->AggregateRxPacketTrace(record);
+    }
+    else
+    {
+        ReportRxPacketTrace(record);
     }
-    m_rxPacketTraceFile << "DL\t" << Simulator::Now().GetSeconds() << "\t" << params.m_frameNum
-                        << "\t" << +params.m_sfNum << "\t" << +params.m_slotNum << "\t"
-                        << +params.m_symStart << "\t" << +params.m_numSym << "\t" << params.m_cellId
-                        << "\t" << params.m_rnti << "\t" << +params.m_ccId << "\t"
-                        << params.m_tbSize << "\t" << +params.m_mcs << "\t" << +params.m_rv << "\t"
-                        << 10 * std::log10(params.m_sinr) << "\t" << params.m_corrupt << "\t"
-                        << params.m_tbler << std::endl;
 
     if (params.m_corrupt)
     {
@@ -276,29 +577,21 @@ MmWavePhyTrace::RxPacketTraceUeCallback(Ptr<MmWavePhyTrace> phyStats,
 }
 
 void
-MmWavePhyTrace::RxPacketTraceEnbCallback(Ptr<MmWavePhyTrace> phyStats,
-                                         std::string path,
-                                         RxPacketTraceParams params)
+MmWavePhyTrace::RxPacketTraceEnbCallbackWithoutContext(Ptr<MmWavePhyTrace> phyStats,
+                                                       RxPacketTraceParams params)
 {
-    if (!m_rxPacketTraceFile.is_open())
+    RxPacketTraceRecord record;
+    record.m_params = params;
+    record.m_time = Simulator::Now().GetSeconds();
+    record.m_downlink = false;
+    if (phyStats->m_rxAggregation)
     {
-        m_rxPacketTraceFile.open(m_rxPacketTraceFilename.c_str());
-        m_rxPacketTraceFile << "DL/"
-                               "UL\ttime\tframe\tsubF\tslot\t1stSym\tsymbol#"
-                               "\tcellId\trnti\tccId\ttbSize\tmcs\trv\tSINR(dB)\tcorrupt\tTBler"
-                            << std::endl;
-        if (!m_rxPacketTraceFile.is_open())
-        {
-            NS_FATAL_ERROR("Could not open tracefile");
-        }
+        phyStats->AggregateRxPacketTrace(record);
+    }
+    else
+    {
+        ReportRxPacketTrace(record);
     }
-    m_rxPacketTraceFile << "UL\t" << Simulator::Now().GetSeconds() << "\t" << params.m_frameNum
-                        << "\t" << +params.m_sfNum << "\t" << +params.m_slotNum << "\t"
-                        << +params.m_symStart << "\t" << +params.m_numSym << "\t" << params.m_cellId
-                        << "\t" << params.m_rnti << "\t" << +params.m_ccId << "\t"
-                        << params.m_tbSize << "\t" << +params.m_mcs << "\t" << +params.m_rv << "\t"
-                        << 10 * std::log10(params.m_sinr) << " \t" << params.m_corrupt << "\t"
-                        << params.m_tbler << std::endl;
 
     if (params.m_corrupt)
     {
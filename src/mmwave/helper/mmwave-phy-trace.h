@@ -32,12 +32,21 @@
 
 #ifndef SRC_MMWAVE_HELPER_MMWAVE_PHY_TRACE_H_
 #define SRC_MMWAVE_HELPER_MMWAVE_PHY_TRACE_H_
+#include "mmwave-trace-writer.h"
+
+#include <ns3/event-id.h>
 #include <ns3/mmwave-phy-mac-common.h>
+#include <ns3/nstime.h>
 #include <ns3/object.h>
+#include <ns3/random-variable-stream.h>
 #include <ns3/spectrum-value.h>
 
+#include <array>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <tuple>
+#include <vector>
 
 namespace ns3
 {
@@ -67,6 +76,20 @@ class MmWavePhyTrace : public Object
                                          std::string path,
                                          RxPacketTraceParams param);
 
+    /**
+     * Same as RxPacketTraceUeCallback, to be connected without context
+     * directly to the MmWaveSpectrumPhy of the UE
+     */
+    static void RxPacketTraceUeCallbackWithoutContext(Ptr<MmWavePhyTrace> phyStats,
+                                                      RxPacketTraceParams param);
+
+    /**
+     * Same as RxPacketTraceEnbCallback, to be connected without context
+     * directly to the MmWaveSpectrumPhy of the eNB
+     */
+    static void RxPacketTraceEnbCallbackWithoutContext(Ptr<MmWavePhyTrace> phyStats,
+                                                       RxPacketTraceParams param);
+
     /**
      * Callback used to trace an UL PHY tranmission
      */
@@ -97,7 +120,100 @@ class MmWavePhyTrace : public Object
      */
     void SetDlPhyTxOutputFilename(std::string fileName);
 
+    /**
+     * Enables or disables the asynchronous output through the MmWaveTraceWriter
+     * \param async if true, the traces are written by the background writer thread
+     */
+    void SetAsyncOutput(bool async);
+
+    /**
+     * Write the summaries of the current aggregation window, together with the
+     * raw records sampled in it, and start a new window.
+     * Called automatically when a window expires and at Simulator::Destroy.
+     */
+    void FlushRxAggregates(void);
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model. Return the number of streams (possibly zero) that
+     * have been assigned.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    void DoDispose(void) override;
+
   private:
+    /**
+     * Record of the PHY reception trace
+     */
+    struct RxPacketTraceRecord
+    {
+        RxPacketTraceParams m_params; //!< the trace parameters
+        double m_time;                //!< reception time in seconds
+        bool m_downlink;              //!< true for DL receptions, false for UL
+    };
+
+    static void WriteRxPacketTrace(std::ostream& os, const RxPacketTraceRecord& record);
+    static void WritePhyTransmissionTrace(std::ostream& os,
+                                          const PhyTransmissionTraceParams& param);
+    static void ReportRxPacketTrace(const RxPacketTraceRecord& record);
+
+    /**
+     * Refresh the streams of the shared writer if it has been recreated since
+     * the last record, i.e., after a Simulator::Destroy
+     */
+    static void UpdateWriter(void);
+
+    /**
+     * Per-UE statistics of the TBs received in an aggregation window
+     */
+    struct RxAggregate
+    {
+        static constexpr uint8_t MAX_MCS = 31;
+
+        RxAggregate();
+
+        uint32_t m_numTb;                                 //!< number of TBs
+        uint32_t m_numCorrupt;                            //!< number of corrupted TBs
+        uint32_t m_numRetx;                               //!< number of HARQ retransmissions
+        uint64_t m_tbBytes;                               //!< sum of the TB sizes
+        double m_sinrSum;                                 //!< sum of the linear TB SINRs
+        double m_sinrMin;                                 //!< minimum linear TB SINR
+        std::array<uint32_t, MAX_MCS + 1> m_mcsHistogram; //!< number of TBs per MCS
+    };
+
+    /**
+     * Direction (true for DL), cell ID and RNTI of an aggregate. The PHY
+     * reception trace does not carry the IMSI, and the RNTI identifies the UE
+     * within the cell: after a handover, the UE is aggregated under the new
+     * cell ID and RNTI, as in the raw trace.
+     */
+    typedef std::tuple<bool, uint16_t, uint16_t> RxAggregateKey;
+
+    /**
+     * Add a PHY reception to the aggregates of the current window and sample
+     * it in the reservoir
+     * \param record the PHY reception
+     */
+    void AggregateRxPacketTrace(const RxPacketTraceRecord& record);
+
+    bool m_rxAggregation;                                 //!< aggregate the PHY reception trace
+    Time m_rxAggregationWindow;                           //!< duration of an aggregation window
+    uint32_t m_rxReservoirSize;                           //!< raw records sampled per window
+    std::string m_rxAggregateFilename;                    //!< output filename for the summaries
+    std::ofstream m_rxAggregateFile;                      //!< output stream for the summaries
+    Time m_rxWindowStart;                                 //!< start of the current window
+    EventId m_rxWindowEvent;                              //!< flush at the end of the window
+    EventId m_rxFlushEvent;                               //!< flush at Simulator::Destroy
+    std::map<RxAggregateKey, RxAggregate> m_rxAggregates; //!< aggregates of the current window
+    std::vector<RxPacketTraceRecord> m_rxReservoir;       //!< raw records sampled in the window
+    uint64_t m_rxReservoirSeen;                           //!< records offered to the reservoir
+    Ptr<UniformRandomVariable> m_rxReservoirRng;          //!< RNG of the reservoir sampling
+
     // void ReportInterferenceTrace (uint64_t imsi, SpectrumValue& sinr);
     // void ReportDLTbSize (uint64_t imsi, uint64_t tbSize);
     static std::ofstream m_rxPacketTraceFile;   //!< Output stream for the PHY reception trace
@@ -108,6 +224,13 @@ class MmWavePhyTrace : public Object
 
     static std::ofstream m_dlPhyTraceFile;   //!< Output stream for the DL PHY transmission trace
     static std::string m_dlPhyTraceFilename; //!< Output filename for the DL PHY transmission trace
+
+    static bool m_asyncOutput;                //!< use the background trace writer
+    static Ptr<MmWaveTraceWriter> m_writer;   //!< writer owning the async streams
+    static const uint16_t NO_STREAM = 0xFFFF; //!< stream not opened yet
+    static uint16_t m_rxPacketTraceStream;    //!< writer stream of the PHY reception trace
+    static uint16_t m_ulPhyTraceStream;       //!< writer stream of the UL PHY transmission trace
+    static uint16_t m_dlPhyTraceStream;       //!< writer stream of the DL PHY transmission trace
 };
 
 } // namespace mmwave
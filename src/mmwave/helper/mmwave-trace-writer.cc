@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-trace-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/enum.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include <ns3/log.h>
+
+#include <chrono>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MmWaveTraceWriter");
+
+namespace mmwave
+{
+
+NS_OBJECT_ENSURE_REGISTERED(MmWaveTraceWriter);
+
+Ptr<MmWaveTraceWriter> MmWaveTraceWriter::m_instance = nullptr;
+
+MmWaveTraceWriter::MmWaveTraceWriter()
+    : m_queueSize(65536),
+      m_policy(BLOCK),
+      m_numStreams(0),
+      m_stop(false),
+      m_sleeping(false),
+      m_written(0),
+      m_enqueued(0),
+      m_dropped(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MmWaveTraceWriter::~MmWaveTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Stop();
+}
+
+TypeId
+MmWaveTraceWriter::GetTypeId(void)
+{
+    static TypeId tid =
+        TypeId("ns3::MmWaveTraceWriter")
+            .SetParent<Object>()
+            .AddConstructor<MmWaveTraceWriter>()
+            .SetGroupName("MmWave")
+            .AddAttribute("QueueSize",
+                          "Number of records that can be pending in the writer queue",
+                          UintegerValue(65536),
+                          MakeUintegerAccessor(&MmWaveTraceWriter::m_queueSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("BackPressurePolicy",
+                          "Behavior of the simulation thread when the writer queue is full",
+                          EnumValue(MmWaveTraceWriter::BLOCK),
+                          MakeEnumAccessor(&MmWaveTraceWriter::m_policy),
+                          MakeEnumChecker(MmWaveTraceWriter::BLOCK,
+                                          "Block",
+                                          MmWaveTraceWriter::DROP,
+                                          "Drop"));
+    return tid;
+}
+
+Ptr<MmWaveTraceWriter>
+MmWaveTraceWriter::Get(void)
+{
+    if (!m_instance)
+    {
+        m_instance = CreateObject<MmWaveTraceWriter>();
+        Simulator::ScheduleDestroy(&MmWaveTraceWriter::DestroyInstance);
+    }
+    return m_instance;
+}
+
+void
+MmWaveTraceWriter::DestroyInstance(void)
+{
+    if (m_instance)
+    {
+        m_instance->Dispose();
+        m_instance = nullptr;
+    }
+}
+
+void
+MmWaveTraceWriter::DoDispose(void)
+{
+    NS_LOG_FUNCTION(this);
+    Stop();
+    Object::DoDispose();
+}
+
+uint16_t
+MmWaveTraceWriter::OpenStream(std::string filename, std::string header)
+{
+    NS_LOG_FUNCTION(this << filename);
+    NS_ABORT_MSG_IF(m_numStreams >= MAX_STREAMS, "Too many trace streams");
+
+    std::unique_ptr<std::ofstream> stream(new std::ofstream(filename.c_str()));
+    if (!stream->is_open())
+    {
+        NS_FATAL_ERROR("Could not open tracefile " << filename);
+    }
+    if (!header.empty())
+    {
+        *stream << header << std::endl;
+    }
+    // the writer thread only reads the slot after popping a record for it
+    uint16_t streamId = m_numStreams++;
+    m_streams[streamId] = std::move(stream);
+    Start();
+    return streamId;
+}
+
+void
+MmWaveTraceWriter::Push(const TraceRecord& record)
+{
+    NS_ASSERT_MSG(m_queue, "Write called before OpenStream");
+    if (!m_queue->TryPush(record))
+    {
+        if (m_policy == DROP)
+        {
+            ++m_dropped;
+            return;
+        }
+        // wait for the writer thread to drain the queue
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.notify_one();
+        m_drainedCv.wait(lock, [this, &record] { return m_queue->TryPush(record); });
+    }
+    ++m_enqueued;
+    if (m_sleeping.load())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cv.notify_one();
+    }
+}
+
+void
+MmWaveTraceWriter::Flush(void)
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.notify_one();
+    m_drainedCv.wait(lock, [this] { return m_written.load() >= m_enqueued; });
+}
+
+uint64_t
+MmWaveTraceWriter::GetDroppedRecords(void) const
+{
+    return m_dropped;
+}
+
+void
+MmWaveTraceWriter::Start(void)
+{
+    if (m_thread.joinable())
+    {
+        return;
+    }
+    m_queue.reset(new SpscRingBuffer<TraceRecord>(m_queueSize));
+    m_stop = false;
+    m_thread = std::thread(&MmWaveTraceWriter::Run, this);
+}
+
+void
+MmWaveTraceWriter::Stop(void)
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_cv.notify_one();
+        }
+        m_thread.join();
+        NS_LOG_INFO("Trace writer stopped: " << m_written << " records written, " << m_dropped
+                                             << " dropped");
+    }
+    for (uint16_t i = 0; i < m_numStreams; i++)
+    {
+        m_streams[i]->close();
+        m_streams[i].reset();
+    }
+    m_numStreams = 0;
+}
+
+void
+MmWaveTraceWriter::Run(void)
+{
+    TraceRecord record;
+    while (true)
+    {
+        // the records are formatted and written without the mutex, so that
+        // Push, Flush and Stop never wait for the file I/O
+        while (m_queue->TryPop(record))
+        {
+            record.m_format(*m_streams[record.m_stream], record.m_payload);
+            m_written.fetch_add(1, std::memory_order_release);
+        }
+        // a thread waiting on m_drainedCv checks its predicate with the mutex
+        // held, so it either sees the drained queue or gets the notification
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_drainedCv.notify_all();
+        if (m_stop.load())
+        {
+            // a record may have been enqueued just before the stop request
+            if (m_queue->IsEmpty())
+            {
+                break;
+            }
+            continue;
+        }
+        m_sleeping = true;
+        if (m_queue->IsEmpty())
+        {
+            // the timeout covers a wake-up notified before m_sleeping was seen
+            m_cv.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        m_sleeping = false;
+    }
+}
+
+} // namespace mmwave
+
+} // namespace ns3
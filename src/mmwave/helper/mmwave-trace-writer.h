@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MMWAVE_TRACE_WRITER_H_
+#define MMWAVE_TRACE_WRITER_H_
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+namespace mmwave
+{
+
+/**
+ * \ingroup mmwave
+ * Bounded, lock-free, single-producer single-consumer ring buffer.
+ *
+ * The capacity is rounded up to the next power of two. TryPush must only be
+ * called by the producer thread and TryPop only by the consumer thread.
+ */
+template <typename T>
+class SpscRingBuffer
+{
+  public:
+    explicit SpscRingBuffer(uint32_t capacity)
+    {
+        uint32_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    bool TryPush(const T& item)
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+        {
+            return false; // full
+        }
+        m_slots[tail & m_mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& item)
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+        {
+            return false; // empty
+        }
+        item = m_slots[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    uint32_t GetCapacity() const
+    {
+        return m_mask + 1;
+    }
+
+  private:
+    std::vector<T> m_slots;
+    uint32_t m_mask;
+    alignas(64) std::atomic<uint64_t> m_head{0}; //!< next slot to be read (consumer)
+    alignas(64) std::atomic<uint64_t> m_tail{0}; //!< next slot to be written (producer)
+};
+
+/**
+ * \ingroup mmwave
+ * Fixed-size record exchanged between the simulation thread and the trace
+ * writer thread. The payload is a trivially copyable struct that is turned
+ * into text by m_format on the writer thread.
+ */
+struct TraceRecord
+{
+    static constexpr uint32_t PAYLOAD_SIZE = 112;
+    typedef void (*Formatter)(std::ostream& os, const void* payload);
+
+    Formatter m_format;                         //!< payload formatter
+    uint16_t m_stream;                          //!< destination stream
+    alignas(8) uint8_t m_payload[PAYLOAD_SIZE]; //!< raw record
+};
+
+/**
+ * \ingroup mmwave
+ * Background writer shared by the mmWave trace and stats calculators.
+ *
+ * Records are enqueued on the simulation thread and formatted and written to
+ * disk by a dedicated writer thread, so that file I/O never stalls event
+ * processing. All pending records are flushed and the files closed when
+ * Simulator::Destroy is called.
+ */
+class MmWaveTraceWriter : public Object
+{
+  public:
+    /// What to do when the queue is full
+    enum BackPressurePolicy
+    {
+        BLOCK, //!< wait for the writer thread to free a slot
+        DROP,  //!< discard the record and count it
+    };
+
+    MmWaveTraceWriter();
+    virtual ~MmWaveTraceWriter();
+
+    static TypeId GetTypeId(void);
+
+    /**
+     * Get the writer shared by all calculators, creating it if needed.
+     * The instance is released at Simulator::Destroy.
+     * \return the shared writer
+     */
+    static Ptr<MmWaveTraceWriter> Get(void);
+
+    /**
+     * Open an output file. Must be called on the simulation thread.
+     * \param filename the name of the file
+     * \param header line written at the top of the file (skipped if empty)
+     * \return the stream identifier to be used with Write
+     */
+    uint16_t OpenStream(std::string filename, std::string header);
+
+    /**
+     * Enqueue a record for stream streamId. F is invoked on the writer thread.
+     * \param streamId identifier returned by OpenStream
+     * \param record the record
+     */
+    template <typename T, void (*F)(std::ostream&, const T&)>
+    void Write(uint16_t streamId, const T& record);
+
+    /**
+     * Wait until all the records enqueued so far have been handed to their
+     * output streams.
+     */
+    void Flush(void);
+
+    /**
+     * \return the number of records discarded because of the DROP policy
+     */
+    uint64_t GetDroppedRecords(void) const;
+
+  protected:
+    void DoDispose(void) override;
+
+  private:
+    template <typename T, void (*F)(std::ostream&, const T&)>
+    static void Format(std::ostream& os, const void* payload)
+    {
+        T record;
+        std::memcpy(&record, payload, sizeof(T));
+        F(os, record);
+    }
+
+    void Push(const TraceRecord& record);
+    void Start(void);
+    void Stop(void);
+    void Run(void);
+    static void DestroyInstance(void);
+
+    static const uint16_t MAX_STREAMS = 64;
+
+    uint32_t m_queueSize;
+    BackPressurePolicy m_policy;
+
+    std::unique_ptr<SpscRingBuffer<TraceRecord>> m_queue;
+    /**
+     * Output streams. A slot is only written by OpenStream, before any record
+     * for it is enqueued, so the queue publishes it to the writer thread.
+     */
+    std::array<std::unique_ptr<std::ofstream>, MAX_STREAMS> m_streams;
+    uint16_t m_numStreams; //!< only accessed by the simulation thread
+    std::thread m_thread;
+    std::atomic<bool> m_stop;
+    std::atomic<bool> m_sleeping; //!< the writer thread is waiting on m_cv
+    std::atomic<uint64_t> m_written;
+    uint64_t m_enqueued; //!< only accessed by the simulation thread
+    uint64_t m_dropped;  //!< only accessed by the simulation thread
+    std::mutex m_mutex;                  //!< never held by the writer thread during I/O
+    std::condition_variable m_cv;        //!< wakes up the writer thread
+    std::condition_variable m_drainedCv; //!< notified when the writer drained the queue
+
+    static Ptr<MmWaveTraceWriter> m_instance;
+};
+
+template <typename T, void (*F)(std::ostream&, const T&)>
+void
+MmWaveTraceWriter::Write(uint16_t streamId, const T& record)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "trace records must be trivially copyable");
+    static_assert(sizeof(T) <= TraceRecord::PAYLOAD_SIZE, "trace record too large");
+    TraceRecord r;
+    r.m_format = &MmWaveTraceWriter::Format<T, F>;
+    r.m_stream = streamId;
+    std::memcpy(r.m_payload, &record, sizeof(T));
+    Push(r);
+}
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* MMWAVE_TRACE_WRITER_H_ */
@@ -636,7 +636,7 @@ MmWaveEnbMac::DoReceivePhyPdu(Ptr<Packet> p)
     std::map<uint16_t, std::map<uint8_t, LteMacSapUser*>>::iterator rntiIt =
         m_rlcAttached.find(rnti);
     NS_ASSERT_MSG(rntiIt != m_rlcAttached.end(), "could not find RNTI" << rnti);
-    std::vector<MacSubheader> macSubheaders = macHeader.GetSubheaders();
+    MacSubheaderSpan macSubheaders = macHeader.GetSubheaders();
     uint32_t currPos = 0;
     for (unsigned ipdu = 0; ipdu < macSubheaders.size(); ipdu++)
     {
@@ -838,8 +838,7 @@ MmWaveEnbMac::DoDlHarqFeedback(DlHarqInfo params)
     if (params.m_harqStatus == DlHarqInfo::ACK)
     {
         // discard buffer
-        Ptr<PacketBurst> emptyBuf = CreateObject<PacketBurst>();
-        (*it).second.at(params.m_harqProcessId).m_pktBurst = emptyBuf;
+        (*it).second.at(params.m_harqProcessId).m_pdu = nullptr;
         NS_LOG_DEBUG(this << " HARQ-ACK UE " << params.m_rnti << " harqId "
                           << (uint16_t)params.m_harqProcessId);
     }
@@ -980,9 +979,9 @@ MmWaveEnbMac::DoSchedConfigIndication(MmWaveMacSchedSapUser::SchedConfigIndParam
                     std::map<uint16_t, MmWaveDlHarqProcessesBuffer_t>::iterator harqIt =
                         m_miDlHarqProcessesPackets.find(rnti);
                     NS_ASSERT(harqIt != m_miDlHarqProcessesPackets.end());
-                    Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
-                    harqIt->second.at(tbUid).m_pktBurst = pb;
-                    harqIt->second.at(tbUid).m_lcidList.clear();
+                    MmWaveDlHarqProcessInfo& harqProcess = harqIt->second.at(tbUid);
+                    harqProcess.m_pdu = nullptr;
+                    harqProcess.m_lcidList.clear();
 
                     std::map<uint32_t, struct MacPduInfo>::iterator pduMapIt = mapRet.first;
                     pduMapIt->second.m_numRlcPdu = 0;
@@ -1005,7 +1004,7 @@ MmWaveEnbMac::DoSchedConfigIndication(MmWaveMacSchedSapUser::SchedConfigIndParam
                         txOpParams.rnti = rnti;
                         txOpParams.lcid = rlcPduInfo[ipdu].m_lcid;
                         (*lcidIt).second->NotifyTxOpportunity(txOpParams);
-                        harqIt->second.at(tbUid).m_lcidList.push_back(rlcPduInfo[ipdu].m_lcid);
+                        harqProcess.m_lcidList.push_back(rlcPduInfo[ipdu].m_lcid);
                     }
 
                     if (pduMapIt->second.m_numRlcPdu == 0)
@@ -1027,10 +1026,10 @@ MmWaveEnbMac::DoSchedConfigIndication(MmWaveMacSchedSapUser::SchedConfigIndParam
                     {
                         NS_LOG_DEBUG("Subheader "
                                      << i << " size "
-                                     << pduMapIt->second.m_macHeader.GetSubheaders().at(i).m_size);
+                                     << pduMapIt->second.m_macHeader.GetSubheaders()[i].m_size);
                     }
                     NS_LOG_DEBUG("Total MAC PDU size " << pduMapIt->second.m_pdu->GetSize());
-                    harqIt->second.at(tbUid).m_pktBurst->AddPacket(pduMapIt->second.m_pdu);
+                    harqProcess.m_pdu = pduMapIt->second.m_pdu;
 
                     m_txMacPacketTraceEnb(rnti,
                                           m_componentCarrierId,
@@ -1047,22 +1046,19 @@ MmWaveEnbMac::DoSchedConfigIndication(MmWaveMacSchedSapUser::SchedConfigIndParam
                         std::map<uint16_t, MmWaveDlHarqProcessesBuffer_t>::iterator it =
                             m_miDlHarqProcessesPackets.find(rnti);
                         NS_ASSERT(it != m_miDlHarqProcessesPackets.end());
-                        Ptr<PacketBurst> pb = it->second.at(tbUid).m_pktBurst;
-                        for (std::list<Ptr<Packet>>::const_iterator j = pb->Begin(); j != pb->End();
-                             ++j)
+                        Ptr<Packet> pkt = it->second.at(tbUid).m_pdu;
+                        if (pkt)
                         {
-                            Ptr<Packet> pkt = (*j)->Copy();
-                            MmWaveMacPduTag tag; // update PDU tag for retransmission
-                            if (!pkt->RemovePacketTag(tag))
+                            // update PDU tag for retransmission, the TB is sent again as it is
+                            MmWaveMacPduTag tag(SfnSf(ind.m_sfnSf.m_frameNum,
+                                                      ind.m_sfnSf.m_sfNum,
+                                                      ind.m_sfnSf.m_slotNum,
+                                                      dciElem.m_symStart),
+                                                dciElem.m_numSym);
+                            if (!pkt->ReplacePacketTag(tag))
                             {
                                 NS_FATAL_ERROR("No MAC PDU tag");
                             }
-                            tag.SetSfn(SfnSf(ind.m_sfnSf.m_frameNum,
-                                             ind.m_sfnSf.m_sfNum,
-                                             ind.m_sfnSf.m_slotNum,
-                                             dciElem.m_symStart));
-                            tag.SetNumSym(dciElem.m_numSym);
-                            pkt->AddPacketTag(tag);
 
                             m_txMacPacketTraceEnb(rnti, m_componentCarrierId, pkt->GetSize());
                             m_phySapProvider->SendMacPdu(pkt);
@@ -1124,16 +1120,7 @@ MmWaveEnbMac::DoAddUe(uint16_t rnti)
     m_macCschedSapProvider->CschedUeConfigReq(params);
 
     // Create DL transmission HARQ buffers
-    MmWaveDlHarqProcessesBuffer_t buf;
-    uint16_t harqNum = m_phyMacConfig->GetNumHarqProcess();
-    buf.resize(harqNum);
-    for (uint8_t i = 0; i < harqNum; i++)
-    {
-        Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
-        buf.at(i).m_pktBurst = pb;
-    }
-    m_miDlHarqProcessesPackets.insert(
-        std::pair<uint16_t, MmWaveDlHarqProcessesBuffer_t>(rnti, buf));
+    m_miDlHarqProcessesPackets[rnti].resize(m_phyMacConfig->GetNumHarqProcess());
 }
 
 void
@@ -49,9 +49,15 @@ namespace ns3
 namespace mmwave
 {
 
+/**
+ * Slot of a DL HARQ process. The MAC PDU of the TB is kept as transmitted,
+ * and the same packet is handed again to the PHY for each retransmission:
+ * only its MmWaveMacPduTag, which identifies the transmission, is replaced.
+ * The PHY never modifies the PDU, and the channel copies it for each receiver.
+ */
 struct MmWaveDlHarqProcessInfo
 {
-    Ptr<PacketBurst> m_pktBurst;
+    Ptr<Packet> m_pdu; // MAC PDU of the TB under transmission, null if none
     // maintain list of LCs contained in this TB
     // used to signal HARQ failure to RLC handlers
     std::vector<uint8_t> m_lcidList;
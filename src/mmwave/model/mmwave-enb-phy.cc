@@ -50,11 +50,11 @@
 #include <ns3/object-factory.h>
 #include <ns3/phased-array-model.h>
 #include <ns3/pointer.h>
+#include <ns3/profiler.h>
 #include <ns3/random-variable-stream.h>
 #include <ns3/simulator.h>
 
 #include <algorithm>
-#include <array>
 #include <cfloat>
 #include <cmath>
 #include <complex.h>
@@ -86,6 +86,7 @@ MmWaveEnbPhy::MmWaveEnbPhy(Ptr<MmWaveSpectrumPhy> dlPhy, Ptr<MmWaveSpectrumPhy>
 {
     m_enbCphySapProvider = new MemberLteEnbCphySapProvider<MmWaveEnbPhy>(this);
     m_roundFromLastUeSinrUpdate = 0;
+    m_sinrNoise = CreateObject<NormalRandomVariable>();
     Simulator::ScheduleNow(&MmWaveEnbPhy::StartSlot, this);
 }
 
@@ -200,7 +201,7 @@ MmWaveEnbPhy::DoInitialize(void)
     {
         NS_ASSERT_MSG(
             (double)m_transient / m_updateSinrPeriod >= 16,
-            "Window too small to compute the variance according to the ApplyFilter method");
+            "Window too small to detect the stable SINR periods of the filter");
     }
     Simulator::Schedule(MicroSeconds(0), &MmWaveEnbPhy::UpdateUeSinrEstimate, this);
     MmWavePhy::DoInitialize();
@@ -211,44 +212,6 @@ MmWaveEnbPhy::DoDispose(void)
 {
 }
 
-// TODO remove these methods
-// Function for average
-double
-MmWaveEnbPhy::MakeAvg(std::vector<double> v)
-{
-    double return_value = 0.0;
-    int n = v.size();
-
-    for (int i = 0; i < n; i++)
-    {
-        return_value += v.at(i);
-    }
-
-    return (return_value / v.size());
-}
-
-//****************End of average funtion****************
-
-// Function for variance
-double
-MmWaveEnbPhy::MakeVar(std::vector<double> v, double mean)
-{
-    double sum = 0.0;
-    double temp = 0.0;
-    double var = 0.0;
-    int n = v.size();
-
-    for (int j = 0; j < n; j++)
-    {
-        temp = std::pow((v.at(j) - mean), 2);
-        sum += temp;
-    }
-
-    return var = sum / (v.size());
-}
-
-//****************End of variance funtion****************
-
 double
 MmWaveEnbPhy::AddGaussianNoise(double LastSinrValue)
 {
@@ -257,9 +220,8 @@ MmWaveEnbPhy::AddGaussianNoise(double LastSinrValue)
     double signalEnergy;
     double noisySample;
 
-    Ptr<NormalRandomVariable> randomVariable = CreateObject<NormalRandomVariable>();
-    double gaussianSampleRe = randomVariable->GetValue();
-    double gaussianSampleIm = randomVariable->GetValue();
+    double gaussianSampleRe = m_sinrNoise->GetValue();
+    double gaussianSampleIm = m_sinrNoise->GetValue();
     gaussianNoise = std::complex<double>(sqrt(0.5) * sqrt(N0) * gaussianSampleRe,
                                          sqrt(0.5) * sqrt(N0) * gaussianSampleIm);
 
@@ -270,244 +232,15 @@ MmWaveEnbPhy::AddGaussianNoise(double LastSinrValue)
     return noisySample;
 }
 
-std::pair<uint64_t, uint64_t>
-MmWaveEnbPhy::ApplyFilter(std::vector<double> noisySinr)
-{
-    std::vector<double> noisySinrdB;
-    for (uint64_t i = 0; i < noisySinr.size(); ++i)
-    {
-        noisySinrdB.push_back(10 * std::log10(noisySinr.at(i)));
-    }
-
-    std::vector<double> vectorVar;
-    NS_LOG_DEBUG("noisySinrdBSize() " << noisySinrdB.size());
-    for (uint64_t i = 0; i < noisySinrdB.size() - 1; ++i)
-    {
-        std::vector<double> partialSamples;
-        partialSamples.push_back(noisySinrdB.at(i));
-        partialSamples.push_back(noisySinrdB.at(i + 1));
-        double meanValue = MakeAvg(partialSamples);
-        double varValue = MakeVar(partialSamples, meanValue);
-        vectorVar.push_back(varValue);
-        partialSamples.clear();
-    }
-
-    uint64_t startFilter = 1e6;
-    uint64_t endFilter = 1e6;
-
-    bool flagStartFilter = true;
-    bool flagEndFilter = true;
-
-    uint64_t noisySinrIndex = 0;
-
-    for (uint64_t varIndex = vectorVar.size() - 1; varIndex > 0;
-         varIndex--) // start filter when variance of the noisy trace is high
-    {
-        NS_LOG_DEBUG("varIndex " << varIndex);
-        noisySinrIndex = varIndex + 1;
-        NS_LOG_DEBUG("vectorVar[i] " << vectorVar.at(varIndex));
-        NS_LOG_DEBUG("vectorVar[i] == NaN " << (std::isnan(vectorVar.at(varIndex))));
-        bool highVariance = (vectorVar.at(varIndex) > 5 || std::isnan(vectorVar.at(varIndex)));
-        bool lowSinr = noisySinr.at(noisySinrIndex) < 10;
-
-        if (highVariance ||
-            (lowSinr && !highVariance)) // filter is applied only for low-SINR regimes [dB]
-        {
-            endFilter = noisySinrIndex;
-            flagEndFilter = false; // a "start" sample has been identified
-            break;
-        }
-    }
-
-    if (flagEndFilter) // in this case, we can avoid the filtering
-    {
-        endFilter = 0;
-    }
-
-    /* in this case, consider at least a window of 15 samples, after which we can consider
-     * as we are leaving the blockage phase and we start coming back to LOS PL regimes
-     */
-    uint64_t varIndex = 0;
-    uint64_t numberOfVarWindow = 16;
-    NS_LOG_DEBUG("VectorVarSize() " << vectorVar.size());
-    for (uint64_t noisySinrIndex = endFilter; noisySinrIndex > numberOfVarWindow;
-         --noisySinrIndex) // must be at least after the beginnning of the blocakge
-    {
-        NS_LOG_DEBUG("noisySinrIndex " << noisySinrIndex);
-        varIndex = noisySinrIndex - 1;
-
-        std::vector<double>::const_iterator first = vectorVar.begin() + varIndex;
-        std::vector<double>::const_iterator last =
-            vectorVar.begin() + varIndex -
-            (numberOfVarWindow - 1); // vectorVar has one sample less than noisySinrdB
-        std::vector<double> prov(last, first);
-
-        std::vector<double>::const_iterator firstNoisy = noisySinrdB.begin() + noisySinrIndex;
-        std::vector<double>::const_iterator lastNoisy =
-            noisySinrdB.begin() + noisySinrIndex - numberOfVarWindow;
-        std::vector<double> provNoisy(lastNoisy, firstNoisy);
-
-        NS_LOG_INFO("provNoisy.size " << provNoisy.size());
-        for (std::vector<double>::const_iterator h = provNoisy.begin(); h != provNoisy.end(); h++)
-        {
-            NS_LOG_INFO("h " << *h);
-            NS_LOG_INFO("i " << noisySinrIndex);
-            NS_LOG_INFO("hh " << *(noisySinrdB.begin() + noisySinrIndex - numberOfVarWindow));
-        }
-
-        /* the filtering ends when the variance of the noisy trace is almost the same, so when
-         * the SINR is on sufficiently high values
-         */
-
-        if (Simulator::Now() > Seconds(2.1) && Simulator::Now() < Seconds(2.3))
-        {
-            NS_LOG_DEBUG(
-                "(std::all_of(prov.begin(),prov.end(), [](double j){return j < 1;})) "
-                << (std::all_of(prov.begin(), prov.end(), [](double j) { return j < 1; })));
-            NS_LOG_DEBUG("(std::all_of(prov.begin(),prov.end(), [](double j){nan;})) "
-                         << (std::all_of(prov.begin(), prov.end(), [](double k) {
-                                return !std::isnan(k);
-                            })));
-            NS_LOG_DEBUG(
-                "(std::all_of(provNoisy.begin(),provNoisy.end(), [](double p){return p > 10;})) "
-                << (std::all_of(provNoisy.begin(), provNoisy.end(), [](double p) {
-                       return p > 10;
-                   })));
-        }
-
-        if (((std::all_of(prov.begin(), prov.end(), [](double j) { return j < 1; })) &&
-             (std::all_of(prov.begin(), prov.end(), [](double k) { return !std::isnan(k); }))) ||
-            (std::all_of(provNoisy.begin(), provNoisy.end(), [](double p) { return p > 10; })))
-        {
-            startFilter = noisySinrIndex;
-            flagStartFilter = false; // a "end" sample has been identified
-            break;
-        }
-
-        // bool lowVariance = (vectorVar.at(varIndex) < 1 && !std::isnan(vectorVar.at(varIndex)));
-        // bool highSinr = noisySinr.at(noisySinrIndex) > 10;
-
-        // if (highSinr && lowVariance)  // filter is applied only for low-SINR regimes [dB]
-        // {
-        //        startFilter = noisySinrIndex;
-        //        flagStartFilter = false; // a "start" sample has been identified
-        //        break;
-        // }
-    }
-
-    if (flagStartFilter) // in this case, filter till the end of the trace
-    {
-        startFilter = 0;
-    }
-
-    std::pair<uint64_t, uint64_t> pairFiltering = std::make_pair(startFilter, endFilter);
-
-    return pairFiltering;
-}
-
-std::vector<double>
-MmWaveEnbPhy::MakeFilter(std::vector<double> noisySinr,
-                         std::vector<double> realSinr,
-                         std::pair<uint64_t, uint64_t> pairFiltering)
+int64_t
+MmWaveEnbPhy::AssignStreams(int64_t stream)
 {
-    for (uint64_t i = 0; i < noisySinr.size(); ++i)
-    {
-        NS_LOG_DEBUG("() " << noisySinr.at(i));
-    }
-    // const uint64_t lengthFiltering  = (std::get<1>(pairFiltering) - std::get<0>(pairFiltering));
-    /* find best alpha parameter for the Kalman estimation */
-    int rep = 0;
-    std::array<double, 100> meanError;
-    for (double alpha = 0; alpha < 1; alpha = alpha + 0.01)
-    {
-        std::vector<double> x;
-        x.push_back(0); // initialization of array
-        int counter = 0;
-
-        for (uint64_t i = std::get<0>(pairFiltering); i < std::get<1>(pairFiltering); i++)
-        {
-            x.push_back((1 - alpha) * x.at(counter) + alpha * (noisySinr.at(i)));
-            counter++;
-        }
-
-        std::vector<double> errorEstimation;
-        counter = 0;
-        for (uint64_t i = std::get<0>(pairFiltering); i < std::get<1>(pairFiltering); i++)
-        {
-            errorEstimation.push_back(std::abs(x.at(counter + 1) - realSinr.at(i)));
-            counter++;
-        }
-
-        meanError.at(rep) = MakeAvg(errorEstimation);
-        if (Simulator::Now() > Seconds(2.1) && Simulator::Now() < Seconds(2.3))
-        {
-            NS_LOG_DEBUG("meanError " << meanError.at(rep) << " rep " << rep);
-        }
-        rep++;
-    }
-
-    int posMinAlpha =
-        std::distance(meanError.begin(), std::min_element(meanError.begin(), meanError.end()));
-    double minAlpha = (posMinAlpha + 1) * 0.01;
-    if (minAlpha > 0.5)
-    {
-        minAlpha = 0.2;
-    }
-    NS_LOG_DEBUG("! " << minAlpha);
-
-    std::vector<double> blockageTrace;
-    blockageTrace.push_back(0);
-    int counter = 0;
-    for (uint64_t i = std::get<0>(pairFiltering); i < std::get<1>(pairFiltering); i++)
-    {
-        NS_LOG_DEBUG(noisySinr.at(i));
-        blockageTrace.push_back((1 - minAlpha) * blockageTrace.at(counter) +
-                                minAlpha * (noisySinr.at(i)));
-        NS_LOG_DEBUG("fff " << blockageTrace.at(counter));
-        counter++;
-    }
-
-    std::vector<double> retFinalTrace;
-    /* first piece */
-    std::vector<double>::const_iterator firstPieceStart = noisySinr.begin();
-    std::vector<double>::const_iterator firstPieceEnd =
-        noisySinr.begin() + std::get<0>(pairFiltering) + 1;
-    std::vector<double> firstPiece;
-    firstPiece.insert(firstPiece.begin(), firstPieceStart, firstPieceEnd);
-    for (std::vector<double>::const_iterator i = firstPiece.begin(); i != firstPiece.end(); i++)
-    {
-        NS_LOG_DEBUG("/ " << *i);
-    }
-
-    /*last piece*/
-    std::vector<double>::const_iterator lastPieceStart =
-        noisySinr.begin() + std::get<1>(pairFiltering) + 1;
-    std::vector<double>::const_iterator lastPieceEnd = noisySinr.end();
-    std::vector<double> lastPiece;
-
-    firstPiece.insert(firstPiece.end(), blockageTrace.begin() + 1, blockageTrace.end() - 1);
-    for (std::vector<double>::const_iterator i = firstPiece.begin(); i != firstPiece.end(); i++)
-    {
-        NS_LOG_DEBUG("// " << *i);
-    }
-
-    firstPiece.insert(firstPiece.end(), lastPieceStart, lastPieceEnd);
-    for (std::vector<double>::const_iterator i = firstPiece.begin(); i != firstPiece.end(); i++)
-    {
-        NS_LOG_DEBUG("/// " << *i);
-    }
-
-    /* insert blockageTrace (from begin + 1, in order to AVOID THE TRANSIENT, to end) in the
-     * noisySinr trace, after std::get<0>(pairFiltering) +1 samples, which are the samples in which
-     * we estimate that a blockage occurs and the Kalmn filter is applied
-     */
-    // std::copy(blockageTrace.begin(),blockageTrace.end(),noisySinr.begin()+std::get<0>(pairFiltering)
-    // );
-    // std::copy(blockageTrace.begin()+1,blockageTrace.end(),noisySinr.begin()+std::get<0>(pairFiltering)+1
-    // ); // AVOID TRANSIENT
-
-    return firstPiece; // this noisySinr trace has already been updated with the filtered samples,
-                       // where applied.
+    NS_LOG_FUNCTION(this << stream);
+    int64_t currentStream = stream;
+    m_sinrNoise->SetStream(currentStream++);
+    currentStream += m_downlinkSpectrumPhy->AssignStreams(currentStream);
+    currentStream += m_uplinkSpectrumPhy->AssignStreams(currentStream);
+    return (currentStream - stream);
 }
 
 void
@@ -583,14 +316,14 @@ void
 MmWaveEnbPhy::UpdateUeSinrEstimate()
 {
     NS_LOG_FUNCTION(this);
+    NS_PROFILE_SCOPE("mmwave", "MmWaveEnbPhy::UpdateUeSinrEstimate");
 
     m_sinrMap.clear();
     m_rxPsdMap.clear();
 
     Ptr<SpectrumValue> noisePsd =
         MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity(m_phyMacConfig, m_noiseFigure);
-    Ptr<SpectrumValue> totalReceivedPsd =
-        Create<SpectrumValue>(SpectrumValue(noisePsd->GetSpectrumModel()));
+    Ptr<SpectrumValue> totalReceivedPsd = Create<SpectrumValue>(noisePsd->GetSpectrumModel());
 
     for (std::map<uint64_t, Ptr<NetDevice>>::iterator ue = m_ueAttachedImsiMap.begin();
          ue != m_ueAttachedImsiMap.end();
@@ -665,8 +398,9 @@ MmWaveEnbPhy::UpdateUeSinrEstimate()
         Ptr<PhasedArrayModel> txPam =
             DynamicCast<PhasedArrayModel>(uePhy->GetDlSpectrumPhy()->GetAntenna());
 
+        // the spectrum propagation loss models do not modify the PSD of the parameters
         Ptr<SpectrumSignalParameters> rxParams = Create<SpectrumSignalParameters>();
-        rxParams->psd = rxPsd->Copy();
+        rxParams->psd = rxPsd;
 
         if (m_spectrumPropagationLossModel)
         {
@@ -712,9 +446,9 @@ MmWaveEnbPhy::UpdateUeSinrEstimate()
          ue != m_rxPsdMap.end();
          ++ue)
     {
-        SpectrumValue interference = *totalReceivedPsd - *(ue->second);
-        NS_LOG_LOGIC("interference " << interference);
-        SpectrumValue sinr = *(ue->second) / (*noisePsd); // + interference);
+        NS_LOG_LOGIC("interference " << (*totalReceivedPsd - *(ue->second)));
+        SpectrumValue sinr = *(ue->second);
+        sinr /= *noisePsd; // + interference);
         // we consider the SNR only!
         NS_LOG_LOGIC("sinr " << sinr);
         double sinrAvg = Sum(sinr) / (sinr.GetSpectrumModel()->GetNumBands());
@@ -723,167 +457,22 @@ MmWaveEnbPhy::UpdateUeSinrEstimate()
 
         if (m_noiseAndFilter)
         {
-            pairDevices_t pairDevices =
-                std::make_pair(ue->first, m_cellId);            // this is the current pair (UE-eNB)
-            auto iteratorSinr = m_sinrVector.find(pairDevices); // pair [pairDevices,Sinrvalue]
-            if (iteratorSinr != m_sinrVector.end()) // this map has already been initialized, so I
-                                                    // can add a new element for the SINR collection
-            {
-                if (Now().GetMicroSeconds() <= m_transient)
-                {
-                    m_sinrVector.at(pairDevices)
-                        .push_back(sinrAvg); // before transient, so just collect SINR values
-                }
-                else
-                {
-                    m_sinrVector.at(pairDevices).erase(m_sinrVector.at(pairDevices).begin());
-                    m_sinrVector.at(pairDevices)
-                        .push_back(sinrAvg); // before transient, so just collect SINR values
-                }
-
-                NS_LOG_DEBUG("At time " << Now().GetMicroSeconds() << " push back the REAL SINR "
-                                        << 10 * std::log10(sinrAvg) << " for pair with CellId "
-                                        << m_cellId << " and UE " << ue->first);
-            }
-            else // vector is not initialized, so it means that we are still in the initial
-                 // transient phase, for that pair
-            {
-                m_sinrVector.insert(std::make_pair(pairDevices, std::vector<double>()));
-                m_sinrVector.at(pairDevices).push_back(sinrAvg); // push back a new SINR value
-                NS_LOG_DEBUG("At time " << Now().GetMicroSeconds()
-                                        << " first initializazion and push back the SINR "
-                                        << 10 * std::log10(sinrAvg) << " for pair with CellId "
-                                        << m_cellId << " and UE " << ue->first);
-            }
-
-            auto iteratorFinalTrace =
-                m_finalSinrVector.find(pairDevices); // pair [pairDevices,Sinrvalue]
-            if (iteratorFinalTrace == m_finalSinrVector.end())
-            {
-                m_samplesFilter.insert(
-                    std::make_pair(pairDevices, std::pair<uint64_t, uint64_t>()));
-                m_finalSinrVector.insert(std::make_pair(pairDevices, std::vector<double>()));
-            }
-
-            auto iteratorSinrToFilter =
-                m_sinrVectorToFilter.find(pairDevices); // pair [pairDevices,Sinrvalue]
-            if (iteratorSinrToFilter == m_sinrVectorToFilter.end())
-            {
-                m_sinrVectorToFilter.insert(std::make_pair(pairDevices, std::vector<double>()));
-                m_sinrVectorNoisy.insert(std::make_pair(pairDevices, std::vector<double>()));
-            }
-
-            /* generate Gaussian noise for the last SINR value (that is the current one) */
-            double sinrNoisy = AddGaussianNoise(m_sinrVector.at(pairDevices).back());
-
-            /* UPDATE TRACE TO BE FILTERED */
-            if (Now().GetMicroSeconds() <= m_transient)
-            {
-                m_sinrVectorNoisy.at(pairDevices).push_back(sinrNoisy);
-
-                // if (sinrNoisy < 0)
-                // {
-                //        NS_LOG_DEBUG("Old SINR value was " << 10*std::log10(sinrNoisy) << " while
-                //        now is " << 10*std::log10(0.1)); sinrNoisy = 0.1;
-                // }
-                m_sinrVectorToFilter.at(pairDevices).push_back(sinrNoisy);
-            }
-            else
-            {
-                m_sinrVectorNoisy.at(pairDevices).erase(m_sinrVectorNoisy.at(pairDevices).begin());
-                m_sinrVectorNoisy.at(pairDevices).push_back(sinrNoisy);
-
-                // if (sinrNoisy < 0)
-                // {
-                //        NS_LOG_DEBUG("Old SINR value was " << 10*std::log10(sinrNoisy) << " while
-                //        now is " << 10*std::log10(0.1)); sinrNoisy = 0.1;
-                // }
-
-                double toPlot = *m_sinrVectorToFilter.at(pairDevices).begin();
-                double toPlotbis = sinrNoisy;
-                NS_LOG_DEBUG("(Remove SINR)  " << toPlot);
-                NS_LOG_DEBUG("(Add SINR)  " << toPlotbis);
-
-                m_sinrVectorToFilter.at(pairDevices)
-                    .erase(m_sinrVectorToFilter.at(pairDevices).begin());
-                m_sinrVectorToFilter.at(pairDevices).push_back(sinrNoisy);
-            }
-
-            if (Now().GetMicroSeconds() > m_transient) // apply filter only when I have a
-                                                       // sufficiently large set of SINR samples
+            auto filter = m_sinrFilters.find(ue->first);
+            if (filter == m_sinrFilters.end())
             {
-                std::vector<double> vectorNoisy = m_sinrVectorNoisy.at(pairDevices);
-                std::pair<uint64_t, uint64_t> pairFiltering = ApplyFilter(
-                    vectorNoisy); // find where to apply the filter, according to the variance
-                m_samplesFilter.at(pairDevices) = pairFiltering; // where to apply the linear filter
-                NS_LOG_DEBUG("Noisy vector start at sample " << std::get<0>(pairFiltering));
-                NS_LOG_DEBUG("Noisy vector end at sample " << std::get<1>(pairFiltering));
-
-                /* just apply filter where the SINR is too low and we are in a blockage situation */
-                if (std::get<0>(m_samplesFilter.at(pairDevices)) ==
-                    std::get<1>(m_samplesFilter.at(pairDevices))) // if start = end
-                {
-                    m_finalSinrVector.at(pairDevices) =
-                        m_sinrVectorToFilter.at(pairDevices); // no need to apply the filter
-                    NS_LOG_DEBUG("At time "
-                                 << Now().GetMicroSeconds()
-                                 << " there is no need to apply the Kalman filter for mmWave eNB "
-                                 << m_cellId << " and UE " << ue->first);
-                }
-                else
-                {
-                    std::vector<double> vectorToFilter = m_sinrVectorToFilter.at(pairDevices);
-                    std::vector<double> sinrVector = m_sinrVector.at(pairDevices);
-                    std::pair<uint64_t, uint64_t> filterPair = m_samplesFilter.at(pairDevices);
-                    m_finalSinrVector.at(pairDevices) =
-                        MakeFilter(vectorNoisy, sinrVector, filterPair);
-                    NS_LOG_DEBUG("finaltrace " << m_finalSinrVector.at(pairDevices).back());
-                }
-
-                /* the last sample in the filtered sequence is referred to the current time instant,
-                 * referred to the uplink reference signal that is used to build the RT in the
-                 * LteEnbRrc class */
-                double sampleToForward = m_finalSinrVector.at(pairDevices).back();
-                if (sampleToForward < 0) // this would be converted in NaN, in the log scale
-                {
-                    sampleToForward = 1e-20;
-                }
-                NS_LOG_DEBUG(" mmWave eNB " << m_cellId << " reports the SINR "
-                                            << 10 * std::log10(sampleToForward) << " for UE "
-                                            << ue->first);
-                m_sinrMap[ue->first] =
-                    sampleToForward; // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< in order to
-                                     // FORWARD to LteEnbRrc the value of SINR for the RT
-
-                // m_sinrVectorToFilter.at(pairDevices).erase(m_sinrVectorToFilter.at(pairDevices).begin());
-                // m_sinrVectorToFilter.at(pairDevices).push_back(m_finalSinrVector.at(pairDevices).back());
-                m_sinrVectorToFilter.at(pairDevices).pop_back();
-                m_sinrVectorToFilter.at(pairDevices)
-                    .push_back(m_finalSinrVector.at(pairDevices).back());
-            }
-            else // before the transient is over, just forwart the (last) noisy sample, without
-                 // having filtered
-            {
-                double sampleToForward = m_sinrVectorToFilter.at(pairDevices).back();
-                if (sampleToForward < 0) // this would be converted in NaN, in the log scale
-                {
-                    sampleToForward = 1e-20;
-                }
-                NS_LOG_DEBUG(" mmWave eNB " << m_cellId << " FIRST reports the SINR "
-                                            << 10 * std::log10(sampleToForward) << " for UE "
-                                            << ue->first);
-                m_sinrMap[ue->first] =
-                    sampleToForward; // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< in order to
-                                     // FORWARD to LteEnbRrc the value of SINR for the RT
+                // the window holds the samples collected during the transient
+                uint32_t window = m_transient / m_updateSinrPeriod + 1;
+                filter = m_sinrFilters.emplace(ue->first, MmWaveSinrFilter(window)).first;
             }
 
-            /* after the SINR sample is forwarded, I need to REFRESH all the maps, so that
-             * a new SINR sequence can be created, to generate a new SINR sample
-             * for the next RT
-             */
-            m_finalSinrVector.erase(pairDevices);
-            m_samplesFilter.erase(pairDevices);
-            NS_LOG_DEBUG("ERASE MAPS FOR RT");
+            /* generate Gaussian noise for the current SINR value, then filter it */
+            double sinrNoisy = AddGaussianNoise(sinrAvg);
+            double sampleToForward = filter->second.AddSample(sinrAvg, sinrNoisy);
+            NS_LOG_DEBUG(" mmWave eNB " << m_cellId << " reports the SINR "
+                                        << 10 * std::log10(sampleToForward) << " for UE "
+                                        << ue->first);
+            m_sinrMap[ue->first] =
+                sampleToForward; // in order to FORWARD to LteEnbRrc the value of SINR for the RT
         }
         else // noise and filtering processes are not applied!
         {
@@ -1112,10 +701,14 @@ MmWaveEnbPhy::StartTti(void)
         // Trace current DL transmission info
         TraceDlPhyTransmission(currTti.m_dci, PhyTransmissionTraceParams::DATA);
 
+        Ptr<MmWaveTransportBlock> tb = Create<MmWaveTransportBlock>(
+            currTti.m_dci,
+            SfnSf(m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));
+        tb->AddPdus(pktBurst);
         Simulator::Schedule(NanoSeconds(1.0),
                             &MmWaveEnbPhy::SendDataChannels,
                             this,
-                            pktBurst,
+                            tb,
                             ttiPeriod - NanoSeconds(2.0),
                             currTti);
     }
@@ -1230,7 +823,9 @@ MmWaveEnbPhy::EndSlot(void)
 }
 
 void
-MmWaveEnbPhy::SendDataChannels(Ptr<PacketBurst> pb, Time slotPrd, TtiAllocInfo& slotInfo)
+MmWaveEnbPhy::SendDataChannels(Ptr<MmWaveTransportBlock> tb,
+                               Time slotPrd,
+                               TtiAllocInfo& slotInfo)
 {
     if (slotInfo.m_isOmni)
     {
@@ -1273,7 +868,7 @@ MmWaveEnbPhy::SendDataChannels(Ptr<PacketBurst> pb, Time slotPrd, TtiAllocInfo&
     }
 
     std::list<Ptr<MmWaveControlMessage>> ctrlMsgs;
-    m_downlinkSpectrumPhy->StartTxDataFrames(pb, ctrlMsgs, slotPrd, slotInfo.m_ttiIdx);
+    m_downlinkSpectrumPhy->StartTxDataFrames(tb, ctrlMsgs, slotPrd, slotInfo.m_ttiIdx);
 }
 
 void
@@ -38,10 +38,13 @@
 #include "mmwave-mac.h"
 #include "mmwave-phy-mac-common.h"
 #include "mmwave-phy.h"
+#include "mmwave-sinr-filter.h"
+#include "mmwave-transport-block.h"
 
 #include <ns3/lte-enb-cphy-sap.h>
 #include <ns3/lte-enb-phy-sap.h>
 #include <ns3/mmwave-harq-phy.h>
+#include <ns3/random-variable-stream.h>
 
 namespace ns3
 {
@@ -132,7 +135,7 @@ class MmWaveEnbPhy : public MmWavePhy
 
     SlotAllocInfo m_currSlotAllocInfo; //!< Holds the allocation info for the current NR slot
 
-    void SendDataChannels(Ptr<PacketBurst> pb, Time slotPrd, TtiAllocInfo& slotInfo);
+    void SendDataChannels(Ptr<MmWaveTransportBlock> tb, Time slotPrd, TtiAllocInfo& slotInfo);
 
     void SendCtrlChannels(std::list<Ptr<MmWaveControlMessage>> ctrlMsg, Time slotPrd);
 
@@ -166,15 +169,14 @@ class MmWaveEnbPhy : public MmWavePhy
 
     double AddGaussianNoise(double sample);
 
-    std::pair<uint64_t, uint64_t> ApplyFilter(std::vector<double>);
-
-    double MakeAvg(std::vector<double>);
-
-    double MakeVar(std::vector<double>, double);
-
-    std::vector<double> MakeFilter(std::vector<double>,
-                                   std::vector<double>,
-                                   std::pair<uint64_t, uint64_t>);
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model and by its spectrum PHYs.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
 
   private:
     bool AddUePhy(uint16_t rnti);
@@ -224,17 +226,9 @@ class MmWaveEnbPhy : public MmWavePhy
     std::map<uint64_t, Ptr<NetDevice>> m_ueAttachedImsiMap;
     std::map<uint64_t, double> m_sinrMap;
     std::map<uint64_t, Ptr<SpectrumValue>> m_rxPsdMap;
-    std::map<pairDevices_t, std::vector<double>>
-        m_sinrVector; // array containing all SINR values for a specific pair (UE-eNB)
-    std::map<pairDevices_t, std::vector<double>>
-        m_sinrVectorToFilter; // array containing the  SINR values that must be filtered
-    std::map<pairDevices_t, std::vector<double>>
-        m_sinrVectorNoisy; // array containing the  noisy SINR values that must be filteredF
-    std::map<pairDevices_t, std::vector<double>>
-        m_finalSinrVector; // array containing all  SINR values after the filtering for a specific
-                           // pair (UE-eNB)
-    std::map<pairDevices_t, std::pair<uint64_t, uint64_t>>
-        m_samplesFilter; // array containing all noisy SINR values for a specific pair (UE-eNB)
+    std::map<uint64_t, MmWaveSinrFilter>
+        m_sinrFilters; // filters of the noisy SINR values of the UEs, by IMSI
+    Ptr<NormalRandomVariable> m_sinrNoise; // samples of the SINR measurement noise
 
     int m_updateSinrPeriod;               // the period of SINR update for eNBs
     double m_ueUpdateSinrPeriod;          // the period of SINR reporting to the UEs
@@ -35,6 +35,7 @@
 #include <ns3/boolean.h>
 #include <ns3/log.h>
 #include <ns3/lte-common.h>
+#include <ns3/profiler.h>
 
 #include <cmath>
 #include <stdlib.h> /* abs */
@@ -705,6 +706,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq(
     const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
 {
     NS_LOG_FUNCTION(this);
+    NS_PROFILE_SCOPE("mmwave", "MmWaveFlexTtiMacScheduler::DoSchedTriggerReq");
 
     uint32_t frameNum = params.m_snfSf.m_frameNum;
     uint8_t sfNum = params.m_snfSf.m_sfNum;
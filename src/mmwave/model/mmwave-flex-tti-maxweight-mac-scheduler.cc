@@ -16,6 +16,7 @@
 #include <ns3/eps-bearer.h>
 #include <ns3/log.h>
 #include <ns3/lte-common.h>
+#include <ns3/profiler.h>
 
 #include <algorithm>
 #include <cmath>
@@ -807,6 +808,7 @@ void
 MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq(
     const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
 {
+    NS_PROFILE_SCOPE("mmwave", "MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq");
     uint32_t frameNum = params.m_snfSf.m_frameNum;
     uint8_t sfNum = params.m_snfSf.m_sfNum;
     uint8_t slotNum = params.m_snfSf.m_slotNum;
@@ -104,8 +104,10 @@ mmWaveInterference::StartRx(Ptr<const SpectrumValue> rxPsd)
         NS_LOG_LOGIC("additional signal" << *m_rxSignal);
         // receiving multiple simultaneous signals, make sure they are synchronized
         NS_ASSERT(m_lastChangeTime == Now());
-        // make sure they use orthogonal resource blocks
-        NS_ASSERT(Sum((*rxPsd) * (*m_rxSignal)) == 0.0);
+        // make sure they use orthogonal resource blocks, comparing the occupied bands first
+        NS_ASSERT((rxPsd->GetOccupiedBands() && m_rxSignal->GetOccupiedBands() &&
+                   !rxPsd->GetOccupiedBands()->Overlaps(*m_rxSignal->GetOccupiedBands())) ||
+                  Sum((*rxPsd) * (*m_rxSignal)) == 0.0);
         (*m_rxSignal) += (*rxPsd);
     }
 }
@@ -194,8 +196,11 @@ mmWaveInterference::ConditionallyEvaluateChunk()
     {
         NS_LOG_LOGIC(this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals
                           << " noise = " << *m_noise);
-        SpectrumValue interf = (*m_allSignals) - (*m_rxSignal) + (*m_noise);
-        SpectrumValue sinr = (*m_rxSignal) / interf;
+        SpectrumValue interf = *m_allSignals;
+        interf -= *m_rxSignal;
+        interf += *m_noise;
+        SpectrumValue sinr = *m_rxSignal;
+        sinr /= interf;
         Time duration = Now() - m_lastChangeTime;
         for (std::list<Ptr<mmWaveChunkProcessor>>::const_iterator it =
                  m_PowerChunkProcessorList.begin();
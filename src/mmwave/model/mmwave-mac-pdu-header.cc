@@ -30,6 +30,8 @@
 #include "ns3/tag.h"
 #include "ns3/uinteger.h"
 
+#include <utility>
+
 namespace ns3
 {
 
@@ -39,7 +41,8 @@ namespace mmwave
 NS_OBJECT_ENSURE_REGISTERED(MmWaveMacPduHeader);
 
 MmWaveMacPduHeader::MmWaveMacPduHeader()
-    : m_headerSize(0)
+    : m_numSubheaders(0),
+      m_headerSize(0)
 {
 }
 
@@ -69,30 +72,30 @@ MmWaveMacPduHeader::Serialize(Buffer::Iterator i) const
     // RDF TODO: implement BSR MAC control elements
 
     // this part builds the MAC sub-header format from 36.321 sec 6.1.2
-    for (unsigned ipdu = 0; ipdu < m_subheaderList.size(); ipdu++)
+    MacSubheaderSpan subheaders = GetSubheaders();
+    for (uint32_t ipdu = 0; ipdu < subheaders.size(); ipdu++)
     {
+        uint32_t size = subheaders[ipdu].m_size;
         // first octet R/R/E/LCID (R=reserved bit, E=extension bit)
-        uint8_t octet1 = m_subheaderList[ipdu].m_lcid & 0x1F;
-        if (ipdu < (m_subheaderList.size() - 1)) // not the last subheader
+        uint8_t octet1 = subheaders[ipdu].m_lcid & 0x1F;
+        if (ipdu < (subheaders.size() - 1)) // not the last subheader
         {
             octet1 |= (1 << 5);
         }
         i.WriteU8(octet1);
         // second octet F/Length (F=1 if length > 127 bits)
-        uint8_t octet2 = (m_subheaderList[ipdu].m_size & 0x7F);
-        // third octet = upper 8 bits of length if length > 127
-        uint8_t octet3 = 0;
-        if (m_subheaderList[ipdu].m_size > 0x7F)
+        uint8_t octet2 = (size & 0x7F);
+        if (size > 0x7F)
         {
             octet2 |= (1 << 7);
-            octet3 = ((m_subheaderList[ipdu].m_size >> 7) & 0x7F);
             i.WriteU8(octet2);
-            if (m_subheaderList[ipdu].m_size > 0x3FFF)
+            // third octet = upper 8 bits of length if length > 127
+            uint8_t octet3 = ((size >> 7) & 0x7F);
+            if (size > 0x3FFF)
             {
                 octet3 |= (1 << 7); // write extension flag 2
-                uint8_t octet4 = ((m_subheaderList[ipdu].m_size >> 14) & 0xFF);
                 i.WriteU8(octet3);
-                i.WriteU8(octet4);
+                i.WriteU8((size >> 14) & 0xFF);
             }
             else
             {
@@ -110,7 +113,7 @@ uint32_t
 MmWaveMacPduHeader::Deserialize(Buffer::Iterator i)
 {
     // decode sub-headers and create RLC info elements
-    m_headerSize = 0;
+    Clear();
     bool done = false;
     while (!done)
     {
@@ -132,18 +135,9 @@ MmWaveMacPduHeader::Deserialize(Buffer::Iterator i)
             {
                 uint8_t octet4 = (uint8_t)i.ReadU8();
                 size |= (octet4 << 14);
-                m_headerSize += 4;
-            }
-            else
-            {
-                m_headerSize += 3;
             }
         }
-        else
-        {
-            m_headerSize += 2;
-        }
-        m_subheaderList.push_back(MacSubheader(lcid, size));
+        AddSubheader(MacSubheader(lcid, size));
     }
 
     return m_headerSize;
@@ -155,21 +149,76 @@ MmWaveMacPduHeader::Print(std::ostream& os) const
 }
 
 void
-MmWaveMacPduHeader::AddSubheader(MacSubheader macSubheader)
+MmWaveMacPduHeader::AddSubheader(const MacSubheader& macSubheader)
 {
-    this->m_subheaderList.push_back(macSubheader);
-    if (macSubheader.m_size > 0x3FFF)
+    if (m_numSubheaders < INLINE_SUBHEADERS)
+    {
+        m_inlineSubheaders[m_numSubheaders] = macSubheader;
+    }
+    else
     {
-        m_headerSize += 4;
+        if (m_heapSubheaders.empty())
+        {
+            m_heapSubheaders.assign(m_inlineSubheaders.begin(), m_inlineSubheaders.end());
+        }
+        m_heapSubheaders.push_back(macSubheader);
     }
-    else if (macSubheader.m_size > 0x7F)
+    m_numSubheaders++;
+    m_headerSize += GetSubheaderSize(macSubheader.m_size);
+}
+
+void
+MmWaveMacPduHeader::SetSubheaders(std::vector<MacSubheader> macSubheaderList)
+{
+    Clear();
+    if (macSubheaderList.size() > INLINE_SUBHEADERS)
     {
-        m_headerSize += 3;
+        m_heapSubheaders = std::move(macSubheaderList);
+        m_numSubheaders = m_heapSubheaders.size();
+        for (const auto& subheader : m_heapSubheaders)
+        {
+            m_headerSize += GetSubheaderSize(subheader.m_size);
+        }
     }
     else
     {
-        m_headerSize += 2;
+        for (const auto& subheader : macSubheaderList)
+        {
+            AddSubheader(subheader);
+        }
+    }
+}
+
+MacSubheaderSpan
+MmWaveMacPduHeader::GetSubheaders(void) const
+{
+    if (m_numSubheaders > INLINE_SUBHEADERS)
+    {
+        return MacSubheaderSpan(m_heapSubheaders.data(), m_numSubheaders);
     }
+    return MacSubheaderSpan(m_inlineSubheaders.data(), m_numSubheaders);
+}
+
+uint32_t
+MmWaveMacPduHeader::GetSubheaderSize(uint32_t size)
+{
+    if (size > 0x3FFF)
+    {
+        return 4;
+    }
+    else if (size > 0x7F)
+    {
+        return 3;
+    }
+    return 2;
+}
+
+void
+MmWaveMacPduHeader::Clear()
+{
+    m_numSubheaders = 0;
+    m_headerSize = 0;
+    m_heapSubheaders.clear();
 }
 
 } // namespace mmwave
@@ -31,6 +31,9 @@
 #include "ns3/nstime.h"
 #include "ns3/packet.h"
 
+#include <array>
+#include <vector>
+
 namespace ns3
 {
 
@@ -69,6 +72,62 @@ struct MacSubheader
     uint32_t m_size; // 22 bits
 };
 
+/**
+ * \ingroup mmwave
+ * Read-only view of the contiguous subheaders of a MmWaveMacPduHeader, valid
+ * until the header is modified or destroyed
+ */
+class MacSubheaderSpan
+{
+  public:
+    /**
+     * \param data the first subheader
+     * \param size the number of subheaders
+     */
+    MacSubheaderSpan(const MacSubheader* data, uint32_t size)
+        : m_data(data),
+          m_size(size)
+    {
+    }
+
+    const MacSubheader* begin() const
+    {
+        return m_data;
+    }
+
+    const MacSubheader* end() const
+    {
+        return m_data + m_size;
+    }
+
+    uint32_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    const MacSubheader& operator[](uint32_t i) const
+    {
+        return m_data[i];
+    }
+
+  private:
+    const MacSubheader* m_data; // first subheader
+    uint32_t m_size;            // number of subheaders
+};
+
+/**
+ * \ingroup mmwave
+ * MAC PDU header, made of the subheaders of the RLC PDUs of the TB.
+ *
+ * Up to INLINE_SUBHEADERS subheaders are stored in the header itself, so that
+ * building, serializing and parsing the header of a TB does not allocate any
+ * memory. The subheaders are moved to the heap only when there are more.
+ */
 class MmWaveMacPduHeader : public Header
 {
   public:
@@ -86,21 +145,38 @@ class MmWaveMacPduHeader : public Header
     virtual uint32_t Deserialize(Buffer::Iterator i);
     virtual uint32_t GetSerializedSize() const;
     virtual void Print(std::ostream& os) const;
-    void AddSubheader(MacSubheader rlcPduInfo);
+    void AddSubheader(const MacSubheader& macSubheader);
 
-    void SetSubheaders(std::vector<MacSubheader> macSubheaderList)
-    {
-        m_subheaderList = macSubheaderList;
-    }
+    /**
+     * Replace the subheaders of the header
+     *
+     * \param macSubheaderList the subheaders, moved to the header if more than INLINE_SUBHEADERS
+     */
+    void SetSubheaders(std::vector<MacSubheader> macSubheaderList);
 
-    std::vector<MacSubheader> GetSubheaders(void)
-    {
-        return m_subheaderList;
-    }
+    /**
+     * \return the subheaders of the header
+     */
+    MacSubheaderSpan GetSubheaders(void) const;
+
+    /// Number of subheaders stored without allocating memory
+    static constexpr uint32_t INLINE_SUBHEADERS = 32;
+
+  private:
+    /**
+     * \param size the size of the RLC PDU of a subheader
+     * \return the size of the serialized subheader
+     */
+    static uint32_t GetSubheaderSize(uint32_t size);
+
+    /// Remove all the subheaders
+    void Clear();
 
-  protected:
-    std::vector<MacSubheader> m_subheaderList;
-    uint32_t m_headerSize;
+    // subheaders, unless there are more than INLINE_SUBHEADERS
+    std::array<MacSubheader, INLINE_SUBHEADERS> m_inlineSubheaders;
+    std::vector<MacSubheader> m_heapSubheaders; // all the subheaders, if more than inline
+    uint32_t m_numSubheaders;                   // number of subheaders
+    uint32_t m_headerSize;                      // size of the serialized header
 };
 
 } // namespace mmwave
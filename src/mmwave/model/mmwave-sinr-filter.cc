@@ -0,0 +1,164 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-sinr-filter.h"
+
+#include <ns3/assert.h>
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ns3
+{
+
+namespace mmwave
+{
+
+NS_LOG_COMPONENT_DEFINE("MmWaveSinrFilter");
+
+MmWaveSinrFilter::MmWaveSinrFilter(uint32_t window)
+    : m_samples(window),
+      m_count(0),
+      m_highRun(0),
+      m_smallVarRun(0),
+      m_lastStable(NO_SAMPLE),
+      m_lastBlocked(NO_SAMPLE),
+      m_blockageStart(NO_SAMPLE)
+{
+    NS_ASSERT_MSG(window > STABLE_SAMPLES, "Window too small to detect the stable periods");
+}
+
+double
+MmWaveSinrFilter::AddSample(double sinr, double noisySinr)
+{
+    NS_LOG_FUNCTION(this << sinr << noisySinr);
+
+    uint64_t window = m_samples.size();
+    uint64_t index = m_count;
+    double previousDb = (index > 0) ? m_samples[(index - 1) % window].noisySinrDb : 0;
+    Sample& sample = m_samples[index % window];
+    sample.sinr = sinr;
+    sample.noisySinr = noisySinr;
+    sample.noisySinrDb = 10 * std::log10(noisySinr);
+
+    if (index > 0)
+    {
+        // variance of the last two noisy samples, in dB
+        double mean = (previousDb + sample.noisySinrDb) / 2;
+        double var =
+            (std::pow(previousDb - mean, 2) + std::pow(sample.noisySinrDb - mean, 2)) / 2;
+        bool highVariance = (var > 5 || std::isnan(var));
+        bool lowSinr = noisySinr < 10;
+        if (highVariance || lowSinr)
+        {
+            // the blockage starts after the last stable period before this sample
+            m_lastBlocked = index;
+            m_blockageStart = (m_lastStable == NO_SAMPLE) ? NO_SAMPLE : m_lastStable + 1;
+        }
+        m_smallVarRun = (var < 1) ? m_smallVarRun + 1 : 0;
+    }
+    m_highRun = (sample.noisySinrDb > 10) ? m_highRun + 1 : 0;
+    if (m_highRun >= STABLE_SAMPLES || m_smallVarRun >= STABLE_SAMPLES - 1)
+    {
+        m_lastStable = index;
+    }
+    m_count++;
+
+    double filteredSinr = noisySinr;
+    if (m_count > window) // filter only once the window is full
+    {
+        uint64_t oldest = m_count - window;
+        // the two oldest samples of the window are not checked for blockage
+        uint64_t end = 0;
+        if (m_lastBlocked != NO_SAMPLE && m_lastBlocked >= oldest + 2)
+        {
+            end = m_lastBlocked - oldest;
+        }
+        uint64_t start = 0;
+        if (end > 0 && m_blockageStart != NO_SAMPLE && m_blockageStart > oldest + STABLE_SAMPLES)
+        {
+            start = m_blockageStart - oldest;
+        }
+        NS_LOG_DEBUG("Blockage from sample " << start << " to sample " << end);
+
+        // only a blockage that lasts up to the newest sample changes it
+        if (start != end && end == window - 1)
+        {
+            filteredSinr = Smooth(start, end);
+        }
+    }
+
+    if (filteredSinr < 0) // this would be converted in NaN, in the log scale
+    {
+        filteredSinr = 1e-20;
+    }
+    return filteredSinr;
+}
+
+const MmWaveSinrFilter::Sample&
+MmWaveSinrFilter::GetSample(uint64_t index) const
+{
+    return m_samples[(m_count - m_samples.size() + index) % m_samples.size()];
+}
+
+double
+MmWaveSinrFilter::Smooth(uint64_t start, uint64_t end) const
+{
+    if (end - start < 2)
+    {
+        return GetSample(start).noisySinr;
+    }
+
+    // find the coefficient of the moving average that best follows the real SINR
+    std::array<double, 100> meanError;
+    double alpha = 0;
+    for (uint32_t rep = 0; rep < meanError.size(); ++rep)
+    {
+        double average = 0;
+        double error = 0;
+        for (uint64_t i = start; i < end; ++i)
+        {
+            const Sample& sample = GetSample(i);
+            average = (1 - alpha) * average + alpha * sample.noisySinr;
+            error += std::abs(average - sample.sinr);
+        }
+        meanError[rep] = error / (end - start);
+        alpha = alpha + 0.01;
+    }
+    int posMinAlpha =
+        std::distance(meanError.begin(), std::min_element(meanError.begin(), meanError.end()));
+    double minAlpha = (posMinAlpha + 1) * 0.01;
+    if (minAlpha > 0.5)
+    {
+        minAlpha = 0.2;
+    }
+    NS_LOG_DEBUG("Smoothing samples " << start << " to " << end << " with coefficient "
+                                      << minAlpha);
+
+    // the newest sample gets the average of the blockage up to two samples before
+    double average = 0;
+    for (uint64_t i = start; i + 1 < end; ++i)
+    {
+        average = (1 - minAlpha) * average + minAlpha * GetSample(i).noisySinr;
+    }
+    return average;
+}
+
+} // namespace mmwave
+
+} // namespace ns3
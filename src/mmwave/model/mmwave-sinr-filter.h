@@ -0,0 +1,106 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_SINR_FILTER_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_SINR_FILTER_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+namespace mmwave
+{
+
+/**
+ * \ingroup mmwave
+ * Filter of the noisy SINR measurements of a UE at a mmWave eNB, used when
+ * MmWaveEnbPhy::NoiseAndFilter is enabled.
+ *
+ * The last window samples of the real and of the noisy SINR are kept in a
+ * fixed capacity circular buffer. When the newest noisy sample is in a
+ * blockage, i.e., it is below 10 dB or differs by more than about 4.5 dB from
+ * the previous one, the samples since the end of the last stable period are
+ * smoothed with an exponential moving average, whose coefficient minimizes
+ * the error with respect to the real SINR. A stable period is made of 16
+ * samples either all above 10 dB or all within 2 dB of the previous one.
+ *
+ * The blockage and stable period boundaries are updated with each sample,
+ * so that only the smoothing, when needed, scans the window, and no memory
+ * is allocated after the construction.
+ */
+class MmWaveSinrFilter
+{
+  public:
+    /**
+     * \param window the number of samples of the window, larger than STABLE_SAMPLES
+     */
+    explicit MmWaveSinrFilter(uint32_t window);
+
+    /**
+     * Add a SINR measurement and compute the SINR to be reported
+     *
+     * \param sinr the real SINR, in linear units
+     * \param noisySinr the SINR with the measurement noise, in linear units
+     * \return the filtered SINR, in linear units, never negative
+     */
+    double AddSample(double sinr, double noisySinr);
+
+    /// Number of samples of a stable period
+    static constexpr uint32_t STABLE_SAMPLES = 16;
+
+  private:
+    /// Samples with no blockage or stable period
+    static constexpr uint64_t NO_SAMPLE = UINT64_MAX;
+
+    /// A SINR measurement
+    struct Sample
+    {
+        double sinr;        ///< real SINR, in linear units
+        double noisySinr;   ///< noisy SINR, in linear units
+        double noisySinrDb; ///< noisy SINR, in dB, NaN if not positive
+    };
+
+    /**
+     * \param index the index of a sample in the window, zero for the oldest
+     * \return the sample
+     */
+    const Sample& GetSample(uint64_t index) const;
+
+    /**
+     * Smooth the noisy samples of a blockage that ends with the newest sample
+     *
+     * \param start the index in the window of the first sample to smooth
+     * \param end the index in the window of the last sample of the blockage
+     * \return the filtered SINR of the newest sample
+     */
+    double Smooth(uint64_t start, uint64_t end) const;
+
+    std::vector<Sample> m_samples; ///< circular buffer of the last samples
+    uint64_t m_count;              ///< number of samples added so far
+    uint32_t m_highRun;            ///< consecutive samples above 10 dB, up to the newest
+    uint32_t m_smallVarRun;        ///< consecutive small variations, up to the newest
+    uint64_t m_lastStable;         ///< last sample of the last stable period, or NO_SAMPLE
+    uint64_t m_lastBlocked;        ///< last sample in blockage, or NO_SAMPLE
+    uint64_t m_blockageStart;      ///< sample after the last stable period before m_lastBlocked
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_SINR_FILTER_H_ */
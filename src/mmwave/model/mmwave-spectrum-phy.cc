@@ -37,9 +37,7 @@
 
 #include "mmwave-spectrum-phy.h"
 
-#include "mmwave-mac-pdu-tag.h"
 #include "mmwave-phy-mac-common.h"
-#include "mmwave-radio-bearer-tag.h"
 
 #include "ns3/mmwave-eesm-ir-t1.h"
 #include <ns3/antenna-model.h>
@@ -53,6 +51,7 @@
 #include <ns3/mmwave-ue-phy.h>
 #include <ns3/object-factory.h>
 #include <ns3/phased-array-model.h>
+#include <ns3/profiler.h>
 #include <ns3/ptr.h>
 #include <ns3/simulator.h>
 #include <ns3/trace-source-accessor.h>
@@ -149,7 +148,7 @@ MmWaveSpectrumPhy::Reset()
     m_endRxDlCtrlEvent.Cancel();
     m_rxControlMessageList.clear();
     m_transportBlocks.clear();
-    m_rxPacketBurstList.clear();
+    m_rxTransportBlockList.clear();
     // m_txPacketBurst = 0;
     // m_rxSpectrumModel = 0;
 }
@@ -440,7 +439,7 @@ MmWaveSpectrumPhy::StartRxData(Ptr<MmwaveSpectrumSignalParametersDataFrame> para
         // this is a useful signal
         m_interferenceData->StartRx(params->psd);
 
-        if (m_rxPacketBurstList.empty())
+        if (m_rxTransportBlockList.empty())
         {
             NS_ASSERT(m_state == IDLE);
             // first transmission, i.e., we're IDLE and we start RX
@@ -465,16 +464,16 @@ MmWaveSpectrumPhy::StartRxData(Ptr<MmwaveSpectrumSignalParametersDataFrame> para
                       (m_firstRxDuration == params->duration));
         }
 
-        if (params->packetBurst && !params->packetBurst->GetPackets().empty())
+        if (params->transportBlock && !params->transportBlock->GetPdus().empty())
         {
-            m_rxPacketBurstList.push_back(params->packetBurst);
+            m_rxTransportBlockList.push_back(params->transportBlock);
         }
 
         m_rxControlMessageList.insert(m_rxControlMessageList.end(),
                                       params->ctrlMsgList.begin(),
                                       params->ctrlMsgList.end());
 
-        NS_LOG_LOGIC(this << " numSimultaneousRxEvents = " << m_rxPacketBurstList.size());
+        NS_LOG_LOGIC(this << " numSimultaneousRxEvents = " << m_rxTransportBlockList.size());
     }
     break;
 
@@ -565,6 +564,7 @@ MmWaveSpectrumPhy::StartRxCtrl(Ptr<MmWaveSpectrumSignalParametersDlCtrlFrame> dl
 void
 MmWaveSpectrumPhy::EndRxData()
 {
+    NS_PROFILE_SCOPE("mmwave", "MmWaveSpectrumPhy::EndRxData");
     NS_ASSERT(m_state = RX_DATA);
 
     m_interferenceData->EndRx(); // trigger the SINR computation
@@ -583,7 +583,7 @@ MmWaveSpectrumPhy::EndRxData()
                      << ", Avg SINR dB=" << 10 * std::log10(itTb->second.m_sinrAvg)
                      << ", GetNumBands=" << m_sinrPerceived.GetSpectrumModel()->GetNumBands());
 
-        if ((m_dataErrorModelEnabled) && (m_rxPacketBurstList.size() > 0))
+        if ((m_dataErrorModelEnabled) && (!m_rxTransportBlockList.empty()))
         {
             // Retrieve HARQ history
             std::function<const MmWaveErrorModel::MmWaveErrorModelHistory&(uint16_t, uint8_t)>
@@ -639,183 +639,162 @@ MmWaveSpectrumPhy::EndRxData()
 
     // fire the traces and send the ACKs/NACKs
     std::map<uint16_t, DlHarqInfo> harqDlInfoMap;
-    for (auto packetBurst : m_rxPacketBurstList)
+    for (const auto& transportBlock : m_rxTransportBlockList)
     {
-        for (auto packet : packetBurst->GetPackets())
+        uint16_t rnti = transportBlock->GetRnti();
+        itTb = m_transportBlocks.find(rnti);
+        if (itTb != m_transportBlocks.end())
         {
-            if (packet->GetSize() == 0)
+            if (!itTb->second.m_isCorrupted)
             {
-                continue;
+                // the TB is shared with the transmitter and the other receivers
+                for (const auto& pdu : transportBlock->GetPdus())
+                {
+                    m_phyRxDataEndOkCallback(pdu->Copy());
+                }
+            }
+            else
+            {
+                NS_LOG_INFO("TB failed");
             }
 
-            LteRadioBearerTag bearerTag;
-            if (packet->PeekPacketTag(bearerTag) == false)
+            RxPacketTraceParams traceParams;
+            traceParams.m_tbSize = itTb->second.m_expected.m_tbSize;
+            traceParams.m_cellId = m_cellId;
+            traceParams.m_frameNum = transportBlock->GetSfn().m_frameNum;
+            traceParams.m_sfNum = transportBlock->GetSfn().m_sfNum;
+            traceParams.m_slotNum = transportBlock->GetSfn().m_slotNum;
+            traceParams.m_rnti = rnti;
+            traceParams.m_mcs = itTb->second.m_expected.m_mcs;
+            traceParams.m_rv = itTb->second.m_expected.m_rv;
+            traceParams.m_sinr = itTb->second.m_sinrAvg;
+            traceParams.m_sinrMin = itTb->second.m_sinrMin;
+            traceParams.m_tbler = itTb->second.m_outputOfEM->m_tbler;
+            traceParams.m_corrupt = itTb->second.m_isCorrupted;
+            traceParams.m_symStart = itTb->second.m_expected.m_symStart;
+            traceParams.m_numSym = itTb->second.m_expected.m_numSym;
+            traceParams.m_ccId = m_componentCarrierId;
+
+            if (!itTb->second.m_expected.m_isDownlink)
             {
-                NS_FATAL_ERROR("No radio bearer tag found");
+                // eNB received an uplink TB
+                m_rxPacketTraceEnb(traceParams);
             }
-            uint16_t rnti = bearerTag.GetRnti();
-            itTb = m_transportBlocks.find(rnti);
-            if (itTb != m_transportBlocks.end())
+            else
             {
-                if (!itTb->second.m_isCorrupted)
-                {
-                    m_phyRxDataEndOkCallback(packet);
-                }
-                else
-                {
-                    NS_LOG_INFO("TB failed");
-                }
+                // UE received a downlink TB
+                m_rxPacketTraceUe(traceParams);
+            }
 
-                MmWaveMacPduTag pduTag;
-                if (packet->PeekPacketTag(pduTag) == false)
+            // send HARQ feedback (if not already done for this TB)
+            if (!itTb->second.m_harqFeedbackSent)
+            {
+                itTb->second.m_harqFeedbackSent = true;
+                if (!itTb->second.m_expected.m_isDownlink) // UPLINK TB
                 {
-                    NS_FATAL_ERROR("No radio bearer tag found");
-                }
+                    UlHarqInfo harqUlInfo;
+                    harqUlInfo.m_rnti = rnti;
+                    harqUlInfo.m_harqProcessId = itTb->second.m_expected.m_harqProcessId;
+                    harqUlInfo.m_numRetx = itTb->second.m_expected.m_rv;
+                    if (itTb->second.m_isCorrupted)
+                    {
+                        harqUlInfo.m_receptionStatus = UlHarqInfo::NotOk;
+                        NS_LOG_DEBUG("UE"
+                                     << rnti << " send UL-HARQ-NACK"
+                                     << " harqId " << +itTb->second.m_expected.m_harqProcessId
+                                     << " size " << itTb->second.m_expected.m_tbSize << " mcs "
+                                     << +itTb->second.m_expected.m_mcs << " tbler "
+                                     << itTb->second.m_outputOfEM->m_tbler << " sinrAvg "
+                                     << itTb->second.m_sinrAvg);
+                    }
+                    else
+                    {
+                        harqUlInfo.m_receptionStatus = UlHarqInfo::Ok;
+                        NS_LOG_DEBUG("UE"
+                                     << rnti << " send UL-HARQ-ACK"
+                                     << " harqId " << +itTb->second.m_expected.m_harqProcessId
+                                     << " size " << itTb->second.m_expected.m_tbSize << " mcs "
+                                     << +itTb->second.m_expected.m_mcs << " tbler "
+                                     << itTb->second.m_outputOfEM->m_tbler << " sinrAvg "
+                                     << itTb->second.m_sinrAvg);
+                    }
 
-                RxPacketTraceParams traceParams;
-                traceParams.m_tbSize = itTb->second.m_expected.m_tbSize;
-                traceParams.m_cellId = m_cellId;
-                traceParams.m_frameNum = pduTag.GetSfn().m_frameNum;
-                traceParams.m_sfNum = pduTag.GetSfn().m_sfNum;
-                traceParams.m_slotNum = pduTag.GetSfn().m_slotNum;
-                traceParams.m_rnti = rnti;
-                traceParams.m_mcs = itTb->second.m_expected.m_mcs;
-                traceParams.m_rv = itTb->second.m_expected.m_rv;
-                traceParams.m_sinr = itTb->second.m_sinrAvg;
-                traceParams.m_sinrMin = itTb->second.m_sinrMin;
-                traceParams.m_tbler = itTb->second.m_outputOfEM->m_tbler;
-                traceParams.m_corrupt = itTb->second.m_isCorrupted;
-                traceParams.m_symStart = itTb->second.m_expected.m_symStart;
-                traceParams.m_numSym = itTb->second.m_expected.m_numSym;
-                traceParams.m_ccId = m_componentCarrierId;
-
-                if (!itTb->second.m_expected.m_isDownlink)
-                {
-                    // eNB received an uplink TB
-                    m_rxPacketTraceEnb(traceParams);
+                    if (!m_phyUlHarqFeedbackCallback.IsNull())
+                    {
+                        m_phyUlHarqFeedbackCallback(harqUlInfo);
+                    }
+
+                    // Update HARQ process info accordingly
+                    if (!itTb->second.m_isCorrupted || itTb->second.m_expected.m_rv == 3)
+                    {
+                        m_harqPhyModule->ResetUlHarqProcessStatus(
+                            rnti,
+                            itTb->second.m_expected.m_harqProcessId);
+                    }
+                    else
+                    {
+                        m_harqPhyModule->UpdateUlHarqProcessStatus(
+                            rnti,
+                            itTb->second.m_expected.m_harqProcessId,
+                            itTb->second.m_outputOfEM);
+                    }
                 }
                 else
-                {
-                    // UE received a downlink TB
-                    m_rxPacketTraceUe(traceParams);
-                }
+                { // DOWNLIK TB
+                    DlHarqInfo harqDlInfo;
+                    harqDlInfo.m_rnti = rnti;
+                    harqDlInfo.m_harqProcessId = itTb->second.m_expected.m_harqProcessId;
+                    harqDlInfo.m_numRetx = itTb->second.m_expected.m_rv;
 
-                // send HARQ feedback (if not already done for this TB)
-                if (!itTb->second.m_harqFeedbackSent)
-                {
-                    itTb->second.m_harqFeedbackSent = true;
-                    if (!itTb->second.m_expected.m_isDownlink) // UPLINK TB
+                    if (itTb->second.m_isCorrupted)
+                    {
+                        NS_LOG_DEBUG("UE"
+                                     << rnti << " send DL-HARQ-NACK"
+                                     << " harqId " << +itTb->second.m_expected.m_harqProcessId
+                                     << " size " << itTb->second.m_expected.m_tbSize << " mcs "
+                                     << +itTb->second.m_expected.m_mcs << " tbler "
+                                     << itTb->second.m_outputOfEM->m_tbler << " sinrAvg "
+                                     << itTb->second.m_sinrAvg);
+                        harqDlInfo.m_harqStatus = DlHarqInfo::NACK;
+                    }
+                    else
+                    {
+                        NS_LOG_DEBUG("UE"
+                                     << rnti << " send DL-HARQ-NACK"
+                                     << " harqId " << +itTb->second.m_expected.m_harqProcessId
+                                     << " size " << itTb->second.m_expected.m_tbSize << " mcs "
+                                     << +itTb->second.m_expected.m_mcs << " tbler "
+                                     << itTb->second.m_outputOfEM->m_tbler << " sinrAvg "
+                                     << itTb->second.m_sinrAvg);
+                        harqDlInfo.m_harqStatus = DlHarqInfo::ACK;
+                    }
+
+                    NS_ASSERT(harqDlInfoMap.find(rnti) == harqDlInfoMap.end());
+                    harqDlInfoMap.insert(std::make_pair(rnti, harqDlInfo));
+
+                    if (!m_phyDlHarqFeedbackCallback.IsNull())
+                    {
+                        m_phyDlHarqFeedbackCallback(harqDlInfo);
+                    }
+
+                    // Arrange the history
+                    if (!itTb->second.m_isCorrupted || itTb->second.m_expected.m_rv == 3)
                     {
-                        UlHarqInfo harqUlInfo;
-                        harqUlInfo.m_rnti = rnti;
-                        harqUlInfo.m_harqProcessId = itTb->second.m_expected.m_harqProcessId;
-                        harqUlInfo.m_numRetx = itTb->second.m_expected.m_rv;
-                        if (itTb->second.m_isCorrupted)
-                        {
-                            harqUlInfo.m_receptionStatus = UlHarqInfo::NotOk;
-                            NS_LOG_DEBUG("UE"
-                                         << rnti << " send UL-HARQ-NACK"
-                                         << " harqId " << +itTb->second.m_expected.m_harqProcessId
-                                         << " size " << itTb->second.m_expected.m_tbSize << " mcs "
-                                         << +itTb->second.m_expected.m_mcs << " tbler "
-                                         << itTb->second.m_outputOfEM->m_tbler << " sinrAvg "
-                                         << itTb->second.m_sinrAvg);
-                        }
-                        else
-                        {
-                            harqUlInfo.m_receptionStatus = UlHarqInfo::Ok;
-                            NS_LOG_DEBUG("UE"
-                                         << rnti << " send UL-HARQ-ACK"
-                                         << " harqId " << +itTb->second.m_expected.m_harqProcessId
-                                         << " size " << itTb->second.m_expected.m_tbSize << " mcs "
-                                         << +itTb->second.m_expected.m_mcs << " tbler "
-                                         << itTb->second.m_outputOfEM->m_tbler << " sinrAvg "
-                                         << itTb->second.m_sinrAvg);
-                        }
-
-                        if (!m_phyUlHarqFeedbackCallback.IsNull())
-                        {
-                            m_phyUlHarqFeedbackCallback(harqUlInfo);
-                        }
-
-                        // Update HARQ process info accordingly
-                        if (!itTb->second.m_isCorrupted || itTb->second.m_expected.m_rv == 3)
-                        {
-                            m_harqPhyModule->ResetUlHarqProcessStatus(
-                                rnti,
-                                itTb->second.m_expected.m_harqProcessId);
-                        }
-                        else
-                        {
-                            m_harqPhyModule->UpdateUlHarqProcessStatus(
-                                rnti,
-                                itTb->second.m_expected.m_harqProcessId,
-                                itTb->second.m_outputOfEM);
-                        }
+                        m_harqPhyModule->ResetDlHarqProcessStatus(
+                            rnti,
+                            itTb->second.m_expected.m_harqProcessId);
                     }
                     else
-                    { // DOWNLIK TB
-                        DlHarqInfo harqDlInfo;
-                        harqDlInfo.m_rnti = rnti;
-                        harqDlInfo.m_harqProcessId = itTb->second.m_expected.m_harqProcessId;
-                        harqDlInfo.m_numRetx = itTb->second.m_expected.m_rv;
-
-                        if (itTb->second.m_isCorrupted)
-                        {
-                            NS_LOG_DEBUG("UE"
-                                         << rnti << " send DL-HARQ-NACK"
-                                         << " harqId " << +itTb->second.m_expected.m_harqProcessId
-                                         << " size " << itTb->second.m_expected.m_tbSize << " mcs "
-                                         << +itTb->second.m_expected.m_mcs << " tbler "
-                                         << itTb->second.m_outputOfEM->m_tbler << " sinrAvg "
-                                         << itTb->second.m_sinrAvg);
-                            harqDlInfo.m_harqStatus = DlHarqInfo::NACK;
-                        }
-                        else
-                        {
-                            NS_LOG_DEBUG("UE"
-                                         << rnti << " send DL-HARQ-NACK"
-                                         << " harqId " << +itTb->second.m_expected.m_harqProcessId
-                                         << " size " << itTb->second.m_expected.m_tbSize << " mcs "
-                                         << +itTb->second.m_expected.m_mcs << " tbler "
-                                         << itTb->second.m_outputOfEM->m_tbler << " sinrAvg "
-                                         << itTb->second.m_sinrAvg);
-                            harqDlInfo.m_harqStatus = DlHarqInfo::ACK;
-                        }
-
-                        NS_ASSERT(harqDlInfoMap.find(rnti) == harqDlInfoMap.end());
-                        harqDlInfoMap.insert(std::make_pair(rnti, harqDlInfo));
-
-                        if (!m_phyDlHarqFeedbackCallback.IsNull())
-                        {
-                            m_phyDlHarqFeedbackCallback(harqDlInfo);
-                        }
-
-                        // Arrange the history
-                        if (!itTb->second.m_isCorrupted || itTb->second.m_expected.m_rv == 3)
-                        {
-                            m_harqPhyModule->ResetDlHarqProcessStatus(
-                                rnti,
-                                itTb->second.m_expected.m_harqProcessId);
-                        }
-                        else
-                        {
-                            m_harqPhyModule->UpdateDlHarqProcessStatus(
-                                rnti,
-                                itTb->second.m_expected.m_harqProcessId,
-                                itTb->second.m_outputOfEM);
-                        }
+                    {
+                        m_harqPhyModule->UpdateDlHarqProcessStatus(
+                            rnti,
+                            itTb->second.m_expected.m_harqProcessId,
+                            itTb->second.m_outputOfEM);
                     }
                 }
             }
-            else
-            {
-                // TODO what to do here?
-                // NS_FATAL_ERROR ("End of the tbMap");
-                // Packet is for other device
-                continue;
-            }
         }
+        // otherwise the TB is for another device
     }
 
     // send DL HARQ feedback to LtePhy
@@ -835,7 +814,7 @@ MmWaveSpectrumPhy::EndRxData()
     }
 
     ChangeState(IDLE);
-    m_rxPacketBurstList.clear();
+    m_rxTransportBlockList.clear();
     m_transportBlocks.clear();
     m_rxControlMessageList.clear();
 }
@@ -860,7 +839,7 @@ MmWaveSpectrumPhy::EndRxCtrl()
 }
 
 bool
-MmWaveSpectrumPhy::StartTxDataFrames(Ptr<PacketBurst> pb,
+MmWaveSpectrumPhy::StartTxDataFrames(Ptr<MmWaveTransportBlock> tb,
                                      std::list<Ptr<MmWaveControlMessage>> ctrlMsgList,
                                      Time duration,
                                      uint8_t slotInd)
@@ -884,7 +863,7 @@ MmWaveSpectrumPhy::StartTxDataFrames(Ptr<PacketBurst> pb,
         txParams->duration = duration;
         txParams->txPhy = this->GetObject<SpectrumPhy>();
         txParams->psd = m_txPsd;
-        txParams->packetBurst = pb;
+        txParams->transportBlock = tb;
         txParams->cellId = m_cellId;
         txParams->ctrlMsgList = ctrlMsgList;
         txParams->slotInd = slotInd;
@@ -995,6 +974,14 @@ MmWaveSpectrumPhy::UpdateSinrPerceived(const SpectrumValue& sinr)
     m_sinrPerceived = sinr;
 }
 
+int64_t
+MmWaveSpectrumPhy::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_random->SetStream(stream);
+    return 1;
+}
+
 void
 MmWaveSpectrumPhy::SetHarqPhyModule(Ptr<MmWaveHarqPhy> harq)
 {
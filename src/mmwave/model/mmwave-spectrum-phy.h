@@ -41,6 +41,7 @@
 #include "mmwave-harq-phy.h"
 #include "mmwave-interference.h"
 #include "mmwave-spectrum-signal-parameters.h"
+#include "mmwave-transport-block.h"
 
 #include "ns3/mmwave-beamforming-model.h"
 #include "ns3/random-variable-stream.h"
@@ -229,7 +230,7 @@ class MmWaveSpectrumPhy : public SpectrumPhy
      */
     void SetComponentCarrierId(uint8_t componentCarrierId);
 
-    bool StartTxDataFrames(Ptr<PacketBurst> pb,
+    bool StartTxDataFrames(Ptr<MmWaveTransportBlock> tb,
                            std::list<Ptr<MmWaveControlMessage>> ctrlMsgList,
                            Time duration,
                            uint8_t slotInd);
@@ -275,6 +276,16 @@ class MmWaveSpectrumPhy : public SpectrumPhy
 
     void SetHarqPhyModule(Ptr<MmWaveHarqPhy> harq);
 
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model.  Return the number of streams (possibly zero) that
+     * have been assigned.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
   private:
     /**
      * \brief change the state
@@ -298,7 +309,7 @@ class MmWaveSpectrumPhy : public SpectrumPhy
     Ptr<const SpectrumModel> m_rxSpectrumModel;
     Ptr<SpectrumValue> m_txPsd;
     // Ptr<PacketBurst> m_txPacketBurst;
-    std::list<Ptr<PacketBurst>> m_rxPacketBurstList;
+    std::list<Ptr<MmWaveTransportBlock>> m_rxTransportBlockList;
     std::list<Ptr<MmWaveControlMessage>> m_rxControlMessageList;
 
     Time m_firstRxStart;
@@ -28,6 +28,7 @@
 #include "mmwave-spectrum-signal-parameters.h"
 
 #include "mmwave-control-messages.h"
+#include "mmwave-transport-block.h"
 
 #include <ns3/log.h>
 #include <ns3/packet-burst.h>
@@ -51,7 +52,7 @@ mmwaveSpectrumSignalParameters::mmwaveSpectrumSignalParameters(
     : SpectrumSignalParameters(p)
 {
     NS_LOG_FUNCTION(this << &p);
-    packetBurst = p.packetBurst->Copy();
+    packetBurst = p.packetBurst;
 }
 
 Ptr<SpectrumSignalParameters>
@@ -73,10 +74,7 @@ MmwaveSpectrumSignalParametersDataFrame::MmwaveSpectrumSignalParametersDataFrame
 {
     NS_LOG_FUNCTION(this << &p);
     cellId = p.cellId;
-    if (p.packetBurst)
-    {
-        packetBurst = p.packetBurst->Copy();
-    }
+    transportBlock = p.transportBlock;
     ctrlMsgList = p.ctrlMsgList;
     slotInd = p.slotInd;
 }
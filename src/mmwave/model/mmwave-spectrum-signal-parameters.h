@@ -40,6 +40,7 @@ namespace mmwave
 {
 
 class MmWaveControlMessage;
+class MmWaveTransportBlock;
 
 /**
  * \ingroup mmwave
@@ -61,7 +62,7 @@ struct mmwaveSpectrumSignalParameters : public SpectrumSignalParameters
      */
     mmwaveSpectrumSignalParameters(const mmwaveSpectrumSignalParameters& p);
 
-    Ptr<PacketBurst> packetBurst;
+    Ptr<PacketBurst> packetBurst; ///< packets sent, shared by the copies of the parameters
 };
 
 struct MmwaveSpectrumSignalParametersDataFrame : public SpectrumSignalParameters
@@ -79,7 +80,11 @@ struct MmwaveSpectrumSignalParametersDataFrame : public SpectrumSignalParameters
      */
     MmwaveSpectrumSignalParametersDataFrame(const MmwaveSpectrumSignalParametersDataFrame& p);
 
-    Ptr<PacketBurst> packetBurst;
+    /**
+     * The TB sent, shared by the copies of the parameters that the channel makes for each
+     * receiver. Receivers must copy its PDUs before modifying them.
+     */
+    Ptr<MmWaveTransportBlock> transportBlock;
 
     std::list<Ptr<MmWaveControlMessage>> ctrlMsgList;
 
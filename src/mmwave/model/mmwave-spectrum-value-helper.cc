@@ -37,7 +37,12 @@
 #include <ns3/string.h>
 
 #include <cmath>
+#include <functional>
 #include <map>
+#include <tuple>
+
+/// Maximum number of PSDs of each cache of MmWaveSpectrumValueHelper
+#define MAX_CACHED_PSDS 1024
 
 // namespace std {
 
@@ -51,6 +56,20 @@ namespace mmwave
 {
 
 std::map<uint8_t, Ptr<SpectrumModel>> MmWaveSpectrumValueHelper::m_model;
+std::map<MmWaveSpectrumValueHelper::TxPsdKey, MmWaveSpectrumValueHelper::TxPsdEntry>
+    MmWaveSpectrumValueHelper::m_txPsds;
+std::map<std::pair<Ptr<const SpectrumModel>, double>, Ptr<SpectrumValue>>
+    MmWaveSpectrumValueHelper::m_noisePsds;
+
+bool
+MmWaveSpectrumValueHelper::TxPsdKey::operator<(const TxPsdKey& other) const
+{
+    return std::make_tuple(PeekPointer(m_model), m_bandwidth, m_powerTx, m_rbsHash) <
+           std::make_tuple(PeekPointer(other.m_model),
+                           other.m_bandwidth,
+                           other.m_powerTx,
+                           other.m_rbsHash);
+}
 
 Ptr<SpectrumModel>
 MmWaveSpectrumValueHelper::GetSpectrumModel(Ptr<MmWavePhyMacCommon> ptrConfig)
@@ -94,9 +113,22 @@ MmWaveSpectrumValueHelper::GetSpectrumModel(Ptr<MmWavePhyMacCommon> ptrConfig)
 Ptr<SpectrumValue>
 MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity(Ptr<MmWavePhyMacCommon> ptrConfig,
                                                         double powerTx,
-                                                        std::vector<int> activeRbs)
+                                                        const std::vector<int>& activeRbs)
 {
     Ptr<SpectrumModel> model = GetSpectrumModel(ptrConfig);
+
+    std::size_t rbsHash = activeRbs.size();
+    for (int rbId : activeRbs)
+    {
+        rbsHash ^= std::hash<int>()(rbId) + 0x9e3779b9 + (rbsHash << 6) + (rbsHash >> 2);
+    }
+    TxPsdKey key{model, ptrConfig->GetBandwidth(), powerTx, rbsHash};
+    auto it = m_txPsds.find(key);
+    if (it != m_txPsds.end() && it->second.m_activeRbs == activeRbs)
+    {
+        return it->second.m_psd;
+    }
+
     Ptr<SpectrumValue> txPsd = Create<SpectrumValue>(model);
 
     double powerTxW = std::pow(10., (powerTx - 30) / 10);
@@ -104,12 +136,27 @@ MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity(Ptr<MmWavePhyMacCommon>
     double txPowerDensity = 0;
     txPowerDensity = (powerTxW / (ptrConfig->GetBandwidth()));
 
-    for (std::vector<int>::iterator it = activeRbs.begin(); it != activeRbs.end(); it++)
+    for (int rbId : activeRbs)
     {
-        int rbId = (*it);
         (*txPsd)[rbId] = txPowerDensity;
     }
+    // let the channel, the interference and the PHYs skip the unused RBs
+    txPsd->SetOccupiedBands(Create<SpectrumBandRuns>(activeRbs));
 
+    if (it != m_txPsds.end())
+    {
+        // hash collision, replace the entry
+        it->second = TxPsdEntry{activeRbs, txPsd};
+    }
+    else
+    {
+        if (m_txPsds.size() >= MAX_CACHED_PSDS)
+        {
+            NS_LOG_LOGIC("TX PSD cache full, clearing it");
+            m_txPsds.clear();
+        }
+        m_txPsds.emplace(key, TxPsdEntry{activeRbs, txPsd});
+    }
     return txPsd;
 }
 
@@ -137,6 +184,13 @@ MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity(double noiseFigureDb,
                                                            Ptr<SpectrumModel> spectrumModel)
 {
     NS_LOG_FUNCTION(noiseFigureDb << spectrumModel);
+    auto key = std::make_pair(Ptr<const SpectrumModel>(spectrumModel), noiseFigureDb);
+    auto it = m_noisePsds.find(key);
+    if (it != m_noisePsds.end())
+    {
+        return it->second;
+    }
+
     const double kT_dBm_Hz = -174.0; // dBm/Hz
     double kT_W_Hz = std::pow(10.0, (kT_dBm_Hz - 30) / 10.0);
     double noiseFigureLinear = std::pow(10.0, noiseFigureDb / 10.0);
@@ -144,6 +198,13 @@ MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity(double noiseFigureDb,
 
     Ptr<SpectrumValue> noisePsd = Create<SpectrumValue>(spectrumModel);
     (*noisePsd) = noisePowerSpectralDensity;
+
+    if (m_noisePsds.size() >= MAX_CACHED_PSDS)
+    {
+        NS_LOG_LOGIC("noise PSD cache full, clearing it");
+        m_noisePsds.clear();
+    }
+    m_noisePsds.emplace(key, noisePsd);
     return noisePsd;
 }
 
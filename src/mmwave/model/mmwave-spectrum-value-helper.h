@@ -35,6 +35,7 @@
 #include <ns3/mmwave-phy-mac-common.h>
 #include <ns3/spectrum-value.h>
 
+#include <map>
 #include <vector>
 
 namespace ns3
@@ -53,24 +54,78 @@ class MmWaveSpectrumValueHelper
   public:
     static Ptr<SpectrumModel> GetSpectrumModel(Ptr<MmWavePhyMacCommon> ptrConfig);
 
+    /**
+     * Create the PSD of a transmission. The PSDs are cached: the PSD returned is
+     * shared with the other callers that pass the same configuration, power and
+     * RBs, and must not be modified. Copy it before scaling it.
+     *
+     * \param ptrConfig the PHY and MAC configuration
+     * \param powerTx the TX power, in dBm
+     * \param activeRbs the RBs used for the transmission
+     * \return the TX PSD, shared
+     */
     static Ptr<SpectrumValue> CreateTxPowerSpectralDensity(Ptr<MmWavePhyMacCommon> ptrConfig,
                                                            double powerTx,
-                                                           std::vector<int> activeRbs);
+                                                           const std::vector<int>& activeRbs);
 
     static Ptr<SpectrumValue> CreateTxPowerSpectralDensity(Ptr<MmWavePhyMacCommon> ptrConfig,
                                                            double powerTx,
                                                            std::map<int, double> powerTxMap,
                                                            std::vector<int> activeRbs);
 
+    /**
+     * Create the PSD of the noise. Like the TX PSDs, the noise PSDs are cached,
+     * shared, and must not be modified.
+     *
+     * \param ptrConfig the PHY and MAC configuration
+     * \param noiseFigure the noise figure, in dB
+     * \return the noise PSD, shared
+     */
     static Ptr<SpectrumValue> CreateNoisePowerSpectralDensity(Ptr<MmWavePhyMacCommon> ptrConfig,
                                                               double noiseFigure);
 
+    /**
+     * Create the PSD of the noise, cached and shared
+     *
+     * \param noiseFigure the noise figure, in dB
+     * \param spectrumModel the spectrum model of the PSD
+     * \return the noise PSD, shared
+     */
     static Ptr<SpectrumValue> CreateNoisePowerSpectralDensity(double noiseFigure,
                                                               Ptr<SpectrumModel> spectrumModel);
 
   private:
+    /**
+     * Key of a cached TX PSD. The RBs are only hashed, and compared with the
+     * RBs of the entry on a match.
+     */
+    struct TxPsdKey
+    {
+        Ptr<const SpectrumModel> m_model; //!< spectrum model of the PSD
+        double m_bandwidth;               //!< bandwidth of the configuration
+        double m_powerTx;                 //!< TX power, in dBm
+        std::size_t m_rbsHash;            //!< hash of the active RBs
+
+        /**
+         * \param other another key
+         * \return true if this key sorts before \p other
+         */
+        bool operator<(const TxPsdKey& other) const;
+    };
+
+    /// A cached TX PSD
+    struct TxPsdEntry
+    {
+        std::vector<int> m_activeRbs; //!< active RBs of the PSD
+        Ptr<SpectrumValue> m_psd;     //!< the PSD
+    };
+
     // static Ptr<SpectrumModel> m_model;
     static std::map<uint8_t, Ptr<SpectrumModel>> m_model;
+    /// cache of the TX PSDs
+    static std::map<TxPsdKey, TxPsdEntry> m_txPsds;
+    /// cache of the noise PSDs, by spectrum model and noise figure
+    static std::map<std::pair<Ptr<const SpectrumModel>, double>, Ptr<SpectrumValue>> m_noisePsds;
 };
 
 } // namespace mmwave
@@ -0,0 +1,103 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-transport-block.h"
+
+#include <ns3/log.h>
+#include <ns3/packet-burst.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MmWaveTransportBlock");
+
+namespace mmwave
+{
+
+MmWaveTransportBlock::MmWaveTransportBlock(const DciInfoElementTdma& dci, SfnSf sfn)
+    : m_rnti(dci.m_rnti),
+      m_harqProcess(dci.m_harqProcess),
+      m_mcs(dci.m_mcs),
+      m_tbSize(dci.m_tbSize),
+      m_sfn(sfn),
+      m_numSym(dci.m_numSym)
+{
+    NS_LOG_FUNCTION(this << dci.m_rnti << +dci.m_harqProcess);
+}
+
+void
+MmWaveTransportBlock::AddPdu(Ptr<Packet> pdu)
+{
+    NS_LOG_FUNCTION(this << pdu);
+    m_pdus.push_back(pdu);
+}
+
+void
+MmWaveTransportBlock::AddPdus(Ptr<const PacketBurst> pb)
+{
+    NS_LOG_FUNCTION(this << pb);
+    m_pdus.reserve(m_pdus.size() + pb->GetNPackets());
+    for (auto it = pb->Begin(); it != pb->End(); ++it)
+    {
+        m_pdus.push_back(*it);
+    }
+}
+
+uint16_t
+MmWaveTransportBlock::GetRnti() const
+{
+    return m_rnti;
+}
+
+uint8_t
+MmWaveTransportBlock::GetHarqProcess() const
+{
+    return m_harqProcess;
+}
+
+uint8_t
+MmWaveTransportBlock::GetMcs() const
+{
+    return m_mcs;
+}
+
+uint32_t
+MmWaveTransportBlock::GetTbSize() const
+{
+    return m_tbSize;
+}
+
+SfnSf
+MmWaveTransportBlock::GetSfn() const
+{
+    return m_sfn;
+}
+
+uint8_t
+MmWaveTransportBlock::GetNumSym() const
+{
+    return m_numSym;
+}
+
+const std::vector<Ptr<Packet>>&
+MmWaveTransportBlock::GetPdus() const
+{
+    return m_pdus;
+}
+
+} // namespace mmwave
+
+} // namespace ns3
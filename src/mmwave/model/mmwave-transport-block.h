@@ -0,0 +1,118 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_TRANSPORT_BLOCK_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_TRANSPORT_BLOCK_H_
+
+#include "mmwave-phy-mac-common.h"
+
+#include <ns3/packet.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <vector>
+
+namespace ns3
+{
+
+class PacketBurst;
+
+namespace mmwave
+{
+
+/**
+ * \ingroup mmwave
+ * A transport block sent over the air in a data TTI: the MAC PDUs of a UE,
+ * together with the scheduling information of the DCI that allocated the TTI.
+ *
+ * The receiver decides the outcome of the TB and delivers or drops all its
+ * PDUs at once, without looking up the RNTI and the SFN in the tags of each
+ * PDU.
+ *
+ * Once sent, the TB is shared by the transmitter and all the receivers, and
+ * is not modified anymore.
+ */
+class MmWaveTransportBlock : public SimpleRefCount<MmWaveTransportBlock>
+{
+  public:
+    /**
+     * \param dci the DCI of the TTI
+     * \param sfn the frame, subframe, slot and first symbol of the TTI
+     */
+    MmWaveTransportBlock(const DciInfoElementTdma& dci, SfnSf sfn);
+
+    /**
+     * \param pdu a MAC PDU to be sent in the TB
+     */
+    void AddPdu(Ptr<Packet> pdu);
+
+    /**
+     * Add all the MAC PDUs of a packet burst to the TB
+     *
+     * \param pb the packet burst
+     */
+    void AddPdus(Ptr<const PacketBurst> pb);
+
+    /**
+     * \return the RNTI of the UE
+     */
+    uint16_t GetRnti() const;
+
+    /**
+     * \return the HARQ process of the TB
+     */
+    uint8_t GetHarqProcess() const;
+
+    /**
+     * \return the MCS of the TB
+     */
+    uint8_t GetMcs() const;
+
+    /**
+     * \return the size of the TB, in bytes, as scheduled
+     */
+    uint32_t GetTbSize() const;
+
+    /**
+     * \return the frame, subframe, slot and first symbol of the TTI
+     */
+    SfnSf GetSfn() const;
+
+    /**
+     * \return the number of symbols of the TTI
+     */
+    uint8_t GetNumSym() const;
+
+    /**
+     * \return the MAC PDUs of the TB
+     */
+    const std::vector<Ptr<Packet>>& GetPdus() const;
+
+  private:
+    uint16_t m_rnti;                 // RNTI of the UE
+    uint8_t m_harqProcess;           // HARQ process of the TB
+    uint8_t m_mcs;                   // MCS of the TB
+    uint32_t m_tbSize;               // scheduled size of the TB
+    SfnSf m_sfn;                     // frame, subframe, slot and first symbol of the TTI
+    uint8_t m_numSym;                // number of symbols of the TTI
+    std::vector<Ptr<Packet>> m_pdus; // MAC PDUs of the TB
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_TRANSPORT_BLOCK_H_ */
@@ -288,11 +288,6 @@ MmWaveUeMac::SetConfigurationParameters(Ptr<MmWavePhyMacCommon> ptrConfig)
 
     m_miUlHarqProcessesPacket.clear();
     m_miUlHarqProcessesPacket.resize(m_phyMacConfig->GetNumHarqProcess());
-    for (uint8_t i = 0; i < m_miUlHarqProcessesPacket.size(); i++)
-    {
-        Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
-        m_miUlHarqProcessesPacket.at(i).m_pktBurst = pb;
-    }
     m_miUlHarqProcessesPacketTimer.clear();
     m_miUlHarqProcessesPacketTimer.resize(m_phyMacConfig->GetNumHarqProcess(), 0);
 
@@ -358,8 +353,7 @@ MmWaveUeMac::DoTransmitPdu(LteMacSapProvider::TransmitPduParameters params)
 
             LteRadioBearerTag bearerTag(params.rnti, 0, 0);
             it->second.m_pdu->AddPacketTag(bearerTag);
-            m_miUlHarqProcessesPacket.at(params.harqProcessId)
-                .m_pktBurst->AddPacket(it->second.m_pdu);
+            m_miUlHarqProcessesPacket.at(params.harqProcessId).m_pdu = it->second.m_pdu;
             m_miUlHarqProcessesPacketTimer.at(params.harqProcessId) =
                 m_phyMacConfig->GetHarqTimeout();
             // m_harqProcessId = (m_harqProcessId + 1) % m_phyMacConfig->GetHarqTimeout();
@@ -491,12 +485,11 @@ MmWaveUeMac::RefreshHarqProcessesPacketBuffer(void)
     {
         if (m_miUlHarqProcessesPacketTimer.at(i) == 0)
         {
-            if (m_miUlHarqProcessesPacket.at(i).m_pktBurst->GetSize() > 0)
+            if (m_miUlHarqProcessesPacket.at(i).m_pdu)
             {
                 // timer expired: drop packets in buffer for this process
                 NS_LOG_INFO(this << " HARQ Proc Id " << i << " packets buffer expired");
-                Ptr<PacketBurst> emptyPb = CreateObject<PacketBurst>();
-                m_miUlHarqProcessesPacket.at(i).m_pktBurst = emptyPb;
+                m_miUlHarqProcessesPacket.at(i).m_pdu = nullptr;
                 m_miUlHarqProcessesPacket.at(i).m_lcidList.clear();
             }
         }
@@ -539,7 +532,7 @@ MmWaveUeMac::DoReceivePhyPdu(Ptr<Packet> p)
     NS_LOG_INFO("ReceivePdu for rnti " << tag.GetRnti());
     if (tag.GetRnti() == m_rnti) // packet is for the current user
     {
-        std::vector<MacSubheader> macSubheaders = macHeader.GetSubheaders();
+        MacSubheaderSpan macSubheaders = macHeader.GetSubheaders();
         // NS_LOG_UNCOND("MmWaveUeMac receive PHY pdu with " << macSubheaders.size() << " pdu");
         uint32_t currPos = 0;
         for (unsigned ipdu = 0; ipdu < macSubheaders.size(); ipdu++)
@@ -689,8 +682,7 @@ MmWaveUeMac::DoReceiveControlMessage(Ptr<MmWaveControlMessage> msg)
             {
                 // New transmission -> empty pkt buffer queue (for deleting eventual pkts not acked
                 // )
-                Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
-                m_miUlHarqProcessesPacket.at(dciInfoElem.m_harqProcess).m_pktBurst = pb;
+                m_miUlHarqProcessesPacket.at(dciInfoElem.m_harqProcess).m_pdu = nullptr;
                 m_miUlHarqProcessesPacket.at(dciInfoElem.m_harqProcess).m_lcidList.clear();
                 // Retrieve data from RLC
                 std::map<uint8_t, LteMacSapProvider::ReportBufferStatusParameters>::iterator itBsr;
@@ -746,8 +738,7 @@ MmWaveUeMac::DoReceiveControlMessage(Ptr<MmWaveControlMessage> msg)
                     emptyPdu->AddPacketTag(tag);
                     LteRadioBearerTag bearerTag(dciInfoElem.m_rnti, 3, 0);
                     emptyPdu->AddPacketTag(bearerTag);
-                    m_miUlHarqProcessesPacket.at(dciInfoElem.m_harqProcess)
-                        .m_pktBurst->AddPacket(emptyPdu);
+                    m_miUlHarqProcessesPacket.at(dciInfoElem.m_harqProcess).m_pdu = emptyPdu;
                     m_miUlHarqProcessesPacketTimer.at(dciInfoElem.m_harqProcess) =
                         m_phyMacConfig->GetHarqTimeout();
                     // m_harqProcessId = (m_harqProcessId + 1) % m_phyMacConfig->GetHarqTimeout();
@@ -936,14 +927,12 @@ MmWaveUeMac::DoReceiveControlMessage(Ptr<MmWaveControlMessage> msg)
             {
                 // HARQ retransmission -> retrieve data from HARQ buffer
                 NS_LOG_DEBUG(this << " UE MAC RETX HARQ " << (unsigned)dciInfoElem.m_harqProcess);
-                Ptr<PacketBurst> pb =
-                    m_miUlHarqProcessesPacket.at(dciInfoElem.m_harqProcess).m_pktBurst;
-                for (std::list<Ptr<Packet>>::const_iterator j = pb->Begin(); j != pb->End(); ++j)
+                Ptr<Packet> pkt = m_miUlHarqProcessesPacket.at(dciInfoElem.m_harqProcess).m_pdu;
+                if (pkt)
                 {
-                    Ptr<Packet> pkt = (*j)->Copy();
-                    // update packet tag
+                    // update packet tag, the TB is sent again as it is
                     MmWaveMacPduTag tag;
-                    if (!pkt->RemovePacketTag(tag))
+                    if (!pkt->PeekPacketTag(tag))
                     {
                         NS_FATAL_ERROR("No MAC PDU tag");
                     }
@@ -967,7 +956,7 @@ MmWaveUeMac::DoReceiveControlMessage(Ptr<MmWaveControlMessage> msg)
                               (frameNum >= m_frameNum));
 
                     tag.SetSfn(SfnSf(frameNum, sfNum, slotNum, dciInfoElem.m_symStart));
-                    pkt->AddPacketTag(tag);
+                    pkt->ReplacePacketTag(tag);
 
                     m_txMacPacketTraceUe(m_rnti, m_componentCarrierId, pkt->GetSize());
                     m_phySapProvider->SendMacPdu(pkt);
@@ -153,9 +153,11 @@ class MmWaveUeMac : public Object
     uint8_t m_raPreambleId;
     uint8_t m_raRnti;
 
+    // slot of a UL HARQ process, the MAC PDU is retransmitted as it is, with
+    // the MmWaveMacPduTag of the retransmission
     struct UlHarqProcessInfo
     {
-        Ptr<PacketBurst> m_pktBurst;
+        Ptr<Packet> m_pdu; // MAC PDU of the TB under transmission, null if none
         // maintain list of LCs contained in this TB
         // used to signal HARQ failure to RLC handlers
         std::vector<uint8_t> m_lcidList;
@@ -401,6 +401,16 @@ MmWaveUePhy::GetUlSpectrumPhy() const
     return m_uplinkSpectrumPhy;
 }
 
+int64_t
+MmWaveUePhy::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    int64_t currentStream = stream;
+    currentStream += m_downlinkSpectrumPhy->AssignStreams(currentStream);
+    currentStream += m_uplinkSpectrumPhy->AssignStreams(currentStream);
+    return (currentStream - stream);
+}
+
 void
 MmWaveUePhy::ReceiveControlMessageList(std::list<Ptr<MmWaveControlMessage>> msgList)
 {
@@ -682,11 +692,15 @@ MmWaveUePhy::StartTti()
 
         if (pktBurst)
         {
+            Ptr<MmWaveTransportBlock> tb = Create<MmWaveTransportBlock>(
+                currTti.m_dci,
+                SfnSf(m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));
+            tb->AddPdus(pktBurst);
             std::list<Ptr<MmWaveControlMessage>> ctrlMsg = GetControlMessages();
             m_sendDataChannelEvent = Simulator::Schedule(NanoSeconds(1.0),
                                                          &MmWaveUePhy::SendDataChannels,
                                                          this,
-                                                         pktBurst,
+                                                         tb,
                                                          ctrlMsg,
                                                          currTtiDuration - NanoSeconds(2.0),
                                                          m_slotNum);
@@ -794,7 +808,7 @@ MmWaveUePhy::DelayPhyDataPacketReceived(Ptr<Packet> p)
 }
 
 void
-MmWaveUePhy::SendDataChannels(Ptr<PacketBurst> pb,
+MmWaveUePhy::SendDataChannels(Ptr<MmWaveTransportBlock> tb,
                               std::list<Ptr<MmWaveControlMessage>> ctrlMsg,
                               Time duration,
                               uint8_t slotInd)
@@ -808,15 +822,10 @@ MmWaveUePhy::SendDataChannels(Ptr<PacketBurst> pb,
      * */
     // antennaArray->SetSector (3,16);
 
-    if (pb->GetNPackets() > 0)
+    if (!tb->GetPdus().empty())
     {
-        LteRadioBearerTag tag;
-        if (!pb->GetPackets().front()->PeekPacketTag(tag))
-        {
-            NS_FATAL_ERROR("No radio bearer tag");
-        }
-        // call only if the packet burst is > 0
-        m_downlinkSpectrumPhy->StartTxDataFrames(pb, ctrlMsg, duration, slotInd);
+        // call only if the TB has some PDUs
+        m_downlinkSpectrumPhy->StartTxDataFrames(tb, ctrlMsg, duration, slotInd);
     }
 }
 
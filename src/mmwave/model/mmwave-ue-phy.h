@@ -36,6 +36,7 @@
 #include "mmwave-amc.h"
 #include "mmwave-enb-net-device.h"
 #include "mmwave-phy-mac-common.h"
+#include "mmwave-transport-block.h"
 
 #include <ns3/lte-ue-cphy-sap.h>
 #include <ns3/lte-ue-phy-sap.h>
@@ -162,7 +163,7 @@ class MmWaveUePhy : public MmWavePhy
     void PhyDataPacketReceived(Ptr<Packet> p);
     void DelayPhyDataPacketReceived(Ptr<Packet> p);
 
-    void SendDataChannels(Ptr<PacketBurst> pb,
+    void SendDataChannels(Ptr<MmWaveTransportBlock> tb,
                           std::list<Ptr<MmWaveControlMessage>> ctrlMsg,
                           Time duration,
                           uint8_t slotInd);
@@ -191,6 +192,16 @@ class MmWaveUePhy : public MmWavePhy
 
     void UpdateSinrEstimate(uint16_t cellId, double sinr);
 
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model and by its spectrum PHYs.  Return the number of
+     * streams (possibly zero) that have been assigned.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
   private:
     void DoReset();
     void DoStartCellSearch(uint16_t dlEarfcn);
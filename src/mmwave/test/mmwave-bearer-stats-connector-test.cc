@@ -0,0 +1,326 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mmwave-bearer-stats-calculator.h"
+#include "ns3/mmwave-bearer-stats-connector.h"
+#include "ns3/error-model.h"
+#include "ns3/node.h"
+#include "ns3/object-map.h"
+#include "ns3/pointer.h"
+#include "ns3/queue.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traced-callback.h"
+
+#include <map>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * Stand-in for an RLC or PDCP entity, with the same PDU trace sources
+ */
+class BearerStatsTestEntity : public Object
+{
+  public:
+    static TypeId GetTypeId(void)
+    {
+        static TypeId tid =
+            TypeId("ns3::BearerStatsTestEntity")
+                .SetParent<Object>()
+                .AddConstructor<BearerStatsTestEntity>()
+                .AddTraceSource("TxPDU",
+                                "PDU transmitted",
+                                MakeTraceSourceAccessor(&BearerStatsTestEntity::m_txPdu),
+                                "ns3::LteRlc::NotifyTxTracedCallback")
+                .AddTraceSource("RxPDU",
+                                "PDU received",
+                                MakeTraceSourceAccessor(&BearerStatsTestEntity::m_rxPdu),
+                                "ns3::LteRlc::ReceiveTracedCallback");
+        return tid;
+    }
+
+    TracedCallback<uint16_t, uint8_t, uint32_t> m_txPdu;           //!< TxPDU trace source
+    TracedCallback<uint16_t, uint8_t, uint32_t, uint64_t> m_rxPdu; //!< RxPDU trace source
+};
+
+/**
+ * Stand-in for a radio bearer info, pointing to its RLC and PDCP entities
+ */
+class BearerStatsTestBearer : public Object
+{
+  public:
+    static TypeId GetTypeId(void)
+    {
+        static TypeId tid =
+            TypeId("ns3::BearerStatsTestBearer")
+                .SetParent<Object>()
+                .AddConstructor<BearerStatsTestBearer>()
+                .AddAttribute("LteRlc",
+                              "RLC entity",
+                              PointerValue(),
+                              MakePointerAccessor(&BearerStatsTestBearer::m_rlc),
+                              MakePointerChecker<BearerStatsTestEntity>())
+                .AddAttribute("LtePdcp",
+                              "PDCP entity",
+                              PointerValue(),
+                              MakePointerAccessor(&BearerStatsTestBearer::m_pdcp),
+                              MakePointerChecker<BearerStatsTestEntity>());
+        return tid;
+    }
+
+    BearerStatsTestBearer()
+        : m_rlc(CreateObject<BearerStatsTestEntity>()),
+          m_pdcp(CreateObject<BearerStatsTestEntity>())
+    {
+    }
+
+    Ptr<BearerStatsTestEntity> m_rlc;  //!< RLC entity
+    Ptr<BearerStatsTestEntity> m_pdcp; //!< PDCP entity
+};
+
+/**
+ * Stand-in for the RRC of a UE or for the UeManager of an eNB, with the same
+ * bearer attributes and trace sources
+ */
+class BearerStatsTestRrc : public Object
+{
+  public:
+    static TypeId GetTypeId(void)
+    {
+        static TypeId tid =
+            TypeId("ns3::BearerStatsTestRrc")
+                .SetParent<Object>()
+                .AddConstructor<BearerStatsTestRrc>()
+                .AddAttribute("Srb0",
+                              "SRB0",
+                              PointerValue(),
+                              MakePointerAccessor(&BearerStatsTestRrc::m_srb0),
+                              MakePointerChecker<BearerStatsTestBearer>())
+                .AddAttribute("Srb1",
+                              "SRB1",
+                              PointerValue(),
+                              MakePointerAccessor(&BearerStatsTestRrc::m_srb1),
+                              MakePointerChecker<BearerStatsTestBearer>())
+                .AddAttribute("DataRadioBearerMap",
+                              "DRBs",
+                              ObjectMapValue(),
+                              MakeObjectMapAccessor(&BearerStatsTestRrc::m_drbMap),
+                              MakeObjectMapChecker<BearerStatsTestBearer>())
+                .AddAttribute("DataRadioRlcMap",
+                              "Secondary RLCs",
+                              ObjectMapValue(),
+                              MakeObjectMapAccessor(&BearerStatsTestRrc::m_rlcMap),
+                              MakeObjectMapChecker<BearerStatsTestBearer>())
+                .AddTraceSource("RandomAccessSuccessful",
+                                "Random access completed",
+                                MakeTraceSourceAccessor(&BearerStatsTestRrc::m_randomAccess),
+                                "ns3::LteUeRrc::ImsiCidRntiTracedCallback")
+                .AddTraceSource("ConnectionReconfiguration",
+                                "RRC connection reconfiguration",
+                                MakeTraceSourceAccessor(&BearerStatsTestRrc::m_reconfiguration),
+                                "ns3::LteUeRrc::ImsiCidRntiTracedCallback")
+                .AddTraceSource("SecondaryRlcCreated",
+                                "Secondary RLC created",
+                                MakeTraceSourceAccessor(&BearerStatsTestRrc::m_secondaryRlc),
+                                "ns3::UeManager::ImsiCidRntiTracedCallback");
+        return tid;
+    }
+
+    BearerStatsTestRrc()
+        : m_srb0(CreateObject<BearerStatsTestBearer>()),
+          m_srb1(CreateObject<BearerStatsTestBearer>())
+    {
+        m_drbMap[3] = CreateObject<BearerStatsTestBearer>();
+        m_rlcMap[3] = CreateObject<BearerStatsTestBearer>();
+    }
+
+    Ptr<BearerStatsTestBearer> m_srb0;                         //!< SRB0
+    Ptr<BearerStatsTestBearer> m_srb1;                         //!< SRB1
+    std::map<uint8_t, Ptr<BearerStatsTestBearer>> m_drbMap;    //!< DRBs
+    std::map<uint8_t, Ptr<BearerStatsTestBearer>> m_rlcMap;    //!< secondary RLCs
+    TracedCallback<uint64_t, uint16_t, uint16_t> m_randomAccess;    //!< RandomAccessSuccessful
+    TracedCallback<uint64_t, uint16_t, uint16_t> m_reconfiguration; //!< ConnectionReconfiguration
+    TracedCallback<uint64_t, uint16_t, uint16_t> m_secondaryRlc;    //!< SecondaryRlcCreated
+};
+
+/**
+ * Stand-in for the RRC of an eNB, with its map of UeManagers
+ */
+class BearerStatsTestEnbRrc : public Object
+{
+  public:
+    static TypeId GetTypeId(void)
+    {
+        static TypeId tid =
+            TypeId("ns3::BearerStatsTestEnbRrc")
+                .SetParent<Object>()
+                .AddConstructor<BearerStatsTestEnbRrc>()
+                .AddAttribute("UeMap",
+                              "UeManagers by RNTI",
+                              ObjectMapValue(),
+                              MakeObjectMapAccessor(&BearerStatsTestEnbRrc::m_ueMap),
+                              MakeObjectMapChecker<BearerStatsTestRrc>())
+                .AddTraceSource("NewUeContext",
+                                "New UE context",
+                                MakeTraceSourceAccessor(&BearerStatsTestEnbRrc::m_newUeContext),
+                                "ns3::LteEnbRrc::NewUeContextTracedCallback")
+                .AddTraceSource("ConnectionReconfiguration",
+                                "RRC connection reconfiguration",
+                                MakeTraceSourceAccessor(&BearerStatsTestEnbRrc::m_reconfiguration),
+                                "ns3::LteEnbRrc::ConnectionHandoverTracedCallback");
+        return tid;
+    }
+
+    std::map<uint16_t, Ptr<BearerStatsTestRrc>> m_ueMap;            //!< UeManagers by RNTI
+    TracedCallback<uint16_t, uint16_t> m_newUeContext;              //!< NewUeContext
+    TracedCallback<uint64_t, uint16_t, uint16_t> m_reconfiguration; //!< ConnectionReconfiguration
+};
+
+/**
+ * Stand-in for the LTE net devices, pointing to their RRC
+ */
+class BearerStatsTestNetDevice : public SimpleNetDevice
+{
+  public:
+    static TypeId GetTypeId(void)
+    {
+        static TypeId tid =
+            TypeId("ns3::BearerStatsTestNetDevice")
+                .SetParent<SimpleNetDevice>()
+                .AddAttribute("LteUeRrc",
+                              "RRC of the UE",
+                              PointerValue(),
+                              MakePointerAccessor(&BearerStatsTestNetDevice::m_ueRrc),
+                              MakePointerChecker<BearerStatsTestRrc>())
+                .AddAttribute("LteEnbRrc",
+                              "RRC of the eNB",
+                              PointerValue(),
+                              MakePointerAccessor(&BearerStatsTestNetDevice::m_enbRrc),
+                              MakePointerChecker<BearerStatsTestEnbRrc>());
+        return tid;
+    }
+
+    Ptr<BearerStatsTestRrc> m_ueRrc;     //!< RRC of the UE
+    Ptr<BearerStatsTestEnbRrc> m_enbRrc; //!< RRC of the eNB
+};
+
+/**
+ * This test case checks that the bearer stats connector binds the RLC and
+ * PDCP statistics to the entities of a UE and of its UeManager, which it
+ * reaches through the attributes of the devices instead of Config paths
+ */
+class MmWaveBearerStatsConnectorTestCase : public TestCase
+{
+  public:
+    MmWaveBearerStatsConnectorTestCase()
+        : TestCase("Checks the direct connection of the RLC and PDCP statistics")
+    {
+    }
+
+  private:
+    virtual void DoRun(void) override;
+};
+
+void
+MmWaveBearerStatsConnectorTestCase::DoRun(void)
+{
+    const uint64_t imsi = 7;
+    const uint16_t cellId = 2;
+    const uint16_t rnti = 5;
+
+    Ptr<Node> enbNode = CreateObject<Node>();
+    Ptr<BearerStatsTestNetDevice> enbDevice = CreateObject<BearerStatsTestNetDevice>();
+    enbDevice->m_enbRrc = CreateObject<BearerStatsTestEnbRrc>();
+    enbNode->AddDevice(enbDevice);
+    Ptr<Node> ueNode = CreateObject<Node>();
+    Ptr<BearerStatsTestNetDevice> ueDevice = CreateObject<BearerStatsTestNetDevice>();
+    ueDevice->m_ueRrc = CreateObject<BearerStatsTestRrc>();
+    ueNode->AddDevice(ueDevice);
+    Ptr<BearerStatsTestRrc> ueRrc = ueDevice->m_ueRrc;
+
+    Ptr<MmWaveBearerStatsCalculator> rlcStats =
+        CreateObjectWithAttributes<MmWaveBearerStatsCalculator>(
+            "DlRlcOutputFilename",
+            StringValue(CreateTempDirFilename("DlRlcStats.txt")),
+            "UlRlcOutputFilename",
+            StringValue(CreateTempDirFilename("UlRlcStats.txt")));
+    Ptr<MmWaveBearerStatsCalculator> pdcpStats =
+        CreateObjectWithAttributes<MmWaveBearerStatsCalculator>(
+            "DlPdcpOutputFilename",
+            StringValue(CreateTempDirFilename("DlPdcpStats.txt")),
+            "UlPdcpOutputFilename",
+            StringValue(CreateTempDirFilename("UlPdcpStats.txt")));
+    Ptr<MmWaveBearerStatsConnector> connector = CreateObject<MmWaveBearerStatsConnector>();
+    connector->EnableRlcStats(rlcStats);
+    connector->EnablePdcpStats(pdcpStats);
+
+    // the UE attaches and its bearers are set up
+    Ptr<BearerStatsTestRrc> ueManager = CreateObject<BearerStatsTestRrc>();
+    enbDevice->m_enbRrc->m_ueMap[rnti] = ueManager;
+    enbDevice->m_enbRrc->m_newUeContext(cellId, rnti);
+    ueRrc->m_randomAccess(imsi, cellId, rnti);
+    ueRrc->m_reconfiguration(imsi, cellId, rnti);
+    enbDevice->m_enbRrc->m_reconfiguration(imsi, cellId, rnti);
+    ueManager->m_secondaryRlc(imsi, cellId, rnti);
+
+    // SRBs
+    ueRrc->m_srb0->m_rlc->m_txPdu(rnti, 0, 10);
+    ueManager->m_srb0->m_rlc->m_rxPdu(rnti, 0, 10, 0);
+    ueRrc->m_srb1->m_rlc->m_txPdu(rnti, 1, 20);
+    ueManager->m_srb1->m_pdcp->m_txPdu(rnti, 1, 30);
+    NS_TEST_ASSERT_MSG_EQ(rlcStats->GetUlTxPackets(imsi, 0), 1, "UE SRB0 RLC not connected");
+    NS_TEST_ASSERT_MSG_EQ(rlcStats->GetUlRxPackets(imsi, 0), 1, "eNB SRB0 RLC not connected");
+    NS_TEST_ASSERT_MSG_EQ(rlcStats->GetUlTxData(imsi, 1), 20, "UE SRB1 RLC not connected");
+    NS_TEST_ASSERT_MSG_EQ(pdcpStats->GetDlTxData(imsi, 1), 30, "eNB SRB1 PDCP not connected");
+
+    // DRBs, at the UE and at the eNB
+    ueRrc->m_drbMap[3]->m_rlc->m_txPdu(rnti, 3, 100);
+    ueRrc->m_drbMap[3]->m_pdcp->m_rxPdu(rnti, 3, 200, 0);
+    ueManager->m_drbMap[3]->m_rlc->m_rxPdu(rnti, 3, 100, 0);
+    ueManager->m_drbMap[3]->m_pdcp->m_txPdu(rnti, 3, 200);
+    NS_TEST_ASSERT_MSG_EQ(rlcStats->GetUlTxData(imsi, 3), 100, "UE DRB RLC not connected");
+    NS_TEST_ASSERT_MSG_EQ(pdcpStats->GetDlRxData(imsi, 3), 200, "UE DRB PDCP not connected");
+    NS_TEST_ASSERT_MSG_EQ(rlcStats->GetUlRxData(imsi, 3), 100, "eNB DRB RLC not connected");
+    NS_TEST_ASSERT_MSG_EQ(pdcpStats->GetDlTxData(imsi, 3), 200, "eNB DRB PDCP not connected");
+
+    // secondary RLC of the eNB, created at runtime
+    ueManager->m_rlcMap[3]->m_rlc->m_txPdu(rnti, 3, 300);
+    NS_TEST_ASSERT_MSG_EQ(rlcStats->GetDlTxData(imsi, 3), 300, "Secondary RLC not connected");
+
+    connector->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * Test suite for the mmWave bearer stats connector
+ */
+class MmWaveBearerStatsConnectorTestSuite : public TestSuite
+{
+  public:
+    MmWaveBearerStatsConnectorTestSuite();
+};
+
+MmWaveBearerStatsConnectorTestSuite::MmWaveBearerStatsConnectorTestSuite()
+    : TestSuite("mmwave-bearer-stats-connector", UNIT)
+{
+    AddTestCase(new MmWaveBearerStatsConnectorTestCase, TestCase::QUICK);
+}
+
+static MmWaveBearerStatsConnectorTestSuite g_mmWaveBearerStatsConnectorTestSuite;
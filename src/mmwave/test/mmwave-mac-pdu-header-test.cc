@@ -0,0 +1,121 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mmwave-mac-pdu-header.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * This test case checks that the MAC PDU header is parsed as it was built,
+ * with subheaders stored inline and moved to the heap
+ */
+class MmWaveMacPduHeaderTestCase : public TestCase
+{
+  public:
+    MmWaveMacPduHeaderTestCase()
+        : TestCase("Checks the serialization of the MAC PDU header")
+    {
+    }
+
+  private:
+    virtual void DoRun(void) override;
+
+    /**
+     * Check the subheaders of a header
+     *
+     * \param header the header
+     * \param expected the expected subheaders
+     */
+    void CheckSubheaders(const MmWaveMacPduHeader& header,
+                         const std::vector<MacSubheader>& expected);
+};
+
+void
+MmWaveMacPduHeaderTestCase::CheckSubheaders(const MmWaveMacPduHeader& header,
+                                            const std::vector<MacSubheader>& expected)
+{
+    MacSubheaderSpan subheaders = header.GetSubheaders();
+    NS_TEST_ASSERT_MSG_EQ(subheaders.size(), expected.size(), "Wrong number of subheaders");
+    for (uint32_t i = 0; i < subheaders.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(+subheaders[i].m_lcid, +expected[i].m_lcid, "Wrong LCID " << i);
+        NS_TEST_ASSERT_MSG_EQ(subheaders[i].m_size, expected[i].m_size, "Wrong size " << i);
+    }
+}
+
+void
+MmWaveMacPduHeaderTestCase::DoRun(void)
+{
+    // sizes with one, two and three length octets
+    const uint32_t sizes[] = {0, 100, 127, 128, 5000, 0x3FFF, 0x4000, 0x3FFFFF};
+    const uint32_t sizeBytes[] = {2, 2, 2, 3, 3, 3, 4, 4};
+    const uint32_t numSizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    for (uint32_t n = 1; n <= MmWaveMacPduHeader::INLINE_SUBHEADERS + 8; ++n)
+    {
+        MmWaveMacPduHeader header;
+        std::vector<MacSubheader> expected;
+        uint32_t headerSize = 0;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            MacSubheader subheader(i % 32, sizes[(n + i) % numSizes]);
+            header.AddSubheader(subheader);
+            expected.push_back(subheader);
+            headerSize += sizeBytes[(n + i) % numSizes];
+        }
+        NS_TEST_ASSERT_MSG_EQ(header.GetSerializedSize(), headerSize, "Wrong header size");
+        CheckSubheaders(header, expected);
+
+        Ptr<Packet> p = Create<Packet>(10);
+        p->AddHeader(header);
+        NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 10 + headerSize, "Wrong packet size");
+        MmWaveMacPduHeader parsed;
+        p->RemoveHeader(parsed);
+        NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 10, "Header not removed");
+        NS_TEST_ASSERT_MSG_EQ(parsed.GetSerializedSize(), headerSize, "Wrong parsed header size");
+        CheckSubheaders(parsed, expected);
+
+        MmWaveMacPduHeader copy;
+        copy.SetSubheaders(expected);
+        NS_TEST_ASSERT_MSG_EQ(copy.GetSerializedSize(), headerSize, "Wrong set header size");
+        CheckSubheaders(copy, expected);
+        copy.AddSubheader(MacSubheader(3, 0));
+        expected.push_back(MacSubheader(3, 0));
+        CheckSubheaders(copy, expected);
+    }
+}
+
+/**
+ * Test suite for the MAC PDU header
+ */
+class MmWaveMacPduHeaderTestSuite : public TestSuite
+{
+  public:
+    MmWaveMacPduHeaderTestSuite();
+};
+
+MmWaveMacPduHeaderTestSuite::MmWaveMacPduHeaderTestSuite()
+    : TestSuite("mmwave-mac-pdu-header", UNIT)
+{
+    AddTestCase(new MmWaveMacPduHeaderTestCase, TestCase::QUICK);
+}
+
+static MmWaveMacPduHeaderTestSuite g_mmWaveMacPduHeaderTestSuite;
@@ -0,0 +1,234 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/mmwave-phy-trace.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * Read the lines of a trace file, skipping the header
+ *
+ * \param filename the name of the file
+ * \return the lines of the file, header excluded
+ */
+static std::vector<std::string>
+ReadTraceLines(std::string filename)
+{
+    std::vector<std::string> lines;
+    std::ifstream file(filename.c_str());
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line))
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/**
+ * Split a line of a trace file into its tab-separated fields
+ *
+ * \param line the line
+ * \return the fields of the line
+ */
+static std::vector<std::string>
+SplitTraceLine(std::string line)
+{
+    std::vector<std::string> fields;
+    std::istringstream is(line);
+    std::string field;
+    while (std::getline(is, field, '\t'))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/**
+ * This test case checks the per-window summaries and the reservoir sampling
+ * of the aggregated PHY reception trace
+ */
+class MmWavePhyTraceAggregationTestCase : public TestCase
+{
+  public:
+    MmWavePhyTraceAggregationTestCase()
+        : TestCase("Checks the aggregation mode of the PHY reception trace")
+    {
+    }
+
+  private:
+    virtual void DoRun(void) override;
+
+    /**
+     * Create a MmWavePhyTrace in aggregation mode
+     *
+     * \param reservoirSize the number of raw records sampled per window
+     * \param stream the stream of the reservoir sampling
+     * \return the trace
+     */
+    Ptr<MmWavePhyTrace> CreateTrace(uint32_t reservoirSize, int64_t stream);
+
+    /**
+     * Schedule the reception of a DL TB by the trace
+     *
+     * \param trace the trace
+     * \param time the reception time
+     * \param tbSize the size of the TB
+     * \param mcs the MCS of the TB
+     * \param corrupt whether the TB is corrupted
+     * \param rv the redundancy version of the TB
+     * \param sinr the linear SINR of the TB
+     */
+    void ScheduleRx(Ptr<MmWavePhyTrace> trace,
+                    Time time,
+                    uint32_t tbSize,
+                    uint8_t mcs,
+                    bool corrupt,
+                    uint8_t rv,
+                    double sinr = 10.0);
+
+    std::string m_rawFilename;       //!< name of the raw PHY reception trace
+    std::string m_aggregateFilename; //!< name of the aggregated PHY reception trace
+};
+
+Ptr<MmWavePhyTrace>
+MmWavePhyTraceAggregationTestCase::CreateTrace(uint32_t reservoirSize, int64_t stream)
+{
+    Ptr<MmWavePhyTrace> trace = CreateObject<MmWavePhyTrace>();
+    trace->SetAttribute("OutputFilename", StringValue(m_rawFilename));
+    trace->SetAttribute("RxAggregationFilename", StringValue(m_aggregateFilename));
+    trace->SetAttribute("RxAggregation", BooleanValue(true));
+    trace->SetAttribute("RxAggregationWindow", TimeValue(MilliSeconds(10)));
+    trace->SetAttribute("RxReservoirSize", UintegerValue(reservoirSize));
+    trace->AssignStreams(stream);
+    return trace;
+}
+
+void
+MmWavePhyTraceAggregationTestCase::ScheduleRx(Ptr<MmWavePhyTrace> trace,
+                                              Time time,
+                                              uint32_t tbSize,
+                                              uint8_t mcs,
+                                              bool corrupt,
+                                              uint8_t rv,
+                                              double sinr)
+{
+    RxPacketTraceParams params = {};
+    params.m_cellId = 1;
+    params.m_rnti = 2;
+    params.m_tbSize = tbSize;
+    params.m_mcs = mcs;
+    params.m_rv = rv;
+    params.m_sinr = sinr;
+    params.m_corrupt = corrupt;
+    Simulator::Schedule(time,
+                        &MmWavePhyTrace::RxPacketTraceUeCallbackWithoutContext,
+                        trace,
+                        params);
+}
+
+void
+MmWavePhyTraceAggregationTestCase::DoRun(void)
+{
+    m_rawFilename = CreateTempDirFilename("mmwave-phy-trace-raw.txt");
+    m_aggregateFilename = CreateTempDirFilename("mmwave-phy-trace-aggregated.txt");
+
+    // two windows, the last one without any later TB to trigger its output
+    Ptr<MmWavePhyTrace> trace = CreateTrace(2, 1);
+    ScheduleRx(trace, MilliSeconds(1), 100, 5, false, 0, 10.0);
+    ScheduleRx(trace, MilliSeconds(2), 200, 5, true, 0, 100.0);
+    ScheduleRx(trace, MilliSeconds(3), 300, 7, false, 1, 1000.0);
+    ScheduleRx(trace, MilliSeconds(12), 400, 9, false, 0);
+    Simulator::Run();
+
+    std::vector<std::string> lines = ReadTraceLines(m_aggregateFilename);
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 2, "The last window has not been written when it expired");
+    std::vector<std::string> fields = SplitTraceLine(lines[0]);
+    NS_TEST_ASSERT_MSG_EQ(fields.size(), 13, "Wrong number of fields");
+    NS_TEST_ASSERT_MSG_EQ(fields[0], "DL", "Wrong direction");
+    NS_TEST_ASSERT_MSG_EQ(std::stod(fields[1]), 0.0, "Wrong window start");
+    NS_TEST_ASSERT_MSG_EQ(std::stod(fields[2]), 0.01, "Wrong window end");
+    NS_TEST_ASSERT_MSG_EQ(fields[3], "1", "Wrong cell ID");
+    NS_TEST_ASSERT_MSG_EQ(fields[4], "2", "Wrong RNTI");
+    NS_TEST_ASSERT_MSG_EQ(fields[5], "3", "Wrong number of TBs");
+    NS_TEST_ASSERT_MSG_EQ(fields[6], "600", "Wrong sum of the TB sizes");
+    NS_TEST_ASSERT_MSG_EQ(fields[7], "1", "Wrong number of retransmissions");
+    NS_TEST_ASSERT_MSG_EQ(fields[8], "1", "Wrong number of corrupted TBs");
+    NS_TEST_ASSERT_MSG_EQ_TOL(std::stod(fields[9]), 1.0 / 3, 1e-5, "Wrong BLER");
+    // mean of the linear SINRs, not of the values in dB (20 dB)
+    NS_TEST_ASSERT_MSG_EQ_TOL(std::stod(fields[10]),
+                              10 * std::log10(370.0),
+                              1e-4,
+                              "Wrong mean SINR");
+    NS_TEST_ASSERT_MSG_EQ_TOL(std::stod(fields[11]), 10.0, 1e-9, "Wrong minimum SINR");
+    NS_TEST_ASSERT_MSG_EQ(fields[12], "5:2,7:1", "Wrong MCS histogram");
+    fields = SplitTraceLine(lines[1]);
+    NS_TEST_ASSERT_MSG_EQ(std::stod(fields[1]), 0.01, "Wrong window start");
+    NS_TEST_ASSERT_MSG_EQ(fields[5], "1", "Wrong number of TBs");
+    NS_TEST_ASSERT_MSG_EQ(fields[6], "400", "Wrong sum of the TB sizes");
+
+    // the reservoir keeps two of the three TBs of the first window
+    NS_TEST_ASSERT_MSG_EQ(ReadTraceLines(m_rawFilename).size(), 3, "Wrong reservoir size");
+    trace = nullptr;
+    Simulator::Destroy();
+
+    // the samples only depend on the stream of the reservoir
+    std::vector<std::string> samples[2];
+    for (uint32_t run = 0; run < 2; ++run)
+    {
+        trace = CreateTrace(5, 7);
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            ScheduleRx(trace, MicroSeconds(50 * i + 1), i + 1, 5, false, 0);
+        }
+        Simulator::Run();
+        trace = nullptr;
+        Simulator::Destroy();
+        samples[run] = ReadTraceLines(m_rawFilename);
+        NS_TEST_ASSERT_MSG_EQ(samples[run].size(), 5, "Wrong reservoir size");
+    }
+    NS_TEST_ASSERT_MSG_EQ((samples[0] == samples[1]), true, "Samples not reproducible");
+}
+
+/**
+ * Test suite for the mmWave PHY trace
+ */
+class MmWavePhyTraceTestSuite : public TestSuite
+{
+  public:
+    MmWavePhyTraceTestSuite();
+};
+
+MmWavePhyTraceTestSuite::MmWavePhyTraceTestSuite()
+    : TestSuite("mmwave-phy-trace", UNIT)
+{
+    AddTestCase(new MmWavePhyTraceAggregationTestCase, TestCase::QUICK);
+}
+
+static MmWavePhyTraceTestSuite g_mmWavePhyTraceTestSuite;
@@ -0,0 +1,226 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mmwave-sinr-filter.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * This test case checks that MmWaveSinrFilter reports the same SINR as the
+ * filter that scans the whole window of SINR samples at each report
+ */
+class MmWaveSinrFilterTestCase : public TestCase
+{
+  public:
+    MmWaveSinrFilterTestCase()
+        : TestCase("Checks the incremental SINR filter against a scan of the window")
+    {
+    }
+
+  private:
+    virtual void DoRun(void) override;
+
+    /**
+     * Find the samples of the window to be filtered, scanning all of them
+     *
+     * \param noisySinr the noisy SINR samples of the window
+     * \return the first and the last sample to be filtered
+     */
+    static std::pair<uint64_t, uint64_t> FindBlockage(const std::vector<double>& noisySinr);
+
+    /**
+     * Filter the noisy SINR samples of a blockage
+     *
+     * \param noisySinr the noisy SINR samples of the window
+     * \param realSinr the real SINR samples of the window
+     * \param blockage the first and the last sample to be filtered
+     * \return the filtered SINR of the newest sample
+     */
+    static double FilterBlockage(const std::vector<double>& noisySinr,
+                                 const std::vector<double>& realSinr,
+                                 std::pair<uint64_t, uint64_t> blockage);
+};
+
+std::pair<uint64_t, uint64_t>
+MmWaveSinrFilterTestCase::FindBlockage(const std::vector<double>& noisySinr)
+{
+    std::vector<double> noisySinrDb;
+    for (double sinr : noisySinr)
+    {
+        noisySinrDb.push_back(10 * std::log10(sinr));
+    }
+    std::vector<double> variance;
+    for (uint64_t i = 0; i + 1 < noisySinrDb.size(); ++i)
+    {
+        double mean = (noisySinrDb[i] + noisySinrDb[i + 1]) / 2;
+        variance.push_back(
+            (std::pow(noisySinrDb[i] - mean, 2) + std::pow(noisySinrDb[i + 1] - mean, 2)) / 2);
+    }
+
+    uint64_t end = 0;
+    for (uint64_t varIndex = variance.size() - 1; varIndex > 0; varIndex--)
+    {
+        if (variance[varIndex] > 5 || std::isnan(variance[varIndex]) ||
+            noisySinr[varIndex + 1] < 10)
+        {
+            end = varIndex + 1;
+            break;
+        }
+    }
+
+    uint64_t start = 0;
+    const uint64_t stable = MmWaveSinrFilter::STABLE_SAMPLES;
+    for (uint64_t index = end; index > stable; --index)
+    {
+        bool lowVariance = std::all_of(variance.begin() + index - stable,
+                                       variance.begin() + index - 1,
+                                       [](double v) { return v < 1; });
+        bool highSinr = std::all_of(noisySinrDb.begin() + index - stable,
+                                    noisySinrDb.begin() + index,
+                                    [](double s) { return s > 10; });
+        if (lowVariance || highSinr)
+        {
+            start = index;
+            break;
+        }
+    }
+    return std::make_pair(start, end);
+}
+
+double
+MmWaveSinrFilterTestCase::FilterBlockage(const std::vector<double>& noisySinr,
+                                         const std::vector<double>& realSinr,
+                                         std::pair<uint64_t, uint64_t> blockage)
+{
+    std::array<double, 100> meanError;
+    int rep = 0;
+    for (double alpha = 0; alpha < 1; alpha = alpha + 0.01)
+    {
+        double average = 0;
+        double error = 0;
+        for (uint64_t i = blockage.first; i < blockage.second; i++)
+        {
+            average = (1 - alpha) * average + alpha * noisySinr[i];
+            error += std::abs(average - realSinr[i]);
+        }
+        meanError.at(rep++) = error / (blockage.second - blockage.first);
+    }
+    double minAlpha =
+        (std::distance(meanError.begin(), std::min_element(meanError.begin(), meanError.end())) +
+         1) *
+        0.01;
+    if (minAlpha > 0.5)
+    {
+        minAlpha = 0.2;
+    }
+
+    // the filtered trace is the noisy one up to the first filtered sample, then
+    // the moving average up to two samples before the last filtered one, and
+    // then the noisy one again
+    std::vector<double> trace(noisySinr.begin(), noisySinr.begin() + blockage.first + 1);
+    double average = 0;
+    for (uint64_t i = blockage.first; i + 1 < blockage.second; i++)
+    {
+        average = (1 - minAlpha) * average + minAlpha * noisySinr[i];
+        trace.push_back(average);
+    }
+    trace.insert(trace.end(), noisySinr.begin() + blockage.second + 1, noisySinr.end());
+    return trace.back();
+}
+
+void
+MmWaveSinrFilterTestCase::DoRun(void)
+{
+    const uint32_t window = 40;
+    const double noise = 3.98107170e-12;
+    Ptr<NormalRandomVariable> gaussian = CreateObject<NormalRandomVariable>();
+    gaussian->SetStream(1);
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    uniform->SetStream(2);
+
+    MmWaveSinrFilter filter(window);
+    std::vector<double> realSinr;
+    std::vector<double> noisySinr;
+    double sinrDb = 20;
+    uint32_t filtered = 0;
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        // a random walk with deep blockages, noisy as in MmWaveEnbPhy
+        sinrDb += uniform->GetValue(-1, 1);
+        if (uniform->GetValue() < 0.02)
+        {
+            sinrDb += (sinrDb > 5) ? -30 : 30;
+        }
+        double sinr = std::pow(10, sinrDb / 10);
+        std::complex<double> gaussianNoise(std::sqrt(0.5 * noise) * gaussian->GetValue(),
+                                           std::sqrt(0.5 * noise) * gaussian->GetValue());
+        double sinrNoisy =
+            (std::pow(std::abs(std::sqrt(sinr * noise) + gaussianNoise), 2) - noise) / noise;
+
+        double expected = sinrNoisy;
+        realSinr.push_back(sinr);
+        noisySinr.push_back(sinrNoisy);
+        if (realSinr.size() > window)
+        {
+            realSinr.erase(realSinr.begin());
+            noisySinr.erase(noisySinr.begin());
+            std::pair<uint64_t, uint64_t> blockage = FindBlockage(noisySinr);
+            if (blockage.first != blockage.second)
+            {
+                expected = FilterBlockage(noisySinr, realSinr, blockage);
+            }
+        }
+        if (expected < 0)
+        {
+            expected = 1e-20;
+        }
+
+        double reported = filter.AddSample(sinr, sinrNoisy);
+        filtered += (reported != std::max(sinrNoisy, 1e-20));
+        NS_TEST_ASSERT_MSG_EQ_TOL(reported,
+                                  expected,
+                                  std::abs(expected) * 1e-12,
+                                  "Wrong filtered SINR at sample " << i);
+    }
+    NS_TEST_ASSERT_MSG_GT(filtered, 0, "The trace never needed filtering");
+}
+
+/**
+ * Test suite for the SINR measurement filter
+ */
+class MmWaveSinrFilterTestSuite : public TestSuite
+{
+  public:
+    MmWaveSinrFilterTestSuite();
+};
+
+MmWaveSinrFilterTestSuite::MmWaveSinrFilterTestSuite()
+    : TestSuite("mmwave-sinr-filter", UNIT)
+{
+    AddTestCase(new MmWaveSinrFilterTestCase, TestCase::QUICK);
+}
+
+static MmWaveSinrFilterTestSuite g_mmWaveSinrFilterTestSuite;
@@ -0,0 +1,139 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mmwave-phy-mac-common.h"
+#include "ns3/mmwave-spectrum-value-helper.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * This test case checks that the cached TX and noise PSDs are shared only
+ * among the callers that pass the same arguments
+ */
+class MmWaveSpectrumValueHelperTestCase : public TestCase
+{
+  public:
+    MmWaveSpectrumValueHelperTestCase()
+        : TestCase("Checks the cache of the TX and noise PSDs")
+    {
+    }
+
+  private:
+    virtual void DoRun(void) override;
+
+    /**
+     * Check the values of a TX PSD
+     *
+     * \param psd the PSD
+     * \param config the PHY and MAC configuration
+     * \param powerTx the TX power, in dBm
+     * \param activeRbs the RBs used for the transmission
+     */
+    void CheckTxPsd(Ptr<const SpectrumValue> psd,
+                    Ptr<MmWavePhyMacCommon> config,
+                    double powerTx,
+                    const std::vector<int>& activeRbs);
+};
+
+void
+MmWaveSpectrumValueHelperTestCase::CheckTxPsd(Ptr<const SpectrumValue> psd,
+                                              Ptr<MmWavePhyMacCommon> config,
+                                              double powerTx,
+                                              const std::vector<int>& activeRbs)
+{
+    double density = std::pow(10., (powerTx - 30) / 10) / config->GetBandwidth();
+    std::vector<double> expected(config->GetNumRb(), 0.0);
+    for (int rbId : activeRbs)
+    {
+        expected[rbId] = density;
+    }
+    NS_TEST_ASSERT_MSG_EQ(psd->GetValuesN(), expected.size(), "Wrong number of RBs");
+    for (uint32_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL((*psd)[i], expected[i], density * 1e-9, "Wrong value " << i);
+    }
+}
+
+void
+MmWaveSpectrumValueHelperTestCase::DoRun(void)
+{
+    Ptr<MmWavePhyMacCommon> config = CreateObject<MmWavePhyMacCommon>();
+    std::vector<int> allRbs;
+    for (uint32_t i = 0; i < config->GetNumRb(); ++i)
+    {
+        allRbs.push_back(i);
+    }
+    std::vector<int> someRbs = {1, 2, 5};
+    std::vector<int> otherRbs = {5, 2, 1};
+
+    Ptr<SpectrumValue> all =
+        MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity(config, 30, allRbs);
+    Ptr<SpectrumValue> some =
+        MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity(config, 30, someRbs);
+    Ptr<SpectrumValue> other =
+        MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity(config, 30, otherRbs);
+    Ptr<SpectrumValue> lower =
+        MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity(config, 23, someRbs);
+    CheckTxPsd(all, config, 30, allRbs);
+    CheckTxPsd(some, config, 30, someRbs);
+    CheckTxPsd(other, config, 30, otherRbs);
+    CheckTxPsd(lower, config, 23, someRbs);
+    NS_TEST_ASSERT_MSG_NE(all, some, "Different RBs share a PSD");
+    std::vector<SpectrumBandRuns::Run> runs = {{1, 3}, {5, 6}};
+    NS_TEST_ASSERT_MSG_EQ((some->GetOccupiedBands()->GetRuns() == runs),
+                          true,
+                          "Wrong occupied bands");
+    NS_TEST_ASSERT_MSG_NE(some, lower, "Different powers share a PSD");
+    NS_TEST_ASSERT_MSG_EQ(MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity(config,
+                                                                                   30,
+                                                                                   someRbs),
+                          some,
+                          "TX PSD not shared");
+
+    Ptr<SpectrumValue> noise =
+        MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity(config, 5);
+    Ptr<SpectrumValue> noisier =
+        MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity(config, 9);
+    NS_TEST_ASSERT_MSG_EQ_TOL((*noisier)[0] / (*noise)[0],
+                              std::pow(10, 0.4),
+                              1e-9,
+                              "Wrong noise PSD");
+    NS_TEST_ASSERT_MSG_EQ(MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity(config, 5),
+                          noise,
+                          "Noise PSD not shared");
+}
+
+/**
+ * Test suite for the PSDs of the mmWave spectrum value helper
+ */
+class MmWaveSpectrumValueHelperTestSuite : public TestSuite
+{
+  public:
+    MmWaveSpectrumValueHelperTestSuite();
+};
+
+MmWaveSpectrumValueHelperTestSuite::MmWaveSpectrumValueHelperTestSuite()
+    : TestSuite("mmwave-spectrum-value-helper", UNIT)
+{
+    AddTestCase(new MmWaveSpectrumValueHelperTestCase, TestCase::QUICK);
+}
+
+static MmWaveSpectrumValueHelperTestSuite g_mmWaveSpectrumValueHelperTestSuite;
@@ -0,0 +1,227 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/mmwave-trace-writer.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <string>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * This test case checks the FIFO and capacity semantics of the SPSC ring buffer
+ */
+class MmWaveSpscRingBufferTestCase : public TestCase
+{
+  public:
+    MmWaveSpscRingBufferTestCase()
+        : TestCase("Checks the SPSC ring buffer used by the trace writer")
+    {
+    }
+
+  private:
+    virtual void DoRun(void) override;
+};
+
+void
+MmWaveSpscRingBufferTestCase::DoRun(void)
+{
+    SpscRingBuffer<uint32_t> queue(5);
+    NS_TEST_ASSERT_MSG_EQ(queue.GetCapacity(), 8, "Capacity not rounded to a power of two");
+    NS_TEST_ASSERT_MSG_EQ(queue.IsEmpty(), true, "New queue not empty");
+
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(queue.TryPush(i), true, "Push failed before reaching capacity");
+    }
+    NS_TEST_ASSERT_MSG_EQ(queue.TryPush(8), false, "Push succeeded on a full queue");
+
+    uint32_t item;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(queue.TryPop(item), true, "Pop failed on a non-empty queue");
+        NS_TEST_ASSERT_MSG_EQ(item, i, "Items not popped in FIFO order");
+        // keep the indexes wrapping around the slots
+        NS_TEST_ASSERT_MSG_EQ(queue.TryPush(100 + i), true, "Push failed after a pop");
+    }
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        queue.TryPop(item);
+        NS_TEST_ASSERT_MSG_EQ(item, 100 + i, "Items not popped in FIFO order after wrap-around");
+    }
+    NS_TEST_ASSERT_MSG_EQ(queue.TryPop(item), false, "Pop succeeded on an empty queue");
+}
+
+/**
+ * This test case checks that the records enqueued in the trace writer reach
+ * the output file, in order, after Simulator::Destroy
+ */
+class MmWaveTraceWriterTestCase : public TestCase
+{
+  public:
+    MmWaveTraceWriterTestCase()
+        : TestCase("Checks that the trace writer flushes all records at Simulator::Destroy")
+    {
+    }
+
+  private:
+    struct Record
+    {
+        uint32_t m_value;
+    };
+
+    static void WriteRecord(std::ostream& os, const Record& record)
+    {
+        os << record.m_value << "\n";
+    }
+
+    virtual void DoRun(void) override;
+};
+
+void
+MmWaveTraceWriterTestCase::DoRun(void)
+{
+    std::string filename = CreateTempDirFilename("mmwave-trace-writer-test.txt");
+    const uint32_t numRecords = 10000;
+
+    Ptr<MmWaveTraceWriter> writer = MmWaveTraceWriter::Get();
+    uint16_t stream = writer->OpenStream(filename, "value");
+    for (uint32_t i = 0; i < numRecords; ++i)
+    {
+        Record record = {i};
+        writer->Write<Record, &MmWaveTraceWriterTestCase::WriteRecord>(stream, record);
+    }
+    Simulator::Destroy();
+    NS_TEST_ASSERT_MSG_EQ(writer->GetDroppedRecords(), 0, "Records dropped with BLOCK policy");
+    NS_TEST_ASSERT_MSG_NE(MmWaveTraceWriter::Get(), writer, "Writer not released at Destroy");
+    Simulator::Destroy();
+
+    std::ifstream file(filename.c_str());
+    std::string line;
+    std::getline(file, line);
+    NS_TEST_ASSERT_MSG_EQ(line, "value", "Missing header line");
+    uint32_t expected = 0;
+    while (std::getline(file, line))
+    {
+        NS_TEST_ASSERT_MSG_EQ(std::stoul(line), expected, "Records written out of order");
+        ++expected;
+    }
+    NS_TEST_ASSERT_MSG_EQ(expected, numRecords, "Records lost by the trace writer");
+}
+
+/**
+ * This test case checks that, with the Block policy and a queue much smaller
+ * than the number of records, no record is lost, also when a stream is opened
+ * while the writer thread is running
+ */
+class MmWaveTraceWriterBlockTestCase : public TestCase
+{
+  public:
+    MmWaveTraceWriterBlockTestCase()
+        : TestCase("Checks the Block back-pressure policy of the trace writer")
+    {
+    }
+
+  private:
+    struct Record
+    {
+        uint32_t m_value;
+    };
+
+    static void WriteRecord(std::ostream& os, const Record& record)
+    {
+        os << record.m_value << "\n";
+    }
+
+    /**
+     * Check that a file holds the values 0 to numRecords - 1, in order
+     *
+     * \param filename the name of the file
+     * \param numRecords the number of records
+     */
+    void CheckFile(std::string filename, uint32_t numRecords);
+
+    virtual void DoRun(void) override;
+};
+
+void
+MmWaveTraceWriterBlockTestCase::CheckFile(std::string filename, uint32_t numRecords)
+{
+    std::ifstream file(filename.c_str());
+    std::string line;
+    uint32_t expected = 0;
+    while (std::getline(file, line))
+    {
+        NS_TEST_ASSERT_MSG_EQ(std::stoul(line), expected, "Records written out of order");
+        ++expected;
+    }
+    NS_TEST_ASSERT_MSG_EQ(expected, numRecords, "Records lost by the trace writer");
+}
+
+void
+MmWaveTraceWriterBlockTestCase::DoRun(void)
+{
+    std::string first = CreateTempDirFilename("mmwave-trace-writer-block-1.txt");
+    std::string second = CreateTempDirFilename("mmwave-trace-writer-block-2.txt");
+    const uint32_t numRecords = 100000;
+
+    Ptr<MmWaveTraceWriter> writer =
+        CreateObjectWithAttributes<MmWaveTraceWriter>("QueueSize", UintegerValue(8));
+    uint16_t firstStream = writer->OpenStream(first, "");
+    uint16_t secondStream = 0;
+    for (uint32_t i = 0; i < numRecords; ++i)
+    {
+        if (i == numRecords / 2)
+        {
+            secondStream = writer->OpenStream(second, "");
+        }
+        Record record = {i};
+        writer->Write<Record, &MmWaveTraceWriterBlockTestCase::WriteRecord>(firstStream, record);
+        if (i >= numRecords / 2)
+        {
+            record.m_value = i - numRecords / 2;
+            writer->Write<Record, &MmWaveTraceWriterBlockTestCase::WriteRecord>(secondStream,
+                                                                                record);
+        }
+    }
+    writer->Flush();
+    NS_TEST_ASSERT_MSG_EQ(writer->GetDroppedRecords(), 0, "Records dropped with BLOCK policy");
+    writer->Dispose();
+
+    CheckFile(first, numRecords);
+    CheckFile(second, numRecords / 2);
+}
+
+class MmWaveTraceWriterTestSuite : public TestSuite
+{
+  public:
+    MmWaveTraceWriterTestSuite();
+};
+
+MmWaveTraceWriterTestSuite::MmWaveTraceWriterTestSuite()
+    : TestSuite("mmwave-trace-writer", UNIT)
+{
+    AddTestCase(new MmWaveSpscRingBufferTestCase, TestCase::QUICK);
+    AddTestCase(new MmWaveTraceWriterTestCase, TestCase::QUICK);
+    AddTestCase(new MmWaveTraceWriterBlockTestCase, TestCase::QUICK);
+}
+
+static MmWaveTraceWriterTestSuite mmwaveTraceWriterTestSuite;
@@ -0,0 +1,243 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mmwave-chunk-processor.h"
+#include "ns3/mmwave-enb-net-device.h"
+#include "ns3/mmwave-harq-phy.h"
+#include "ns3/mmwave-spectrum-phy.h"
+#include "ns3/mmwave-spectrum-signal-parameters.h"
+#include "ns3/mmwave-transport-block.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * This test case checks the reception of several uplink TBs in the same slot
+ * by a mmWave eNB: the PDUs of each TB are delivered or dropped together, and
+ * the trace and the HARQ feedback are fired once per TB.
+ */
+class MmWaveTransportBlockRxTestCase : public TestCase
+{
+  public:
+    MmWaveTransportBlockRxTestCase()
+        : TestCase("Checks the reception of several TBs in the same slot")
+    {
+    }
+
+  private:
+    virtual void DoRun(void) override;
+
+    /**
+     * Send a TB from a UE to the eNB, and tell the eNB to expect it
+     *
+     * \param rxPhy the spectrum PHY of the eNB
+     * \param rnti the RNTI of the UE
+     * \param harqId the HARQ process of the TB
+     * \param mcs the MCS of the TB
+     * \param rbs the resource blocks of the TB
+     * \param psd the received power of the TB in each of its resource blocks
+     * \param numPdus the number of MAC PDUs in the TB
+     */
+    void SendTb(Ptr<MmWaveSpectrumPhy> rxPhy,
+                uint16_t rnti,
+                uint8_t harqId,
+                uint8_t mcs,
+                std::vector<int> rbs,
+                double psd,
+                uint32_t numPdus);
+
+    /**
+     * \param pdu a MAC PDU delivered by the PHY
+     */
+    void RxPdu(Ptr<Packet> pdu);
+
+    /**
+     * \param params the trace of a received TB
+     */
+    void RxTb(RxPacketTraceParams params);
+
+    /**
+     * \param harqInfo the HARQ feedback of a received TB
+     */
+    void UlHarqFeedback(UlHarqInfo harqInfo);
+
+    Ptr<const SpectrumModel> m_spectrumModel; //!< spectrum model of the test
+    std::vector<Ptr<Packet>> m_rxPdus;        //!< PDUs delivered by the PHY
+    std::vector<RxPacketTraceParams> m_rxTbs; //!< traces of the received TBs
+    std::vector<UlHarqInfo> m_harqFeedbacks;  //!< HARQ feedback of the received TBs
+    static constexpr uint32_t TB_SIZE = 100;  //!< size of the TBs
+    static constexpr uint8_t SYM_START = 1;   //!< first symbol of the TBs
+    static constexpr uint8_t NUM_SYM = 2;     //!< number of symbols of the TBs
+};
+
+void
+MmWaveTransportBlockRxTestCase::SendTb(Ptr<MmWaveSpectrumPhy> rxPhy,
+                                       uint16_t rnti,
+                                       uint8_t harqId,
+                                       uint8_t mcs,
+                                       std::vector<int> rbs,
+                                       double psd,
+                                       uint32_t numPdus)
+{
+    rxPhy->AddExpectedTb(rnti, 1, TB_SIZE, mcs, rbs, harqId, 0, false, SYM_START, NUM_SYM);
+
+    DciInfoElementTdma dci(rnti,
+                           DciInfoElementTdma::UL_dci,
+                           SYM_START,
+                           NUM_SYM,
+                           mcs,
+                           TB_SIZE,
+                           1,
+                           0,
+                           harqId);
+    Ptr<MmWaveTransportBlock> tb = Create<MmWaveTransportBlock>(dci, SfnSf(7, 3, 1, SYM_START));
+    for (uint32_t i = 0; i < numPdus; ++i)
+    {
+        tb->AddPdu(Create<Packet>(TB_SIZE / numPdus));
+    }
+
+    Ptr<MmwaveSpectrumSignalParametersDataFrame> params =
+        Create<MmwaveSpectrumSignalParametersDataFrame>();
+    Ptr<SpectrumValue> txPsd = Create<SpectrumValue>(m_spectrumModel);
+    for (int rb : rbs)
+    {
+        (*txPsd)[rb] = psd;
+    }
+    params->psd = txPsd;
+    params->duration = MicroSeconds(10);
+    params->txPhy = CreateObject<MmWaveSpectrumPhy>();
+    params->cellId = 1;
+    params->transportBlock = tb;
+    rxPhy->StartRx(params);
+}
+
+void
+MmWaveTransportBlockRxTestCase::RxPdu(Ptr<Packet> pdu)
+{
+    m_rxPdus.push_back(pdu);
+}
+
+void
+MmWaveTransportBlockRxTestCase::RxTb(RxPacketTraceParams params)
+{
+    m_rxTbs.push_back(params);
+}
+
+void
+MmWaveTransportBlockRxTestCase::UlHarqFeedback(UlHarqInfo harqInfo)
+{
+    m_harqFeedbacks.push_back(harqInfo);
+}
+
+void
+MmWaveTransportBlockRxTestCase::DoRun(void)
+{
+    // 10 resource blocks with a unit noise, the UEs transmit in disjoint halves
+    std::vector<double> frequencies;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        frequencies.push_back(28e9 + i * 1e6);
+    }
+    m_spectrumModel = Create<SpectrumModel>(frequencies);
+    Ptr<SpectrumValue> noisePsd = Create<SpectrumValue>(m_spectrumModel);
+    (*noisePsd) = 1.0;
+
+    // the eNB is the only device the receiver needs to know about
+    Ptr<MmWaveSpectrumPhy> rxPhy = CreateObject<MmWaveSpectrumPhy>();
+    rxPhy->SetDevice(CreateObject<MmWaveEnbNetDevice>());
+    rxPhy->SetCellId(1);
+    rxPhy->SetNoisePowerSpectralDensity(noisePsd);
+    Ptr<MmWaveHarqPhy> harq = Create<MmWaveHarqPhy>();
+    rxPhy->SetHarqPhyModule(harq);
+    Ptr<mmWaveChunkProcessor> pData = Create<mmWaveChunkProcessor>();
+    pData->AddCallback(MakeCallback(&MmWaveSpectrumPhy::UpdateSinrPerceived, rxPhy));
+    rxPhy->AddDataSinrChunkProcessor(pData);
+    rxPhy->AssignStreams(1);
+    rxPhy->SetPhyRxDataEndOkCallback(MakeCallback(&MmWaveTransportBlockRxTestCase::RxPdu, this));
+    rxPhy->SetPhyUlHarqFeedbackCallback(
+        MakeCallback(&MmWaveTransportBlockRxTestCase::UlHarqFeedback, this));
+    rxPhy->TraceConnectWithoutContext("RxPacketTraceEnb",
+                                      MakeCallback(&MmWaveTransportBlockRxTestCase::RxTb, this));
+
+    // a robust TB at 30 dB and a fragile one at -20 dB in the same slot
+    SendTb(rxPhy, 1, 2, 0, {0, 1, 2, 3, 4}, 1000.0, 2);
+    SendTb(rxPhy, 2, 5, 20, {5, 6, 7, 8, 9}, 0.01, 4);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxTbs.size(), 2, "The trace is not fired once per TB");
+    NS_TEST_ASSERT_MSG_EQ(m_rxTbs[0].m_rnti, 1, "Wrong RNTI of the first TB");
+    NS_TEST_ASSERT_MSG_EQ(m_rxTbs[0].m_corrupt, false, "Robust TB corrupted");
+    NS_TEST_ASSERT_MSG_EQ(+m_rxTbs[0].m_mcs, 0, "Wrong MCS of the first TB");
+    NS_TEST_ASSERT_MSG_EQ(m_rxTbs[0].m_tbSize, TB_SIZE, "Wrong size of the first TB");
+    NS_TEST_ASSERT_MSG_EQ(m_rxTbs[0].m_frameNum, 7, "Wrong frame of the first TB");
+    NS_TEST_ASSERT_MSG_EQ(+m_rxTbs[0].m_sfNum, 3, "Wrong subframe of the first TB");
+    NS_TEST_ASSERT_MSG_EQ(+m_rxTbs[0].m_slotNum, 1, "Wrong slot of the first TB");
+    NS_TEST_ASSERT_MSG_EQ(+m_rxTbs[0].m_symStart, +SYM_START, "Wrong first symbol");
+    NS_TEST_ASSERT_MSG_EQ(+m_rxTbs[0].m_numSym, +NUM_SYM, "Wrong number of symbols");
+    NS_TEST_ASSERT_MSG_EQ(m_rxTbs[1].m_rnti, 2, "Wrong RNTI of the second TB");
+    NS_TEST_ASSERT_MSG_EQ(m_rxTbs[1].m_corrupt, true, "Fragile TB not corrupted");
+    NS_TEST_ASSERT_MSG_EQ(+m_rxTbs[1].m_mcs, 20, "Wrong MCS of the second TB");
+
+    // only the PDUs of the robust TB are delivered
+    NS_TEST_ASSERT_MSG_EQ(m_rxPdus.size(), 2, "Wrong number of delivered PDUs");
+    for (const auto& pdu : m_rxPdus)
+    {
+        NS_TEST_ASSERT_MSG_EQ(pdu->GetSize(), TB_SIZE / 2, "PDU not of the robust TB");
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(m_harqFeedbacks.size(), 2, "HARQ feedback not sent once per TB");
+    NS_TEST_ASSERT_MSG_EQ(m_harqFeedbacks[0].m_rnti, 1, "Wrong RNTI of the first feedback");
+    NS_TEST_ASSERT_MSG_EQ(+m_harqFeedbacks[0].m_harqProcessId, 2, "Wrong HARQ process");
+    NS_TEST_ASSERT_MSG_EQ(m_harqFeedbacks[0].m_receptionStatus,
+                          UlHarqInfo::Ok,
+                          "Robust TB not acknowledged");
+    NS_TEST_ASSERT_MSG_EQ(m_harqFeedbacks[1].m_rnti, 2, "Wrong RNTI of the second feedback");
+    NS_TEST_ASSERT_MSG_EQ(+m_harqFeedbacks[1].m_harqProcessId, 5, "Wrong HARQ process");
+    NS_TEST_ASSERT_MSG_EQ(m_harqFeedbacks[1].m_receptionStatus,
+                          UlHarqInfo::NotOk,
+                          "Fragile TB not negatively acknowledged");
+
+    // the failed transmission is kept for the combining of the retransmission
+    NS_TEST_ASSERT_MSG_EQ(harq->GetHarqProcessInfoUl(1, 2).size(), 0, "Acked TB kept");
+    NS_TEST_ASSERT_MSG_EQ(harq->GetHarqProcessInfoUl(2, 5).size(), 1, "Nacked TB not kept");
+
+    rxPhy = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * Test suite for the mmWave transport blocks
+ */
+class MmWaveTransportBlockTestSuite : public TestSuite
+{
+  public:
+    MmWaveTransportBlockTestSuite();
+};
+
+MmWaveTransportBlockTestSuite::MmWaveTransportBlockTestSuite()
+    : TestSuite("mmwave-transport-block", UNIT)
+{
+    AddTestCase(new MmWaveTransportBlockRxTestCase, TestCase::QUICK);
+}
+
+static MmWaveTransportBlockTestSuite g_mmWaveTransportBlockTestSuite;
@@ -357,6 +357,12 @@ void
 Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
+    DoAddAtEnd(end, false);
+}
+
+void
+Buffer::DoAddAtEnd(uint32_t end, bool spare)
+{
     NS_ASSERT(CheckInternalState());
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
@@ -373,7 +379,17 @@ Buffer::AddAtEnd(uint32_t end)
     }
     else
     {
+        /* When concatenating, make room for as many bytes as we will hold,
+         * so that the buffers built by appending many packets (e.g., by the
+         * RLC) are not copied at each append. The other buffers are sized
+         * exactly, as oversized ones would raise g_maxSize and keep the
+         * smaller ones out of the free list.
+         */
         uint32_t newSize = GetInternalSize() + end;
+        if (spare)
+        {
+            newSize *= 2;
+        }
         struct Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
         m_data->m_count--;
@@ -404,6 +420,10 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
+    if (o.GetSize() == 0)
+    {
+        return;
+    }
     if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
         m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
         o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
@@ -422,7 +442,7 @@ Buffer::AddAtEnd(const Buffer& o)
         m_end = m_zeroAreaEnd;
         m_data->m_dirtyEnd = m_zeroAreaEnd;
         uint32_t endData = o.m_end - o.m_zeroAreaEnd;
-        AddAtEnd(endData);
+        DoAddAtEnd(endData, true);
         Buffer::Iterator dst = End();
         dst.Prev(endData);
         Buffer::Iterator src = o.End();
@@ -432,8 +452,50 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
-    *this = CreateFullCopy();
-    AddAtEnd(o.GetSize());
+    uint32_t startData = o.m_zeroAreaStart - o.m_start;
+    uint32_t zeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
+    if (m_zeroAreaStart == m_zeroAreaEnd && zeroSize > 0)
+    {
+        /* We have no zero area: copy the data before the zero area of the
+         * other buffer, and take its zero area rather than filling it in.
+         */
+        Buffer::Iterator srcEnd = o.Begin();
+        srcEnd.Next(startData);
+        DoAddAtEnd(startData, true);
+        Buffer::Iterator dst = End();
+        dst.Prev(startData);
+        dst.Write(o.Begin(), srcEnd);
+        if (m_data->m_count == 1)
+        {
+            m_zeroAreaStart = m_end;
+            m_zeroAreaEnd = m_end + zeroSize;
+            m_end = m_zeroAreaEnd;
+            m_data->m_dirtyEnd = m_end;
+            m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
+            uint32_t endData = o.m_end - o.m_zeroAreaEnd;
+            DoAddAtEnd(endData, true);
+            dst = End();
+            dst.Prev(endData);
+            Buffer::Iterator src = o.End();
+            src.Prev(endData);
+            dst.Write(src, o.End());
+            NS_ASSERT(CheckInternalState());
+            return;
+        }
+        // the data is shared: fill in the rest of the other buffer
+        uint32_t rest = o.GetSize() - startData;
+        DoAddAtEnd(rest, true);
+        dst = End();
+        dst.Prev(rest);
+        dst.Write(srcEnd, o.End());
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    /* Keep our zero area, and fill in the zero area of the other buffer
+     * after our data: only the data of the other buffer is copied.
+     */
+    DoAddAtEnd(o.GetSize(), true);
     Buffer::Iterator destStart = End();
     destStart.Prev(o.GetSize());
     destStart.Write(o.Begin(), o.End());
@@ -835,27 +897,36 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    // the bytes to write are either all before or all after our zero area
+    uint8_t* to;
+    if (m_current <= m_zeroStart)
+    {
+        to = &m_data[m_current];
+    }
+    else
+    {
+        to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
@@ -715,6 +715,15 @@ class Buffer
      */
     void Initialize(uint32_t zeroSize);
 
+    /**
+     * \brief Add bytes at the end of the buffer.
+     *
+     * \param end the number of bytes to add
+     * \param spare whether to double the size of the storage, if it is
+     *        reallocated, to amortize the copies of repeated appends
+     */
+    void DoAddAtEnd(uint32_t end, bool spare);
+
     /**
      * \brief Get the buffer real size.
      * \warning The real size is the actual memory used by the buffer.
@@ -26,6 +26,8 @@
 
 #define USE_FREE_LIST 1
 #define FREE_LIST_SIZE 1000
+#define FREE_LIST_CLASSES 7
+#define FREE_LIST_MIN_SIZE 64
 #define OFFSET_MAX (std::numeric_limits<int32_t>::max())
 
 namespace ns3
@@ -60,9 +62,7 @@ static class ByteTagListDataFreeList : public std::vector<struct ByteTagListData
 {
   public:
     ~ByteTagListDataFreeList();
-} g_freeList; //!< Container for struct ByteTagListData
-
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+} g_freeList[FREE_LIST_CLASSES]; //!< Containers for struct ByteTagListData, one per size class
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
@@ -73,6 +73,27 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList()
         delete[] buffer;
     }
 }
+
+/**
+ * \brief Get the size class of a ByteTagListData
+ *
+ * The data size of the size classes doubles from FREE_LIST_MIN_SIZE.
+ *
+ * \param [in] size The data size.
+ * \returns The smallest size class with enough room, or FREE_LIST_CLASSES if none.
+ */
+static uint32_t
+GetSizeClass(uint32_t size)
+{
+    uint32_t sizeClass = 0;
+    uint32_t classSize = FREE_LIST_MIN_SIZE;
+    while (classSize < size && sizeClass < FREE_LIST_CLASSES)
+    {
+        classSize *= 2;
+        sizeClass++;
+    }
+    return sizeClass;
+}
 #endif /* USE_FREE_LIST */
 
 ByteTagList::Iterator::Item::Item(TagBuffer buf_)
@@ -355,24 +376,26 @@ struct ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
+    uint32_t sizeClass = GetSizeClass(size);
+    struct ByteTagListData* data;
+    if (sizeClass < FREE_LIST_CLASSES && !g_freeList[sizeClass].empty())
     {
-        struct ByteTagListData* data = g_freeList.back();
-        g_freeList.pop_back();
+        data = g_freeList[sizeClass].back();
+        g_freeList[sizeClass].pop_back();
         NS_ASSERT(data != nullptr);
-        if (data->size >= size)
+    }
+    else
+    {
+        // the buffers of a size class are as large as the class, to be recycled
+        if (sizeClass < FREE_LIST_CLASSES)
         {
-            data->count = 1;
-            data->dirty = 0;
-            return data;
+            size = FREE_LIST_MIN_SIZE << sizeClass;
         }
-        uint8_t* buffer = (uint8_t*)data;
-        delete[] buffer;
+        uint8_t* buffer = new uint8_t[size + sizeof(struct ByteTagListData) - 4];
+        data = (struct ByteTagListData*)buffer;
+        data->size = size;
     }
-    uint8_t* buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(struct ByteTagListData) - 4];
-    struct ByteTagListData* data = (struct ByteTagListData*)buffer;
     data->count = 1;
-    data->size = size;
     data->dirty = 0;
     return data;
 }
@@ -385,18 +408,18 @@ ByteTagList::Deallocate(struct ByteTagListData* data)
     {
         return;
     }
-    g_maxSize = std::max(g_maxSize, data->size);
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
+        uint32_t sizeClass = GetSizeClass(data->size);
+        if (sizeClass == FREE_LIST_CLASSES || g_freeList[sizeClass].size() > FREE_LIST_SIZE)
         {
             uint8_t* buffer = (uint8_t*)data;
             delete[] buffer;
         }
         else
         {
-            g_freeList.push_back(data);
+            g_freeList[sizeClass].push_back(data);
         }
     }
 }
@@ -22,13 +22,26 @@
 #include "header.h"
 #include "trailer.h"
 
+#include "ns3/abort.h"
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <list>
 #include <utility>
 
+#if __has_include(<dlfcn.h>) && __has_include(<execinfo.h>)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#define NS3_HAVE_BACKTRACE
+#endif
+
 namespace ns3
 {
 
@@ -37,6 +50,7 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
+struct PacketMetadata::Data PacketMetadata::m_emptyData = {1, 0, 0, {0}};
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
@@ -51,10 +65,76 @@ PacketMetadata::DataFreeList::~DataFreeList()
     PacketMetadata::m_enable = false;
 }
 
+/**
+ * \relates PacketMetadata
+ * \anchor GlobalValuePacketMetadataForbidden
+ * \brief A global switch to abort the simulation if the packet metadata is enabled.
+ */
+static GlobalValue g_packetMetadataForbidden =
+    GlobalValue("PacketMetadataForbidden",
+                "Abort the simulation, naming the caller, if the packet metadata "
+                "is enabled (for instance by packet printing or ASCII tracing)",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
+/**
+ * Find the code that is enabling the packet metadata, that is, the first
+ * caller outside of the network module.
+ *
+ * \return the library and the function of the caller, or "unknown caller"
+ */
+static std::string
+GetEnablingCaller()
+{
+#ifdef NS3_HAVE_BACKTRACE
+    void* frames[16];
+    int depth = backtrace(frames, 16);
+    Dl_info self;
+    if (dladdr(reinterpret_cast<void*>(&GetEnablingCaller), &self) != 0)
+    {
+        for (int i = 1; i < depth; i++)
+        {
+            Dl_info info;
+            if (dladdr(frames[i], &info) != 0 && info.dli_fname != nullptr &&
+                std::strcmp(info.dli_fname, self.dli_fname) != 0)
+            {
+                std::string caller = info.dli_fname;
+                if (info.dli_sname != nullptr)
+                {
+                    int status;
+                    char* demangled =
+                        abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                    caller += std::string(" (") + (status == 0 ? demangled : info.dli_sname) + ")";
+                    std::free(demangled);
+                }
+                return caller;
+            }
+        }
+    }
+#endif
+    return "unknown caller";
+}
+
 void
 PacketMetadata::Enable()
 {
     NS_LOG_FUNCTION_NOARGS();
+    std::string caller = GetEnablingCaller();
+    NS_LOG_INFO("packet metadata enabled by " << caller);
+    BooleanValue forbidden;
+    g_packetMetadataForbidden.GetValue(forbidden);
+    NS_ABORT_MSG_IF(forbidden.Get(),
+                    "PacketMetadataForbidden is set, but the packet metadata is enabled by "
+                        << caller);
+#ifdef DISABLE_PACKET_METADATA
+    static bool warned = false;
+    if (!warned)
+    {
+        warned = true;
+        std::clog << "The packet metadata is compiled out (--disable-packet-metadata): "
+                  << "ignoring the request to enable it by " << caller << std::endl;
+    }
+#else
     NS_ASSERT_MSG(!m_metadataSkipped,
                   "Error: attempting to enable the packet metadata "
                   "subsystem too late in the simulation, which is not allowed.\n"
@@ -63,6 +143,7 @@ PacketMetadata::Enable()
                   "to call ns3::PacketMetadata::Enable () near the beginning of"
                   " the program, before any packets are sent.");
     m_enable = true;
+#endif
 }
 
 void
@@ -70,7 +151,7 @@ PacketMetadata::EnableChecking()
 {
     NS_LOG_FUNCTION_NOARGS();
     Enable();
-    m_enableChecking = true;
+    m_enableChecking = m_enable;
 }
 
 void
@@ -650,6 +731,11 @@ void
 PacketMetadata::AddHeader(const Header& header, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &header << size);
+    if (!m_enable)
+    {
+        m_metadataSkipped = true;
+        return;
+    }
     NS_ASSERT(IsStateOk());
     uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
     DoAddHeader(uid, size);
@@ -680,14 +766,14 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
 void
 PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
 {
-    uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &header << size);
-    NS_ASSERT(IsStateOk());
     if (!m_enable)
     {
         m_metadataSkipped = true;
         return;
     }
+    NS_ASSERT(IsStateOk());
+    uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
     struct PacketMetadata::SmallItem item;
     struct PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_head, &item, &extraItem);
@@ -726,14 +812,14 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
 void
 PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
 {
-    uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &trailer << size);
-    NS_ASSERT(IsStateOk());
     if (!m_enable)
     {
         m_metadataSkipped = true;
         return;
     }
+    NS_ASSERT(IsStateOk());
+    uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
     struct PacketMetadata::SmallItem item;
     item.next = 0xffff;
     item.prev = m_tail;
@@ -749,14 +835,14 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
 void
 PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
 {
-    uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &trailer << size);
-    NS_ASSERT(IsStateOk());
     if (!m_enable)
     {
         m_metadataSkipped = true;
         return;
     }
+    NS_ASSERT(IsStateOk());
+    uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
     struct PacketMetadata::SmallItem item;
     struct PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_tail, &item, &extraItem);
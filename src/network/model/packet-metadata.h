@@ -686,6 +686,13 @@ class PacketMetadata
      */
     static bool m_metadataSkipped;
 
+    /**
+     * Empty metadata storage shared by the packets created while the
+     * metadata is not enabled, so that they don't allocate any storage.
+     * Its size is zero, hence the first item added to a packet makes a copy.
+     */
+    static struct Data m_emptyData;
+
     static uint32_t m_maxSize;  //!< maximum metadata size
     static uint16_t m_chunkUid; //!< Chunk Uid
 
@@ -707,12 +714,19 @@ namespace ns3
 {
 
 PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
-    : m_data(PacketMetadata::Create(10)),
+    : m_data(&m_emptyData),
       m_head(0xffff),
       m_tail(0xffff),
       m_used(0),
       m_packetUid(uid)
 {
+    if (!m_enable)
+    {
+        m_emptyData.m_count++;
+        m_metadataSkipped = m_metadataSkipped || size > 0;
+        return;
+    }
+    m_data = PacketMetadata::Create(10);
     memset(m_data->m_data, 0xff, 4);
     if (size > 0)
     {
@@ -30,13 +30,109 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <cstring>
 
+#define USE_FREE_LIST 1
+#define TAG_DATA_CLASS_STEP 16
+#define TAG_DATA_CLASSES 8
+#define TAG_DATA_SLAB_SIZE 4096
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+#ifdef USE_FREE_LIST
+
+/**
+ * \ingroup packet
+ *
+ * \brief Free lists of the TagData structs, one per size class.
+ *
+ * The TagData structs of up to TAG_DATA_CLASSES * TAG_DATA_CLASS_STEP bytes
+ * are carved out of slabs of TAG_DATA_SLAB_SIZE bytes, and recycled through
+ * the free list of their size class instead of being returned to the heap.
+ * The slabs are linked from g_tagDataSlabs and kept until the process exits.
+ *
+ * Internal use only.
+ */
+static PacketTagList::TagData* g_tagDataFreeList[TAG_DATA_CLASSES];
+
+/// Last allocated slab, whose first word points to the previous slab
+static void* g_tagDataSlabs = nullptr;
+
+/**
+ * \brief Get the size class of a TagData struct
+ *
+ * \param [in] dataSize The size of the data area of the TagData.
+ * \returns The size class, or TAG_DATA_CLASSES if the TagData is too large.
+ */
+static size_t
+GetTagDataClass(size_t dataSize)
+{
+    size_t allocSize = sizeof(PacketTagList::TagData) + dataSize - 1;
+    return std::min<size_t>((allocSize - 1) / TAG_DATA_CLASS_STEP, TAG_DATA_CLASSES);
+}
+
+PacketTagList::TagData*
+PacketTagList::CreateTagData(size_t dataSize)
+{
+    NS_ASSERT_MSG(dataSize < std::numeric_limits<decltype(TagData::size)>::max(),
+                  "Requested TagData size " << dataSize << " exceeds maximum "
+                                            << std::numeric_limits<decltype(TagData::size)>::max());
+
+    void* p;
+    size_t sizeClass = GetTagDataClass(dataSize);
+    if (sizeClass < TAG_DATA_CLASSES)
+    {
+        if (g_tagDataFreeList[sizeClass] == nullptr)
+        {
+            // carve a new slab into TagData of this class, after the link to the previous slab
+            size_t nodeSize = (sizeClass + 1) * TAG_DATA_CLASS_STEP;
+            uint8_t* slab = static_cast<uint8_t*>(std::malloc(TAG_DATA_SLAB_SIZE));
+            *reinterpret_cast<void**>(slab) = g_tagDataSlabs;
+            g_tagDataSlabs = slab;
+            for (size_t offset = TAG_DATA_CLASS_STEP; offset + nodeSize <= TAG_DATA_SLAB_SIZE;
+                 offset += nodeSize)
+            {
+                TagData* node = reinterpret_cast<TagData*>(slab + offset);
+                node->next = g_tagDataFreeList[sizeClass];
+                g_tagDataFreeList[sizeClass] = node;
+            }
+        }
+        p = g_tagDataFreeList[sizeClass];
+        g_tagDataFreeList[sizeClass] = g_tagDataFreeList[sizeClass]->next;
+    }
+    else
+    {
+        p = std::malloc(sizeof(TagData) + dataSize - 1);
+    }
+    // The matching frees are in FreeTagData
+
+    TagData* tag = new (p) TagData;
+    tag->size = dataSize;
+    return tag;
+}
+
+void
+PacketTagList::FreeTagData(TagData* tag)
+{
+    size_t sizeClass = GetTagDataClass(tag->size);
+    tag->~TagData();
+    if (sizeClass < TAG_DATA_CLASSES)
+    {
+        tag->next = g_tagDataFreeList[sizeClass];
+        g_tagDataFreeList[sizeClass] = tag;
+    }
+    else
+    {
+        std::free(tag);
+    }
+}
+
+#else /* USE_FREE_LIST */
+
 PacketTagList::TagData*
 PacketTagList::CreateTagData(size_t dataSize)
 {
@@ -45,13 +141,22 @@ PacketTagList::CreateTagData(size_t dataSize)
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
     void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    // The matching frees are in FreeTagData
 
     TagData* tag = new (p) TagData;
     tag->size = dataSize;
     return tag;
 }
 
+void
+PacketTagList::FreeTagData(TagData* tag)
+{
+    tag->~TagData();
+    std::free(tag);
+}
+
+#endif /* USE_FREE_LIST */
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -195,8 +300,7 @@ PacketTagList::RemoveWriter(Tag& tag,
     if (preMerge)
     {
         // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        FreeTagData(cur);
     }
     else
     {
@@ -30,6 +30,17 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+/**
+ * Update the metadata of a packet. The statement is compiled out, together
+ * with the cost of tracking the metadata of each header, trailer and
+ * fragment, when ns-3 is configured with --disable-packet-metadata.
+ */
+#ifdef DISABLE_PACKET_METADATA
+#define PACKET_METADATA(statement)
+#else
+#define PACKET_METADATA(statement) statement
+#endif
+
 uint32_t Packet::m_globalUid = 0;
 
 TypeId
@@ -242,8 +253,12 @@ Packet::CreateFragment(uint32_t start, uint32_t length) const
     ByteTagList byteTagList = m_byteTagList;
     byteTagList.Adjust(-start);
     NS_ASSERT(m_buffer.GetSize() >= start + length);
+#ifdef DISABLE_PACKET_METADATA
+    const PacketMetadata& metadata = m_metadata;
+#else
     uint32_t end = m_buffer.GetSize() - (start + length);
     PacketMetadata metadata = m_metadata.CreateFragment(start, end);
+#endif
     // again, call the constructor directly rather than
     // through Create because it is private.
     Ptr<Packet> ret =
@@ -273,7 +288,7 @@ Packet::AddHeader(const Header& header)
     m_byteTagList.Adjust(size);
     m_byteTagList.AddAtStart(size);
     header.Serialize(m_buffer.Begin());
-    m_metadata.AddHeader(header, size);
+    PACKET_METADATA(m_metadata.AddHeader(header, size));
 }
 
 uint32_t
@@ -286,7 +301,7 @@ Packet::RemoveHeader(Header& header, uint32_t size)
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
-    m_metadata.RemoveHeader(header, deserialized);
+    PACKET_METADATA(m_metadata.RemoveHeader(header, deserialized));
     return deserialized;
 }
 
@@ -297,7 +312,7 @@ Packet::RemoveHeader(Header& header)
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
-    m_metadata.RemoveHeader(header, deserialized);
+    PACKET_METADATA(m_metadata.RemoveHeader(header, deserialized));
     return deserialized;
 }
 
@@ -329,7 +344,7 @@ Packet::AddTrailer(const Trailer& trailer)
     m_buffer.AddAtEnd(size);
     Buffer::Iterator end = m_buffer.End();
     trailer.Serialize(end);
-    m_metadata.AddTrailer(trailer, size);
+    PACKET_METADATA(m_metadata.AddTrailer(trailer, size));
 }
 
 uint32_t
@@ -338,7 +353,7 @@ Packet::RemoveTrailer(Trailer& trailer)
     uint32_t deserialized = trailer.Deserialize(m_buffer.End());
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtEnd(deserialized);
-    m_metadata.RemoveTrailer(trailer, deserialized);
+    PACKET_METADATA(m_metadata.RemoveTrailer(trailer, deserialized));
     return deserialized;
 }
 
@@ -360,7 +375,7 @@ Packet::AddAtEnd(Ptr<const Packet> packet)
     copy.Adjust(GetSize());
     m_byteTagList.Add(copy);
     m_buffer.AddAtEnd(packet->m_buffer);
-    m_metadata.AddAtEnd(packet->m_metadata);
+    PACKET_METADATA(m_metadata.AddAtEnd(packet->m_metadata));
 }
 
 void
@@ -369,7 +384,7 @@ Packet::AddPaddingAtEnd(uint32_t size)
     NS_LOG_FUNCTION(this << size);
     m_byteTagList.AddAtEnd(GetSize());
     m_buffer.AddAtEnd(size);
-    m_metadata.AddPaddingAtEnd(size);
+    PACKET_METADATA(m_metadata.AddPaddingAtEnd(size));
 }
 
 void
@@ -377,7 +392,7 @@ Packet::RemoveAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_buffer.RemoveAtEnd(size);
-    m_metadata.RemoveAtEnd(size);
+    PACKET_METADATA(m_metadata.RemoveAtEnd(size));
 }
 
 void
@@ -386,7 +401,7 @@ Packet::RemoveAtStart(uint32_t size)
     NS_LOG_FUNCTION(this << size);
     m_buffer.RemoveAtStart(size);
     m_byteTagList.Adjust(-size);
-    m_metadata.RemoveAtStart(size);
+    PACKET_METADATA(m_metadata.RemoveAtStart(size));
 }
 
 void
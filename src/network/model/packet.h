@@ -208,7 +208,10 @@ class PacketTagIterator
  * output from Packet::Print. If you wish to only enable
  * checking of metadata, and do not need any printing capability, you can
  * call Packet::EnableChecking: its runtime cost is lower than
- * Packet::EnablePrinting.
+ * Packet::EnablePrinting. Configuring ns-3 with --disable-packet-metadata
+ * compiles the maintenance of metadata out, and the requests to enable it
+ * are then ignored. Setting the PacketMetadataForbidden global value aborts
+ * the simulation, naming the caller, if the metadata is enabled.
  *
  * - The set of tags contain simulation-specific information which cannot
  * be stored in the packet byte buffer because the protocol headers or trailers
@@ -22,6 +22,8 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -395,6 +397,144 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Buffer concatenation unit tests: the buffers to concatenate have data
+ * before and after their zero area, are empty or share their data.
+ */
+class BufferConcatenationTest : public TestCase
+{
+  private:
+    /**
+     * Create a buffer and the bytes it holds
+     * \param startData The size of the data before the zero area
+     * \param zeroSize The size of the zero area
+     * \param endData The size of the data after the zero area
+     * \param value The first value to write
+     * \param bytes The bytes of the buffer, to which the bytes are appended
+     * \return The buffer
+     */
+    static Buffer CreateBuffer(uint32_t startData,
+                               uint32_t zeroSize,
+                               uint32_t endData,
+                               uint8_t value,
+                               std::vector<uint8_t>& bytes);
+
+    /**
+     * Check the content of a buffer
+     * \param b The buffer to check
+     * \param bytes The bytes that should be in the buffer
+     * \param msg The message to report
+     */
+    void CheckBytes(const Buffer& b, const std::vector<uint8_t>& bytes, const std::string& msg);
+
+  public:
+    void DoRun() override;
+    BufferConcatenationTest();
+};
+
+BufferConcatenationTest::BufferConcatenationTest()
+    : TestCase("Buffer concatenation")
+{
+}
+
+Buffer
+BufferConcatenationTest::CreateBuffer(uint32_t startData,
+                                      uint32_t zeroSize,
+                                      uint32_t endData,
+                                      uint8_t value,
+                                      std::vector<uint8_t>& bytes)
+{
+    Buffer b(zeroSize);
+    b.AddAtStart(startData);
+    b.AddAtEnd(endData);
+    Buffer::Iterator i = b.Begin();
+    for (uint32_t j = 0; j < startData; j++)
+    {
+        i.WriteU8(value);
+        bytes.push_back(value++);
+    }
+    bytes.insert(bytes.end(), zeroSize, 0);
+    i = b.End();
+    i.Prev(endData);
+    for (uint32_t j = 0; j < endData; j++)
+    {
+        i.WriteU8(value);
+        bytes.push_back(value++);
+    }
+    return b;
+}
+
+void
+BufferConcatenationTest::CheckBytes(const Buffer& b,
+                                    const std::vector<uint8_t>& bytes,
+                                    const std::string& msg)
+{
+    NS_TEST_ASSERT_MSG_EQ(b.GetSize(), bytes.size(), "Wrong size " << msg);
+    std::vector<uint8_t> got(b.GetSize());
+    b.CopyData(got.data(), got.size());
+    NS_TEST_ASSERT_MSG_EQ((got == bytes), true, "Wrong bytes " << msg);
+}
+
+void
+BufferConcatenationTest::DoRun()
+{
+    const uint32_t sizes[] = {0, 3, 20};
+    for (uint32_t a = 0; a < 27; a++)
+    {
+        for (uint32_t b = 0; b < 27; b++)
+        {
+            for (bool shared : {false, true})
+            {
+                std::ostringstream msg;
+                msg << a << " " << b << " " << shared;
+                std::vector<uint8_t> bytes;
+                Buffer first = CreateBuffer(sizes[a / 9], sizes[a / 3 % 3], sizes[a % 3], 1, bytes);
+                std::vector<uint8_t> firstBytes = bytes;
+                Buffer second =
+                    CreateBuffer(sizes[b / 9], sizes[b / 3 % 3], sizes[b % 3], 100, bytes);
+                Buffer copy = first;
+                if (!shared)
+                {
+                    copy = Buffer();
+                }
+                first.AddAtEnd(second);
+                CheckBytes(first, bytes, msg.str());
+                if (shared)
+                {
+                    CheckBytes(copy, firstBytes, "of the copy " + msg.str());
+                }
+
+                // write to the concatenation, which must not change the second buffer
+                if (first.GetSize() > firstBytes.size())
+                {
+                    std::vector<uint8_t> secondBytes(bytes.begin() + firstBytes.size(),
+                                                     bytes.end());
+                    first.AddAtEnd(1);
+                    Buffer::Iterator i = first.End();
+                    i.Prev(1);
+                    i.WriteU8(0xff);
+                    bytes.push_back(0xff);
+                    CheckBytes(first, bytes, "after a write " + msg.str());
+                    CheckBytes(second, secondBytes, "of the second buffer " + msg.str());
+                }
+            }
+        }
+    }
+
+    // concatenate many buffers, as the RLC does with many small SDUs
+    std::vector<uint8_t> bytes;
+    Buffer pdu;
+    for (uint32_t j = 0; j < 100; j++)
+    {
+        Buffer sdu = CreateBuffer(j % 7, j % 3 * 50, j % 2, j, bytes);
+        pdu.AddAtEnd(sdu);
+    }
+    CheckBytes(pdu, bytes, "of the concatenation of 100 buffers");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -411,6 +551,7 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", UNIT)
 {
     AddTestCase(new BufferTest, TestCase::QUICK);
+    AddTestCase(new BufferConcatenationTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -236,10 +236,13 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     NS_ASSERT(txParams->txPhy);
     NS_ASSERT(txParams->psd);
-    Ptr<SpectrumSignalParameters> txParamsTrace =
-        txParams->Copy(); // copy it since traced value cannot be const (because of potential
-                          // underlying DynamicCasts)
-    m_txSigParamsTrace(txParamsTrace);
+    if (!m_txSigParamsTrace.IsEmpty())
+    {
+        Ptr<SpectrumSignalParameters> txParamsTrace =
+            txParams->Copy(); // copy it since traced value cannot be const (because of potential
+                              // underlying DynamicCasts)
+        m_txSigParamsTrace(txParamsTrace);
+    }
 
     Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility();
     SpectrumModelUid_t txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
@@ -310,7 +313,11 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
                 NS_LOG_LOGIC("copying signal parameters " << txParams);
                 Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
+                if (convertedTxPowerSpectrum != txParams->psd)
+                {
+                    // the copy of the parameters already owns a copy of the TX PSD
+                    rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
+                }
                 Time delay = MicroSeconds(0);
 
                 Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
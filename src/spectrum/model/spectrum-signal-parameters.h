@@ -88,9 +88,10 @@ struct SpectrumSignalParameters : public SimpleRefCount<SpectrumSignalParameters
      * underwater acoustic communications. Other transmission media to
      * be defined.
      *
-     * \note when SpectrumSignalParameters is copied, only the pointer to the PSD will be copied.
-     * This is because SpectrumChannel objects normally overwrite the psd anyway, so there is no
-     * point in making a copy.
+     * \note when SpectrumSignalParameters is copied, the PSD is copied as well, because
+     * SpectrumChannel objects scale the PSD of each receiver in place. The payload of the
+     * signal carried by derived classes should instead be shared by the copies, and hence
+     * never be modified by the receivers.
      */
     Ptr<SpectrumValue> psd;
 
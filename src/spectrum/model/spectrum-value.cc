@@ -22,15 +22,242 @@
 #include <ns3/math.h>
 #include <ns3/spectrum-value.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+
+/// Alignment and granularity of the blocks of SpectrumValuePool
+#define SPECTRUM_VALUE_ALIGNMENT 64
+/// Maximum number of block sizes with a free list in SpectrumValuePool
+#define SPECTRUM_VALUE_FREE_LISTS 16
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("SpectrumValue");
 
+/**
+ * \ingroup spectrum
+ *
+ * \brief Free list of the blocks of one size of SpectrumValuePool
+ *
+ * The first word of each free block points to the next free block.
+ */
+struct SpectrumValueFreeList
+{
+    std::size_t size; //!< size of the blocks, or 0 if the free list is unused
+    void* head;       //!< first free block
+};
+
+/// Free lists of SpectrumValuePool, in the order their block sizes were first used
+static SpectrumValueFreeList g_spectrumValueFreeLists[SPECTRUM_VALUE_FREE_LISTS];
+
+/**
+ * \param size the requested size, in bytes
+ * \return the size of the block, a non-zero multiple of SPECTRUM_VALUE_ALIGNMENT
+ */
+static std::size_t
+GetSpectrumValueBlockSize(std::size_t size)
+{
+    if (size == 0)
+    {
+        return SPECTRUM_VALUE_ALIGNMENT;
+    }
+    return (size + SPECTRUM_VALUE_ALIGNMENT - 1) & ~std::size_t(SPECTRUM_VALUE_ALIGNMENT - 1);
+}
+
+/**
+ * \param size the size of the blocks, as returned by GetSpectrumValueBlockSize
+ * \return the free list of the blocks of \p size bytes, or nullptr if there
+ * are too many block sizes already
+ */
+static SpectrumValueFreeList*
+GetSpectrumValueFreeList(std::size_t size)
+{
+    for (auto& freeList : g_spectrumValueFreeLists)
+    {
+        if (freeList.size == size)
+        {
+            return &freeList;
+        }
+        if (freeList.size == 0)
+        {
+            freeList.size = size;
+            return &freeList;
+        }
+    }
+    return nullptr;
+}
+
+void*
+SpectrumValuePool::Allocate(std::size_t size)
+{
+    size = GetSpectrumValueBlockSize(size);
+    SpectrumValueFreeList* freeList = GetSpectrumValueFreeList(size);
+    if (freeList && freeList->head)
+    {
+        void* p = freeList->head;
+        freeList->head = *static_cast<void**>(p);
+        return p;
+    }
+    void* p = std::aligned_alloc(SPECTRUM_VALUE_ALIGNMENT, size);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void
+SpectrumValuePool::Free(void* p, std::size_t size)
+{
+    if (!p)
+    {
+        return;
+    }
+    size = GetSpectrumValueBlockSize(size);
+    SpectrumValueFreeList* freeList = GetSpectrumValueFreeList(size);
+    if (freeList)
+    {
+        *static_cast<void**>(p) = freeList->head;
+        freeList->head = p;
+    }
+    else
+    {
+        std::free(p);
+    }
+}
+
+SpectrumBandRuns::SpectrumBandRuns(std::vector<int> bands)
+{
+    std::sort(bands.begin(), bands.end());
+    for (int band : bands)
+    {
+        NS_ASSERT(band >= 0);
+        if (!m_runs.empty() && static_cast<uint32_t>(band) <= m_runs.back().second)
+        {
+            m_runs.back().second = std::max<uint32_t>(m_runs.back().second, band + 1);
+        }
+        else
+        {
+            m_runs.emplace_back(band, band + 1);
+        }
+    }
+}
+
+SpectrumBandRuns::SpectrumBandRuns(std::vector<Run> runs)
+    : m_runs(std::move(runs))
+{
+}
+
+const std::vector<SpectrumBandRuns::Run>&
+SpectrumBandRuns::GetRuns() const
+{
+    return m_runs;
+}
+
+bool
+SpectrumBandRuns::Overlaps(const SpectrumBandRuns& other) const
+{
+    auto a = m_runs.begin();
+    auto b = other.m_runs.begin();
+    while (a != m_runs.end() && b != other.m_runs.end())
+    {
+        if (a->second <= b->first)
+        {
+            ++a;
+        }
+        else if (b->second <= a->first)
+        {
+            ++b;
+        }
+        else
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Ptr<const SpectrumBandRuns>
+SpectrumBandRuns::Union(Ptr<const SpectrumBandRuns> a, Ptr<const SpectrumBandRuns> b)
+{
+    if (a == b)
+    {
+        return a;
+    }
+    std::vector<Run> runs;
+    runs.reserve(a->m_runs.size() + b->m_runs.size());
+    std::merge(a->m_runs.begin(),
+               a->m_runs.end(),
+               b->m_runs.begin(),
+               b->m_runs.end(),
+               std::back_inserter(runs));
+    // coalesce the overlapping and adjacent runs
+    std::size_t last = 0;
+    for (std::size_t i = 1; i < runs.size(); ++i)
+    {
+        if (runs[i].first <= runs[last].second)
+        {
+            runs[last].second = std::max(runs[last].second, runs[i].second);
+        }
+        else
+        {
+            runs[++last] = runs[i];
+        }
+    }
+    runs.resize(std::min(runs.size(), last + 1));
+    return Create<SpectrumBandRuns>(std::move(runs));
+}
+
+/**
+ * \param values the values of a SpectrumValue
+ * \param bands a set of bands
+ * \return true if all the values outside the bands are zero
+ */
+static bool
+IsZeroOutside(const Values& values, const SpectrumBandRuns& bands)
+{
+    std::size_t i = 0;
+    for (const auto& run : bands.GetRuns())
+    {
+        for (; i < run.first; ++i)
+        {
+            if (values[i] != 0)
+            {
+                return false;
+            }
+        }
+        i = run.second;
+    }
+    for (; i < values.size(); ++i)
+    {
+        if (values[i] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 SpectrumValue::SpectrumValue()
 {
 }
 
+void*
+SpectrumValue::operator new(std::size_t size)
+{
+    return SpectrumValuePool::Allocate(size);
+}
+
+void
+SpectrumValue::operator delete(void* p, std::size_t size)
+{
+    SpectrumValuePool::Free(p, size);
+}
+
 SpectrumValue::SpectrumValue(Ptr<const SpectrumModel> sof)
     : m_spectrumModel(sof),
       m_values(sof->GetNumBands())
@@ -40,6 +267,7 @@ SpectrumValue::SpectrumValue(Ptr<const SpectrumModel> sof)
 double&
 SpectrumValue::operator[](size_t index)
 {
+    m_occupiedBands = nullptr;
     return m_values.at(index);
 }
 
@@ -76,15 +304,35 @@ SpectrumValue::ConstValuesEnd() const
 Values::iterator
 SpectrumValue::ValuesBegin()
 {
+    m_occupiedBands = nullptr;
     return m_values.begin();
 }
 
 Values::iterator
 SpectrumValue::ValuesEnd()
 {
+    m_occupiedBands = nullptr;
     return m_values.end();
 }
 
+void
+SpectrumValue::SetOccupiedBands(Ptr<const SpectrumBandRuns> bands)
+{
+    if (bands)
+    {
+        NS_ASSERT(bands->GetRuns().empty() || bands->GetRuns().back().second <= m_values.size());
+        NS_ASSERT_MSG(IsZeroOutside(m_values, *bands),
+                      "Non-zero values outside the occupied bands");
+    }
+    m_occupiedBands = bands;
+}
+
+Ptr<const SpectrumBandRuns>
+SpectrumValue::GetOccupiedBands() const
+{
+    return m_occupiedBands;
+}
+
 Bands::const_iterator
 SpectrumValue::ConstBandsBegin() const
 {
@@ -100,47 +348,77 @@ SpectrumValue::ConstBandsEnd() const
 void
 SpectrumValue::Add(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const double* w = x.m_values.data();
+    if (x.m_occupiedBands)
     {
-        *it1 += *it2;
-        ++it1;
-        ++it2;
+        for (const auto& run : x.m_occupiedBands->GetRuns())
+        {
+            for (std::size_t i = run.first; i < run.second; ++i)
+            {
+                v[i] += w[i];
+            }
+        }
+        if (m_occupiedBands)
+        {
+            m_occupiedBands = SpectrumBandRuns::Union(m_occupiedBands, x.m_occupiedBands);
+        }
+        return;
     }
+
+    std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] += w[i];
+    }
+    m_occupiedBands = nullptr;
 }
 
 void
 SpectrumValue::Add(double s)
 {
-    Values::iterator it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    m_occupiedBands = nullptr;
+    double* v = m_values.data();
+    std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 += s;
-        ++it1;
+        v[i] += s;
     }
 }
 
 void
 SpectrumValue::Subtract(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const double* w = x.m_values.data();
+    if (x.m_occupiedBands)
     {
-        *it1 -= *it2;
-        ++it1;
-        ++it2;
+        for (const auto& run : x.m_occupiedBands->GetRuns())
+        {
+            for (std::size_t i = run.first; i < run.second; ++i)
+            {
+                v[i] -= w[i];
+            }
+        }
+        if (m_occupiedBands)
+        {
+            m_occupiedBands = SpectrumBandRuns::Union(m_occupiedBands, x.m_occupiedBands);
+        }
+        return;
+    }
+
+    std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] -= w[i];
     }
+    m_occupiedBands = nullptr;
 }
 
 void
@@ -152,46 +430,48 @@ SpectrumValue::Subtract(double s)
 void
 SpectrumValue::Multiply(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
+    m_occupiedBands = nullptr;
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const double* w = x.m_values.data();
+    std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 *= *it2;
-        ++it1;
-        ++it2;
+        v[i] *= w[i];
     }
 }
 
 void
 SpectrumValue::Multiply(double s)
 {
-    Values::iterator it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    if (!std::isfinite(s))
     {
-        *it1 *= s;
-        ++it1;
+        // 0 * inf and 0 * NaN are NaN, the bands outside the runs are no longer zero
+        m_occupiedBands = nullptr;
+    }
+    double* v = m_values.data();
+    std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] *= s;
     }
 }
 
 void
 SpectrumValue::Divide(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
+    m_occupiedBands = nullptr;
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const double* w = x.m_values.data();
+    std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 /= *it2;
-        ++it1;
-        ++it2;
+        v[i] /= w[i];
     }
 }
 
@@ -199,30 +479,34 @@ void
 SpectrumValue::Divide(double s)
 {
     NS_LOG_FUNCTION(this << s);
-    Values::iterator it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    if (s == 0 || !std::isfinite(s))
     {
-        *it1 /= s;
-        ++it1;
+        // 0 / 0 and 0 / NaN are NaN, the bands outside the runs are no longer zero
+        m_occupiedBands = nullptr;
+    }
+    double* v = m_values.data();
+    std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] /= s;
     }
 }
 
 void
 SpectrumValue::ChangeSign()
 {
-    Values::iterator it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = -(*it1);
-        ++it1;
+        v[i] = -v[i];
     }
 }
 
 void
 SpectrumValue::ShiftLeft(int n)
 {
+    m_occupiedBands = nullptr;
     int i = 0;
     while (i < (int)m_values.size() - n)
     {
@@ -239,6 +523,7 @@ SpectrumValue::ShiftLeft(int n)
 void
 SpectrumValue::ShiftRight(int n)
 {
+    m_occupiedBands = nullptr;
     int i = m_values.size() - 1;
     while (i - n >= 0)
     {
@@ -256,6 +541,7 @@ void
 SpectrumValue::Pow(double exp)
 {
     NS_LOG_FUNCTION(this << exp);
+    m_occupiedBands = nullptr;
     Values::iterator it1 = m_values.begin();
 
     while (it1 != m_values.end())
@@ -269,6 +555,7 @@ void
 SpectrumValue::Exp(double base)
 {
     NS_LOG_FUNCTION(this << base);
+    m_occupiedBands = nullptr;
     Values::iterator it1 = m_values.begin();
 
     while (it1 != m_values.end())
@@ -282,6 +569,7 @@ void
 SpectrumValue::Log10()
 {
     NS_LOG_FUNCTION(this);
+    m_occupiedBands = nullptr;
     Values::iterator it1 = m_values.begin();
 
     while (it1 != m_values.end())
@@ -295,6 +583,7 @@ void
 SpectrumValue::Log2()
 {
     NS_LOG_FUNCTION(this);
+    m_occupiedBands = nullptr;
     Values::iterator it1 = m_values.begin();
 
     while (it1 != m_values.end())
@@ -308,6 +597,7 @@ void
 SpectrumValue::Log()
 {
     NS_LOG_FUNCTION(this);
+    m_occupiedBands = nullptr;
     Values::iterator it1 = m_values.begin();
 
     while (it1 != m_values.end())
@@ -334,6 +624,17 @@ double
 Sum(const SpectrumValue& x)
 {
     double s = 0;
+    if (x.m_occupiedBands)
+    {
+        for (const auto& run : x.m_occupiedBands->GetRuns())
+        {
+            for (std::size_t i = run.first; i < run.second; ++i)
+            {
+                s += x.m_values[i];
+            }
+        }
+        return s;
+    }
     Values::const_iterator it1 = x.ConstValuesBegin();
     while (it1 != x.ConstValuesEnd())
     {
@@ -376,11 +677,7 @@ Integral(const SpectrumValue& arg)
 Ptr<SpectrumValue>
 SpectrumValue::Copy() const
 {
-    Ptr<SpectrumValue> p = Create<SpectrumValue>(m_spectrumModel);
-    *p = *this;
-    return p;
-
-    //  return Copy<SpectrumValue> (*this)
+    return Create<SpectrumValue>(*this);
 }
 
 /**
@@ -612,6 +909,7 @@ SpectrumValue::operator/=(double rhs)
 SpectrumValue&
 SpectrumValue::operator=(double rhs)
 {
+    m_occupiedBands = nullptr;
     Values::iterator it1 = m_values.begin();
 
     while (it1 != m_values.end())
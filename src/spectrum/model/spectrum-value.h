@@ -24,14 +24,150 @@
 #include <ns3/simple-ref-count.h>
 #include <ns3/spectrum-model.h>
 
+#include <cstddef>
 #include <ostream>
+#include <utility>
 #include <vector>
 
 namespace ns3
 {
 
+/**
+ * \ingroup spectrum
+ *
+ * \brief Pool of the storage of the SpectrumValue instances
+ *
+ * The storage is handed out in blocks aligned to 64 bytes, the size of a
+ * cache line, so that the element-wise operations on the values can be
+ * vectorized. Freed blocks are recycled through one free list per block
+ * size. Since all the values of a SpectrumModel have the same size, each
+ * SpectrumModel in practice has its own pool, and PSD arithmetic stops going
+ * through malloc once a simulation reaches its steady state. The blocks are
+ * kept until the process exits. Like the free lists of the packets, the pool
+ * is not thread-safe.
+ */
+class SpectrumValuePool
+{
+  public:
+    /**
+     * \param size the size of the block, in bytes
+     * \return a block of at least \p size bytes, aligned to 64 bytes
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * \param p a block returned by Allocate
+     * \param size the size that was passed to Allocate
+     */
+    static void Free(void* p, std::size_t size);
+};
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Allocator of the values of a SpectrumValue, drawn from SpectrumValuePool
+ */
+template <class T>
+class SpectrumValueAllocator
+{
+  public:
+    typedef T value_type; ///< type of the allocated elements
+
+    SpectrumValueAllocator() = default;
+
+    /**
+     * Rebinding copy constructor
+     */
+    template <class U>
+    SpectrumValueAllocator(const SpectrumValueAllocator<U>&)
+    {
+    }
+
+    /**
+     * \param n the number of elements
+     * \return storage for \p n elements
+     */
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(SpectrumValuePool::Allocate(n * sizeof(T)));
+    }
+
+    /**
+     * \param p the storage returned by allocate
+     * \param n the number of elements passed to allocate
+     */
+    void deallocate(T* p, std::size_t n)
+    {
+        SpectrumValuePool::Free(p, n * sizeof(T));
+    }
+};
+
+/// All the SpectrumValueAllocator instances share the same pool
+template <class T, class U>
+bool
+operator==(const SpectrumValueAllocator<T>&, const SpectrumValueAllocator<U>&)
+{
+    return true;
+}
+
+/// All the SpectrumValueAllocator instances share the same pool
+template <class T, class U>
+bool
+operator!=(const SpectrumValueAllocator<T>&, const SpectrumValueAllocator<U>&)
+{
+    return false;
+}
+
 /// Container for element values
-typedef std::vector<double> Values;
+typedef std::vector<double, SpectrumValueAllocator<double>> Values;
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Set of bands of a SpectrumModel, as sorted runs of consecutive bands
+ *
+ * A transmission that occupies only some of the bands of its SpectrumModel
+ * attaches the runs of the bands it occupies to its PSD, so that the
+ * operations on the PSD can skip the other bands.
+ */
+class SpectrumBandRuns : public SimpleRefCount<SpectrumBandRuns>
+{
+  public:
+    /// Run of bands, from the index of its first band to the index past its last band
+    typedef std::pair<uint32_t, uint32_t> Run;
+
+    /**
+     * \param bands the indices of the bands, in any order and possibly repeated
+     */
+    SpectrumBandRuns(std::vector<int> bands);
+
+    /**
+     * \param runs the runs, sorted, disjoint and not adjacent
+     */
+    SpectrumBandRuns(std::vector<Run> runs);
+
+    /**
+     * \return the runs of bands, sorted
+     */
+    const std::vector<Run>& GetRuns() const;
+
+    /**
+     * \param other another set of bands
+     * \return true if a band belongs to both sets
+     */
+    bool Overlaps(const SpectrumBandRuns& other) const;
+
+    /**
+     * \param a a set of bands
+     * \param b another set of bands
+     * \return the bands that belong to either set
+     */
+    static Ptr<const SpectrumBandRuns> Union(Ptr<const SpectrumBandRuns> a,
+                                             Ptr<const SpectrumBandRuns> b);
+
+  private:
+    std::vector<Run> m_runs; //!< sorted runs of bands
+};
 
 /**
  * \ingroup spectrum
@@ -80,12 +216,30 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
 
     SpectrumValue();
 
+    /**
+     * Allocate a SpectrumValue from SpectrumValuePool
+     *
+     * \param size the size of the object
+     * \return the storage of the object
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Return the storage of a SpectrumValue to SpectrumValuePool
+     *
+     * \param p the storage of the object
+     * \param size the size of the object
+     */
+    static void operator delete(void* p, std::size_t size);
+
     /**
      * Access value at given frequency index
      *
      * @param index the given frequency index
      *
      * @return reference to the value
+     *
+     * \note this forgets the occupied bands, see SetOccupiedBands
      */
     double& operator[](size_t index);
 
@@ -142,6 +296,8 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      *
      * @return an iterator pointing to the beginning of the embedded Values
+     *
+     * \note like the non-const operator[], this forgets the occupied bands
      */
     Values::iterator ValuesBegin();
 
@@ -149,6 +305,8 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      *
      * @return an iterator pointing to the end of the embedded Values
+     *
+     * \note like the non-const operator[], this forgets the occupied bands
      */
     Values::iterator ValuesEnd();
 
@@ -158,6 +316,25 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     uint32_t GetValuesN() const;
 
+    /**
+     * Declare that all the values outside some bands are zero. The occupied
+     * bands are kept by the copies, by the addition and subtraction of values
+     * with occupied bands, and by the multiplication and division by a finite
+     * scalar. Addition and subtraction then only visit the occupied bands of
+     * the value added or subtracted. Any other modification forgets the
+     * occupied bands, including writing through the non-const operator[] and
+     * iterators.
+     *
+     * \param bands the occupied bands, or nullptr if unknown
+     */
+    void SetOccupiedBands(Ptr<const SpectrumBandRuns> bands);
+
+    /**
+     * \return the bands outside which all the values are zero, or nullptr if
+     * unknown
+     */
+    Ptr<const SpectrumBandRuns> GetOccupiedBands() const;
+
     /**
      * \brief Get the value element at the position
      * \param pos position
@@ -589,6 +766,9 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
 
     Ptr<const SpectrumModel> m_spectrumModel; //!< The spectrum model
 
+    /// Bands outside which all the values are zero, or nullptr if unknown
+    Ptr<const SpectrumBandRuns> m_occupiedBands;
+
     /**
      * Set of values which implement the codomain of the functions in
      * the Function Space defined by SpectrumValue. There is no restriction
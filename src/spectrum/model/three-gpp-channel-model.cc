@@ -28,6 +28,7 @@
 #include "ns3/node.h"
 #include "ns3/phased-array-model.h"
 #include "ns3/pointer.h"
+#include "ns3/profiler.h"
 #include "ns3/string.h"
 #include <ns3/simulator.h>
 
@@ -1100,6 +1101,7 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
                                  Ptr<const PhasedArrayModel> bAntenna)
 {
     NS_LOG_FUNCTION(this);
+    NS_PROFILE_SCOPE("spectrum", "ThreeGppChannelModel::GetChannel");
 
     // Compute the channel params key. The key is reciprocal, i.e., key (a, b) = key (b, a)
     uint64_t channelParamsKey =
@@ -29,6 +29,7 @@
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
+#include "ns3/profiler.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 
@@ -144,6 +145,7 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     const ns3::Vector& uSpeed) const
 {
     NS_LOG_FUNCTION(this);
+    NS_PROFILE_SCOPE("spectrum", "ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain");
 
     Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue>(txPsd);
 
@@ -228,26 +230,38 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     NS_ASSERT(numCluster <= doppler.GetSize());
 
     // apply the doppler term and the propagation delay to the long term component
-    // to obtain the beamforming gain
-    auto vit = tempPsd->ValuesBegin();      // psd iterator
-    auto sbit = tempPsd->ConstBandsBegin(); // band iterator
-    while (vit != tempPsd->ValuesEnd())
+    // to obtain the beamforming gain, visiting only the occupied bands if known
+    Ptr<const SpectrumBandRuns> occupiedBands = tempPsd->GetOccupiedBands();
+    std::vector<SpectrumBandRuns::Run> allBands;
+    if (!occupiedBands)
     {
-        if ((*vit) != 0.00)
+        allBands.emplace_back(0, tempPsd->GetValuesN());
+    }
+    const auto& runs = occupiedBands ? occupiedBands->GetRuns() : allBands;
+
+    auto values = tempPsd->ValuesBegin();    // psd iterator
+    auto bands = tempPsd->ConstBandsBegin(); // band iterator
+    for (const auto& run : runs)
+    {
+        for (uint32_t i = run.first; i < run.second; ++i)
         {
-            std::complex<double> subsbandGain(0.0, 0.0);
-            double fsb = (*sbit).fc; // center frequency of the sub-band
-            for (uint16_t cIndex = 0; cIndex < numCluster; cIndex++)
+            auto vit = values + i;
+            if ((*vit) != 0.00)
             {
-                double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
-                subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] *
-                                                  std::complex<double>(cos(delay), sin(delay));
+                std::complex<double> subsbandGain(0.0, 0.0);
+                double fsb = (bands + i)->fc; // center frequency of the sub-band
+                for (uint16_t cIndex = 0; cIndex < numCluster; cIndex++)
+                {
+                    double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
+                    subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] *
+                                                      std::complex<double>(cos(delay), sin(delay));
+                }
+                *vit = (*vit) * (norm(subsbandGain));
             }
-            *vit = (*vit) * (norm(subsbandGain));
         }
-        vit++;
-        sbit++;
     }
+    // the gain leaves the unoccupied bands at zero
+    tempPsd->SetOccupiedBands(occupiedBands);
     return tempPsd;
 }
 
@@ -336,7 +350,8 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
     NS_ASSERT_MSG(a->GetDistanceFrom(b) > 0.0,
                   "The position of a and b devices cannot be the same");
 
-    Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(params->psd);
+    // CalcBeamformingGain copies the PSD
+    Ptr<SpectrumValue> rxPsd = params->psd;
 
     // retrieve the antenna of device a
     NS_ASSERT_MSG(aPhasedArrayModel, "Antenna not found for node " << aId);
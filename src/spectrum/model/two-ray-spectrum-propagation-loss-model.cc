@@ -24,6 +24,7 @@
 #include <ns3/node.h>
 #include <ns3/object-factory.h>
 #include <ns3/pointer.h>
+#include <ns3/profiler.h>
 #include <ns3/random-variable-stream.h>
 #include <ns3/string.h>
 
@@ -1035,6 +1036,7 @@ TwoRaySpectrumPropagationLossModel::CalcBeamformingGain(
     Ptr<const PhasedArrayModel> bPhasedArrayModel) const
 {
     NS_LOG_FUNCTION(this);
+    NS_PROFILE_SCOPE("spectrum", "TwoRaySpectrumPropagationLossModel::CalcBeamformingGain");
 
     // Get the relative angles between tx and rx phased arrays
     Angles aAngle(b->GetPosition(), a->GetPosition());
@@ -27,6 +27,8 @@
 
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 using namespace ns3;
 
@@ -93,6 +95,174 @@ SpectrumValueTestCase::DoRun()
     NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(m_a, m_b, TOLERANCE, "");
 }
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the storage of the values drawn from SpectrumValuePool
+ */
+class SpectrumValuePoolTestCase : public TestCase
+{
+  public:
+    SpectrumValuePoolTestCase();
+    void DoRun() override;
+};
+
+SpectrumValuePoolTestCase::SpectrumValuePoolTestCase()
+    : TestCase("Storage of the values from the pool")
+{
+}
+
+void
+SpectrumValuePoolTestCase::DoRun()
+{
+    // an odd number of bands, so that vectorized loops have a remainder
+    std::vector<double> freqs;
+    for (int i = 0; i < 37; ++i)
+    {
+        freqs.push_back(1e9 + 1e6 * i);
+    }
+    Ptr<SpectrumModel> sm = Create<SpectrumModel>(freqs);
+
+    Ptr<SpectrumValue> a = Create<SpectrumValue>(sm);
+    Ptr<SpectrumValue> b = Create<SpectrumValue>(sm);
+    for (int i = 0; i < 37; ++i)
+    {
+        (*a)[i] = i;
+        (*b)[i] = 2 * i + 1;
+    }
+    NS_TEST_ASSERT_MSG_EQ(reinterpret_cast<uintptr_t>(&(*a)[0]) % 64,
+                          0,
+                          "Values not aligned to a cache line");
+
+    Ptr<SpectrumValue> c = a->Copy();
+    NS_TEST_ASSERT_MSG_NE(&(*c)[0], &(*a)[0], "Copy shares the values");
+    *c *= *b;
+    *c += *a;
+    *c /= *b;
+    *c -= 1;
+    for (int i = 0; i < 37; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL((*c)[i],
+                                  (i * (2.0 * i + 1) + i) / (2 * i + 1) - 1,
+                                  TOLERANCE,
+                                  "Wrong value " << i);
+    }
+
+    // the storage of a released value is recycled for the next value of the same model
+    const double* values = &(*c)[0];
+    c = nullptr;
+    c = Create<SpectrumValue>(sm);
+    NS_TEST_ASSERT_MSG_EQ(&(*c)[0], values, "Values not recycled");
+    NS_TEST_ASSERT_MSG_EQ(Sum(*c), 0, "Recycled values not cleared");
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the arithmetic on values with occupied bands
+ */
+class SpectrumValueOccupiedBandsTestCase : public TestCase
+{
+  public:
+    SpectrumValueOccupiedBandsTestCase();
+    void DoRun() override;
+};
+
+SpectrumValueOccupiedBandsTestCase::SpectrumValueOccupiedBandsTestCase()
+    : TestCase("Arithmetic on the occupied bands")
+{
+}
+
+void
+SpectrumValueOccupiedBandsTestCase::DoRun()
+{
+    Ptr<const SpectrumBandRuns> some =
+        Create<SpectrumBandRuns>(std::vector<int>{9, 3, 4, 5, 8, 4});
+    Ptr<const SpectrumBandRuns> other = Create<SpectrumBandRuns>(std::vector<int>{6, 12});
+    std::vector<SpectrumBandRuns::Run> runs = {{3, 6}, {8, 10}};
+    NS_TEST_ASSERT_MSG_EQ((some->GetRuns() == runs), true, "Wrong runs");
+    NS_TEST_ASSERT_MSG_EQ(some->Overlaps(*other), false, "Disjoint runs overlap");
+    Ptr<const SpectrumBandRuns> both = SpectrumBandRuns::Union(some, other);
+    runs = {{3, 7}, {8, 10}, {12, 13}};
+    NS_TEST_ASSERT_MSG_EQ((both->GetRuns() == runs), true, "Wrong union");
+    NS_TEST_ASSERT_MSG_EQ(both->Overlaps(*other), true, "Union does not overlap");
+
+    std::vector<double> freqs;
+    for (int i = 0; i < 16; ++i)
+    {
+        freqs.push_back(1e9 + 1e6 * i);
+    }
+    Ptr<SpectrumModel> sm = Create<SpectrumModel>(freqs);
+    SpectrumValue a(sm);
+    SpectrumValue b(sm);
+    SpectrumValue dense(sm);
+    for (int i = 0; i < 16; ++i)
+    {
+        dense[i] = i + 1;
+    }
+    for (const auto& run : some->GetRuns())
+    {
+        for (uint32_t i = run.first; i < run.second; ++i)
+        {
+            a[i] = 2 * i;
+        }
+    }
+    for (const auto& run : other->GetRuns())
+    {
+        for (uint32_t i = run.first; i < run.second; ++i)
+        {
+            b[i] = 3 * i;
+        }
+    }
+    SpectrumValue expected(sm);
+    for (int i = 0; i < 16; ++i)
+    {
+        expected[i] = dense[i] + a[i] - b[i];
+    }
+    a.SetOccupiedBands(some);
+    b.SetOccupiedBands(other);
+
+    // the scalar multiplication keeps the occupied bands, the sum only visits them
+    a *= 2;
+    NS_TEST_ASSERT_MSG_EQ(a.GetOccupiedBands(), some, "Occupied bands lost");
+    NS_TEST_ASSERT_MSG_EQ_TOL(Sum(a), 2 * 2 * (3 + 4 + 5 + 8 + 9), TOLERANCE, "Wrong sum");
+    a /= 2;
+
+    // a non-finite factor or a null divisor turns the zeros into NaN
+    SpectrumValue c = a;
+    c *= std::numeric_limits<double>::infinity();
+    NS_TEST_ASSERT_MSG_EQ(c.GetOccupiedBands(), nullptr, "Occupied bands kept after c *= inf");
+    NS_TEST_ASSERT_MSG_EQ(std::isnan(Sum(c)), true, "0 * inf is not visited by the sum");
+    c = a;
+    c *= std::nan("");
+    NS_TEST_ASSERT_MSG_EQ(c.GetOccupiedBands(), nullptr, "Occupied bands kept after c *= NaN");
+    c = a;
+    c /= 0.0;
+    NS_TEST_ASSERT_MSG_EQ(c.GetOccupiedBands(), nullptr, "Occupied bands kept after c /= 0");
+    NS_TEST_ASSERT_MSG_EQ(std::isnan(Sum(c)), true, "0 / 0 is not visited by the sum");
+    c = a;
+    c /= std::nan("");
+    NS_TEST_ASSERT_MSG_EQ(c.GetOccupiedBands(), nullptr, "Occupied bands kept after c /= NaN");
+
+    SpectrumValue sum = a;
+    sum -= b;
+    NS_TEST_ASSERT_MSG_EQ((sum.GetOccupiedBands()->GetRuns() == both->GetRuns()),
+                          true,
+                          "Wrong occupied bands of the difference");
+    sum += dense;
+    NS_TEST_ASSERT_MSG_EQ(sum.GetOccupiedBands(), nullptr, "Dense sum has occupied bands");
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(sum, expected, TOLERANCE, "Wrong sparse arithmetic");
+
+    dense += a;
+    dense -= b;
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(dense, expected, TOLERANCE, "Wrong sparse sum");
+
+    // writing through the non-const accessors forgets the occupied bands
+    a[0] = 1;
+    NS_TEST_ASSERT_MSG_EQ(a.GetOccupiedBands(), nullptr, "Occupied bands kept after a write");
+    NS_TEST_ASSERT_MSG_EQ_TOL(Sum(a), 1 + 2 * (3 + 4 + 5 + 8 + 9), TOLERANCE, "Wrong dense sum");
+}
+
 /**
  * \ingroup spectrum-tests
  *
@@ -268,6 +438,9 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     v1rs3[4] = v1[1];
     tv1rs3 = v1 >> 3;
     AddTestCase(new SpectrumValueTestCase(tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
+
+    AddTestCase(new SpectrumValuePoolTestCase, TestCase::QUICK);
+    AddTestCase(new SpectrumValueOccupiedBandsTestCase, TestCase::QUICK);
 }
 
 /**
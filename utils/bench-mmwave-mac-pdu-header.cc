@@ -0,0 +1,124 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the building, serialization and
+// parsing of the mmWave MAC PDU header, for an increasing number of
+// subheaders, and to count the memory allocations they perform.
+// Sample usage:  ./ns3 run 'bench-mmwave-mac-pdu-header --pdus=1000000'
+
+#include "ns3/buffer.h"
+#include "ns3/command-line.h"
+#include "ns3/mmwave-mac-pdu-header.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace ns3;
+using namespace mmwave;
+
+/// Number of memory allocations performed by the program
+static uint64_t g_allocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+    g_allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Build the header of a TB, serialize it and parse it, as the MACs do.
+ *
+ * \param buffer the buffer to serialize the header to, large enough
+ * \param subheaders the number of subheaders
+ * \return the sum of the sizes of the parsed subheaders
+ */
+static uint64_t
+BuildAndParse(Buffer& buffer, uint32_t subheaders)
+{
+    MmWaveMacPduHeader header;
+    for (uint32_t i = 0; i < subheaders; ++i)
+    {
+        header.AddSubheader(MacSubheader(i % 32, 100 + 100 * i));
+    }
+    header.Serialize(buffer.Begin());
+
+    MmWaveMacPduHeader parsed;
+    parsed.Deserialize(buffer.Begin());
+    uint64_t total = 0;
+    for (const auto& subheader : parsed.GetSubheaders())
+    {
+        total += subheader.m_size;
+    }
+    return total;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t pdus = 1000000;
+    uint32_t maxSubheaders = 32;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the mmWave MAC PDU header.");
+    cmd.AddValue("pdus", "number of PDU headers per number of subheaders", pdus);
+    cmd.AddValue("maxSubheaders", "maximum number of subheaders", maxSubheaders);
+    cmd.Parse(argc, argv);
+
+    Buffer buffer;
+    buffer.AddAtStart(4 * maxSubheaders);
+
+    std::cout << "subheaders  time [ns/pdu]  allocations/pdu" << std::endl;
+    for (uint32_t subheaders = 1; subheaders <= maxSubheaders; subheaders *= 2)
+    {
+        uint64_t total = 0;
+        SystemWallClockMs time;
+        uint64_t allocations = g_allocations;
+        time.Start();
+        for (uint32_t i = 0; i < pdus; ++i)
+        {
+            total += BuildAndParse(buffer, subheaders);
+        }
+        double ms = time.End();
+        allocations = g_allocations - allocations;
+
+        if (total == 0)
+        {
+            return 1;
+        }
+        std::cout << subheaders << "\t\t" << ms * 1e6 / pdus << "\t\t"
+                  << static_cast<double>(allocations) / pdus << std::endl;
+    }
+    return 0;
+}
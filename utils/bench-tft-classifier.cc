@@ -0,0 +1,182 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the downlink packet classification
+// of the EPC gateway, with one EpcTftClassifier per UE, for an increasing
+// number of packet filters per bearer. The first packet of each flow is
+// matched against the TFTs, the following ones hit the classification cache.
+// Sample usage:  ./ns3 run 'bench-tft-classifier --ues=10000 --bearers=4'
+
+#include "ns3/command-line.h"
+#include "ns3/epc-tft-classifier.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/// Remote port of the flows of the first dedicated bearer
+static const uint16_t FLOW_PORT = 10000;
+/// Remote port of the packet filters that do not match any flow
+static const uint16_t UNMATCHED_PORT = 20000;
+
+/**
+ * Create the classifier of a UE, with a default bearer and the dedicated
+ * bearers. Only the last filter of each dedicated bearer matches its flow, so
+ * that all the filters are evaluated on a cache miss.
+ *
+ * \param bearers the number of dedicated bearers
+ * \param filters the number of packet filters per dedicated bearer
+ * \return the classifier
+ */
+static Ptr<EpcTftClassifier>
+CreateClassifier(uint32_t bearers, uint32_t filters)
+{
+    Ptr<EpcTftClassifier> c = Create<EpcTftClassifier>();
+    c->Add(EpcTft::Default(), 1);
+    for (uint32_t b = 0; b < bearers; ++b)
+    {
+        Ptr<EpcTft> tft = Create<EpcTft>();
+        for (uint32_t f = 0; f + 1 < filters; ++f)
+        {
+            EpcTft::PacketFilter pf;
+            pf.remotePortStart = UNMATCHED_PORT + f;
+            pf.remotePortEnd = UNMATCHED_PORT + f;
+            tft->Add(pf);
+        }
+        EpcTft::PacketFilter pf;
+        pf.remotePortStart = FLOW_PORT + b;
+        pf.remotePortEnd = FLOW_PORT + b;
+        tft->Add(pf);
+        c->Add(tft, 2 + b);
+    }
+    return c;
+}
+
+/**
+ * Create a downlink UDP packet of a UE.
+ *
+ * \param ue the UE index
+ * \param remotePort the port of the remote host
+ * \return the packet
+ */
+static Ptr<Packet>
+CreatePacket(uint32_t ue, uint16_t remotePort)
+{
+    Ptr<Packet> p = Create<Packet>(100);
+    UdpHeader udp;
+    udp.SetSourcePort(remotePort);
+    udp.SetDestinationPort(5000);
+    p->AddHeader(udp);
+    Ipv4Header ipv4;
+    ipv4.SetSource(Ipv4Address("1.0.0.1"));
+    ipv4.SetDestination(Ipv4Address(0x07000000 + ue + 2));
+    ipv4.SetProtocol(UdpL4Protocol::PROT_NUMBER);
+    ipv4.SetPayloadSize(p->GetSize());
+    p->AddHeader(ipv4);
+    return p;
+}
+
+/**
+ * Classify the packets of all the flows once.
+ *
+ * \param classifiers the classifier of each UE
+ * \param packets the packets of the flows of each UE
+ * \return the number of misclassified packets
+ */
+static uint32_t
+ClassifyAll(const std::vector<Ptr<EpcTftClassifier>>& classifiers,
+            const std::vector<std::vector<Ptr<Packet>>>& packets)
+{
+    uint32_t errors = 0;
+    for (uint32_t ue = 0; ue < classifiers.size(); ++ue)
+    {
+        for (uint32_t b = 0; b < packets[ue].size(); ++b)
+        {
+            uint32_t id = classifiers[ue]->Classify(packets[ue][b],
+                                                    EpcTft::DOWNLINK,
+                                                    Ipv4L3Protocol::PROT_NUMBER);
+            errors += (id != 2 + b);
+        }
+    }
+    return errors;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t ues = 10000;
+    uint32_t bearers = 4;
+    uint32_t maxFilters = 16;
+    uint32_t packets = 10;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the downlink EPC TFT classification.");
+    cmd.AddValue("ues", "number of UEs", ues);
+    cmd.AddValue("bearers", "number of dedicated bearers per UE", bearers);
+    cmd.AddValue("maxFilters", "maximum number of packet filters per bearer", maxFilters);
+    cmd.AddValue("packets", "number of packets per flow", packets);
+    cmd.Parse(argc, argv);
+
+    std::vector<std::vector<Ptr<Packet>>> flowPackets(ues);
+    for (uint32_t ue = 0; ue < ues; ++ue)
+    {
+        for (uint32_t b = 0; b < bearers; ++b)
+        {
+            flowPackets[ue].push_back(CreatePacket(ue, FLOW_PORT + b));
+        }
+    }
+    double flows = static_cast<double>(ues) * bearers;
+
+    std::cout << "ues=" << ues << " bearers=" << bearers << " packets/flow=" << packets
+              << std::endl;
+    std::cout << "filters/bearer  first packet [ns/pkt]  cached [ns/pkt]" << std::endl;
+    for (uint32_t filters = 1; filters <= maxFilters; filters *= 2)
+    {
+        std::vector<Ptr<EpcTftClassifier>> classifiers;
+        classifiers.reserve(ues);
+        for (uint32_t ue = 0; ue < ues; ++ue)
+        {
+            classifiers.push_back(CreateClassifier(bearers, filters));
+        }
+
+        SystemWallClockMs time;
+        time.Start();
+        uint32_t errors = ClassifyAll(classifiers, flowPackets);
+        double firstMs = time.End();
+
+        time.Start();
+        for (uint32_t i = 1; i < packets; ++i)
+        {
+            errors += ClassifyAll(classifiers, flowPackets);
+        }
+        double cachedMs = time.End();
+
+        if (errors > 0)
+        {
+            std::cerr << "misclassified packets: " << errors << std::endl;
+            return 1;
+        }
+        std::cout << filters << "\t\t" << firstMs * 1e6 / flows << "\t\t\t"
+                  << (packets > 1 ? cachedMs * 1e6 / (flows * (packets - 1)) : 0) << std::endl;
+    }
+    return 0;
+}